@@ -0,0 +1,347 @@
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+// Config files
+#include <SAMRAI_config.h>
+
+// Headers for basic PETSc functions
+#include <petscsys.h>
+
+// Headers for basic SAMRAI objects
+#include <BergerRigoutsos.h>
+#include <CartesianGridGeometry.h>
+#include <LoadBalancer.h>
+#include <StandardTagAndInitialize.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibamr/IBBeamForceSpec.h>
+#include <ibamr/IBSpringForceSpec.h>
+#include <ibamr/IBStandardInitializer.h>
+#include <ibamr/IBTargetPointForceSpec.h>
+#include <ibamr/app_namespaces.h>
+#include <ibtk/AppInitializer.h>
+#include <ibtk/LDataManager.h>
+#include <ibtk/LMesh.h>
+#include <ibtk/LNode.h>
+
+// A minimal tag and initialization strategy that initializes only the
+// Lagrangian data maintained by an LDataManager.
+class LDataInitializationStrategy
+    : public StandardTagAndInitStrategy<NDIM>
+{
+public:
+    LDataInitializationStrategy(
+        LDataManager* l_data_manager)
+        : d_l_data_manager(l_data_manager)
+    {
+        // intentionally blank
+        return;
+    }// LDataInitializationStrategy
+
+    void
+    initializeLevelData(
+        Pointer<BasePatchHierarchy<NDIM> > hierarchy,
+        int level_number,
+        double init_data_time,
+        bool can_be_refined,
+        bool initial_time,
+        Pointer<BasePatchLevel<NDIM> > old_level,
+        bool allocate_data)
+    {
+        d_l_data_manager->setPatchHierarchy(hierarchy);
+        d_l_data_manager->resetLevels(0, hierarchy->getFinestLevelNumber());
+        d_l_data_manager->initializeLevelData(hierarchy, level_number, init_data_time, can_be_refined, initial_time, old_level, allocate_data);
+        return;
+    }// initializeLevelData
+
+    void
+    resetHierarchyConfiguration(
+        Pointer<BasePatchHierarchy<NDIM> > hierarchy,
+        int coarsest_level,
+        int finest_level)
+    {
+        d_l_data_manager->setPatchHierarchy(hierarchy);
+        d_l_data_manager->resetLevels(0, hierarchy->getFinestLevelNumber());
+        d_l_data_manager->resetHierarchyConfiguration(hierarchy, coarsest_level, finest_level);
+        return;
+    }// resetHierarchyConfiguration
+
+    void
+    applyGradientDetector(
+        Pointer<BasePatchHierarchy<NDIM> > hierarchy,
+        int level_number,
+        double error_data_time,
+        int tag_index,
+        bool initial_time,
+        bool uses_richardson_extrapolation_too)
+    {
+        d_l_data_manager->applyGradientDetector(hierarchy, level_number, error_data_time, tag_index, initial_time, uses_richardson_extrapolation_too);
+        return;
+    }// applyGradientDetector
+
+private:
+    LDataManager* const d_l_data_manager;
+};
+
+// Function prototypes
+void
+initialize_lagrangian_data(
+    map<int,vector<double> >& node_data,
+    const string& initializer_name,
+    Pointer<AppInitializer> app_initializer,
+    Pointer<CartesianGridGeometry<NDIM> > grid_geometry,
+    Pointer<LoadBalancer<NDIM> > load_balancer);
+
+void
+collect_node_data(
+    map<int,vector<double> >& node_data,
+    LDataManager* l_data_manager,
+    const int finest_ln);
+
+/*******************************************************************************
+ * This program initializes the Lagrangian data using a sequence of            *
+ * IBStandardInitializer configurations, and it compares the data obtained     *
+ * with each configuration to the data obtained with a reference               *
+ * configuration.  For each configuration, the expected result of the          *
+ * comparison (MATCH or DIFFER) must be specified.  The program exits with a   *
+ * nonzero status if any comparison does not yield the expected result.       *
+ *                                                                             *
+ * The command line is:                                                        *
+ *                                                                             *
+ *    executable <input file name>                                             *
+ *                                                                             *
+ *******************************************************************************/
+int
+main(
+    int argc,
+    char* argv[])
+{
+    // Initialize PETSc, MPI, and SAMRAI.
+    PetscInitialize(&argc,&argv,NULL,NULL);
+    SAMRAI_MPI::setCommunicator(PETSC_COMM_WORLD);
+    SAMRAI_MPI::setCallAbortInSerialInsteadOfExit();
+    SAMRAIManager::startup();
+
+    int num_failures = 0;
+
+    {// cleanup dynamically allocated objects prior to shutdown
+
+        // Parse command line options, set some standard options from the input
+        // file, and enable file logging.
+        Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "IB.log");
+        Pointer<Database> main_db = app_initializer->getComponentDatabase("Main");
+
+        // Determine the initializer configurations to be tested.  The
+        // configurations are used in the order in which they are specified,
+        // followed by the reference configuration.
+        const string reference_initializer = main_db->getString("reference_initializer");
+        const int num_initializers = main_db->keyExists("initializers") ? main_db->getArraySize("initializers") : 0;
+        vector<string> initializers(num_initializers);
+        vector<string> expected_results(num_initializers);
+        if (num_initializers > 0)
+        {
+            if (!main_db->keyExists("expected_results") || main_db->getArraySize("expected_results") != num_initializers)
+            {
+                TBOX_ERROR("Key data `expected_results' must have the same number of entries as `initializers'.\n");
+            }
+            main_db->getStringArray("initializers", &initializers[0], num_initializers);
+            main_db->getStringArray("expected_results", &expected_results[0], num_initializers);
+        }
+
+        // Create the objects that are shared by all of the configurations.
+        Pointer<CartesianGridGeometry<NDIM> > grid_geometry = new CartesianGridGeometry<NDIM>(
+            "CartesianGeometry", app_initializer->getComponentDatabase("CartesianGeometry"));
+        Pointer<LoadBalancer<NDIM> > load_balancer = new LoadBalancer<NDIM>(
+            "LoadBalancer", app_initializer->getComponentDatabase("LoadBalancer"));
+
+        // Initialize the Lagrangian data using each configuration.
+        vector<map<int,vector<double> > > node_data(num_initializers);
+        for (int k = 0; k < num_initializers; ++k)
+        {
+            initialize_lagrangian_data(node_data[k], initializers[k], app_initializer, grid_geometry, load_balancer);
+        }
+        map<int,vector<double> > reference_node_data;
+        initialize_lagrangian_data(reference_node_data, reference_initializer, app_initializer, grid_geometry, load_balancer);
+
+        // Compare the data obtained using each configuration to the reference
+        // data.
+        for (int k = 0; k < num_initializers; ++k)
+        {
+            const int num_mismatches = SAMRAI_MPI::sumReduction(node_data[k] == reference_node_data ? 0 : 1);
+            const string result = num_mismatches == 0 ? "MATCH" : "DIFFER";
+            pout << initializers[k] << ": Lagrangian data " << (num_mismatches == 0 ? "match" : "differ from") << " those obtained using " << reference_initializer;
+            if (result == expected_results[k])
+            {
+                pout << " (expected)\n";
+            }
+            else
+            {
+                pout << " (expected " << expected_results[k] << ")\n";
+                ++num_failures;
+            }
+        }
+        pout << (num_failures == 0 ? "PASSED" : "FAILED") << "\n";
+
+    }// cleanup dynamically allocated objects prior to shutdown
+
+    SAMRAIManager::shutdown();
+    PetscFinalize();
+    return num_failures == 0 ? 0 : 1;
+}// main
+
+void
+initialize_lagrangian_data(
+    map<int,vector<double> >& node_data,
+    const string& initializer_name,
+    Pointer<AppInitializer> app_initializer,
+    Pointer<CartesianGridGeometry<NDIM> > grid_geometry,
+    Pointer<LoadBalancer<NDIM> > load_balancer)
+{
+    pout << "Initializing Lagrangian data using " << initializer_name << "\n";
+
+    // Each configuration uses its own Lagrangian data manager and patch
+    // hierarchy, so that no data are shared between configurations.
+    LDataManager* l_data_manager = LDataManager::getManager(
+        initializer_name+"::LDataManager", "IB_4", "IB_4", IntVector<NDIM>(0), /*register_for_restart*/ false);
+    LDataInitializationStrategy l_data_init_strategy(l_data_manager);
+    Pointer<PatchHierarchy<NDIM> > patch_hierarchy = new PatchHierarchy<NDIM>(
+        initializer_name+"::PatchHierarchy", grid_geometry, /*register_for_restart*/ false);
+    Pointer<StandardTagAndInitialize<NDIM> > error_detector = new StandardTagAndInitialize<NDIM>(
+        initializer_name+"::StandardTagAndInitialize", &l_data_init_strategy, app_initializer->getComponentDatabase("StandardTagAndInitialize"));
+    Pointer<BergerRigoutsos<NDIM> > box_generator = new BergerRigoutsos<NDIM>();
+    Pointer<GriddingAlgorithm<NDIM> > gridding_algorithm = new GriddingAlgorithm<NDIM>(
+        initializer_name+"::GriddingAlgorithm", app_initializer->getComponentDatabase("GriddingAlgorithm"), error_detector, box_generator, load_balancer, /*register_for_restart*/ false);
+
+    // Initialize the patch hierarchy and the Lagrangian data.
+    Pointer<IBStandardInitializer> ib_initializer = new IBStandardInitializer(
+        initializer_name, app_initializer->getComponentDatabase(initializer_name));
+    l_data_manager->registerLInitStrategy(ib_initializer);
+    gridding_algorithm->makeCoarsestLevel(patch_hierarchy, 0.0);
+    int level_number = 0;
+    bool done = false;
+    while (!done && gridding_algorithm->levelCanBeRefined(level_number))
+    {
+        gridding_algorithm->makeFinerLevel(patch_hierarchy, 0.0, true, 0);
+        done = !patch_hierarchy->finerLevelExists(level_number);
+        ++level_number;
+    }
+    l_data_manager->beginDataRedistribution();
+    l_data_manager->endDataRedistribution();
+    l_data_manager->freeLInitStrategy();
+    ib_initializer.setNull();
+
+    // Collect the data associated with the nodes.
+    collect_node_data(node_data, l_data_manager, patch_hierarchy->getFinestLevelNumber());
+    return;
+}// initialize_lagrangian_data
+
+void
+collect_node_data(
+    map<int,vector<double> >& node_data,
+    LDataManager* l_data_manager,
+    const int finest_ln)
+{
+    // For each local node, record the node position and the contents of the
+    // spring, beam, and target point specifications associated with the node.
+    for (int ln = 0; ln <= finest_ln; ++ln)
+    {
+        if (!l_data_manager->levelContainsLagrangianData(ln)) continue;
+        Pointer<LData> X_data = l_data_manager->getLData(LDataManager::POSN_DATA_NAME, ln);
+        const blitz::Array<double,2>& X = *X_data->getLocalFormVecArray();
+        const Pointer<LMesh> mesh = l_data_manager->getLMesh(ln);
+        const vector<LNode*>& local_nodes = mesh->getLocalNodes();
+        for (vector<LNode*>::const_iterator cit = local_nodes.begin(); cit != local_nodes.end(); ++cit)
+        {
+            const LNode* const node = *cit;
+            vector<double>& data = node_data[node->getLagrangianIndex()];
+            const int local_idx = node->getLocalPETScIndex();
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                data.push_back(X(local_idx,d));
+            }
+
+            const IBSpringForceSpec* const spring_spec = node->getNodeDataItem<IBSpringForceSpec>();
+            if (spring_spec)
+            {
+                const unsigned int num_springs = spring_spec->getNumberOfSprings();
+                data.push_back(num_springs);
+                for (unsigned int k = 0; k < num_springs; ++k)
+                {
+                    data.push_back(spring_spec->getSlaveNodeIndices()[k]);
+                    data.push_back(spring_spec->getForceFunctionIndices()[k]);
+                    const vector<double>& parameters = spring_spec->getParameters()[k];
+                    data.push_back(parameters.size());
+                    data.insert(data.end(), parameters.begin(), parameters.end());
+                }
+            }
+            else
+            {
+                data.push_back(-1.0);
+            }
+
+            const IBBeamForceSpec* const beam_spec = node->getNodeDataItem<IBBeamForceSpec>();
+            if (beam_spec)
+            {
+                const unsigned int num_beams = beam_spec->getNumberOfBeams();
+                data.push_back(num_beams);
+                for (unsigned int k = 0; k < num_beams; ++k)
+                {
+                    data.push_back(beam_spec->getNeighborNodeIndices()[k].first);
+                    data.push_back(beam_spec->getNeighborNodeIndices()[k].second);
+                    data.push_back(beam_spec->getBendingRigidities()[k]);
+                    for (unsigned int d = 0; d < NDIM; ++d)
+                    {
+                        data.push_back(beam_spec->getMeshDependentCurvatures()[k][d]);
+                    }
+                }
+            }
+            else
+            {
+                data.push_back(-1.0);
+            }
+
+            const IBTargetPointForceSpec* const target_spec = node->getNodeDataItem<IBTargetPointForceSpec>();
+            if (target_spec)
+            {
+                data.push_back(target_spec->getStiffness());
+                data.push_back(target_spec->getDamping());
+                for (unsigned int d = 0; d < NDIM; ++d)
+                {
+                    data.push_back(target_spec->getTargetPointPosition()[d]);
+                }
+            }
+            else
+            {
+                data.push_back(-1.0);
+            }
+        }
+        X_data->restoreArrays();
+    }
+    return;
+}// collect_node_data
@@ -0,0 +1,386 @@
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+
+// Config files
+#include <IBTK_prefix_config.h>
+#include <SAMRAI_config.h>
+
+// Headers for basic PETSc objects
+#include <petscsys.h>
+
+// Headers for basic libraries
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+// Headers for major SAMRAI objects
+#include <BoxArray.h>
+#include <CartesianGridGeometry.h>
+#include <CartesianPatchGeometry.h>
+#include <CellVariable.h>
+#include <PatchHierarchy.h>
+#include <PatchLevel.h>
+#include <ProcessorMapping.h>
+#include <SideVariable.h>
+#include <VariableDatabase.h>
+#include <tbox/DatabaseBox.h>
+#include <tbox/MemoryDatabase.h>
+
+// Headers for application-specific algorithm/data structure objects
+#include <ibtk/AppInitializer.h>
+#include <ibtk/LEInteractor.h>
+#include <ibtk/app_namespaces.h>
+
+// Function prototypes
+static Pointer<PatchHierarchy<NDIM> >
+build_single_patch_hierarchy(
+    int patch_size);
+
+static void
+generate_markers(
+    std::vector<double>& X,
+    int num_markers,
+    bool sorted,
+    Pointer<Patch<NDIM> > patch);
+
+static double
+time_operation(
+    bool spread,
+    Pointer<PatchData<NDIM> > q_data,
+    std::vector<double>& Q,
+    int Q_depth,
+    const std::vector<double>& X,
+    Pointer<Patch<NDIM> > patch,
+    const std::string& weighting_fcn,
+    int num_repetitions);
+
+/*******************************************************************************
+ * For each run, the input filename must be given on the command line.  In all *
+ * cases, the command line is:                                                 *
+ *                                                                             *
+ *    executable <input file name>                                             *
+ *                                                                             *
+ *******************************************************************************/
+int
+main(
+    int argc,
+    char *argv[])
+{
+    // Initialize PETSc, MPI, and SAMRAI.
+    PetscInitialize(&argc,&argv,NULL,NULL);
+    SAMRAI_MPI::setCommunicator(PETSC_COMM_WORLD);
+    SAMRAI_MPI::setCallAbortInSerialInsteadOfExit();
+    SAMRAIManager::startup();
+
+    {// cleanup dynamically allocated objects prior to shutdown
+
+        // Parse command line options, set some standard options from the input
+        // file, and enable file logging.
+        Pointer<AppInitializer> app_initializer = new AppInitializer(argc, argv, "le_interactor_benchmark.log");
+        Pointer<Database> input_db = app_initializer->getInputDatabase();
+        if (SAMRAI_MPI::getNodes() != 1)
+        {
+            TBOX_ERROR("LEInteractorBenchmark must be run on a single processor.\n");
+        }
+
+        // Configure the Lagrangian-Eulerian interaction routines.
+        if (input_db->keyExists("LEInteractor"))
+        {
+            LEInteractor::setFromDatabase(input_db->getDatabase("LEInteractor"));
+        }
+        LEInteractor::printClassData(pout);
+
+        // Read the benchmark parameters.
+        Pointer<Database> bench_db = app_initializer->getComponentDatabase("LEInteractorBenchmark");
+        const Array<std::string> weighting_fcns = bench_db->getStringArray("weighting_fcns");
+        const Array<int> patch_sizes = bench_db->getIntegerArray("patch_sizes");
+        const Array<int> ghost_widths = bench_db->getIntegerArray("ghost_widths");
+        const Array<double> marker_densities = bench_db->getDoubleArray("marker_densities");
+        const Array<std::string> marker_orderings = bench_db->getStringArray("marker_orderings");
+        const std::string data_centering = bench_db->getStringWithDefault("data_centering", "SIDE");
+        const int num_repetitions = bench_db->getIntegerWithDefault("num_repetitions", 10);
+        const int random_seed = bench_db->getIntegerWithDefault("random_seed", 0);
+        if (data_centering != "CELL" && data_centering != "SIDE")
+        {
+            TBOX_ERROR("LEInteractorBenchmark: unknown data centering " << data_centering << "\n"
+                       << "valid choices are: CELL, SIDE\n");
+        }
+        for (int k = 0; k < weighting_fcns.getSize(); ++k)
+        {
+            if (!LEInteractor::isAvailableWeightingFunction(weighting_fcns[k]))
+            {
+                TBOX_ERROR("LEInteractorBenchmark: weighting function " << weighting_fcns[k] << " is not available for NDIM = " << NDIM << "\n");
+            }
+        }
+        for (int k = 0; k < marker_orderings.getSize(); ++k)
+        {
+            if (marker_orderings[k] != "UNSORTED" && marker_orderings[k] != "SORTED")
+            {
+                TBOX_ERROR("LEInteractorBenchmark: unknown marker ordering " << marker_orderings[k] << "\n"
+                           << "valid choices are: UNSORTED, SORTED\n");
+            }
+        }
+        std::srand(static_cast<unsigned int>(random_seed));
+
+        // Register one Eulerian variable for each ghost cell width.
+        VariableDatabase<NDIM>* var_db = VariableDatabase<NDIM>::getDatabase();
+        Pointer<VariableContext> ctx = var_db->getContext("LEInteractorBenchmark");
+        std::vector<int> q_idxs(ghost_widths.getSize());
+        for (int k = 0; k < ghost_widths.getSize(); ++k)
+        {
+            std::ostringstream var_name;
+            var_name << "q_gcw_" << ghost_widths[k];
+            Pointer<Variable<NDIM> > q_var;
+            if (data_centering == "CELL")
+            {
+                q_var = new CellVariable<NDIM,double>(var_name.str(), NDIM);
+            }
+            else
+            {
+                q_var = new SideVariable<NDIM,double>(var_name.str());
+            }
+            q_idxs[k] = var_db->registerVariableAndContext(q_var, ctx, IntVector<NDIM>(ghost_widths[k]));
+        }
+
+        // Run the benchmark cases.
+        const int Q_depth = NDIM;
+        pout << "\n"
+             << std::setw(24) << "weighting_fcn"
+             << std::setw(8)  << "N"
+             << std::setw(6)  << "gcw"
+             << std::setw(10) << "density"
+             << std::setw(10) << "ordering"
+             << std::setw(12) << "markers"
+             << std::setw(14) << "spread M/s"
+             << std::setw(14) << "spread GB/s"
+             << std::setw(14) << "interp M/s"
+             << std::setw(14) << "interp GB/s" << "\n";
+        for (int n = 0; n < patch_sizes.getSize(); ++n)
+        {
+            Pointer<PatchHierarchy<NDIM> > patch_hierarchy = build_single_patch_hierarchy(patch_sizes[n]);
+            Pointer<PatchLevel<NDIM> > level = patch_hierarchy->getPatchLevel(0);
+            Pointer<Patch<NDIM> > patch;
+            for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+            {
+                patch = level->getPatch(p());
+            }
+            const int num_cells = patch->getBox().size();
+            for (int g = 0; g < ghost_widths.getSize(); ++g)
+            {
+                level->allocatePatchData(q_idxs[g], 0.0);
+                Pointer<PatchData<NDIM> > q_data = patch->getPatchData(q_idxs[g]);
+                for (int d = 0; d < marker_densities.getSize(); ++d)
+                {
+                    const int num_markers = std::max(1, static_cast<int>(marker_densities[d]*static_cast<double>(num_cells)));
+                    for (int o = 0; o < marker_orderings.getSize(); ++o)
+                    {
+                        std::vector<double> X, Q(Q_depth*num_markers, 1.0);
+                        generate_markers(X, num_markers, marker_orderings[o] == "SORTED", patch);
+                        for (int w = 0; w < weighting_fcns.getSize(); ++w)
+                        {
+                            const std::string& weighting_fcn = weighting_fcns[w];
+                            const int stencil_size = LEInteractor::getStencilSize(weighting_fcn);
+                            if (ghost_widths[g] < stencil_size/2+1)
+                            {
+                                // The stencil does not fit within the ghost
+                                // cell region; skip this case.
+                                continue;
+                            }
+
+                            // Nominal number of bytes touched per marker: the
+                            // Eulerian stencil values (read and written when
+                            // spreading) along with the marker position and
+                            // Lagrangian values.
+                            double stencil_values = 1.0;
+                            for (int k = 0; k < NDIM; ++k) stencil_values *= static_cast<double>(stencil_size);
+                            const double marker_bytes = static_cast<double>((NDIM+Q_depth)*sizeof(double));
+                            const double interp_bytes = static_cast<double>(Q_depth)*stencil_values*sizeof(double)+marker_bytes;
+                            const double spread_bytes = 2.0*static_cast<double>(Q_depth)*stencil_values*sizeof(double)+marker_bytes;
+
+                            const double spread_time = time_operation(true , q_data, Q, Q_depth, X, patch, weighting_fcn, num_repetitions);
+                            const double interp_time = time_operation(false, q_data, Q, Q_depth, X, patch, weighting_fcn, num_repetitions);
+                            const double num_ops = static_cast<double>(num_markers)*static_cast<double>(num_repetitions);
+                            pout << std::setw(24) << weighting_fcn
+                                 << std::setw(8)  << patch_sizes[n]
+                                 << std::setw(6)  << ghost_widths[g]
+                                 << std::setw(10) << marker_densities[d]
+                                 << std::setw(10) << marker_orderings[o]
+                                 << std::setw(12) << num_markers
+                                 << std::setw(14) << std::setprecision(4) << 1.0e-6*num_ops/spread_time
+                                 << std::setw(14) << std::setprecision(4) << 1.0e-9*num_ops*spread_bytes/spread_time
+                                 << std::setw(14) << std::setprecision(4) << 1.0e-6*num_ops/interp_time
+                                 << std::setw(14) << std::setprecision(4) << 1.0e-9*num_ops*interp_bytes/interp_time << "\n";
+                        }
+                    }
+                }
+                level->deallocatePatchData(q_idxs[g]);
+            }
+        }
+
+    }// cleanup dynamically allocated objects prior to shutdown
+
+    SAMRAIManager::shutdown();
+    PetscFinalize();
+    return 0;
+}// main
+
+static Pointer<PatchHierarchy<NDIM> >
+build_single_patch_hierarchy(
+    const int patch_size)
+{
+    // Setup a periodic unit-sized domain consisting of a single N^NDIM patch.
+    // Periodicity ensures that the patch does not touch any physical
+    // boundaries, so that all of the interaction kernels are available.
+    int lower[NDIM], upper[NDIM], periodic_dimension[NDIM];
+    double x_lo[NDIM], x_up[NDIM];
+    for (int d = 0; d < NDIM; ++d)
+    {
+        lower[d] = 0;
+        upper[d] = patch_size-1;
+        periodic_dimension[d] = 1;
+        x_lo[d] = 0.0;
+        x_up[d] = 1.0;
+    }
+    Array<DatabaseBox> domain_boxes(1);
+    domain_boxes[0] = DatabaseBox(NDIM, lower, upper);
+    Pointer<Database> geometry_db = new MemoryDatabase("CartesianGeometry");
+    geometry_db->putDatabaseBoxArray("domain_boxes", domain_boxes);
+    geometry_db->putDoubleArray("x_lo", x_lo, NDIM);
+    geometry_db->putDoubleArray("x_up", x_up, NDIM);
+    geometry_db->putIntegerArray("periodic_dimension", periodic_dimension, NDIM);
+    Pointer<CartesianGridGeometry<NDIM> > grid_geometry = new CartesianGridGeometry<NDIM>("CartesianGeometry", geometry_db, false);
+    Pointer<PatchHierarchy<NDIM> > patch_hierarchy = new PatchHierarchy<NDIM>("PatchHierarchy", grid_geometry, false);
+
+    // Assign the single patch to this processor.
+    const BoxArray<NDIM>& patch_boxes = grid_geometry->getPhysicalDomain();
+    ProcessorMapping mapping(patch_boxes.getNumberOfBoxes());
+    for (int k = 0; k < patch_boxes.getNumberOfBoxes(); ++k)
+    {
+        mapping.setProcessorAssignment(k, SAMRAI_MPI::getRank());
+    }
+    patch_hierarchy->makeNewPatchLevel(0, IntVector<NDIM>(1), patch_boxes, mapping);
+    return patch_hierarchy;
+}// build_single_patch_hierarchy
+
+static void
+generate_markers(
+    std::vector<double>& X,
+    const int num_markers,
+    const bool sorted,
+    Pointer<Patch<NDIM> > patch)
+{
+    // Place markers at pseudo-random locations within the interior of the
+    // patch.
+    const Pointer<CartesianPatchGeometry<NDIM> > pgeom = patch->getPatchGeometry();
+    const double* const x_lower = pgeom->getXLower();
+    const double* const x_upper = pgeom->getXUpper();
+    const double* const dx = pgeom->getDx();
+    const Box<NDIM>& patch_box = patch->getBox();
+    std::vector<double> X_unsorted(NDIM*num_markers);
+    for (int k = 0; k < num_markers; ++k)
+    {
+        for (int d = 0; d < NDIM; ++d)
+        {
+            const double r = static_cast<double>(std::rand())/(static_cast<double>(RAND_MAX)+1.0);
+            X_unsorted[NDIM*k+d] = x_lower[d]+r*(x_upper[d]-x_lower[d]);
+        }
+    }
+    if (!sorted)
+    {
+        X.swap(X_unsorted);
+        return;
+    }
+
+    // Order the markers by the lexicographic index of the cell that contains
+    // them, with the first coordinate direction varying fastest.
+    std::vector<std::pair<int,int> > cell_idxs(num_markers);
+    for (int k = 0; k < num_markers; ++k)
+    {
+        int offset = 0;
+        for (int d = NDIM-1; d >= 0; --d)
+        {
+            const int n = patch_box.numberCells(d);
+            const int i = std::min(n-1, static_cast<int>((X_unsorted[NDIM*k+d]-x_lower[d])/dx[d]));
+            offset = n*offset+i;
+        }
+        cell_idxs[k] = std::make_pair(offset, k);
+    }
+    std::sort(cell_idxs.begin(), cell_idxs.end());
+    X.resize(NDIM*num_markers);
+    for (int k = 0; k < num_markers; ++k)
+    {
+        const int j = cell_idxs[k].second;
+        for (int d = 0; d < NDIM; ++d)
+        {
+            X[NDIM*k+d] = X_unsorted[NDIM*j+d];
+        }
+    }
+    return;
+}// generate_markers
+
+static double
+time_operation(
+    const bool spread,
+    Pointer<PatchData<NDIM> > q_data,
+    std::vector<double>& Q,
+    const int Q_depth,
+    const std::vector<double>& X,
+    Pointer<Patch<NDIM> > patch,
+    const std::string& weighting_fcn,
+    const int num_repetitions)
+{
+    Pointer<CellData<NDIM,double> > q_cc_data = q_data;
+    Pointer<SideData<NDIM,double> > q_sc_data = q_data;
+    const int Q_size = static_cast<int>(Q.size());
+    const int X_size = static_cast<int>(X.size());
+    const Box<NDIM> box = spread ? q_data->getGhostBox() : patch->getBox();
+
+    // Perform one untimed pass to warm up the caches, then time the requested
+    // number of repetitions.
+    double start_time = 0.0;
+    for (int k = -1; k < num_repetitions; ++k)
+    {
+        if (k == 0) start_time = MPI_Wtime();
+        if (spread)
+        {
+            if (q_cc_data) LEInteractor::spread(q_cc_data, &Q[0], Q_size, Q_depth, &X[0], X_size, NDIM, patch, box, weighting_fcn);
+            if (q_sc_data) LEInteractor::spread(q_sc_data, &Q[0], Q_size, Q_depth, &X[0], X_size, NDIM, patch, box, weighting_fcn);
+        }
+        else
+        {
+            if (q_cc_data) LEInteractor::interpolate(&Q[0], Q_size, Q_depth, &X[0], X_size, NDIM, q_cc_data, patch, box, weighting_fcn);
+            if (q_sc_data) LEInteractor::interpolate(&Q[0], Q_size, Q_depth, &X[0], X_size, NDIM, q_sc_data, patch, box, weighting_fcn);
+        }
+    }
+    return std::max(MPI_Wtime()-start_time, 1.0e-12);
+}// time_operation
@@ -0,0 +1 @@
+../../src/utilities/ASCIIFileParser-inl.h
\ No newline at end of file
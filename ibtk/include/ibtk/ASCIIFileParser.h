@@ -0,0 +1 @@
+../../src/utilities/ASCIIFileParser.h
\ No newline at end of file
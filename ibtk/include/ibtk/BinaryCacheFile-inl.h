@@ -0,0 +1 @@
+../../src/utilities/BinaryCacheFile-inl.h
\ No newline at end of file
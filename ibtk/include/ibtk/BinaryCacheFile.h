@@ -0,0 +1 @@
+../../src/utilities/BinaryCacheFile.h
\ No newline at end of file
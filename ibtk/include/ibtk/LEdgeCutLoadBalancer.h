@@ -0,0 +1 @@
+../../src/lagrangian/LEdgeCutLoadBalancer.h
\ No newline at end of file
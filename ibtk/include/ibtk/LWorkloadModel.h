@@ -0,0 +1 @@
+../../src/lagrangian/LWorkloadModel.h
\ No newline at end of file
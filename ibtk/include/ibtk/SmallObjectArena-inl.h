@@ -0,0 +1 @@
+../../src/utilities/SmallObjectArena-inl.h
\ No newline at end of file
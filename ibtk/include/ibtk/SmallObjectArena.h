@@ -0,0 +1 @@
+../../src/utilities/SmallObjectArena.h
\ No newline at end of file
@@ -73,6 +73,7 @@
 #include "ibtk/IBTK_CHKERRQ.h"
 #include "ibtk/IndexUtilities.h"
 #include "ibtk/LEInteractor.h"
+#include "ibtk/LWorkloadModel.h"
 #include "ibtk/ibtk_utilities.h"
 #include "ibtk/libmesh_utilities.h"
 #include "ibtk/namespaces.h" // IWYU pragma: keep
@@ -281,6 +282,28 @@ FEDataManager::registerLoadBalancer(
     return;
 }// return
 
+void
+FEDataManager::setUseMeasuredWorkloadEstimates(
+    const bool use_measured_workload_estimates)
+{
+    if (use_measured_workload_estimates && !d_workload_model)
+    {
+        d_workload_model = new LWorkloadModel(d_object_name+"::workload_model");
+    }
+    else if (!use_measured_workload_estimates)
+    {
+        d_workload_model.setNull();
+        d_has_measured_workload_weights = false;
+    }
+    return;
+}// setUseMeasuredWorkloadEstimates
+
+Pointer<LWorkloadModel>
+FEDataManager::getWorkloadModel() const
+{
+    return d_workload_model;
+}// getWorkloadModel
+
 void
 FEDataManager::setPatchHierarchy(
     Pointer<PatchHierarchy<NDIM> > hierarchy)
@@ -445,7 +468,7 @@ FEDataManager::spread(
     // Extract the mesh.
     const MeshBase& mesh = d_es->get_mesh();
     const int dim = mesh.mesh_dimension();
-    AutoPtr<QBase> qrule = QBase::build(QGAUSS, dim, FIRST);
+    QBase* qrule = NULL;
 
     // Extract the FE systems and DOF maps, and setup the FE objects.
     System& F_system = d_es->get_system(system_name);
@@ -457,7 +480,6 @@ FEDataManager::spread(
     blitz::Array<std::vector<unsigned int>,1> F_dof_indices(n_vars);
     for (unsigned int i = 0; i < n_vars; ++i) F_dof_indices(i).reserve(NDIM == 2 ? 9 : 27);
     AutoPtr<FEBase> F_fe(FEBase::build(dim, F_dof_map.variable_type(0)));
-    F_fe->attach_quadrature_rule(qrule.get());
     const std::vector<double>& JxW_F = F_fe->get_JxW();
     const std::vector<std::vector<double> >& phi_F = F_fe->get_phi();
 
@@ -468,8 +490,8 @@ FEDataManager::spread(
 #endif
     blitz::Array<std::vector<unsigned int>,1> X_dof_indices(NDIM);
     for (unsigned int d = 0; d < NDIM; ++d) X_dof_indices(d).reserve(NDIM == 2 ? 9 : 27);
-    AutoPtr<FEBase> X_fe(FEBase::build(dim, X_dof_map.variable_type(0)));
-    X_fe->attach_quadrature_rule(qrule.get());
+    const FEType& X_fe_type = X_dof_map.variable_type(0);
+    AutoPtr<FEBase> X_fe(FEBase::build(dim, X_fe_type));
     const std::vector<std::vector<double> >& phi_X = X_fe->get_phi();
 
     // Communicate any unsynchronized ghost data and enforce any constraints.
@@ -492,6 +514,7 @@ FEDataManager::spread(
         const blitz::Array<Elem*,1>& patch_elems = d_active_patch_elem_map(local_patch_num);
         const unsigned int num_active_patch_elems = patch_elems.size();
         if (num_active_patch_elems == 0) continue;
+        const double patch_start_time = (d_workload_model ? MPI_Wtime() : 0.0);
 
         const Pointer<Patch<NDIM> > patch = level->getPatch(p());
         const Pointer<CartesianPatchGeometry<NDIM> > patch_geom = patch->getPatchGeometry();
@@ -513,16 +536,21 @@ FEDataManager::spread(
             const int npts = std::max(elem->default_order() == FIRST ? 1.0 : 2.0,
                                       std::ceil(POINT_FACTOR*hmax/patch_dx_min));
             const Order order = static_cast<Order>(std::min(2*npts-1,static_cast<int>(FORTYTHIRD)));
-            if (order != qrule->get_order())
+            QBase* const elem_qrule = getQuadratureRule(elem->type(), order, dim);
+            if (elem_qrule != qrule)
             {
-                qrule = QBase::build(QGAUSS, dim, order);
-                F_fe->attach_quadrature_rule(qrule.get());
-                X_fe->attach_quadrature_rule(qrule.get());
+                qrule = elem_qrule;
+                F_fe->attach_quadrature_rule(qrule);
+                X_fe->attach_quadrature_rule(qrule);
             }
-            X_fe->reinit(elem);
+            if (elem->p_level() != 0) X_fe->reinit(elem);
             n_qp_patch += qrule->n_points();
         }
-        if (n_qp_patch == 0) continue;
+        if (n_qp_patch == 0)
+        {
+            if (d_workload_model) d_workload_model->addPatchWorkTime(d_level_number, p(), MPI_Wtime()-patch_start_time);
+            continue;
+        }
         std::vector<double> F_JxW_qp(n_vars*n_qp_patch);
         std::vector<double>     X_qp(NDIM  *n_qp_patch);
 
@@ -546,14 +574,17 @@ FEDataManager::spread(
             const int npts = std::max(elem->default_order() == FIRST ? 1.0 : 2.0,
                                       std::ceil(POINT_FACTOR*hmax/patch_dx_min));
             const Order order = static_cast<Order>(std::min(2*npts-1,static_cast<int>(FORTYTHIRD)));
-            if (order != qrule->get_order())
+            QBase* const elem_qrule = getQuadratureRule(elem->type(), order, dim);
+            if (elem_qrule != qrule)
             {
-                qrule = QBase::build(QGAUSS, dim, order);
-                F_fe->attach_quadrature_rule(qrule.get());
-                X_fe->attach_quadrature_rule(qrule.get());
+                qrule = elem_qrule;
+                F_fe->attach_quadrature_rule(qrule);
+                X_fe->attach_quadrature_rule(qrule);
             }
             F_fe->reinit(elem);
-            X_fe->reinit(elem);
+            const std::vector<std::vector<double> >* const phi_X_ref = (elem->p_level() == 0 ? getReferenceShapeFunctions(X_fe_type, elem->type(), order, dim) : NULL);
+            if (!phi_X_ref) X_fe->reinit(elem);
+            const std::vector<std::vector<double> >& phi_X_elem = (phi_X_ref ? *phi_X_ref : phi_X);
             const unsigned int n_qp = qrule->n_points();
             for (unsigned int qp = 0; qp < n_qp; ++qp)
             {
@@ -567,7 +598,7 @@ FEDataManager::spread(
             for (unsigned int qp = 0; qp < n_qp; ++qp)
             {
                 const int idx = NDIM*(qp+qp_offset);
-                interpolate(&X_qp[idx],qp,X_node,phi_X);
+                interpolate(&X_qp[idx],qp,X_node,phi_X_elem);
             }
 
             qp_offset += n_qp;
@@ -585,6 +616,7 @@ FEDataManager::spread(
         const bool is_sc_data = f_sc_data;
         if (is_cc_data) LEInteractor::spread(f_cc_data, F_JxW_qp, n_vars, X_qp, NDIM, patch, spread_box, d_spread_weighting_fcn);
         if (is_sc_data) LEInteractor::spread(f_sc_data, F_JxW_qp, n_vars, X_qp, NDIM, patch, spread_box, d_spread_weighting_fcn);
+        if (d_workload_model) d_workload_model->addPatchWorkTime(d_level_number, p(), MPI_Wtime()-patch_start_time);
     }
 
     IBTK_TIMER_STOP(t_spread);
@@ -666,6 +698,7 @@ FEDataManager::prolongData(
         const blitz::Array<Elem*,1>& patch_elems = d_active_patch_elem_map(local_patch_num);
         const unsigned int num_active_patch_elems = patch_elems.size();
         if (num_active_patch_elems == 0) continue;
+        const double patch_start_time = (d_workload_model ? MPI_Wtime() : 0.0);
 
         const Pointer<Patch<NDIM> > patch = level->getPatch(p());
         Pointer<SideData<NDIM,double> > f_data = patch->getPatchData(f_data_idx);
@@ -807,6 +840,7 @@ FEDataManager::prolongData(
                 (*f_data)(s_i) = (accumulate_on_grid ? (*f_data)(s_i) : 0.0) + F_qp;
             }
         }
+        if (d_workload_model) d_workload_model->addPatchWorkTime(d_level_number, p(), MPI_Wtime()-patch_start_time);
     }
 
     IBTK_TIMER_STOP(t_prolong_data);
@@ -828,7 +862,7 @@ FEDataManager::interp(
     // Extract the mesh.
     const MeshBase& mesh = d_es->get_mesh();
     const int dim = mesh.mesh_dimension();
-    AutoPtr<QBase> qrule = QBase::build(QGAUSS, dim, FIRST);
+    QBase* qrule = NULL;
 
     // Extract the FE systems and DOF maps, and setup the FE objects.
     System& F_system = d_es->get_system(system_name);
@@ -840,7 +874,6 @@ FEDataManager::interp(
     blitz::Array<std::vector<unsigned int>,1> F_dof_indices(n_vars);
     for (unsigned int i = 0; i < n_vars; ++i) F_dof_indices(i).reserve(NDIM == 2 ? 9 : 27);
     AutoPtr<FEBase> F_fe(FEBase::build(dim, F_dof_map.variable_type(0)));
-    F_fe->attach_quadrature_rule(qrule.get());
     const std::vector<double>& JxW_F = F_fe->get_JxW();
     const std::vector<std::vector<double> >& phi_F = F_fe->get_phi();
 
@@ -851,8 +884,8 @@ FEDataManager::interp(
 #endif
     blitz::Array<std::vector<unsigned int>,1> X_dof_indices(NDIM);
     for (unsigned int d = 0; d < NDIM; ++d) X_dof_indices(d).reserve(NDIM == 2 ? 9 : 27);
-    AutoPtr<FEBase> X_fe(FEBase::build(dim, X_dof_map.variable_type(0)));
-    X_fe->attach_quadrature_rule(qrule.get());
+    const FEType& X_fe_type = X_dof_map.variable_type(0);
+    AutoPtr<FEBase> X_fe(FEBase::build(dim, X_fe_type));
     const std::vector<std::vector<double> >& phi_X = X_fe->get_phi();
 
     // Communicate any unsynchronized ghost data and enforce any constraints.
@@ -879,6 +912,7 @@ FEDataManager::interp(
         const blitz::Array<Elem*,1>& patch_elems = d_active_patch_elem_map(local_patch_num);
         const unsigned int num_active_patch_elems = patch_elems.size();
         if (num_active_patch_elems == 0) continue;
+        const double patch_start_time = (d_workload_model ? MPI_Wtime() : 0.0);
 
         const Pointer<Patch<NDIM> > patch = level->getPatch(p());
         const Pointer<CartesianPatchGeometry<NDIM> > patch_geom = patch->getPatchGeometry();
@@ -900,16 +934,21 @@ FEDataManager::interp(
             const int npts = std::max(elem->default_order() == FIRST ? 1.0 : 2.0,
                                       std::ceil(POINT_FACTOR*hmax/patch_dx_min));
             const Order order = static_cast<Order>(std::min(2*npts-1,static_cast<int>(FORTYTHIRD)));
-            if (order != qrule->get_order())
+            QBase* const elem_qrule = getQuadratureRule(elem->type(), order, dim);
+            if (elem_qrule != qrule)
             {
-                qrule = QBase::build(QGAUSS, dim, order);
-                F_fe->attach_quadrature_rule(qrule.get());
-                X_fe->attach_quadrature_rule(qrule.get());
+                qrule = elem_qrule;
+                F_fe->attach_quadrature_rule(qrule);
+                X_fe->attach_quadrature_rule(qrule);
             }
-            X_fe->reinit(elem);
+            if (elem->p_level() != 0) X_fe->reinit(elem);
             n_qp_patch += qrule->n_points();
         }
-        if (n_qp_patch == 0) continue;
+        if (n_qp_patch == 0)
+        {
+            if (d_workload_model) d_workload_model->addPatchWorkTime(d_level_number, p(), MPI_Wtime()-patch_start_time);
+            continue;
+        }
         std::vector<double> F_qp(n_vars*n_qp_patch,0.0);
         std::vector<double> X_qp(NDIM  *n_qp_patch);
 
@@ -927,18 +966,21 @@ FEDataManager::interp(
             const int npts = std::max(elem->default_order() == FIRST ? 1.0 : 2.0,
                                       std::ceil(POINT_FACTOR*hmax/patch_dx_min));
             const Order order = static_cast<Order>(std::min(2*npts-1,static_cast<int>(FORTYTHIRD)));
-            if (order != qrule->get_order())
+            QBase* const elem_qrule = getQuadratureRule(elem->type(), order, dim);
+            if (elem_qrule != qrule)
             {
-                qrule = QBase::build(QGAUSS, dim, order);
-                F_fe->attach_quadrature_rule(qrule.get());
-                X_fe->attach_quadrature_rule(qrule.get());
+                qrule = elem_qrule;
+                F_fe->attach_quadrature_rule(qrule);
+                X_fe->attach_quadrature_rule(qrule);
             }
-            X_fe->reinit(elem);
+            const std::vector<std::vector<double> >* const phi_X_ref = (elem->p_level() == 0 ? getReferenceShapeFunctions(X_fe_type, elem->type(), order, dim) : NULL);
+            if (!phi_X_ref) X_fe->reinit(elem);
+            const std::vector<std::vector<double> >& phi_X_elem = (phi_X_ref ? *phi_X_ref : phi_X);
             const unsigned int n_qp = qrule->n_points();
             for (unsigned int qp = 0; qp < n_qp; ++qp)
             {
                 const int idx = NDIM*(qp+qp_offset);
-                interpolate(&X_qp[idx],qp,X_node,phi_X);
+                interpolate(&X_qp[idx],qp,X_node,phi_X_elem);
             }
             qp_offset += n_qp;
         }
@@ -983,11 +1025,12 @@ FEDataManager::interp(
             const int npts = std::max(elem->default_order() == FIRST ? 1.0 : 2.0,
                                       std::ceil(POINT_FACTOR*hmax/patch_dx_min));
             const Order order = static_cast<Order>(std::min(2*npts-1,static_cast<int>(FORTYTHIRD)));
-            if (order != qrule->get_order())
+            QBase* const elem_qrule = getQuadratureRule(elem->type(), order, dim);
+            if (elem_qrule != qrule)
             {
-                qrule = QBase::build(QGAUSS, dim, order);
-                F_fe->attach_quadrature_rule(qrule.get());
-                X_fe->attach_quadrature_rule(qrule.get());
+                qrule = elem_qrule;
+                F_fe->attach_quadrature_rule(qrule);
+                X_fe->attach_quadrature_rule(qrule);
             }
             F_fe->reinit(elem);
             const unsigned int n_qp = qrule->n_points();
@@ -1013,6 +1056,7 @@ FEDataManager::interp(
 
             qp_offset += n_qp;
         }
+        if (d_workload_model) d_workload_model->addPatchWorkTime(d_level_number, p(), MPI_Wtime()-patch_start_time);
     }
 
     // Solve for the nodal values.
@@ -1096,6 +1140,7 @@ FEDataManager::restrictData(
         const blitz::Array<Elem*,1>& patch_elems = d_active_patch_elem_map(local_patch_num);
         const unsigned int num_active_patch_elems = patch_elems.size();
         if (num_active_patch_elems == 0) continue;
+        const double patch_start_time = (d_workload_model ? MPI_Wtime() : 0.0);
 
         const Pointer<Patch<NDIM> > patch = level->getPatch(p());
         Pointer<SideData<NDIM,double> > f_data = patch->getPatchData(f_data_idx);
@@ -1255,6 +1300,7 @@ FEDataManager::restrictData(
                 F_rhs_vec->add_vector(F_rhs_e[i], F_dof_indices(i));
             }
         }
+        if (d_workload_model) d_workload_model->addPatchWorkTime(d_level_number, p(), MPI_Wtime()-patch_start_time);
     }
 
     // Solve for the nodal values.
@@ -1598,7 +1644,44 @@ FEDataManager::updateWorkloadEstimates(
     {
         updateQuadPointCountData(ln,ln);
         HierarchyCellDataOpsReal<NDIM,double> hier_cc_data_ops(d_hierarchy,ln,ln);
-        hier_cc_data_ops.add(d_workload_idx, d_qp_count_idx, d_workload_idx);
+        if (d_workload_model)
+        {
+            // Fit the measured workload model to the timings recorded on the
+            // present patches.
+            double num_local_cells = 0.0;
+            for (int level_num = 0; level_num <= d_hierarchy->getFinestLevelNumber(); ++level_num)
+            {
+                Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(level_num);
+                for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+                {
+                    Pointer<Patch<NDIM> > patch = level->getPatch(p());
+                    const Box<NDIM>& patch_box = patch->getBox();
+                    num_local_cells += static_cast<double>(patch_box.size());
+                    if (level_num != ln) continue;
+                    Pointer<CellData<NDIM,double> > qp_count_data = patch->getPatchData(d_qp_count_idx);
+                    double num_qps = 0.0;
+                    for (CellIterator<NDIM> ic(patch_box); ic; ic++)
+                    {
+                        num_qps += (*qp_count_data)(ic());
+                    }
+                    d_workload_model->addPatchSample(ln, p(), num_qps, static_cast<double>(patch_box.size()));
+                }
+            }
+            if (d_workload_model->computeWorkloadWeights(d_measured_qp_weight, d_measured_cell_weight, num_local_cells))
+            {
+                d_has_measured_workload_weights = true;
+            }
+            d_workload_model->resetMeasurements();
+        }
+        if (d_has_measured_workload_weights)
+        {
+            hier_cc_data_ops.axpy(d_workload_idx, d_measured_qp_weight, d_qp_count_idx, d_workload_idx);
+            if (d_measured_cell_weight > 0.0) hier_cc_data_ops.addScalar(d_workload_idx, d_workload_idx, d_measured_cell_weight);
+        }
+        else
+        {
+            hier_cc_data_ops.add(d_workload_idx, d_qp_count_idx, d_workload_idx);
+        }
     }
 
     IBTK_TIMER_STOP(t_update_workload_estimates);
@@ -1664,6 +1747,10 @@ FEDataManager::resetHierarchyConfiguration(
     setPatchHierarchy(hierarchy);
     resetLevels(0,finest_hier_level);
 
+    // Timings recorded for the previous patch configuration are no longer
+    // meaningful.
+    if (d_workload_model) d_workload_model->resetMeasurements();
+
     IBTK_TIMER_STOP(t_reset_hierarchy_configuration);
     return;
 }// resetHierarchyConfiguration
@@ -1704,7 +1791,7 @@ FEDataManager::applyGradientDetector(
 
         const MeshBase& mesh = d_es->get_mesh();
         const unsigned int dim = mesh.mesh_dimension();
-        AutoPtr<QBase> qrule = QBase::build(QGAUSS, dim, FIRST);
+        QBase* qrule = NULL;
 
         System& X_system = d_es->get_system(COORDINATES_SYSTEM_NAME);
         const DofMap& X_dof_map = X_system.get_dof_map();
@@ -1712,8 +1799,8 @@ FEDataManager::applyGradientDetector(
         for (unsigned d = 0; d < NDIM; ++d) TBOX_ASSERT(X_dof_map.variable_type(d) == X_dof_map.variable_type(0));
 #endif
         blitz::Array<std::vector<unsigned int>,1> X_dof_indices(dim);
-        AutoPtr<FEBase> X_fe(FEBase::build(dim, X_dof_map.variable_type(0)));
-        X_fe->attach_quadrature_rule(qrule.get());
+        const FEType& X_fe_type = X_dof_map.variable_type(0);
+        AutoPtr<FEBase> X_fe(FEBase::build(dim, X_fe_type));
         const std::vector<std::vector<double> >& phi_X = X_fe->get_phi();
         NumericVector<double>* X_vec = getCoordsVector();
         AutoPtr<NumericVector<double> > X_ghost_vec = NumericVector<double>::build();
@@ -1759,15 +1846,18 @@ FEDataManager::applyGradientDetector(
                 const int npts = std::max(elem->default_order() == FIRST ? 1.0 : 2.0,
                                           std::ceil(POINT_FACTOR*hmax/patch_dx_min));
                 const Order order = static_cast<Order>(std::min(2*npts-1,static_cast<int>(FORTYTHIRD)));
-                if (order != qrule->get_order())
+                QBase* const elem_qrule = getQuadratureRule(elem->type(), order, dim);
+                if (elem_qrule != qrule)
                 {
-                    qrule = QBase::build(QGAUSS, dim, order);
-                    X_fe->attach_quadrature_rule(qrule.get());
+                    qrule = elem_qrule;
+                    X_fe->attach_quadrature_rule(qrule);
                 }
-                X_fe->reinit(elem);
+                const std::vector<std::vector<double> >* const phi_X_ref = (elem->p_level() == 0 ? getReferenceShapeFunctions(X_fe_type, elem->type(), order, dim) : NULL);
+                if (!phi_X_ref) X_fe->reinit(elem);
+                const std::vector<std::vector<double> >& phi_X_elem = (phi_X_ref ? *phi_X_ref : phi_X);
                 for (unsigned int qp = 0; qp < qrule->n_points(); ++qp)
                 {
-                    interpolate(&X_qp[0], qp, X_node, phi_X);
+                    interpolate(&X_qp[0], qp, X_node, phi_X_elem);
                     const Index<NDIM> i = IndexUtilities::getCellIndex(X_qp, patch_x_lower, patch_x_upper, patch_dx, patch_lower, patch_upper);
                     tag_data->fill(1,Box<NDIM>(i-Index<NDIM>(1),i+Index<NDIM>(1)));
                 }
@@ -1840,6 +1930,10 @@ FEDataManager::FEDataManager(
       d_object_name(object_name),
       d_registered_for_restart(register_for_restart),
       d_load_balancer(NULL),
+      d_workload_model(NULL),
+      d_has_measured_workload_weights(false),
+      d_measured_qp_weight(0.0),
+      d_measured_cell_weight(0.0),
       d_hierarchy(NULL),
       d_coarsest_ln(-1),
       d_finest_ln(-1),
@@ -1854,7 +1948,9 @@ FEDataManager::FEDataManager(
       d_L2_proj_matrix(),
       d_L2_proj_matrix_diag(),
       d_L2_proj_quad_type(),
-      d_L2_proj_quad_order()
+      d_L2_proj_quad_order(),
+      d_qrule_cache(),
+      d_phi_cache()
 {
 #ifdef DEBUG_CHECK_ASSERTIONS
     TBOX_ASSERT(!object_name.empty());
@@ -1917,6 +2013,10 @@ FEDataManager::~FEDataManager()
     {
         delete it->second;
     }
+    for (std::map<std::pair<ElemType,Order>,QBase*>::iterator it = d_qrule_cache.begin(); it != d_qrule_cache.end(); ++it)
+    {
+        delete it->second;
+    }
     return;
 }// ~FEDataManager
 
@@ -1939,7 +2039,7 @@ FEDataManager::updateQuadPointCountData(
 
         const MeshBase& mesh = d_es->get_mesh();
         const unsigned int dim = mesh.mesh_dimension();
-        AutoPtr<QBase> qrule = QBase::build(QGAUSS, dim, FIRST);
+        QBase* qrule = NULL;
 
         System& X_system = d_es->get_system(COORDINATES_SYSTEM_NAME);
         const DofMap& X_dof_map = X_system.get_dof_map();
@@ -1947,8 +2047,8 @@ FEDataManager::updateQuadPointCountData(
         for (unsigned d = 0; d < NDIM; ++d) TBOX_ASSERT(X_dof_map.variable_type(d) == X_dof_map.variable_type(0));
 #endif
         blitz::Array<std::vector<unsigned int>,1> X_dof_indices(dim);
-        AutoPtr<FEBase> X_fe(FEBase::build(dim, X_dof_map.variable_type(0)));
-        X_fe->attach_quadrature_rule(qrule.get());
+        const FEType& X_fe_type = X_dof_map.variable_type(0);
+        AutoPtr<FEBase> X_fe(FEBase::build(dim, X_fe_type));
         const std::vector<std::vector<double> >& phi_X = X_fe->get_phi();
         NumericVector<double>* X_vec = getCoordsVector();
         NumericVector<double>* X_ghost_vec = buildGhostedCoordsVector();
@@ -1987,15 +2087,18 @@ FEDataManager::updateQuadPointCountData(
                 const int npts = std::max(elem->default_order() == FIRST ? 1.0 : 2.0,
                                           std::ceil(POINT_FACTOR*hmax/patch_dx_min));
                 const Order order = static_cast<Order>(std::min(2*npts-1,static_cast<int>(FORTYTHIRD)));
-                if (order != qrule->get_order())
+                QBase* const elem_qrule = getQuadratureRule(elem->type(), order, dim);
+                if (elem_qrule != qrule)
                 {
-                    qrule = QBase::build(QGAUSS, dim, order);
-                    X_fe->attach_quadrature_rule(qrule.get());
+                    qrule = elem_qrule;
+                    X_fe->attach_quadrature_rule(qrule);
                 }
-                X_fe->reinit(elem);
+                const std::vector<std::vector<double> >* const phi_X_ref = (elem->p_level() == 0 ? getReferenceShapeFunctions(X_fe_type, elem->type(), order, dim) : NULL);
+                if (!phi_X_ref) X_fe->reinit(elem);
+                const std::vector<std::vector<double> >& phi_X_elem = (phi_X_ref ? *phi_X_ref : phi_X);
                 for (unsigned int qp = 0; qp < qrule->n_points(); ++qp)
                 {
-                    interpolate(&X_qp[0], qp, X_node, phi_X);
+                    interpolate(&X_qp[0], qp, X_node, phi_X_elem);
                     const Index<NDIM> i = IndexUtilities::getCellIndex(X_qp, patch_x_lower, patch_x_upper, patch_dx, patch_lower, patch_upper);
                     if (patch_box.contains(i)) (*qp_count_data)(i) += 1.0;
                 }
@@ -2100,15 +2203,15 @@ FEDataManager::collectActivePatchElements(
     // Get the necessary FE data.
     const MeshBase& mesh = d_es->get_mesh();
     const unsigned int dim = mesh.mesh_dimension();
-    AutoPtr<QBase> qrule = QBase::build(QGAUSS, dim, FIRST);
+    QBase* qrule = NULL;
     System& X_system = d_es->get_system(COORDINATES_SYSTEM_NAME);
     const DofMap& X_dof_map = X_system.get_dof_map();
 #ifdef DEBUG_CHECK_ASSERTIONS
     for (unsigned d = 0; d < NDIM; ++d) TBOX_ASSERT(X_dof_map.variable_type(d) == X_dof_map.variable_type(0));
 #endif
     blitz::Array<std::vector<unsigned int>,1> X_dof_indices(dim);
-    AutoPtr<FEBase> X_fe(FEBase::build(dim, X_dof_map.variable_type(0)));
-    X_fe->attach_quadrature_rule(qrule.get());
+    const FEType& X_fe_type = X_dof_map.variable_type(0);
+    AutoPtr<FEBase> X_fe(FEBase::build(dim, X_fe_type));
     const std::vector<std::vector<double> >& phi_X = X_fe->get_phi();
     NumericVector<double>* X_vec = getCoordsVector();
     AutoPtr<NumericVector<double> > X_ghost_vec = NumericVector<double>::build();
@@ -2217,16 +2320,19 @@ FEDataManager::collectActivePatchElements(
                 const int npts = std::max(elem->default_order() == FIRST ? 1.0 : 2.0,
                                           std::ceil(POINT_FACTOR*hmax/patch_dx_min));
                 const Order order = static_cast<Order>(std::min(2*npts-1,static_cast<int>(FORTYTHIRD)));
-                if (order != qrule->get_order())
+                QBase* const elem_qrule = getQuadratureRule(elem->type(), order, dim);
+                if (elem_qrule != qrule)
                 {
-                    qrule = QBase::build(QGAUSS, dim, order);
-                    X_fe->attach_quadrature_rule(qrule.get());
+                    qrule = elem_qrule;
+                    X_fe->attach_quadrature_rule(qrule);
                 }
-                X_fe->reinit(elem);
+                const std::vector<std::vector<double> >* const phi_X_ref = (elem->p_level() == 0 ? getReferenceShapeFunctions(X_fe_type, elem->type(), order, dim) : NULL);
+                if (!phi_X_ref) X_fe->reinit(elem);
+                const std::vector<std::vector<double> >& phi_X_elem = (phi_X_ref ? *phi_X_ref : phi_X);
                 bool found_qp = false;
                 for (unsigned int qp = 0; qp < qrule->n_points() && !found_qp; ++qp)
                 {
-                    interpolate(&X_qp[0], qp, X_node, phi_X);
+                    interpolate(&X_qp[0], qp, X_node, phi_X_elem);
                     const Index<NDIM> i = IndexUtilities::getCellIndex(X_qp, patch_x_lower, patch_x_upper, patch_dx, patch_lower, patch_upper);
                     if (ghost_box.contains(i))
                     {
@@ -2365,6 +2471,58 @@ FEDataManager::collectGhostDOFIndices(
     return;
 }// collectGhostDOFIndices
 
+QBase*
+FEDataManager::getQuadratureRule(
+    const ElemType elem_type,
+    const Order order,
+    const unsigned int dim)
+{
+    QBase*& qrule = d_qrule_cache[std::make_pair(elem_type,order)];
+    if (!qrule)
+    {
+        qrule = QBase::build(QGAUSS, dim, order).release();
+    }
+
+    // NOTE: FEBase::reinit() re-initializes the rule whenever it encounters an
+    // element with a different type or p-refinement level, so we always reset
+    // the rule here.  This is a no-op when the rule is already initialized for
+    // the requested element type.
+    qrule->init(elem_type, 0);
+    return qrule;
+}// getQuadratureRule
+
+const std::vector<std::vector<double> >*
+FEDataManager::getReferenceShapeFunctions(
+    const FEType& fe_type,
+    const ElemType elem_type,
+    const Order order,
+    const unsigned int dim)
+{
+    // Lagrange shape functions are determined entirely by their values on the
+    // reference element.  Other families (e.g., hierarchic bases) may depend on
+    // the element orientation, and so are not tabulated.
+    if (fe_type.family != LAGRANGE) return NULL;
+
+    const std::pair<ElemType,Order> qrule_key(elem_type,order);
+    const std::pair<FEType,std::pair<ElemType,Order> > key(fe_type,qrule_key);
+    std::map<std::pair<FEType,std::pair<ElemType,Order> >,std::vector<std::vector<double> > >::iterator it = d_phi_cache.find(key);
+    if (it != d_phi_cache.end()) return &it->second;
+
+    const QBase* const qrule = getQuadratureRule(elem_type, order, dim);
+    const unsigned int n_qp = qrule->n_points();
+    const unsigned int n_basis = FEInterface::n_shape_functions(dim, fe_type, elem_type);
+    std::vector<std::vector<double> >& phi = d_phi_cache[key];
+    phi.resize(n_basis, std::vector<double>(n_qp));
+    for (unsigned int k = 0; k < n_basis; ++k)
+    {
+        for (unsigned int qp = 0; qp < n_qp; ++qp)
+        {
+            phi[k][qp] = FEInterface::shape(dim, fe_type, elem_type, k, qrule->qp(qp));
+        }
+    }
+    return &phi;
+}// getReferenceShapeFunctions
+
 void
 FEDataManager::getFromRestart()
 {
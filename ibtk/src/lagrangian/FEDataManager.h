@@ -52,9 +52,12 @@
 #include "StandardTagAndInitStrategy.h"
 #include "VariableContext.h"
 #include "blitz/array.h"
+#include "ibtk/LWorkloadModel.h"
 #include "libmesh/auto_ptr.h"
+#include "libmesh/enum_elem_type.h"
 #include "libmesh/enum_order.h"
 #include "libmesh/enum_quadrature_type.h"
+#include "libmesh/fe_type.h"
 #include "libmesh/partitioner.h"
 #include "tbox/Pointer.h"
 #include "tbox/Serializable.h"
@@ -153,6 +156,27 @@ public:
         SAMRAI::tbox::Pointer<SAMRAI::mesh::LoadBalancer<NDIM> > load_balancer,
         int workload_data_idx);
 
+    /*!
+     * \brief Indicate whether workload estimates should be computed from
+     * measured execution times.
+     *
+     * When enabled, the time spent spreading and interpolating on each local
+     * patch is recorded, and updateWorkloadEstimates() fits the per-quadrature
+     * point and per-cell weights of the workload from the timings recorded
+     * since the previous call (see LWorkloadModel).  Until the first fit
+     * succeeds, each quadrature point is assigned unit weight.
+     */
+    void
+    setUseMeasuredWorkloadEstimates(
+        bool use_measured_workload_estimates=true);
+
+    /*!
+     * \brief Return the model used to compute measured workload estimates, or
+     * a NULL pointer if measured workload estimates are not enabled.
+     */
+    SAMRAI::tbox::Pointer<LWorkloadModel>
+    getWorkloadModel() const;
+
     /*!
      * \name Methods to set the hierarchy and range of levels.
      */
@@ -556,6 +580,35 @@ private:
         const blitz::Array<libMesh::Elem*,1>& active_elems,
         const std::string& system_name);
 
+    /*!
+     * Return the (cached) Gauss quadrature rule of the specified order for
+     * elements of the specified type.
+     *
+     * The returned rule is owned by the FEDataManager and is initialized for
+     * elements of the specified type without p-refinement.
+     */
+    libMesh::QBase*
+    getQuadratureRule(
+        libMeshEnums::ElemType elem_type,
+        libMeshEnums::Order order,
+        unsigned int dim);
+
+    /*!
+     * Return the (cached) values of the shape functions of the specified
+     * finite element type evaluated at the points of the quadrature rule
+     * returned by getQuadratureRule(), indexed as phi[i][qp].
+     *
+     * Only shape functions that do not depend on the element geometry are
+     * tabulated.  A NULL pointer is returned in all other cases, in which case
+     * the shape functions must be computed via libMesh::FEBase::reinit().
+     */
+    const std::vector<std::vector<double> >*
+    getReferenceShapeFunctions(
+        const libMesh::FEType& fe_type,
+        libMeshEnums::ElemType elem_type,
+        libMeshEnums::Order order,
+        unsigned int dim);
+
     /*!
      * Read object state from the restart file and initialize class data
      * members.  The database from which the restart data is read is determined
@@ -593,6 +646,13 @@ private:
      */
     SAMRAI::tbox::Pointer<SAMRAI::mesh::LoadBalancer<NDIM> > d_load_balancer;
 
+    /*
+     * Measured workload model and the most recently fitted workload weights.
+     */
+    SAMRAI::tbox::Pointer<LWorkloadModel> d_workload_model;
+    bool d_has_measured_workload_weights;
+    double d_measured_qp_weight, d_measured_cell_weight;
+
     /*
      * Grid hierarchy information.
      */
@@ -662,6 +722,13 @@ private:
     std::map<std::string,libMeshEnums::QuadratureType> d_L2_proj_quad_type;
     std::map<std::string,libMeshEnums::Order> d_L2_proj_quad_order;
 
+    /*
+     * Cached quadrature rules and reference shape function tables used to
+     * evaluate the adaptively chosen quadrature rules.
+     */
+    std::map<std::pair<libMeshEnums::ElemType,libMeshEnums::Order>,libMesh::QBase*> d_qrule_cache;
+    std::map<std::pair<libMesh::FEType,std::pair<libMeshEnums::ElemType,libMeshEnums::Order> >,std::vector<std::vector<double> > > d_phi_cache;
+
     /*
      * Partitioner support.
      */
@@ -35,6 +35,7 @@
 #include <math.h>
 #include <unistd.h>
 #include <algorithm>
+#include <cmath>
 #include <iosfwd>
 #include <limits>
 #include <memory>
@@ -61,6 +62,7 @@
 #include "Index.h"
 #include "LDataManager.h"
 #include "NodeData.h"
+#include "NodeGeometry.h"
 #include "Patch.h"
 #include "PatchData.h"
 #include "PatchLevel.h"
@@ -68,6 +70,7 @@
 #include "RefineOperator.h"
 #include "SAMRAI_config.h"
 #include "SideData.h"
+#include "SideGeometry.h"
 #include "Variable.h"
 #include "VariableDatabase.h"
 #include "blitz/array.h"
@@ -76,6 +79,7 @@
 #include "ibtk/IndexUtilities-inl.h"
 #include "ibtk/LData.h"
 #include "ibtk/LData-inl.h"
+#include "ibtk/LEdgeCutLoadBalancer.h"
 #include "ibtk/LEInteractor.h"
 #include "ibtk/LIndexSetData.h"
 #include "ibtk/LM3DDataWriter.h" // IWYU pragma: keep
@@ -90,15 +94,18 @@
 #include "ibtk/LNode-inl.h"
 #include "ibtk/LSet.h"
 #include "ibtk/LSetData.h"
+#include "ibtk/LWorkloadModel.h"
 #include "ibtk/LSetDataIterator.h"
 #include "ibtk/LSetDataIterator-inl.h"
 #include "ibtk/LSetData-inl.h"
 #include "ibtk/LSet-inl.h"
 #include "ibtk/LSiloDataWriter.h"
 #include "ibtk/LTransaction.h"
+#include "ibtk/SmallObjectArena.h"
 #include "ibtk/compiler_hints.h"
 #include "ibtk/ibtk_utilities.h"
 #include "ibtk/namespaces.h" // IWYU pragma: keep
+#include "mpi.h"
 #include "petscis.h"
 #include "petscsys.h"
 #include "tbox/Array.h"
@@ -137,6 +144,9 @@ static Timer* t_put_to_database;
 static Timer* t_begin_nonlocal_data_fill;
 static Timer* t_end_nonlocal_data_fill;
 static Timer* t_compute_node_distribution;
+static Timer* t_update_node_distribution;
+static Timer* t_compute_lagrangian_box_graph;
+static Timer* t_compute_lagrangian_structure_moments;
 static Timer* t_compute_node_offsets;
 
 // Assume max(U)dt/dx <= 2.
@@ -145,6 +155,38 @@ static const int CFL_WIDTH = 2;
 // Version of LDataManager restart file data.
 static const int LDATA_MANAGER_VERSION = 1;
 
+// The number of values used to store the moments of a structure: the number
+// of nodes, the sum of the node positions, the lower corner of the bounding
+// box, and the negated upper corner of the bounding box.
+static const int STRCT_MOMENT_DEPTH = 1+3*NDIM;
+
+// MPI reduction operation for structure moments.  The first 1+NDIM values of
+// each block are summed, and the remaining values are minimized.
+void
+reduce_structure_moments(
+    void* invec,
+    void* inoutvec,
+    int* len,
+    MPI_Datatype* /*datatype*/)
+{
+    const double* const in = static_cast<const double*>(invec);
+    double* const inout = static_cast<double*>(inoutvec);
+    for (int k = 0; k < *len; ++k)
+    {
+        const double* const a = in+k*STRCT_MOMENT_DEPTH;
+        double* const b = inout+k*STRCT_MOMENT_DEPTH;
+        for (int i = 0; i < 1+NDIM; ++i)
+        {
+            b[i] += a[i];
+        }
+        for (int i = 1+NDIM; i < STRCT_MOMENT_DEPTH; ++i)
+        {
+            b[i] = std::min(b[i],a[i]);
+        }
+    }
+    return;
+}// reduce_structure_moments
+
 inline CellIndex<NDIM>
 get_canonical_cell_index(
     const CellIndex<NDIM>& cell_idx,
@@ -281,6 +323,13 @@ LDataManager::resetLevels(
     d_nonlocal_lag_indices          .resize(d_finest_ln+1);
     d_local_petsc_indices           .resize(d_finest_ln+1);
     d_nonlocal_petsc_indices        .resize(d_finest_ln+1);
+    d_petsc_mapping_version         .resize(d_finest_ln+1,-1);
+    d_lag_to_petsc_cache            .resize(d_finest_ln+1);
+    d_nonlocal_petsc_to_lag_cache   .resize(d_finest_ln+1);
+    d_petsc_mapping_cache_is_valid  .resize(d_finest_ln+1,false);
+    d_strct_moment_cache_X_data     .resize(d_finest_ln+1);
+    d_strct_moment_cache_time       .resize(d_finest_ln+1,0.0);
+    d_strct_moment_cache            .resize(d_finest_ln+1);
     return;
 }// resetLevels
 
@@ -465,12 +514,22 @@ LDataManager::spread(
             // Spread data onto the grid.
             if (F_data_ghost_node_update) F_data[ln]->endGhostUpdate();
             if (X_data_ghost_node_update) X_data[ln]->endGhostUpdate();
+            if (d_use_cached_le_operators) checkCachedLEOperators(X_data[ln], ln);
             Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(ln);
             const IntVector<NDIM>& periodic_shift = grid_geom->getPeriodicShift(level->getRatio());
             for (PatchLevel<NDIM>::Iterator p(level); p; p++)
             {
+                const double patch_start_time = (d_workload_model ? MPI_Wtime() : 0.0);
                 Pointer<Patch<NDIM> > patch = level->getPatch(p());
                 Pointer<PatchData<NDIM> > f_data = patch->getPatchData(f_data_idx);
+                const std::vector<LEInteractor::CSROperator>* const le_ops = (d_use_cached_le_operators ? getCachedLEOperators(/*spread_operators*/ true, f_data, patch, ln) : NULL);
+                if (le_ops)
+                {
+                    LEInteractor::applySpreadingOperator(f_data, *le_ops, F_data[ln]->getGhostedLocalFormVecArray()->data(), F_data[ln]->getDepth(), patch);
+                    F_data[ln]->restoreArrays();
+                    if (d_workload_model) d_workload_model->addPatchWorkTime(ln, p(), MPI_Wtime()-patch_start_time);
+                    continue;
+                }
                 Pointer<CellData<NDIM,double> > f_cc_data = f_data;
                 Pointer<NodeData<NDIM,double> > f_nc_data = f_data;
                 Pointer<SideData<NDIM,double> > f_sc_data = f_data;
@@ -479,6 +538,7 @@ LDataManager::spread(
                 if (f_cc_data) LEInteractor::spread(f_cc_data, F_data[ln], X_data[ln], idx_data, patch, box, periodic_shift, d_spread_weighting_fcn);
                 if (f_nc_data) LEInteractor::spread(f_nc_data, F_data[ln], X_data[ln], idx_data, patch, box, periodic_shift, d_spread_weighting_fcn);
                 if (f_sc_data) LEInteractor::spread(f_sc_data, F_data[ln], X_data[ln], idx_data, patch, box, periodic_shift, d_spread_weighting_fcn);
+                if (d_workload_model) d_workload_model->addPatchWorkTime(ln, p(), MPI_Wtime()-patch_start_time);
             }
         }
 
@@ -569,12 +629,22 @@ LDataManager::interp(
             {
                 f_ghost_fill_scheds[ln]->fillData(fill_data_time);
             }
+            if (d_use_cached_le_operators) checkCachedLEOperators(X_data[ln], ln);
             Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(ln);
             const IntVector<NDIM>& periodic_shift = grid_geom->getPeriodicShift(level->getRatio());
             for (PatchLevel<NDIM>::Iterator p(level); p; p++)
             {
+                const double patch_start_time = (d_workload_model ? MPI_Wtime() : 0.0);
                 Pointer<Patch<NDIM> > patch = level->getPatch(p());
                 Pointer<PatchData<NDIM> > f_data = patch->getPatchData(f_data_idx);
+                const std::vector<LEInteractor::CSROperator>* const le_ops = (d_use_cached_le_operators ? getCachedLEOperators(/*spread_operators*/ false, f_data, patch, ln) : NULL);
+                if (le_ops)
+                {
+                    LEInteractor::applyInterpolationOperator(F_data[ln]->getGhostedLocalFormVecArray()->data(), F_data[ln]->getDepth(), *le_ops, f_data);
+                    F_data[ln]->restoreArrays();
+                    if (d_workload_model) d_workload_model->addPatchWorkTime(ln, p(), MPI_Wtime()-patch_start_time);
+                    continue;
+                }
                 Pointer<CellData<NDIM,double> > f_cc_data = f_data;
                 Pointer<NodeData<NDIM,double> > f_nc_data = f_data;
                 Pointer<SideData<NDIM,double> > f_sc_data = f_data;
@@ -583,6 +653,7 @@ LDataManager::interp(
                 if (f_cc_data) LEInteractor::interpolate(F_data[ln], X_data[ln], idx_data, f_cc_data, patch, box, periodic_shift, d_interp_weighting_fcn);
                 if (f_nc_data) LEInteractor::interpolate(F_data[ln], X_data[ln], idx_data, f_nc_data, patch, box, periodic_shift, d_interp_weighting_fcn);
                 if (f_sc_data) LEInteractor::interpolate(F_data[ln], X_data[ln], idx_data, f_sc_data, patch, box, periodic_shift, d_interp_weighting_fcn);
+                if (d_workload_model) d_workload_model->addPatchWorkTime(ln, p(), MPI_Wtime()-patch_start_time);
             }
         }
 
@@ -597,6 +668,138 @@ LDataManager::interp(
     return;
 }// interp
 
+void
+LDataManager::interp(
+    const std::vector<int>& f_data_idxs,
+    std::vector<std::vector<Pointer<LData> > >& F_data,
+    std::vector<Pointer<LData> >& X_data,
+    const std::vector<std::vector<Pointer<CoarsenSchedule<NDIM> > > >& f_synch_scheds,
+    const std::vector<std::vector<Pointer<RefineSchedule<NDIM> > > >& f_ghost_fill_scheds,
+    const double fill_data_time,
+    const int coarsest_ln_in,
+    const int finest_ln_in)
+{
+    IBTK_TIMER_START(t_interp);
+
+    const int coarsest_ln = (coarsest_ln_in == -1 ? 0 : coarsest_ln_in);
+    const int finest_ln = (finest_ln_in == -1 ? d_hierarchy->getFinestLevelNumber() : finest_ln_in);
+    const unsigned int num_fields = f_data_idxs.size();
+#ifdef DEBUG_CHECK_ASSERTIONS
+    TBOX_ASSERT(F_data.size() == num_fields);
+    TBOX_ASSERT(f_synch_scheds.empty() || f_synch_scheds.size() == num_fields);
+    TBOX_ASSERT(f_ghost_fill_scheds.empty() || f_ghost_fill_scheds.size() == num_fields);
+#endif
+
+    // Synchronize Eulerian values.  As in the single-quantity case, this is
+    // unnecessary when only the finest level contains Lagrangian data.
+    bool levels_need_synch = false;
+    for (int ln = coarsest_ln; ln < finest_ln && !levels_need_synch; ++ln)
+    {
+        levels_need_synch = levelContainsLagrangianData(ln);
+    }
+    for (unsigned int k = 0; k < f_synch_scheds.size() && levels_need_synch; ++k)
+    {
+        for (int ln = finest_ln; ln > coarsest_ln; --ln)
+        {
+            if (ln < static_cast<int>(f_synch_scheds[k].size()) && f_synch_scheds[k][ln])
+            {
+                f_synch_scheds[k][ln]->coarsenData();
+            }
+        }
+    }
+
+    // Interpolate data from the Eulerian grid to the Lagrangian mesh.
+    Pointer<CartesianGridGeometry<NDIM> > grid_geom = d_hierarchy->getGridGeometry();
+    std::vector<Pointer<LData> > F_data_level(num_fields);
+    std::vector<Pointer<PatchData<NDIM> > > f_data(num_fields);
+    for (int ln = coarsest_ln; ln <= finest_ln; ++ln)
+    {
+        if (!levelContainsLagrangianData(ln)) continue;
+
+        for (unsigned int k = 0; k < f_ghost_fill_scheds.size(); ++k)
+        {
+            if (ln < static_cast<int>(f_ghost_fill_scheds[k].size()) && f_ghost_fill_scheds[k][ln])
+            {
+                f_ghost_fill_scheds[k][ln]->fillData(fill_data_time);
+            }
+        }
+        for (unsigned int k = 0; k < num_fields; ++k)
+        {
+            F_data_level[k] = F_data[k][ln];
+        }
+        Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(ln);
+        const IntVector<NDIM>& periodic_shift = grid_geom->getPeriodicShift(level->getRatio());
+        for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+        {
+            Pointer<Patch<NDIM> > patch = level->getPatch(p());
+            for (unsigned int k = 0; k < num_fields; ++k)
+            {
+                f_data[k] = patch->getPatchData(f_data_idxs[k]);
+            }
+            Pointer<LNodeSetData> idx_data = patch->getPatchData(d_lag_node_index_current_idx);
+            const Box<NDIM>& box = idx_data->getBox();
+            LEInteractor::interpolate(F_data_level, X_data[ln], idx_data, f_data, patch, box, periodic_shift, d_interp_weighting_fcn);
+        }
+    }
+
+    // Zero inactivated components.
+    for (unsigned int k = 0; k < num_fields; ++k)
+    {
+        for (int ln = d_coarsest_ln; ln <= d_finest_ln; ++ln)
+        {
+            zeroInactivatedComponents(F_data[k][ln], ln);
+        }
+    }
+
+    IBTK_TIMER_STOP(t_interp);
+    return;
+}// interp
+
+void
+LDataManager::setUseCachedLEOperators(
+    const bool use_cached_le_operators,
+    const double displacement_threshold)
+{
+#ifdef DEBUG_CHECK_ASSERTIONS
+    TBOX_ASSERT(displacement_threshold >= 0.0);
+#endif
+    d_use_cached_le_operators = use_cached_le_operators;
+    d_le_operator_displacement_threshold = displacement_threshold;
+    if (!d_use_cached_le_operators) resetCachedLEOperators();
+    return;
+}// setUseCachedLEOperators
+
+void
+LDataManager::resetCachedLEOperators()
+{
+    d_le_operator_X_data.clear();
+    d_interp_le_operators.clear();
+    d_spread_le_operators.clear();
+    return;
+}// resetCachedLEOperators
+
+void
+LDataManager::setUseMeasuredWorkloadEstimates(
+    const bool use_measured_workload_estimates)
+{
+    if (use_measured_workload_estimates && !d_workload_model)
+    {
+        d_workload_model = new LWorkloadModel(d_object_name+"::workload_model");
+    }
+    else if (!use_measured_workload_estimates)
+    {
+        d_workload_model.setNull();
+        d_has_measured_workload_weights = false;
+    }
+    return;
+}// setUseMeasuredWorkloadEstimates
+
+Pointer<LWorkloadModel>
+LDataManager::getWorkloadModel() const
+{
+    return d_workload_model;
+}// getWorkloadModel
+
 void
 LDataManager::registerLInitStrategy(
     Pointer<LInitStrategy> lag_init)
@@ -674,9 +877,189 @@ LDataManager::registerLoadBalancer(
 #ifdef DEBUG_CHECK_ASSERTIONS
     TBOX_ASSERT(d_workload_var);
 #endif
+
+    // Provide the Lagrangian connectivity to load balancers that use it.
+    Pointer<LEdgeCutLoadBalancer> edge_cut_load_balancer = load_balancer;
+    if (edge_cut_load_balancer) edge_cut_load_balancer->registerLDataManager(this);
     return;
 }// return
 
+void
+LDataManager::setLagrangianConnectivity(
+    const std::string& connectivity_name,
+    const std::vector<std::pair<int,int> >& lag_edges,
+    const int level_number)
+{
+#ifdef DEBUG_CHECK_ASSERTIONS
+    TBOX_ASSERT(level_number >= 0);
+#endif
+    if (static_cast<int>(d_lag_connectivity.size()) <= level_number) d_lag_connectivity.resize(level_number+1);
+    d_lag_connectivity[level_number][connectivity_name] = lag_edges;
+    return;
+}// setLagrangianConnectivity
+
+bool
+LDataManager::computeLagrangianBoxGraph(
+    std::vector<int>& box_node_counts,
+    std::vector<std::map<int,int> >& box_graph,
+    const BoxArray<NDIM>& boxes,
+    const BoxArray<NDIM>& physical_domain,
+    const IntVector<NDIM>& ratio,
+    const int level_number)
+{
+    const int num_boxes = boxes.getNumberOfBoxes();
+    box_node_counts.assign(num_boxes, 0);
+    box_graph.assign(num_boxes, std::map<int,int>());
+    if (!levelContainsLagrangianData(level_number) ||
+        d_lag_mesh_data[level_number].find(POSN_DATA_NAME) == d_lag_mesh_data[level_number].end())
+    {
+        return false;
+    }
+
+    IBTK_TIMER_START(t_compute_lagrangian_box_graph);
+
+    int ierr;
+    const int num_local_nodes = getNumberOfLocalNodes(level_number);
+    const int global_node_offset = getGlobalNodeOffset(level_number);
+
+    // Determine the box that contains each local node.
+    const double* const dx0 = d_grid_geom->getDx();
+    const double* const grid_x_lower = d_grid_geom->getXLower();
+    const double* const grid_x_upper = d_grid_geom->getXUpper();
+    blitz::TinyVector<double,NDIM> dx;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        dx[d] = dx0[d]/static_cast<double>(ratio(d));
+    }
+    const Box<NDIM>& domain_box = physical_domain[0];
+    const CellIndex<NDIM>& domain_lower = domain_box.lower();
+    const CellIndex<NDIM>& domain_upper = domain_box.upper();
+    Pointer<BoxTree<NDIM> > box_tree = new BoxTree<NDIM>(boxes);
+    std::vector<int> local_box_ids(num_local_nodes, -1);
+    const blitz::Array<double,2>& X_data = *d_lag_mesh_data[level_number][POSN_DATA_NAME]->getLocalFormVecArray();
+    for (int local_idx = 0; local_idx < num_local_nodes; ++local_idx)
+    {
+        const double* const X = &X_data(local_idx,0);
+        const CellIndex<NDIM> cell_idx = IndexUtilities::getCellIndex(X, grid_x_lower, grid_x_upper, dx.data(), domain_lower, domain_upper);
+        Array<int> indices;
+        box_tree->findOverlapIndices(indices, Box<NDIM>(cell_idx,cell_idx));
+        if (indices.getSize() == 0) continue;
+        local_box_ids[local_idx] = indices[0];
+        ++box_node_counts[indices[0]];
+    }
+    d_lag_mesh_data[level_number][POSN_DATA_NAME]->restoreArrays();
+    if (num_boxes > 0) SAMRAI_MPI::sumReduction(&box_node_counts[0], num_boxes);
+
+    // Determine the PETSc indices of the endpoints of the local edges.
+    std::vector<int> petsc_idxs;
+    if (level_number < static_cast<int>(d_lag_connectivity.size()))
+    {
+        typedef std::map<std::string,std::vector<std::pair<int,int> > > ConnectivityMap;
+        for (ConnectivityMap::const_iterator it = d_lag_connectivity[level_number].begin(); it != d_lag_connectivity[level_number].end(); ++it)
+        {
+            const std::vector<std::pair<int,int> >& lag_edges = it->second;
+            for (std::vector<std::pair<int,int> >::const_iterator e = lag_edges.begin(); e != lag_edges.end(); ++e)
+            {
+                petsc_idxs.push_back(e->first);
+                petsc_idxs.push_back(e->second);
+            }
+        }
+    }
+    mapLagrangianToPETSc(petsc_idxs, level_number);
+    std::set<int> nonlocal_petsc_idx_set;
+    for (std::vector<int>::const_iterator cit = petsc_idxs.begin(); cit != petsc_idxs.end(); ++cit)
+    {
+        const int idx = *cit;
+        if (idx >= 0 && (idx < global_node_offset || idx >= global_node_offset+num_local_nodes))
+        {
+            nonlocal_petsc_idx_set.insert(idx);
+        }
+    }
+    const std::vector<int> nonlocal_petsc_idxs(nonlocal_petsc_idx_set.begin(), nonlocal_petsc_idx_set.end());
+    const int num_nonlocal_nodes = nonlocal_petsc_idxs.size();
+
+    // Communicate the boxes that contain the endpoints of the local edges.
+    Vec box_id_vec, box_id_local_vec;
+    ierr = VecCreateGhost(PETSC_COMM_WORLD, num_local_nodes, PETSC_DECIDE,
+                          num_nonlocal_nodes, num_nonlocal_nodes > 0 ? &nonlocal_petsc_idxs[0] : NULL,
+                          &box_id_vec);  IBTK_CHKERRQ(ierr);
+    double* box_id_arr;
+    ierr = VecGetArray(box_id_vec, &box_id_arr);  IBTK_CHKERRQ(ierr);
+    std::copy(local_box_ids.begin(), local_box_ids.end(), box_id_arr);
+    ierr = VecRestoreArray(box_id_vec, &box_id_arr);  IBTK_CHKERRQ(ierr);
+    ierr = VecGhostUpdateBegin(box_id_vec, INSERT_VALUES, SCATTER_FORWARD);  IBTK_CHKERRQ(ierr);
+    ierr = VecGhostUpdateEnd(  box_id_vec, INSERT_VALUES, SCATTER_FORWARD);  IBTK_CHKERRQ(ierr);
+    ierr = VecGhostGetLocalForm(box_id_vec, &box_id_local_vec);  IBTK_CHKERRQ(ierr);
+    ierr = VecGetArray(box_id_local_vec, &box_id_arr);  IBTK_CHKERRQ(ierr);
+    std::map<std::pair<int,int>,int> local_graph;
+    const int num_edges = petsc_idxs.size()/2;
+    for (int e = 0; e < num_edges; ++e)
+    {
+        int box_ids[2];
+        for (int k = 0; k < 2; ++k)
+        {
+            const int idx = petsc_idxs[2*e+k];
+            box_ids[k] = -1;
+            if (idx < 0) continue;
+            if (idx >= global_node_offset && idx < global_node_offset+num_local_nodes)
+            {
+                box_ids[k] = static_cast<int>(box_id_arr[idx-global_node_offset]);
+            }
+            else
+            {
+                const int ghost_idx = std::lower_bound(nonlocal_petsc_idxs.begin(), nonlocal_petsc_idxs.end(), idx)-nonlocal_petsc_idxs.begin();
+                box_ids[k] = static_cast<int>(box_id_arr[num_local_nodes+ghost_idx]);
+            }
+        }
+        if (box_ids[0] < 0 || box_ids[1] < 0 || box_ids[0] == box_ids[1]) continue;
+        ++local_graph[std::make_pair(std::min(box_ids[0],box_ids[1]),std::max(box_ids[0],box_ids[1]))];
+    }
+    ierr = VecRestoreArray(box_id_local_vec, &box_id_arr);  IBTK_CHKERRQ(ierr);
+    ierr = VecGhostRestoreLocalForm(box_id_vec, &box_id_local_vec);  IBTK_CHKERRQ(ierr);
+    ierr = VecDestroy(&box_id_vec);  IBTK_CHKERRQ(ierr);
+
+    // Assemble the complete graph on all processors.  The edge counts are
+    // combined in the same order on each processor, so that each processor
+    // obtains identical results.
+    std::vector<int> local_graph_data;
+    local_graph_data.reserve(3*local_graph.size());
+    for (std::map<std::pair<int,int>,int>::const_iterator it = local_graph.begin(); it != local_graph.end(); ++it)
+    {
+        local_graph_data.push_back(it->first.first);
+        local_graph_data.push_back(it->first.second);
+        local_graph_data.push_back(it->second);
+    }
+    const int num_procs = SAMRAI_MPI::getNodes();
+    const int local_graph_data_size = local_graph_data.size();
+    std::vector<int> graph_data_sizes(num_procs,0), graph_data_offsets(num_procs,0);
+    SAMRAI_MPI::allGather(local_graph_data_size, &graph_data_sizes[0]);
+    std::partial_sum(graph_data_sizes.begin(), graph_data_sizes.end()-1, graph_data_offsets.begin()+1);
+    const int graph_data_size = graph_data_offsets[num_procs-1]+graph_data_sizes[num_procs-1];
+    std::vector<int> graph_data(graph_data_size);
+    MPI_Allgatherv(local_graph_data_size > 0 ? &local_graph_data[0] : NULL, local_graph_data_size, MPI_INT,
+                   graph_data_size > 0 ? &graph_data[0] : NULL, &graph_data_sizes[0], &graph_data_offsets[0], MPI_INT,
+                   SAMRAI_MPI::getCommunicator());
+    for (int k = 0; k < graph_data_size; k += 3)
+    {
+        const int i = graph_data[k], j = graph_data[k+1], num_box_edges = graph_data[k+2];
+        box_graph[i][j] += num_box_edges;
+        box_graph[j][i] += num_box_edges;
+    }
+
+    IBTK_TIMER_STOP(t_compute_lagrangian_box_graph);
+    return true;
+}// computeLagrangianBoxGraph
+
+void
+LDataManager::getWorkloadWeights(
+    double& node_weight,
+    double& cell_weight) const
+{
+    node_weight = (d_has_measured_workload_weights ? d_measured_node_weight : d_beta_work);
+    cell_weight = (d_has_measured_workload_weights ? d_measured_cell_weight : 0.0);
+    return;
+}// getWorkloadWeights
+
 Pointer<LData>
 LDataManager::createLData(
     const std::string& quantity_name,
@@ -707,36 +1090,17 @@ LDataManager::computeLagrangianStructureCenterOfMass(
     TBOX_ASSERT(d_coarsest_ln <= level_number &&
                 d_finest_ln   >= level_number);
 #endif
-    int node_counter = 0;
+    std::vector<double> moments;
+    computeLagrangianStructureMomentData(moments, std::vector<int>(1,structure_id), d_lag_mesh_data[level_number][POSN_DATA_NAME], level_number);
+    const double num_nodes = moments[0];
     blitz::TinyVector<double,NDIM> X_com(0.0);
-    std::pair<int,int> lag_idx_range = getLagrangianStructureIndexRange(structure_id, level_number);
-
-    const blitz::Array<double,2>& X_data = *d_lag_mesh_data[level_number][POSN_DATA_NAME]->getLocalFormVecArray();
-    const Pointer<LMesh> mesh = getLMesh(level_number);
-    const std::vector<LNode*>& local_nodes = mesh->getLocalNodes();
-    for (std::vector<LNode*>::const_iterator cit = local_nodes.begin(); cit != local_nodes.end(); ++cit)
+    if (num_nodes > 0.0)
     {
-        const LNode* const node_idx = *cit;
-        const int lag_idx = node_idx->getLagrangianIndex();
-        if (lag_idx_range.first <= lag_idx && lag_idx < lag_idx_range.second)
+        for (unsigned int d = 0; d < NDIM; ++d)
         {
-            ++node_counter;
-            const int local_idx = node_idx->getLocalPETScIndex();
-            const double* const X = &X_data(local_idx,0);
-            for (unsigned int d = 0; d < NDIM; ++d)
-            {
-                X_com[d] += X[d];
-            }
+            X_com[d] = moments[1+d]/num_nodes;
         }
     }
-    d_lag_mesh_data[level_number][POSN_DATA_NAME]->restoreArrays();
-
-    SAMRAI_MPI::sumReduction(&X_com[0],NDIM);
-    node_counter = SAMRAI_MPI::sumReduction(node_counter);
-    for (unsigned int d = 0; d < NDIM; ++d)
-    {
-        X_com[d] /= static_cast<double>(node_counter);
-    }
     return X_com;
 }// computeLagrangianStructureCenterOfMass
 
@@ -749,34 +1113,92 @@ LDataManager::computeLagrangianStructureBoundingBox(
     TBOX_ASSERT(d_coarsest_ln <= level_number &&
                 d_finest_ln   >= level_number);
 #endif
-    blitz::TinyVector<double,NDIM> X_lower( (std::numeric_limits<double>::max()-sqrt(std::numeric_limits<double>::epsilon())));
-    blitz::TinyVector<double,NDIM> X_upper(-(std::numeric_limits<double>::max()-sqrt(std::numeric_limits<double>::epsilon())));
-    std::pair<int,int> lag_idx_range = getLagrangianStructureIndexRange(structure_id, level_number);
+    std::vector<double> moments;
+    computeLagrangianStructureMomentData(moments, std::vector<int>(1,structure_id), d_lag_mesh_data[level_number][POSN_DATA_NAME], level_number);
+    blitz::TinyVector<double,NDIM> X_lower, X_upper;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        X_lower[d] =  moments[1+  NDIM+d];
+        X_upper[d] = -moments[1+2*NDIM+d];
+    }
+    return std::make_pair(X_lower,X_upper);
+}// computeLagrangianStructureBoundingBox
 
-    const blitz::Array<double,2>& X_data = *d_lag_mesh_data[level_number][POSN_DATA_NAME]->getLocalFormVecArray();
-    const Pointer<LMesh> mesh = getLMesh(level_number);
-    const std::vector<LNode*>& local_nodes = mesh->getLocalNodes();
-    for (std::vector<LNode*>::const_iterator cit = local_nodes.begin(); cit != local_nodes.end(); ++cit)
+void
+LDataManager::computeLagrangianStructureMoments(
+    std::vector<blitz::TinyVector<double,NDIM> >& X_com,
+    std::vector<std::pair<blitz::TinyVector<double,NDIM>,blitz::TinyVector<double,NDIM> > >& bounding_boxes,
+    const std::vector<int>& structure_ids,
+    const int level_number,
+    const double data_time,
+    Pointer<LData> X_data)
+{
+#ifdef DEBUG_CHECK_ASSERTIONS
+    TBOX_ASSERT(d_coarsest_ln <= level_number &&
+                d_finest_ln   >= level_number);
+#endif
+    if (!X_data) X_data = d_lag_mesh_data[level_number][POSN_DATA_NAME];
+
+    // Discard the cached moments if they do not correspond to the specified
+    // data and time.
+    //
+    // NOTE: Because the cache retains a reference to the position data, the
+    // cached data cannot be mistakenly associated with a different LData
+    // object, and so all processors make the same determination.
+    std::map<int,std::vector<double> >& cache = d_strct_moment_cache[level_number];
+    if (d_strct_moment_cache_X_data[level_number].getPointer() != X_data.getPointer() ||
+        !MathUtilities<double>::equalEps(d_strct_moment_cache_time[level_number], data_time))
     {
-        const LNode* const node_idx = *cit;
-        const int lag_idx = node_idx->getLagrangianIndex();
-        if (lag_idx_range.first <= lag_idx && lag_idx < lag_idx_range.second)
+        cache.clear();
+        d_strct_moment_cache_X_data[level_number] = X_data;
+        d_strct_moment_cache_time  [level_number] = data_time;
+    }
+
+    // Compute the moments of any structures that are not already cached.
+    std::vector<int> uncached_structure_ids;
+    for (std::vector<int>::const_iterator cit = structure_ids.begin(); cit != structure_ids.end(); ++cit)
+    {
+        if (cache.find(*cit) == cache.end()) uncached_structure_ids.push_back(*cit);
+    }
+    std::sort(uncached_structure_ids.begin(), uncached_structure_ids.end());
+    uncached_structure_ids.erase(std::unique(uncached_structure_ids.begin(), uncached_structure_ids.end()), uncached_structure_ids.end());
+    if (!uncached_structure_ids.empty())
+    {
+        std::vector<double> moments;
+        computeLagrangianStructureMomentData(moments, uncached_structure_ids, X_data, level_number);
+        for (unsigned int k = 0; k < uncached_structure_ids.size(); ++k)
         {
-            const int local_idx = node_idx->getLocalPETScIndex();
-            const double* const X = &X_data(local_idx,0);
-            for (unsigned int d = 0; d < NDIM; ++d)
-            {
-                X_lower[d] = std::min(X_lower[d],X[d]);
-                X_upper[d] = std::max(X_upper[d],X[d]);
-            }
+            cache[uncached_structure_ids[k]].assign(moments.begin()+k*STRCT_MOMENT_DEPTH, moments.begin()+(k+1)*STRCT_MOMENT_DEPTH);
         }
     }
-    d_lag_mesh_data[level_number][POSN_DATA_NAME]->restoreArrays();
 
-    SAMRAI_MPI::minReduction(&X_lower[0],NDIM);
-    SAMRAI_MPI::maxReduction(&X_upper[0],NDIM);
-    return std::make_pair(X_lower,X_upper);
-}// computeLagrangianStructureBoundingBox
+    // Extract the requested quantities.
+    const int num_structures = structure_ids.size();
+    X_com.resize(num_structures);
+    bounding_boxes.resize(num_structures);
+    for (int k = 0; k < num_structures; ++k)
+    {
+        const std::vector<double>& moments = cache[structure_ids[k]];
+        const double num_nodes = moments[0];
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            X_com[k][d] = (num_nodes > 0.0 ? moments[1+d]/num_nodes : 0.0);
+            bounding_boxes[k].first [d] =  moments[1+  NDIM+d];
+            bounding_boxes[k].second[d] = -moments[1+2*NDIM+d];
+        }
+    }
+    return;
+}// computeLagrangianStructureMoments
+
+void
+LDataManager::clearLagrangianStructureMomentCache(
+    const int level_number)
+{
+    if (level_number >= static_cast<int>(d_strct_moment_cache.size())) return;
+    d_strct_moment_cache_X_data[level_number].setNull();
+    d_strct_moment_cache       [level_number].clear();
+    return;
+}// clearLagrangianStructureMomentCache
 
 void
 LDataManager::reinitLagrangianStructure(
@@ -789,6 +1211,7 @@ LDataManager::reinitLagrangianStructure(
                 d_finest_ln   >= level_number);
 #endif
     d_displaced_strct_ids[level_number].push_back(structure_id);
+    clearLagrangianStructureMomentCache(level_number);
 
     // Compute the bounding box of the structure in its reference configuration.
     const blitz::Array<double,2>& X0_data = *d_lag_mesh_data[level_number][INIT_POSN_DATA_NAME]->getLocalFormVecArray();
@@ -904,6 +1327,7 @@ LDataManager::displaceLagrangianStructure(
                 d_finest_ln   >= level_number);
 #endif
     d_displaced_strct_ids[level_number].push_back(structure_id);
+    clearLagrangianStructureMomentCache(level_number);
 
     // Compute the shifted bounding box.
     std::pair<blitz::TinyVector<double,NDIM>,blitz::TinyVector<double,NDIM> > bounding_box = computeLagrangianStructureBoundingBox(structure_id, level_number);
@@ -1084,11 +1508,7 @@ LDataManager::mapLagrangianToPETSc(
                 d_finest_ln   >= level_number);
 #endif
 
-    const int ierr = AOApplicationToPetsc(
-        d_ao[level_number],
-        (!inds.empty() ? static_cast<int>(inds.size()) : static_cast<int>(s_ao_dummy.size())),
-        (!inds.empty() ? &inds[0]                      : &s_ao_dummy[0]));
-    IBTK_CHKERRQ(ierr);
+    applyLagrangianToPETScMapping(!inds.empty() ? &inds[0] : NULL, inds.size(), level_number);
 
     IBTK_TIMER_STOP(t_map_lagrangian_to_petsc);
     return;
@@ -1106,11 +1526,7 @@ LDataManager::mapLagrangianToPETSc(
                 d_finest_ln   >= level_number);
 #endif
 
-    const int ierr = AOApplicationToPetsc(
-        d_ao[level_number],
-        (inds.size() > 0 ? static_cast<int>(inds.size()) : static_cast<int>(s_ao_dummy.size())),
-        (inds.size() > 0 ? inds.data()                   : &s_ao_dummy[0]));
-    IBTK_CHKERRQ(ierr);
+    applyLagrangianToPETScMapping(inds.size() > 0 ? inds.data() : NULL, inds.size(), level_number);
 
     IBTK_TIMER_STOP(t_map_lagrangian_to_petsc);
     return;
@@ -1128,11 +1544,7 @@ LDataManager::mapPETScToLagrangian(
                 d_finest_ln   >= level_number);
 #endif
 
-    const int ierr = AOPetscToApplication(
-        d_ao[level_number],
-        (!inds.empty() ? static_cast<int>(inds.size()) : static_cast<int>(s_ao_dummy.size())),
-        (!inds.empty() ? &inds[0]                      : &s_ao_dummy[0]));
-    IBTK_CHKERRQ(ierr);
+    applyPETScToLagrangianMapping(!inds.empty() ? &inds[0] : NULL, inds.size(), level_number);
 
     IBTK_TIMER_STOP(t_map_petsc_to_lagrangian);
     return;
@@ -1150,16 +1562,23 @@ LDataManager::mapPETScToLagrangian(
                 d_finest_ln   >= level_number);
 #endif
 
-    const int ierr = AOPetscToApplication(
-        d_ao[level_number],
-        (inds.size() > 0 ? static_cast<int>(inds.size()) : static_cast<int>(s_ao_dummy.size())),
-        (inds.size() > 0 ? inds.data()                   : &s_ao_dummy[0]));
-    IBTK_CHKERRQ(ierr);
+    applyPETScToLagrangianMapping(inds.size() > 0 ? inds.data() : NULL, inds.size(), level_number);
 
     IBTK_TIMER_STOP(t_map_petsc_to_lagrangian);
     return;
 }// mapPETScToLagrangian
 
+int
+LDataManager::getPETScMappingVersion(
+    const int level_number) const
+{
+#ifdef DEBUG_CHECK_ASSERTIONS
+    TBOX_ASSERT(d_coarsest_ln <= level_number &&
+                d_finest_ln   >= level_number);
+#endif
+    return d_petsc_mapping_version[level_number];
+}// getPETScMappingVersion
+
 void
 LDataManager::scatterLagrangianToPETSc(
     Vec& lagrangian_vec,
@@ -1210,6 +1629,91 @@ LDataManager::scatterToZero(
     return;
 }// scatterToZero
 
+void
+LDataManager::scatterToZeroInChunks(
+    Vec& parallel_vec,
+    ScatterChunkCallbackFcnPtr callback,
+    void* ctx,
+    const int max_chunk_size) const
+{
+#ifdef DEBUG_CHECK_ASSERTIONS
+    TBOX_ASSERT(callback);
+    TBOX_ASSERT(max_chunk_size > 0);
+#endif
+    int ierr;
+    const int mpi_size = SAMRAI_MPI::getNodes();
+    const int mpi_rank = SAMRAI_MPI::getRank();
+
+    // Determine the ownership ranges of the vector in terms of blocks.
+    int depth, global_size;
+    ierr = VecGetBlockSize(parallel_vec, &depth);  IBTK_CHKERRQ(ierr);
+    ierr = VecGetSize(parallel_vec, &global_size);  IBTK_CHKERRQ(ierr);
+    const int num_blocks = global_size/depth;
+    const PetscInt* ranges;
+    ierr = VecGetOwnershipRanges(parallel_vec, &ranges);  IBTK_CHKERRQ(ierr);
+    const int local_lo = ranges[mpi_rank]/depth;
+
+    // Each chunk is assembled on processor zero from the contiguous portions of
+    // the chunk owned by each processor.
+    double* local_arr;
+    ierr = VecGetArray(parallel_vec, &local_arr);  IBTK_CHKERRQ(ierr);
+    std::vector<double> chunk_data(mpi_rank == 0 ? depth*std::min(max_chunk_size,std::max(num_blocks,1)) : 0);
+    std::vector<int> recv_counts(mpi_rank == 0 ? mpi_size : 0), recv_displs(mpi_rank == 0 ? mpi_size : 0);
+    for (int chunk_lo = 0; chunk_lo < num_blocks; chunk_lo += max_chunk_size)
+    {
+        const int chunk_hi = std::min(chunk_lo+max_chunk_size, num_blocks);
+        const int lo = std::max(chunk_lo, ranges[mpi_rank  ]/depth);
+        const int hi = std::min(chunk_hi, ranges[mpi_rank+1]/depth);
+        const int send_count = depth*std::max(hi-lo, 0);
+        if (mpi_rank == 0)
+        {
+            for (int p = 0; p < mpi_size; ++p)
+            {
+                const int p_lo = std::max(chunk_lo, ranges[p  ]/depth);
+                const int p_hi = std::min(chunk_hi, ranges[p+1]/depth);
+                recv_counts[p] = depth*std::max(p_hi-p_lo, 0);
+                recv_displs[p] = depth*std::min(std::max(p_lo-chunk_lo, 0), chunk_hi-chunk_lo);
+            }
+        }
+        MPI_Gatherv(send_count > 0 ? &local_arr[depth*(lo-local_lo)] : NULL, send_count, MPI_DOUBLE,
+                    mpi_rank == 0 ? &chunk_data[0] : NULL,
+                    mpi_rank == 0 ? &recv_counts[0] : NULL,
+                    mpi_rank == 0 ? &recv_displs[0] : NULL,
+                    MPI_DOUBLE, 0, SAMRAI_MPI::getCommunicator());
+        if (mpi_rank == 0) (*callback)(&chunk_data[0], chunk_lo, chunk_hi-chunk_lo, depth, ctx);
+    }
+    ierr = VecRestoreArray(parallel_vec, &local_arr);  IBTK_CHKERRQ(ierr);
+    return;
+}// scatterToZeroInChunks
+
+void
+LDataManager::scatterSelectedIndices(
+    Vec& parallel_vec,
+    const std::vector<int>& block_idxs,
+    std::vector<double>& values) const
+{
+    int ierr;
+    int depth;
+    ierr = VecGetBlockSize(parallel_vec, &depth);  IBTK_CHKERRQ(ierr);
+    const int num_idxs = block_idxs.size();
+    values.resize(depth*num_idxs);
+
+    IS src_is, dst_is;
+    ierr = ISCreateBlock(PETSC_COMM_SELF, depth, num_idxs, num_idxs > 0 ? &block_idxs[0] : NULL, PETSC_COPY_VALUES, &src_is);  IBTK_CHKERRQ(ierr);
+    ierr = ISCreateStride(PETSC_COMM_SELF, depth*num_idxs, 0, 1, &dst_is);  IBTK_CHKERRQ(ierr);
+    Vec sequential_vec;
+    ierr = VecCreateSeqWithArray(PETSC_COMM_SELF, depth, depth*num_idxs, num_idxs > 0 ? &values[0] : NULL, &sequential_vec);  IBTK_CHKERRQ(ierr);
+    VecScatter ctx;
+    ierr = VecScatterCreate(parallel_vec, src_is, sequential_vec, dst_is, &ctx);  IBTK_CHKERRQ(ierr);
+    ierr = VecScatterBegin(ctx, parallel_vec, sequential_vec, INSERT_VALUES, SCATTER_FORWARD);  IBTK_CHKERRQ(ierr);
+    ierr = VecScatterEnd(ctx, parallel_vec, sequential_vec, INSERT_VALUES, SCATTER_FORWARD);  IBTK_CHKERRQ(ierr);
+    ierr = VecScatterDestroy(&ctx);  IBTK_CHKERRQ(ierr);
+    ierr = VecDestroy(&sequential_vec);  IBTK_CHKERRQ(ierr);
+    ierr = ISDestroy(&dst_is);  IBTK_CHKERRQ(ierr);
+    ierr = ISDestroy(&src_is);  IBTK_CHKERRQ(ierr);
+    return;
+}// scatterSelectedIndices
+
 void
 LDataManager::beginDataRedistribution(
     const int coarsest_ln_in,
@@ -1568,7 +2072,9 @@ LDataManager::endDataRedistribution(
     // NOTE 3: The PETSc ordering is maintained so that the data corresponding
     // to patch interiors is contiguous (as long as there are no overlapping
     // patches).  Nodes in the ghost region of a patch will not in general be
-    // stored as contiguous data, and no attempt is made to do so.
+    // stored as contiguous data, and no attempt is made to do so.  When no
+    // nodes change processors, the previous ordering is retained instead (see
+    // updateNodeDistribution()).
 
     // In the following loop over patch levels, we first compute the new
     // distribution data (e.g., all of these indices).
@@ -1588,6 +2094,41 @@ LDataManager::endDataRedistribution(
         dst_vec[level_number].resize(num_data);
         scatter[level_number].resize(num_data);
 
+        // When no nodes have changed processors, retain the present ordering
+        // of the local nodes and only update the ghost nodes.  In this case,
+        // the owned values of the LData do not need to be communicated, and
+        // the LData only need to be reset if the ghost nodes have changed.
+        const std::vector<int> old_nonlocal_petsc_indices = d_nonlocal_petsc_indices[level_number];
+        if (updateNodeDistribution(d_nonlocal_lag_indices  [level_number],
+                                   d_nonlocal_petsc_indices[level_number],
+                                   level_number))
+        {
+            new_ao[level_number] = d_ao[level_number];
+            num_local_nodes   [level_number] = d_local_lag_indices   [level_number].size();
+            num_nonlocal_nodes[level_number] = d_nonlocal_lag_indices[level_number].size();
+
+            // NOTE: VecCreateGhostBlock() is collective, so the ghost
+            // nodes are retained only if they are unchanged on every
+            // processor.
+            const bool ghost_nodes_unchanged = d_nonlocal_petsc_indices[level_number] == old_nonlocal_petsc_indices;
+            if (SAMRAI_MPI::maxReduction(ghost_nodes_unchanged ? 0 : 1) == 0) continue;
+            std::map<std::string,Pointer<LData> >::iterator it;
+            int i;
+            for (it = level_data.begin(), i = 0; it != level_data.end(); ++it, ++i)
+            {
+                Pointer<LData> data = it->second;
+                const int depth = data->getDepth();
+                src_vec[level_number][i] = data->getVec();
+                ierr = VecCreateGhostBlock(PETSC_COMM_WORLD, depth,
+                                           depth*num_local_nodes[level_number], PETSC_DECIDE,
+                                           num_nonlocal_nodes[level_number],
+                                           num_nonlocal_nodes[level_number] > 0 ? &d_nonlocal_petsc_indices[level_number][0] : NULL,
+                                           &dst_vec[level_number][i]);  IBTK_CHKERRQ(ierr);
+                ierr = VecCopy(src_vec[level_number][i], dst_vec[level_number][i]);  IBTK_CHKERRQ(ierr);
+            }
+            continue;
+        }
+
         // Get the new distribution of nodes for the level.
         //
         // NOTE: This process updates the local PETSc indices of the LNodeSet
@@ -1730,10 +2271,16 @@ LDataManager::endDataRedistribution(
         int i;
         for (it = level_data.begin(), i = 0; it != level_data.end(); ++it, ++i)
         {
-            ierr = VecScatterEnd(scatter[level_number][i], src_vec[level_number][i], dst_vec[level_number][i], INSERT_VALUES, SCATTER_FORWARD); IBTK_CHKERRQ(ierr);
-            ierr = VecScatterDestroy(&scatter[level_number][i]); IBTK_CHKERRQ(ierr);
-            Pointer<LData> data = it->second;
-            data->resetData(dst_vec[level_number][i], d_nonlocal_petsc_indices[level_number]);
+            if (scatter[level_number][i])
+            {
+                ierr = VecScatterEnd(scatter[level_number][i], src_vec[level_number][i], dst_vec[level_number][i], INSERT_VALUES, SCATTER_FORWARD); IBTK_CHKERRQ(ierr);
+                ierr = VecScatterDestroy(&scatter[level_number][i]); IBTK_CHKERRQ(ierr);
+            }
+            if (dst_vec[level_number][i])
+            {
+                Pointer<LData> data = it->second;
+                data->resetData(dst_vec[level_number][i], d_nonlocal_petsc_indices[level_number]);
+            }
         }
     }
 
@@ -1741,17 +2288,24 @@ LDataManager::endDataRedistribution(
     beginNonlocalDataFill(coarsest_ln,finest_ln);
     endNonlocalDataFill(  coarsest_ln,finest_ln);
 
+    // Cached interpolation and spreading operators are invalidated by the
+    // redistribution of the Lagrangian data.
+    resetCachedLEOperators();
+
     // Indicate that the levels have been synchronized and destroy unneeded
     // ordering and indexing objects.
     for (int level_number = coarsest_ln; level_number <= finest_ln; ++level_number)
     {
         d_needs_synch[level_number] = false;
 
-        if (d_ao[level_number])
+        const bool ordering_changed = d_ao[level_number] != new_ao[level_number];
+        if (d_ao[level_number] && ordering_changed)
         {
             ierr = AODestroy(&d_ao[level_number]);  IBTK_CHKERRQ(ierr);
         }
         d_ao[level_number] = new_ao[level_number];
+        resetPETScMappingCache(level_number, ordering_changed);
+        clearLagrangianStructureMomentCache(level_number);
 
         for (std::map<int,IS>::iterator it = src_IS[level_number].begin(); it != src_IS[level_number].end(); ++it)
         {
@@ -1764,6 +2318,10 @@ LDataManager::endDataRedistribution(
         }
     }
 
+    // Return the arena chunks that were occupied only by nodes of the previous
+    // configuration of the hierarchy to the heap.
+    SmallObjectArena::releaseUnusedChunks();
+
     // If a Silo data writer is registered with the manager, give it access to
     // the new application orderings.
     if (d_silo_writer)
@@ -1800,8 +2358,51 @@ LDataManager::updateWorkloadEstimates(
 #endif
 
     updateNodeCountData(coarsest_ln, finest_ln);
+
+    // Fit the measured workload model to the timings recorded on the present
+    // patches.  The fitted weights are kept for subsequent updates (e.g., for
+    // newly created levels, for which no timings are available).
+    if (d_workload_model)
+    {
+        double num_local_cells = 0.0;
+        for (int ln = 0; ln <= d_hierarchy->getFinestLevelNumber(); ++ln)
+        {
+            Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(ln);
+            for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+            {
+                Pointer<Patch<NDIM> > patch = level->getPatch(p());
+                const Box<NDIM>& patch_box = patch->getBox();
+                num_local_cells += static_cast<double>(patch_box.size());
+                if (!levelContainsLagrangianData(ln)) continue;
+                Pointer<LNodeSetData> idx_data = patch->getPatchData(d_lag_node_index_current_idx);
+                int num_nodes = 0;
+                for (LNodeSetData::DataIterator it = idx_data->data_begin(patch_box); it != idx_data->data_end(); ++it)
+                {
+                    ++num_nodes;
+                }
+                d_workload_model->addPatchSample(ln, p(), static_cast<double>(num_nodes), static_cast<double>(patch_box.size()));
+            }
+        }
+        if (d_workload_model->computeWorkloadWeights(d_measured_node_weight, d_measured_cell_weight, num_local_cells))
+        {
+            d_has_measured_workload_weights = true;
+        }
+        d_workload_model->resetMeasurements();
+    }
+
+    const double node_weight = (d_has_measured_workload_weights ? d_measured_node_weight : d_beta_work);
+    const double cell_weight = (d_has_measured_workload_weights ? d_measured_cell_weight : 0.0);
     HierarchyCellDataOpsReal<NDIM,double> hier_cc_data_ops(d_hierarchy,coarsest_ln,finest_ln);
-    hier_cc_data_ops.axpy(d_workload_idx, d_beta_work, d_node_count_idx, d_workload_idx);
+    hier_cc_data_ops.axpy(d_workload_idx, node_weight, d_node_count_idx, d_workload_idx);
+    if (cell_weight > 0.0)
+    {
+        for (int ln = coarsest_ln; ln <= finest_ln; ++ln)
+        {
+            if (!levelContainsLagrangianData(ln)) continue;
+            HierarchyCellDataOpsReal<NDIM,double> level_cc_data_ops(d_hierarchy,ln,ln);
+            level_cc_data_ops.addScalar(d_workload_idx, d_workload_idx, cell_weight);
+        }
+    }
 
     IBTK_TIMER_STOP(t_update_workload_estimates);
     return;
@@ -1963,6 +2564,13 @@ LDataManager::initializeLevelData(
         d_nonlocal_lag_indices          .resize(level_number+1);
         d_local_petsc_indices           .resize(level_number+1);
         d_nonlocal_petsc_indices        .resize(level_number+1);
+        d_petsc_mapping_version         .resize(level_number+1,-1);
+        d_lag_to_petsc_cache            .resize(level_number+1);
+        d_nonlocal_petsc_to_lag_cache   .resize(level_number+1);
+        d_petsc_mapping_cache_is_valid  .resize(level_number+1,false);
+        d_strct_moment_cache_X_data     .resize(level_number+1);
+        d_strct_moment_cache_time       .resize(level_number+1,0.0);
+        d_strct_moment_cache            .resize(level_number+1);
 
 #ifdef DEBUG_CHECK_ASSERTIONS
         TBOX_ASSERT(d_lag_init);
@@ -2095,6 +2703,8 @@ LDataManager::initializeLevelData(
                                num_local_nodes > 0 ? &d_local_lag_indices  [level_number][0] : NULL,
                                num_local_nodes > 0 ? &d_local_petsc_indices[level_number][0] : NULL,
                                &d_ao[level_number]);  IBTK_CHKERRQ(ierr);
+        resetPETScMappingCache(level_number, true);
+        clearLagrangianStructureMomentCache(level_number);
     }
 
     // If a Silo data writer is registered with the manager, give it access to
@@ -2139,6 +2749,7 @@ LDataManager::resetHierarchyConfiguration(
 
     // Reset the patch hierarchy and levels.
     setPatchHierarchy(hierarchy);
+    resetCachedLEOperators();
     resetLevels(0,finest_hier_level);
 
     // Reset the Silo data writer.
@@ -2188,6 +2799,10 @@ LDataManager::resetHierarchyConfiguration(
         d_node_count_coarsen_scheds[level_number] = d_node_count_coarsen_alg->createSchedule(coarser_level, level);
     }
 
+    // Timings recorded for the previous patch configuration are no longer
+    // meaningful.
+    if (d_workload_model) d_workload_model->resetMeasurements();
+
     IBTK_TIMER_STOP(t_reset_hierarchy_configuration);
     return;
 }// resetHierarchyConfiguration
@@ -2437,6 +3052,16 @@ LDataManager::LDataManager(
       d_output_node_count(false),
       d_interp_weighting_fcn(interp_weighting_fcn),
       d_spread_weighting_fcn(spread_weighting_fcn),
+      d_use_cached_le_operators(false),
+      d_le_operator_displacement_threshold(0.0),
+      d_le_operator_X_data(),
+      d_interp_le_operators(),
+      d_spread_le_operators(),
+      d_workload_model(NULL),
+      d_has_measured_workload_weights(false),
+      d_measured_node_weight(0.0),
+      d_measured_cell_weight(0.0),
+      d_lag_connectivity(),
       d_ghost_width(ghost_width),
       d_lag_node_index_bdry_fill_alg(NULL),
       d_lag_node_index_bdry_fill_scheds(),
@@ -2455,7 +3080,15 @@ LDataManager::LDataManager(
       d_local_lag_indices(),
       d_nonlocal_lag_indices(),
       d_local_petsc_indices(),
-      d_nonlocal_petsc_indices()
+      d_nonlocal_petsc_indices(),
+      d_petsc_mapping_version(),
+      d_petsc_mapping_version_counter(0),
+      d_lag_to_petsc_cache(),
+      d_nonlocal_petsc_to_lag_cache(),
+      d_petsc_mapping_cache_is_valid(),
+      d_strct_moment_cache_X_data(),
+      d_strct_moment_cache_time(),
+      d_strct_moment_cache()
 {
 #ifdef DEBUG_CHECK_ASSERTIONS
     TBOX_ASSERT(!object_name.empty());
@@ -2531,6 +3164,9 @@ LDataManager::LDataManager(
         t_begin_nonlocal_data_fill = TimerManager::getManager()->getTimer("IBTK::LDataManager::beginNonlocalDataFill()");
         t_end_nonlocal_data_fill = TimerManager::getManager()->getTimer("IBTK::LDataManager::endNonlocalDataFill()");
         t_compute_node_distribution = TimerManager::getManager()->getTimer("IBTK::LDataManager::computeNodeDistribution()");
+        t_update_node_distribution = TimerManager::getManager()->getTimer("IBTK::LDataManager::updateNodeDistribution()");
+        t_compute_lagrangian_box_graph = TimerManager::getManager()->getTimer("IBTK::LDataManager::computeLagrangianBoxGraph()");
+        t_compute_lagrangian_structure_moments = TimerManager::getManager()->getTimer("IBTK::LDataManager::computeLagrangianStructureMomentData()");
         t_compute_node_offsets = TimerManager::getManager()->getTimer("IBTK::LDataManager::computeNodeOffsets()");
                  );
     return;
@@ -2580,12 +3216,22 @@ LDataManager::spread_specialized(
         if (X_data_ghost_node_update) X_data[ln]->beginGhostUpdate();
         if (F_data_ghost_node_update) F_data[ln]->endGhostUpdate();
         if (X_data_ghost_node_update) X_data[ln]->endGhostUpdate();
+        if (d_use_cached_le_operators) checkCachedLEOperators(X_data[ln], ln);
         Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(ln);
         const IntVector<NDIM>& periodic_shift = grid_geom->getPeriodicShift(level->getRatio());
         for (PatchLevel<NDIM>::Iterator p(level); p; p++)
         {
+            const double patch_start_time = (d_workload_model ? MPI_Wtime() : 0.0);
             Pointer<Patch<NDIM> > patch = level->getPatch(p());
             Pointer<PatchData<NDIM> > f_data = patch->getPatchData(f_data_idx);
+            const std::vector<LEInteractor::CSROperator>* const le_ops = (d_use_cached_le_operators ? getCachedLEOperators(/*spread_operators*/ true, f_data, patch, ln) : NULL);
+            if (le_ops)
+            {
+                LEInteractor::applySpreadingOperator(f_data, *le_ops, F_data[ln]->getGhostedLocalFormVecArray()->data(), F_data[ln]->getDepth(), patch);
+                F_data[ln]->restoreArrays();
+                if (d_workload_model) d_workload_model->addPatchWorkTime(ln, p(), MPI_Wtime()-patch_start_time);
+                continue;
+            }
             Pointer<CellData<NDIM,double> > f_cc_data = f_data;
             Pointer<NodeData<NDIM,double> > f_nc_data = f_data;
             Pointer<SideData<NDIM,double> > f_sc_data = f_data;
@@ -2594,6 +3240,7 @@ LDataManager::spread_specialized(
             if (f_cc_data) LEInteractor::spread(f_cc_data, F_data[ln], X_data[ln], idx_data, patch, box, periodic_shift, d_spread_weighting_fcn);
             if (f_nc_data) LEInteractor::spread(f_nc_data, F_data[ln], X_data[ln], idx_data, patch, box, periodic_shift, d_spread_weighting_fcn);
             if (f_sc_data) LEInteractor::spread(f_sc_data, F_data[ln], X_data[ln], idx_data, patch, box, periodic_shift, d_spread_weighting_fcn);
+            if (d_workload_model) d_workload_model->addPatchWorkTime(ln, p(), MPI_Wtime()-patch_start_time);
         }
     }
     return;
@@ -2618,12 +3265,22 @@ LDataManager::interp_specialized(
         TBOX_ASSERT(ln == finest_ln);
 #endif
         if (ln < static_cast<int>(f_ghost_fill_scheds.size()) && f_ghost_fill_scheds[ln]) f_ghost_fill_scheds[ln]->fillData(fill_data_time);
+        if (d_use_cached_le_operators) checkCachedLEOperators(X_data[ln], ln);
         Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(ln);
         const IntVector<NDIM>& periodic_shift = grid_geom->getPeriodicShift(level->getRatio());
         for (PatchLevel<NDIM>::Iterator p(level); p; p++)
         {
+            const double patch_start_time = (d_workload_model ? MPI_Wtime() : 0.0);
             Pointer<Patch<NDIM> > patch = level->getPatch(p());
             Pointer<PatchData<NDIM> > f_data = patch->getPatchData(f_data_idx);
+            const std::vector<LEInteractor::CSROperator>* const le_ops = (d_use_cached_le_operators ? getCachedLEOperators(/*spread_operators*/ false, f_data, patch, ln) : NULL);
+            if (le_ops)
+            {
+                LEInteractor::applyInterpolationOperator(F_data[ln]->getGhostedLocalFormVecArray()->data(), F_data[ln]->getDepth(), *le_ops, f_data);
+                F_data[ln]->restoreArrays();
+                if (d_workload_model) d_workload_model->addPatchWorkTime(ln, p(), MPI_Wtime()-patch_start_time);
+                continue;
+            }
             Pointer<CellData<NDIM,double> > f_cc_data = f_data;
             Pointer<NodeData<NDIM,double> > f_nc_data = f_data;
             Pointer<SideData<NDIM,double> > f_sc_data = f_data;
@@ -2632,6 +3289,7 @@ LDataManager::interp_specialized(
             if (f_cc_data) LEInteractor::interpolate(F_data[ln], X_data[ln], idx_data, f_cc_data, patch, box, periodic_shift, d_interp_weighting_fcn);
             if (f_nc_data) LEInteractor::interpolate(F_data[ln], X_data[ln], idx_data, f_nc_data, patch, box, periodic_shift, d_interp_weighting_fcn);
             if (f_sc_data) LEInteractor::interpolate(F_data[ln], X_data[ln], idx_data, f_sc_data, patch, box, periodic_shift, d_interp_weighting_fcn);
+            if (d_workload_model) d_workload_model->addPatchWorkTime(ln, p(), MPI_Wtime()-patch_start_time);
         }
     }
 
@@ -2643,6 +3301,101 @@ LDataManager::interp_specialized(
     return;
 }// interp_specialized
 
+void
+LDataManager::checkCachedLEOperators(
+    Pointer<LData> X_data,
+    const int level_number)
+{
+    if (static_cast<int>(d_le_operator_X_data.size()) <= level_number)
+    {
+        d_le_operator_X_data .resize(level_number+1);
+        d_interp_le_operators.resize(level_number+1);
+        d_spread_le_operators.resize(level_number+1);
+    }
+    std::vector<double>& X_cached = d_le_operator_X_data[level_number];
+    const double* const X = X_data->getGhostedLocalFormVecArray()->data();
+    const unsigned int X_size = NDIM*(X_data->getLocalNodeCount()+X_data->getGhostNodeCount());
+    bool reset_operators = X_cached.size() != X_size;
+    if (!reset_operators)
+    {
+        Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(level_number);
+        const double* const dx0 = d_grid_geom->getDx();
+        const IntVector<NDIM>& ratio = level->getRatio();
+        double dx_min = std::numeric_limits<double>::max();
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            dx_min = std::min(dx_min, dx0[d]/static_cast<double>(ratio(d)));
+        }
+        const double max_displacement = d_le_operator_displacement_threshold*dx_min;
+        for (unsigned int k = 0; k < X_size && !reset_operators; ++k)
+        {
+            reset_operators = std::abs(X[k]-X_cached[k]) > max_displacement;
+        }
+    }
+    if (reset_operators)
+    {
+        X_cached.assign(X, X+X_size);
+        d_interp_le_operators[level_number].clear();
+        d_spread_le_operators[level_number].clear();
+    }
+    X_data->restoreArrays();
+    return;
+}// checkCachedLEOperators
+
+const std::vector<LEInteractor::CSROperator>*
+LDataManager::getCachedLEOperators(
+    const bool spread_operators,
+    const Pointer<PatchData<NDIM> > f_data,
+    const Pointer<Patch<NDIM> > patch,
+    const int level_number)
+{
+#ifdef DEBUG_CHECK_ASSERTIONS
+    TBOX_ASSERT(level_number < static_cast<int>(d_le_operator_X_data.size()));
+#endif
+    // Determine the expected layout of the operators.
+    Pointer<CellData<NDIM,double> > f_cc_data = f_data;
+    Pointer<NodeData<NDIM,double> > f_nc_data = f_data;
+    Pointer<SideData<NDIM,double> > f_sc_data = f_data;
+    Box<NDIM> data_box;
+    unsigned int num_ops = 1;
+    if      (f_cc_data) data_box = f_cc_data->getBox();
+    else if (f_nc_data) data_box = NodeGeometry<NDIM>::toNodeBox(f_nc_data->getBox());
+    else if (f_sc_data)
+    {
+        data_box = SideGeometry<NDIM>::toSideBox(f_sc_data->getBox(), 0);
+        num_ops = NDIM;
+    }
+    else
+    {
+        return NULL;
+    }
+
+    // Look up the cached operators.
+    std::vector<std::vector<LEInteractor::CSROperator> >& patch_ops = (spread_operators ? d_spread_le_operators : d_interp_le_operators)[level_number][patch->getPatchNumber()];
+    for (std::vector<std::vector<LEInteractor::CSROperator> >::const_iterator it = patch_ops.begin(); it != patch_ops.end(); ++it)
+    {
+        if (it->size() == num_ops && (*it)[0].data_box == data_box && (*it)[0].gcw == f_data->getGhostCellWidth())
+        {
+            return &(*it);
+        }
+    }
+
+    // Construct the operators using the cached node positions.  Spreading
+    // operators include the nodes in the ghost region of the patch.
+    Pointer<LNodeSetData> idx_data = patch->getPatchData(d_lag_node_index_current_idx);
+    const Box<NDIM>& box = (spread_operators ? idx_data->getGhostBox() : idx_data->getBox());
+    Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(level_number);
+    const IntVector<NDIM>& periodic_shift = d_grid_geom->getPeriodicShift(level->getRatio());
+    const std::vector<double>& X_cached = d_le_operator_X_data[level_number];
+    std::vector<LEInteractor::CSROperator> ops;
+    if (X_cached.empty() || !LEInteractor::buildOperator(ops, &X_cached[0], NDIM, idx_data, f_data, patch, box, periodic_shift, spread_operators ? d_spread_weighting_fcn : d_interp_weighting_fcn))
+    {
+        return NULL;
+    }
+    patch_ops.push_back(ops);
+    return &patch_ops.back();
+}// getCachedLEOperators
+
 void
 LDataManager::scatterData(
     Vec& lagrangian_vec,
@@ -2957,6 +3710,363 @@ LDataManager::computeNodeDistribution(
     return;
 }// computeNodeDistribution
 
+bool
+LDataManager::updateNodeDistribution(
+    std::vector<int>& nonlocal_lag_indices,
+    std::vector<int>& nonlocal_petsc_indices,
+    const int level_number)
+{
+    IBTK_TIMER_START(t_update_node_distribution);
+
+#ifdef DEBUG_CHECK_ASSERTIONS
+    TBOX_ASSERT(level_number >= d_coarsest_ln &&
+                level_number <= d_finest_ln);
+#endif
+
+    // There is no previous ordering to retain before the data are first
+    // distributed.
+    if (!d_ao[level_number])
+    {
+        IBTK_TIMER_STOP(t_update_node_distribution);
+        return false;
+    }
+
+    // Determine whether the nodes in the patch interiors are exactly the nodes
+    // that were previously owned by this processor.  The local PETSc indices
+    // stored in the LNode objects are those of the previous distribution.
+    Pointer<PatchLevel<NDIM> > level = d_hierarchy->getPatchLevel(level_number);
+    const std::vector<int>& local_lag_indices = d_local_lag_indices[level_number];
+    const int num_local_nodes = local_lag_indices.size();
+    int num_retained_nodes = 0;
+    bool local_nodes_unchanged = true;
+    for (PatchLevel<NDIM>::Iterator p(level); p && local_nodes_unchanged; p++)
+    {
+        const Pointer<Patch<NDIM> > patch = level->getPatch(p());
+        const Box<NDIM>& patch_box = patch->getBox();
+        const Pointer<LNodeSetData> lag_node_index_data = patch->getPatchData(d_lag_node_index_current_idx);
+        for (LNodeSetData::DataIterator it = lag_node_index_data->data_begin(patch_box); it != lag_node_index_data->data_end(); ++it)
+        {
+            const LNode* const node_idx = *it;
+            const int local_idx = node_idx->getLocalPETScIndex();
+            if (local_idx < 0 || local_idx >= num_local_nodes || local_lag_indices[local_idx] != node_idx->getLagrangianIndex())
+            {
+                local_nodes_unchanged = false;
+                break;
+            }
+            ++num_retained_nodes;
+        }
+    }
+    local_nodes_unchanged = local_nodes_unchanged && (num_retained_nodes == num_local_nodes);
+    if (SAMRAI_MPI::minReduction(local_nodes_unchanged ? 1 : 0) == 0)
+    {
+        IBTK_TIMER_STOP(t_update_node_distribution);
+        return false;
+    }
+
+    // Assign local PETSc indices to the nonlocal nodes, and reset the local
+    // PETSc indices of any copies of local nodes that appear in the ghost cell
+    // regions of other local patches.
+    nonlocal_lag_indices.clear();
+    std::map<int,int> lag_idx_to_petsc_idx;
+    for (int k = 0; k < num_local_nodes; ++k)
+    {
+        lag_idx_to_petsc_idx.insert(lag_idx_to_petsc_idx.end(), std::make_pair(local_lag_indices[k], k));
+    }
+    int local_offset = num_local_nodes;
+    for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+    {
+        const Pointer<Patch<NDIM> > patch = level->getPatch(p());
+        const Box<NDIM>& patch_box = patch->getBox();
+        const Pointer<LNodeSetData> lag_node_index_data = patch->getPatchData(d_lag_node_index_current_idx);
+        BoxList<NDIM> ghost_boxes = lag_node_index_data->getGhostBox();
+        ghost_boxes.removeIntersections(patch_box);
+        for (BoxList<NDIM>::Iterator bl(ghost_boxes); bl; bl++)
+        {
+            for (LNodeSetData::DataIterator it = lag_node_index_data->data_begin(bl()); it != lag_node_index_data->data_end(); ++it)
+            {
+                LNode* const node_idx = *it;
+                const int lag_idx = node_idx->getLagrangianIndex();
+                std::map<int,int>::const_iterator idx_it = lag_idx_to_petsc_idx.find(lag_idx);
+                if (idx_it == lag_idx_to_petsc_idx.end())
+                {
+                    nonlocal_lag_indices.push_back(lag_idx);
+                    const int petsc_idx = local_offset++;
+                    node_idx->setLocalPETScIndex(petsc_idx);
+                    lag_idx_to_petsc_idx[lag_idx] = petsc_idx;
+                }
+                else
+                {
+                    node_idx->setLocalPETScIndex(idx_it->second);
+                }
+            }
+        }
+    }
+
+    // Map the nonlocal nodes to the (unchanged) global PETSc ordering.
+    int ierr;
+    const int num_nonlocal_nodes = nonlocal_lag_indices.size();
+    nonlocal_petsc_indices = nonlocal_lag_indices;
+    ierr = AOApplicationToPetsc(
+        d_ao[level_number],
+        (num_nonlocal_nodes > 0 ? num_nonlocal_nodes         : static_cast<int>(s_ao_dummy.size())),
+        (num_nonlocal_nodes > 0 ? &nonlocal_petsc_indices[0] : &s_ao_dummy[0]));
+    IBTK_CHKERRQ(ierr);
+
+    // Store the global PETSc index in the local LNode objects.
+    const int node_offset = d_node_offset[level_number];
+    for (PatchLevel<NDIM>::Iterator p(level); p; p++)
+    {
+        const Pointer<Patch<NDIM> > patch = level->getPatch(p());
+        const Pointer<LNodeSetData> lag_node_index_data = patch->getPatchData(d_lag_node_index_current_idx);
+        const Box<NDIM>& ghost_box = lag_node_index_data->getGhostBox();
+        for (LNodeSetData::DataIterator it = lag_node_index_data->data_begin(ghost_box); it != lag_node_index_data->data_end(); ++it)
+        {
+            LNode* const node_idx = *it;
+            const int local_idx = node_idx->getLocalPETScIndex();
+            node_idx->setGlobalPETScIndex(local_idx < num_local_nodes ? node_offset+local_idx : nonlocal_petsc_indices[local_idx-num_local_nodes]);
+        }
+    }
+
+    IBTK_TIMER_STOP(t_update_node_distribution);
+    return true;
+}// updateNodeDistribution
+
+void
+LDataManager::computeLagrangianStructureMomentData(
+    std::vector<double>& moments,
+    const std::vector<int>& structure_ids,
+    Pointer<LData> X_data,
+    const int level_number)
+{
+    IBTK_TIMER_START(t_compute_lagrangian_structure_moments);
+
+    // Initialize the moments.
+    const int num_structures = structure_ids.size();
+    const double huge_val = std::numeric_limits<double>::max()-sqrt(std::numeric_limits<double>::epsilon());
+    moments.resize(num_structures*STRCT_MOMENT_DEPTH);
+    for (int k = 0; k < num_structures; ++k)
+    {
+        double* const m = &moments[k*STRCT_MOMENT_DEPTH];
+        std::fill(m, m+1+NDIM, 0.0);
+        std::fill(m+1+NDIM, m+STRCT_MOMENT_DEPTH, huge_val);
+    }
+
+    // Sort the Lagrangian index ranges of the structures, so that the
+    // structure associated with each local node can be found by binary search.
+    //
+    // NOTE: The index ranges of distinct structures do not overlap.
+    std::vector<std::pair<std::pair<int,int>,int> > lag_idx_ranges;
+    lag_idx_ranges.reserve(num_structures);
+    for (int k = 0; k < num_structures; ++k)
+    {
+        const std::pair<int,int> lag_idx_range = getLagrangianStructureIndexRange(structure_ids[k], level_number);
+        if (lag_idx_range.first < lag_idx_range.second) lag_idx_ranges.push_back(std::make_pair(lag_idx_range,k));
+    }
+    std::sort(lag_idx_ranges.begin(), lag_idx_ranges.end());
+
+    // Accumulate the local contributions in a single pass over the local nodes.
+    if (!lag_idx_ranges.empty())
+    {
+        const int min_lag_idx = lag_idx_ranges.front().first.first;
+        const blitz::Array<double,2>& X_arr = *X_data->getLocalFormVecArray();
+        const Pointer<LMesh> mesh = getLMesh(level_number);
+        const std::vector<LNode*>& local_nodes = mesh->getLocalNodes();
+        for (std::vector<LNode*>::const_iterator cit = local_nodes.begin(); cit != local_nodes.end(); ++cit)
+        {
+            const LNode* const node_idx = *cit;
+            const int lag_idx = node_idx->getLagrangianIndex();
+            if (lag_idx < min_lag_idx) continue;
+            std::vector<std::pair<std::pair<int,int>,int> >::const_iterator it =
+                std::upper_bound(lag_idx_ranges.begin(), lag_idx_ranges.end(),
+                                 std::make_pair(std::make_pair(lag_idx,std::numeric_limits<int>::max()),std::numeric_limits<int>::max()));
+            --it;
+            if (lag_idx >= it->first.second) continue;
+            double* const m = &moments[it->second*STRCT_MOMENT_DEPTH];
+            const double* const X = &X_arr(node_idx->getLocalPETScIndex(),0);
+            m[0] += 1.0;
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                m[1+       d] += X[d];
+                m[1+  NDIM+d] = std::min(m[1+  NDIM+d], X[d]);
+                m[1+2*NDIM+d] = std::min(m[1+2*NDIM+d],-X[d]);
+            }
+        }
+        X_data->restoreArrays();
+    }
+
+    // Reduce the moments of all structures with a single reduction.
+    if (num_structures > 0 && SAMRAI_MPI::getNodes() > 1)
+    {
+        MPI_Datatype moment_type;
+        MPI_Op moment_op;
+        MPI_Type_contiguous(STRCT_MOMENT_DEPTH, MPI_DOUBLE, &moment_type);
+        MPI_Type_commit(&moment_type);
+        MPI_Op_create(&reduce_structure_moments, 1, &moment_op);
+        const std::vector<double> local_moments(moments);
+        MPI_Allreduce(const_cast<double*>(&local_moments[0]), &moments[0], num_structures, moment_type, moment_op, SAMRAI_MPI::getCommunicator());
+        MPI_Op_free(&moment_op);
+        MPI_Type_free(&moment_type);
+    }
+
+    IBTK_TIMER_STOP(t_compute_lagrangian_structure_moments);
+    return;
+}// computeLagrangianStructureMomentData
+
+void
+LDataManager::applyLagrangianToPETScMapping(
+    int* const inds,
+    const int num_inds,
+    const int level_number) const
+{
+    buildPETScMappingCache(level_number);
+
+    // Map the indices of local and nonlocal nodes via the cached lookup table,
+    // and keep track of any remaining indices.
+    const std::vector<std::pair<int,int> >& lag_to_petsc = d_lag_to_petsc_cache[level_number];
+    std::vector<int> uncached_positions, uncached_inds;
+    for (int k = 0; k < num_inds; ++k)
+    {
+        const int lag_idx = inds[k];
+        if (lag_idx < 0) continue;
+        std::vector<std::pair<int,int> >::const_iterator it =
+            std::lower_bound(lag_to_petsc.begin(), lag_to_petsc.end(), std::make_pair(lag_idx,std::numeric_limits<int>::min()));
+        if (it != lag_to_petsc.end() && it->first == lag_idx)
+        {
+            inds[k] = it->second;
+        }
+        else
+        {
+            uncached_positions.push_back(k);
+            uncached_inds.push_back(lag_idx);
+        }
+    }
+
+    // Map the remaining indices via the AO.
+    //
+    // NOTE: The AO must be used by all processors, even those that do not have
+    // any remaining indices to map.
+    const int num_uncached_inds = uncached_inds.size();
+    const int ierr = AOApplicationToPetsc(
+        d_ao[level_number],
+        (num_uncached_inds > 0 ? num_uncached_inds  : static_cast<int>(s_ao_dummy.size())),
+        (num_uncached_inds > 0 ? &uncached_inds[0] : &s_ao_dummy[0]));
+    IBTK_CHKERRQ(ierr);
+    for (int k = 0; k < num_uncached_inds; ++k)
+    {
+        inds[uncached_positions[k]] = uncached_inds[k];
+    }
+    return;
+}// applyLagrangianToPETScMapping
+
+void
+LDataManager::applyPETScToLagrangianMapping(
+    int* const inds,
+    const int num_inds,
+    const int level_number) const
+{
+    buildPETScMappingCache(level_number);
+
+    // Map the indices of local nodes via the local Lagrangian indices, map the
+    // indices of nonlocal nodes via the cached lookup table, and keep track of
+    // any remaining indices.
+    const std::vector<int>& local_lag_indices = d_local_lag_indices[level_number];
+    const int num_local_nodes = local_lag_indices.size();
+    const int node_offset = d_node_offset[level_number];
+    const std::vector<std::pair<int,int> >& nonlocal_petsc_to_lag = d_nonlocal_petsc_to_lag_cache[level_number];
+    std::vector<int> uncached_positions, uncached_inds;
+    for (int k = 0; k < num_inds; ++k)
+    {
+        const int petsc_idx = inds[k];
+        if (petsc_idx < 0) continue;
+        if (petsc_idx >= node_offset && petsc_idx < node_offset+num_local_nodes)
+        {
+            inds[k] = local_lag_indices[petsc_idx-node_offset];
+            continue;
+        }
+        std::vector<std::pair<int,int> >::const_iterator it =
+            std::lower_bound(nonlocal_petsc_to_lag.begin(), nonlocal_petsc_to_lag.end(), std::make_pair(petsc_idx,std::numeric_limits<int>::min()));
+        if (it != nonlocal_petsc_to_lag.end() && it->first == petsc_idx)
+        {
+            inds[k] = it->second;
+        }
+        else
+        {
+            uncached_positions.push_back(k);
+            uncached_inds.push_back(petsc_idx);
+        }
+    }
+
+    // Map the remaining indices via the AO.
+    //
+    // NOTE: The AO must be used by all processors, even those that do not have
+    // any remaining indices to map.
+    const int num_uncached_inds = uncached_inds.size();
+    const int ierr = AOPetscToApplication(
+        d_ao[level_number],
+        (num_uncached_inds > 0 ? num_uncached_inds  : static_cast<int>(s_ao_dummy.size())),
+        (num_uncached_inds > 0 ? &uncached_inds[0] : &s_ao_dummy[0]));
+    IBTK_CHKERRQ(ierr);
+    for (int k = 0; k < num_uncached_inds; ++k)
+    {
+        inds[uncached_positions[k]] = uncached_inds[k];
+    }
+    return;
+}// applyPETScToLagrangianMapping
+
+void
+LDataManager::buildPETScMappingCache(
+    const int level_number) const
+{
+    if (d_petsc_mapping_cache_is_valid[level_number]) return;
+
+    const std::vector<int>& local_lag_indices = d_local_lag_indices[level_number];
+    const std::vector<int>& nonlocal_lag_indices = d_nonlocal_lag_indices[level_number];
+    const std::vector<int>& nonlocal_petsc_indices = d_nonlocal_petsc_indices[level_number];
+    const int num_local_nodes = local_lag_indices.size();
+    const int num_nonlocal_nodes = nonlocal_lag_indices.size();
+#ifdef DEBUG_CHECK_ASSERTIONS
+    TBOX_ASSERT(static_cast<int>(nonlocal_petsc_indices.size()) == num_nonlocal_nodes);
+#endif
+    const int node_offset = d_node_offset[level_number];
+
+    std::vector<std::pair<int,int> >& lag_to_petsc = d_lag_to_petsc_cache[level_number];
+    lag_to_petsc.clear();
+    lag_to_petsc.reserve(num_local_nodes+num_nonlocal_nodes);
+    for (int k = 0; k < num_local_nodes; ++k)
+    {
+        lag_to_petsc.push_back(std::make_pair(local_lag_indices[k],node_offset+k));
+    }
+    for (int k = 0; k < num_nonlocal_nodes; ++k)
+    {
+        lag_to_petsc.push_back(std::make_pair(nonlocal_lag_indices[k],nonlocal_petsc_indices[k]));
+    }
+    std::sort(lag_to_petsc.begin(), lag_to_petsc.end());
+
+    std::vector<std::pair<int,int> >& nonlocal_petsc_to_lag = d_nonlocal_petsc_to_lag_cache[level_number];
+    nonlocal_petsc_to_lag.clear();
+    nonlocal_petsc_to_lag.reserve(num_nonlocal_nodes);
+    for (int k = 0; k < num_nonlocal_nodes; ++k)
+    {
+        nonlocal_petsc_to_lag.push_back(std::make_pair(nonlocal_petsc_indices[k],nonlocal_lag_indices[k]));
+    }
+    std::sort(nonlocal_petsc_to_lag.begin(), nonlocal_petsc_to_lag.end());
+
+    d_petsc_mapping_cache_is_valid[level_number] = true;
+    return;
+}// buildPETScMappingCache
+
+void
+LDataManager::resetPETScMappingCache(
+    const int level_number,
+    const bool ordering_changed)
+{
+    d_lag_to_petsc_cache         [level_number].clear();
+    d_nonlocal_petsc_to_lag_cache[level_number].clear();
+    d_petsc_mapping_cache_is_valid[level_number] = false;
+    if (ordering_changed) d_petsc_mapping_version[level_number] = ++d_petsc_mapping_version_counter;
+    return;
+}// resetPETScMappingCache
+
 void
 LDataManager::computeNodeOffsets(
     unsigned int& num_nodes,
@@ -3030,6 +4140,13 @@ LDataManager::getFromRestart()
     d_nonlocal_lag_indices          .resize(d_finest_ln+1);
     d_local_petsc_indices           .resize(d_finest_ln+1);
     d_nonlocal_petsc_indices        .resize(d_finest_ln+1);
+    d_petsc_mapping_version         .resize(d_finest_ln+1,-1);
+    d_lag_to_petsc_cache            .resize(d_finest_ln+1);
+    d_nonlocal_petsc_to_lag_cache   .resize(d_finest_ln+1);
+    d_petsc_mapping_cache_is_valid  .resize(d_finest_ln+1,false);
+    d_strct_moment_cache_X_data     .resize(d_finest_ln+1);
+    d_strct_moment_cache_time       .resize(d_finest_ln+1,0.0);
+    d_strct_moment_cache            .resize(d_finest_ln+1);
 
     // Read in data that is stored on a level-by-level basis.
     for (int level_number = d_coarsest_ln; level_number <= d_finest_ln; ++level_number)
@@ -3135,6 +4252,7 @@ LDataManager::getFromRestart()
                                n_local_lag_indices > 0 ? &d_local_lag_indices  [level_number][0] : NULL,
                                n_local_lag_indices > 0 ? &d_local_petsc_indices[level_number][0] : NULL,
                                &d_ao[level_number]);  IBTK_CHKERRQ(ierr);
+        resetPETScMappingCache(level_number, true);
     }
     return;
 }// getFromRestart
@@ -56,10 +56,12 @@
 #include "VariableContext.h"
 #include "VisItDataWriter.h"
 #include "blitz/tinyvec2.h"
+#include "ibtk/LEInteractor.h"
 #include "ibtk/LInitStrategy.h"
 #include "ibtk/LNodeSet.h"
 #include "ibtk/LNodeSetVariable.h"
 #include "ibtk/LSiloDataWriter.h"
+#include "ibtk/LWorkloadModel.h"
 #include "ibtk/ParallelSet.h"
 #include "petscao.h"
 #include "petscvec.h"
@@ -72,6 +74,7 @@ class LMesh;
 namespace SAMRAI {
 namespace hier {
 template <int DIM> class BasePatchHierarchy;
+template <int DIM> class BoxArray;
 }  // namespace hier
 namespace tbox {
 class Database;
@@ -330,6 +333,93 @@ public:
         int coarsest_ln=-1,
         int finest_ln=-1);
 
+    /*!
+     * \brief Interpolate several quantities from the Eulerian grid to the
+     * Lagrangian mesh in a single pass over the patches.
+     *
+     * The quantity with patch data descriptor index f_data_idxs[k] is
+     * interpolated into F_data[k][ln] on each level ln.  The synchronization
+     * and ghost fill schedules, if provided, are indexed in the same manner.
+     * The Lagrangian indices local to each patch are determined only once per
+     * patch, and interpolation weights are shared among quantities with the
+     * same data layout.
+     *
+     * \see LEInteractor::interpolate()
+     */
+    void
+    interp(
+        const std::vector<int>& f_data_idxs,
+        std::vector<std::vector<SAMRAI::tbox::Pointer<LData> > >& F_data,
+        std::vector<SAMRAI::tbox::Pointer<LData> >& X_data,
+        const std::vector<std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::CoarsenSchedule<NDIM> > > >& f_synch_scheds=std::vector<std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::CoarsenSchedule<NDIM> > > >(),
+        const std::vector<std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::RefineSchedule<NDIM> > > >& f_ghost_fill_scheds=std::vector<std::vector<SAMRAI::tbox::Pointer<SAMRAI::xfer::RefineSchedule<NDIM> > > >(),
+        double fill_data_time=0.0,
+        int coarsest_ln=-1,
+        int finest_ln=-1);
+
+    /*!
+     * \brief Indicate whether explicit interpolation and spreading operators
+     * should be cached and reused.
+     *
+     * When enabled, spread() and interp() construct sparse representations of
+     * the interpolation and spreading operators for each patch (see
+     * LEInteractor::buildOperator()) and apply them as sparse matrix-vector
+     * products.  The operators on a level are reconstructed only when some
+     * node has moved by more than displacement_threshold times the grid
+     * spacing of the level since the operators were constructed, or when the
+     * Lagrangian data are redistributed.  With the default threshold of zero,
+     * the operators are reused only for unchanged node positions, so that the
+     * results are unaffected by caching.  With a positive threshold, the
+     * operators constructed from the positions stored at construction time
+     * are also used for nearby positions, and the results differ from those
+     * obtained without caching.
+     *
+     * The test requires one pass over the local node positions for each call
+     * to spread() or interp(), which is much less expensive than constructing
+     * the operators.
+     *
+     * \note Operators are only available for weighting functions with
+     * templated kernels (see LEInteractor); otherwise, the standard
+     * implementation is used.
+     */
+    void
+    setUseCachedLEOperators(
+        bool use_cached_le_operators=true,
+        double displacement_threshold=0.0);
+
+    /*!
+     * \brief Discard all cached interpolation and spreading operators, so that
+     * they are reconstructed on the next call to spread() or interp().
+     */
+    void
+    resetCachedLEOperators();
+
+    /*!
+     * \brief Indicate whether workload estimates should be computed from
+     * measured execution times.
+     *
+     * When enabled, the time spent spreading and interpolating on each local
+     * patch is recorded, and updateWorkloadEstimates() fits the per-node and
+     * per-cell weights of the workload from the timings recorded since the
+     * previous call (see LWorkloadModel).  The fitted weights are reused until
+     * new measurements are available, and beta_work is used until the first
+     * fit succeeds.
+     */
+    void
+    setUseMeasuredWorkloadEstimates(
+        bool use_measured_workload_estimates=true);
+
+    /*!
+     * \brief Return the model used to compute measured workload estimates, or
+     * a NULL pointer if measured workload estimates are not enabled.
+     *
+     * Clients may use the returned object to record the time spent in
+     * additional Lagrangian operations that scale with the number of nodes,
+     * e.g., force computations (see LWorkloadModel::addPointWorkTime()).
+     */
+    SAMRAI::tbox::Pointer<LWorkloadModel>
+    getWorkloadModel() const;
+
     /*!
      * Register a concrete strategy object with the integrator that specifies
      * the initial configuration of the curvilinear mesh nodes.
@@ -378,6 +468,62 @@ public:
         SAMRAI::tbox::Pointer<SAMRAI::mesh::LoadBalancer<NDIM> > load_balancer,
         int workload_data_idx);
 
+    /*!
+     * \brief Set the connectivity of the Lagrangian structures on the specified
+     * level of the patch hierarchy.
+     *
+     * The connectivity is specified as a collection of edges (e.g., springs and
+     * beams) between pairs of nodes, each identified by its Lagrangian index.
+     * Each processor provides the edges that it uses to compute forces.  Each
+     * collection of edges is identified by name, so that multiple force
+     * generators may provide connectivity data, and resetting a collection
+     * replaces any edges previously provided under the same name.
+     *
+     * The connectivity is used by LEdgeCutLoadBalancer to keep each structure
+     * on as few processors as possible.
+     */
+    void
+    setLagrangianConnectivity(
+        const std::string& connectivity_name,
+        const std::vector<std::pair<int,int> >& lag_edges,
+        int level_number);
+
+    /*!
+     * \brief Compute the graph that the connectivity of the Lagrangian
+     * structures induces on a collection of boxes.
+     *
+     * For each box, box_node_counts provides the number of local Lagrangian
+     * nodes located in the box, and box_graph maps each other box to the
+     * number of edges that connect nodes in the two boxes.  The boxes are in
+     * the index space of the specified level, but they need not correspond to
+     * the present configuration of that level.
+     *
+     * \return false if the level does not contain Lagrangian data.
+     *
+     * \note This is a collective operation, and the same results are returned
+     * on all processors.  It is intended to be used while the hierarchy is
+     * being regridded, i.e., between calls to beginDataRedistribution() and
+     * endDataRedistribution().
+     */
+    bool
+    computeLagrangianBoxGraph(
+        std::vector<int>& box_node_counts,
+        std::vector<std::map<int,int> >& box_graph,
+        const SAMRAI::hier::BoxArray<NDIM>& boxes,
+        const SAMRAI::hier::BoxArray<NDIM>& physical_domain,
+        const SAMRAI::hier::IntVector<NDIM>& ratio,
+        int level_number);
+
+    /*!
+     * \brief Get the workload weights assigned to each Lagrangian node and to
+     * each Cartesian grid cell of a level that contains Lagrangian data (see
+     * updateWorkloadEstimates()).
+     */
+    void
+    getWorkloadWeights(
+        double& node_weight,
+        double& cell_weight) const;
+
     /*!
      * \brief Indicates whether there is Lagrangian data on the given patch
      * hierarchy level.
@@ -564,6 +710,43 @@ public:
         int structure_id,
         int level_number);
 
+    /*!
+     * \brief Compute the centers of mass and the bounding boxes of a
+     * collection of Lagrangian structures.
+     *
+     * All of the requested quantities are computed in a single pass over the
+     * local nodes followed by a single reduction.  The results are cached for
+     * the specified position data and data time, so that subsequent calls
+     * with the same data and time only reduce the moments of structures that
+     * were not previously requested.  If X_data is NULL, the current positions
+     * of the nodes are used.  The center of mass and bounding box of each
+     * structure are defined as in computeLagrangianStructureCenterOfMass() and
+     * computeLagrangianStructureBoundingBox().
+     *
+     * \note This is a collective operation, and the same collection of
+     * structure IDs must be provided on all processors.  The cached results
+     * are discarded whenever the Lagrangian data are redistributed or
+     * structures are reinitialized or displaced.  Code that modifies the
+     * positions in place without changing the data time must call
+     * clearLagrangianStructureMomentCache().
+     */
+    void
+    computeLagrangianStructureMoments(
+        std::vector<blitz::TinyVector<double,NDIM> >& X_com,
+        std::vector<std::pair<blitz::TinyVector<double,NDIM>,blitz::TinyVector<double,NDIM> > >& bounding_boxes,
+        const std::vector<int>& structure_ids,
+        int level_number,
+        double data_time,
+        SAMRAI::tbox::Pointer<LData> X_data=SAMRAI::tbox::Pointer<LData>(NULL));
+
+    /*!
+     * \brief Discard any cached structure moments on the specified level of
+     * the patch hierarchy.
+     */
+    void
+    clearLagrangianStructureMomentCache(
+        int level_number);
+
     /*!
      * \brief Reset the positions of the nodes of the Lagrangian structure with
      * the specified ID to be equal to the initial positions but shifted so that
@@ -673,6 +856,21 @@ public:
         blitz::Array<int,1>& inds,
         int level_number) const;
 
+    /*!
+     * \brief Return the version of the mapping between the Lagrangian and
+     * global PETSc orderings on the specified level of the patch hierarchy.
+     *
+     * The version changes only when the mapping changes, i.e., when the level
+     * is initialized or when the Lagrangian data are redistributed in a manner
+     * that modifies the global PETSc ordering.  Data that are computed in
+     * terms of global PETSc indices remain valid so long as the version is
+     * unchanged.  Because the ordering is updated collectively, each processor
+     * obtains the same result.
+     */
+    int
+    getPETScMappingVersion(
+        int level_number) const;
+
     /*!
      * \brief Scatter data from the Lagrangian ordering to the global PETSc
      * ordering.
@@ -700,7 +898,9 @@ public:
     /*!
      * \brief Scatter data from a distributed PETSc vector to all processors.
      *
-     * \todo Optimize the implementation of this method.
+     * \note This method requires storage for the entire vector on every
+     * processor.  See scatterToZeroInChunks() and scatterSelectedIndices() for
+     * alternatives that do not.
      */
     void
     scatterToAll(
@@ -710,13 +910,68 @@ public:
     /*!
      * \brief Scatter data from a distributed PETSc vector to processor zero.
      *
-     * \todo Optimize the implementation of this method.
+     * \note This method requires storage for the entire vector on processor
+     * zero.  See scatterToZeroInChunks() and scatterSelectedIndices() for
+     * alternatives that do not.
      */
     void
     scatterToZero(
         Vec& parallel_vec,
         Vec& sequential_vec) const;
 
+    /*!
+     * Callback function specification for scatterToZeroInChunks().
+     *
+     * The chunk contains the values of blocks chunk_offset through
+     * chunk_offset+chunk_size-1 of the vector, with the depth values of each
+     * block stored consecutively.
+     */
+    typedef void
+    (*ScatterChunkCallbackFcnPtr)(
+        const double* chunk_data,
+        int chunk_offset,
+        int chunk_size,
+        int depth,
+        void* ctx);
+
+    /*!
+     * \brief Scatter data from a distributed PETSc vector to processor zero in
+     * chunks of at most max_chunk_size blocks, calling the provided callback
+     * function on processor zero for each chunk in order.
+     *
+     * Unlike scatterToZero(), this method requires only O(max_chunk_size)
+     * storage on processor zero, which makes it suitable for writing output
+     * files or for accumulating quantities from very large vectors.
+     *
+     * \note This is a collective operation.  The callback is only called on
+     * processor zero.
+     */
+    void
+    scatterToZeroInChunks(
+        Vec& parallel_vec,
+        ScatterChunkCallbackFcnPtr callback,
+        void* ctx=NULL,
+        int max_chunk_size=65536) const;
+
+    /*!
+     * \brief Scatter the values of the specified blocks of a distributed
+     * PETSc vector to the present processor.
+     *
+     * The values of block block_idxs[k] are stored in values[depth*k] through
+     * values[depth*k+depth-1].  Each processor may request a different
+     * collection of blocks, and only the requested values are communicated.
+     * The indices refer to the ordering of parallel_vec; e.g., to obtain the
+     * data associated with particular Lagrangian indices from a vector in the
+     * PETSc ordering, first map the indices via mapLagrangianToPETSc().
+     *
+     * \note This is a collective operation.
+     */
+    void
+    scatterSelectedIndices(
+        Vec& parallel_vec,
+        const std::vector<int>& block_idxs,
+        std::vector<double>& values) const;
+
     /*!
      * \brief Start the process of redistributing the Lagrangian data.
      *
@@ -749,6 +1004,13 @@ public:
      * C*dx*|U| with C << 1, it may be possible to redistribute the Lagrangian
      * data less frequently than every timestep.
      *
+     * \note If no node on a level has changed processors, the present
+     * application ordering and PETSc ordering of the local nodes of that level
+     * are retained: only the ghost node indices are recomputed, and the owned
+     * values of the LData are not communicated.  In this case, nodes that move
+     * between patches on the same processor are no longer stored contiguously
+     * by patch.
+     *
      * \see beginDataRedistribution
      */
     void
@@ -767,6 +1029,10 @@ public:
      *    workload(i) = 1 + beta_work*node_count(i)
      *
      * in which alpha and beta are parameters that each default to the value 1.
+     *
+     * When measured workload estimates are enabled, beta_work is replaced by
+     * the fitted per-node weight, and the fitted per-cell weight is added to
+     * the workload of each cell on levels that contain Lagrangian data.
      */
     void
     updateWorkloadEstimates(
@@ -954,6 +1220,28 @@ private:
         int coarsest_ln,
         int finest_ln);
 
+    /*!
+     * \brief Discard the cached operators on the specified level if the node
+     * positions differ from those used to construct the operators by more
+     * than the displacement threshold.
+     */
+    void
+    checkCachedLEOperators(
+        SAMRAI::tbox::Pointer<LData> X_data,
+        int level_number);
+
+    /*!
+     * \brief Return the cached interpolation or spreading operators for the
+     * specified patch data, constructing them if necessary.  Returns NULL if
+     * explicit operators are not available.
+     */
+    const std::vector<LEInteractor::CSROperator>*
+    getCachedLEOperators(
+        bool spread_operators,
+        SAMRAI::tbox::Pointer<SAMRAI::hier::PatchData<NDIM> > f_data,
+        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
+        int level_number);
+
     /*!
      * \brief Common implementation of scatterPETScToLagrangian() and
      * scatterLagrangianToPETSc().
@@ -1022,6 +1310,77 @@ private:
         unsigned int& node_offset,
         int level_number);
 
+    /*!
+     * \brief Compute the moments of the specified structures.
+     *
+     * The moments of each structure are stored in consecutive blocks of
+     * 1+3*NDIM values containing the number of nodes in the structure, the sum of the node positions, the lower corner of the
+     * bounding box, and the negated upper corner of the bounding box.
+     *
+     * \note This is a collective operation.
+     */
+    void
+    computeLagrangianStructureMomentData(
+        std::vector<double>& moments,
+        const std::vector<int>& structure_ids,
+        SAMRAI::tbox::Pointer<LData> X_data,
+        int level_number);
+
+    /*!
+     * \brief Map a collection of indices between the Lagrangian and global
+     * PETSc orderings.
+     *
+     * Indices of local and nonlocal nodes are mapped via cached lookup tables,
+     * and only the remaining indices are mapped via the AO object.
+     *
+     * \note These are collective operations.
+     */
+    void
+    applyLagrangianToPETScMapping(
+        int* inds,
+        int num_inds,
+        int level_number) const;
+    void
+    applyPETScToLagrangianMapping(
+        int* inds,
+        int num_inds,
+        int level_number) const;
+
+    /*!
+     * \brief Rebuild the cached lookup tables used to map indices of local and
+     * nonlocal nodes between the Lagrangian and global PETSc orderings.
+     */
+    void
+    buildPETScMappingCache(
+        int level_number) const;
+
+    /*!
+     * \brief Indicate that the distribution of nodes on the specified level
+     * has changed, and also whether the global PETSc ordering has changed.
+     */
+    void
+    resetPETScMappingCache(
+        int level_number,
+        bool ordering_changed);
+
+    /*!
+     * Update the global Lagrangian and PETSc indices of the nonlocal nodes
+     * associated with the processor, as well as the local PETSc indices of the
+     * interior and ghost nodes in each patch of the specified level, retaining
+     * the present ordering of the local nodes.
+     *
+     * \return false if the set of nodes owned by any processor has changed,
+     * in which case no indices are modified and computeNodeDistribution() must
+     * be used instead.
+     *
+     * \note This is a collective operation.
+     */
+    bool
+    updateNodeDistribution(
+        std::vector<int>& nonlocal_lag_indices,
+        std::vector<int>& nonlocal_petsc_indices,
+        int level_number);
+
     /*!
      * Determine the number of local Lagrangian nodes on all MPI processes with
      * rank less than the rank of the current MPI process.
@@ -1125,6 +1484,30 @@ private:
     const std::string d_interp_weighting_fcn;
     const std::string d_spread_weighting_fcn;
 
+    /*
+     * Cached explicit interpolation and spreading operators.  For each level,
+     * d_le_operator_X_data stores the node positions used to construct the
+     * operators, and the operators are stored for each patch number and for
+     * each Eulerian data layout.
+     */
+    bool d_use_cached_le_operators;
+    double d_le_operator_displacement_threshold;
+    std::vector<std::vector<double> > d_le_operator_X_data;
+    std::vector<std::map<int,std::vector<std::vector<LEInteractor::CSROperator> > > > d_interp_le_operators, d_spread_le_operators;
+
+    /*
+     * Measured workload model and the most recently fitted workload weights.
+     */
+    SAMRAI::tbox::Pointer<LWorkloadModel> d_workload_model;
+    bool d_has_measured_workload_weights;
+    double d_measured_node_weight, d_measured_cell_weight;
+
+    /*
+     * Named collections of edges between Lagrangian nodes that are used to
+     * determine the connectivity of the Lagrangian structures on each level.
+     */
+    std::vector<std::map<std::string,std::vector<std::pair<int,int> > > > d_lag_connectivity;
+
     /*
      * SAMRAI::hier::IntVector object that determines the ghost cell width of
      * the LNodeData SAMRAI::hier::PatchData objects.
@@ -1240,6 +1623,35 @@ private:
      */
     std::vector<std::vector<int> > d_nonlocal_petsc_indices;
 
+    /*!
+     * The version of the mapping between the Lagrangian and global PETSc
+     * orderings on each level of the patch hierarchy, and the counter used to
+     * generate new version numbers.
+     */
+    std::vector<int> d_petsc_mapping_version;
+    int d_petsc_mapping_version_counter;
+
+    /*!
+     * Cached lookup tables used to map the indices of local and nonlocal nodes
+     * between the Lagrangian and global PETSc orderings.
+     *
+     * d_lag_to_petsc_cache[ln] contains (Lagrangian index, PETSc index) pairs
+     * for all local and nonlocal nodes sorted by Lagrangian index.  Local nodes
+     * are mapped from the PETSc ordering via d_local_lag_indices[ln], and
+     * d_nonlocal_petsc_to_lag_cache[ln] contains (PETSc index, Lagrangian index)
+     * pairs for all nonlocal nodes sorted by PETSc index.
+     */
+    mutable std::vector<std::vector<std::pair<int,int> > > d_lag_to_petsc_cache, d_nonlocal_petsc_to_lag_cache;
+    mutable std::vector<bool> d_petsc_mapping_cache_is_valid;
+
+    /*!
+     * Cached moments of the Lagrangian structures on each level, along with
+     * the position data and the data time used to compute them.
+     */
+    std::vector<SAMRAI::tbox::Pointer<LData> > d_strct_moment_cache_X_data;
+    std::vector<double> d_strct_moment_cache_time;
+    std::vector<std::map<int,std::vector<double> > > d_strct_moment_cache;
+
     //\}
 };
 }// namespace IBTK
@@ -36,6 +36,7 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
+#include <limits>
 #include <ostream>
 #include <utility>
 #include <vector>
@@ -50,6 +51,7 @@
 #include "NodeData.h"
 #include "NodeGeometry.h"
 #include "Patch.h"
+#include "PatchData.h"
 #include "SAMRAI_config.h"
 #include "SideData.h"
 #include "SideGeometry.h"
@@ -69,6 +71,21 @@
 #include "tbox/Database.h"
 #include "tbox/Utilities.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Vectorization hints for the unit-stride inner loops of the templated
+// kernels.  The simd construct was introduced in OpenMP 4.0.
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#define IBTK_OMP_SIMD _Pragma("omp simd")
+#define IBTK_OMP_SIMD_SUM(var) _Pragma(IBTK_OMP_STRINGIFY(omp simd reduction(+:var)))
+#define IBTK_OMP_STRINGIFY(x) #x
+#else
+#define IBTK_OMP_SIMD
+#define IBTK_OMP_SIMD_SUM(var)
+#endif
+
 // FORTRAN ROUTINES
 #if (NDIM == 2)
 #define LAGRANGIAN_PIECEWISE_CONSTANT_INTERP_FC FC_FUNC_(lagrangian_piecewise_constant_interp2d, LAGRANGIAN_PIECEWISE_CONSTANT_INTERP2D)
@@ -532,155 +549,1246 @@ struct SortModeComp
             return true;
         }
 };
-}
 
-double (*LEInteractor::s_delta_fcn)(double r) = &ib4_delta_fcn;
-int LEInteractor::s_delta_fcn_stencil_size = 4;
-double LEInteractor::s_delta_fcn_C = 3.0/8.0;
-LEInteractor::SortMode LEInteractor::s_sort_mode = NO_SORT;
+inline int
+get_num_threads()
+{
+#ifdef _OPENMP
+    return (LEInteractor::s_num_threads > 0 ? LEInteractor::s_num_threads : omp_get_max_threads());
+#else
+    return 1;
+#endif
+}// get_num_threads
 
-void
-LEInteractor::setFromDatabase(
-    Pointer<Database> db)
+// One-dimensional kernels used by the templated spreading and interpolation
+// routines.  Each kernel provides its stencil width and the weight phi(r).  A
+// new kernel requires only a new class of this form and an entry in
+// templated_interpolate() and templated_spread().
+struct PiecewiseLinearDelta
 {
-    if (!db) return;
+    static const int width = 2;
 
-    std::string debug_sort_mode_str = "NO_SORT";
-    if (db->keyExists("debug_sort_mode")) debug_sort_mode_str = db->getString("debug_sort_mode");
-    if (debug_sort_mode_str == "NO_SORT")
-    {
-        s_sort_mode = NO_SORT;
-    }
-    else if (debug_sort_mode_str == "SORT_INCREASING_LAG_IDX")
+    inline double
+    operator()(
+        double r) const
+        {
+            r = std::abs(r);
+            return (r < 1.0 ? 1.0-r : 0.0);
+        }
+};
+
+struct PiecewiseCubicDelta
+{
+    static const int width = 4;
+
+    inline double
+    operator()(
+        double r) const
+        {
+            r = std::abs(r);
+            if (r < 1.0) return 1.0-0.5*r-r*r+0.5*r*r*r;
+            if (r < 2.0) return 1.0-(11.0/6.0)*r+r*r-(1.0/6.0)*r*r*r;
+            return 0.0;
+        }
+};
+
+struct IB3Delta
+{
+    static const int width = 3;
+
+    inline double
+    operator()(
+        double r) const
+        {
+            // NOTE: These truncated constants are the ones used by the Fortran
+            // kernels.
+            static const double sixth = 0.16666666666667;
+            static const double third = 0.333333333333333;
+            r = std::abs(r);
+            if (r < 0.5) return third*(1.0+sqrt(1.0-3.0*r*r));
+            if (r < 1.5) return sixth*(5.0-3.0*r-sqrt(1.0-3.0*(1.0-r)*(1.0-r)));
+            return 0.0;
+        }
+};
+
+struct IB4Delta
+{
+    static const int width = 4;
+
+    inline double
+    operator()(
+        double r) const
+        {
+            r = std::abs(r);
+            const double t2 = r*r;
+            if (r < 1.0) return -r/4.0+3.0/8.0+sqrt(-4.0*t2+4.0*r+1.0)/8.0;
+            if (r < 2.0) return -r/4.0+5.0/8.0-sqrt(12.0*r-7.0-4.0*t2)/8.0;
+            return 0.0;
+        }
+};
+
+struct IB6Delta
+{
+    static const int width = 6;
+
+    inline double
+    operator()(
+        double r) const
+        {
+            r = std::abs(r);
+            const double t2 = r*r;
+            const double t4 = t2*r;
+            const double t9 = t2*t2;
+            if (r < 1.0)
+            {
+                const double t16 = sqrt(729.0+4752.0*r-2244.0*t2-4680.0*t4+1500.0*t9+1008.0*t9*r-336.0*t9*t2);
+                return 61.0/112.0-11.0/42.0*r-11.0/56.0*t2+t4/12.0+t16/336.0;
+            }
+            if (r < 2.0)
+            {
+                const double t16 = sqrt(-1431.0-3744.0*r+5676.0*t2+6120.0*t4+3024.0*t9*r-8580.0*t9-336.0*t9*t2);
+                return r/84.0+117.0/224.0-23.0/112.0*t2+t4/24.0-t16/224.0;
+            }
+            if (r < 3.0)
+            {
+                const double t16 = sqrt(-10071.0+54720.0*r-99444.0*t2+77400.0*t4+5040.0*t9*r-28740.0*t9-336.0*t9*t2);
+                return -97.0/84.0*r+209.0/224.0+45.0/112.0*t2-t4/24.0+t16/672.0;
+            }
+            return 0.0;
+        }
+};
+
+// The kernel phi(r/F)/F obtained by broadening a kernel by a factor F.
+template<class Delta, int F>
+struct BroadenedDelta
+{
+    static const int width = F*Delta::width;
+
+    inline double
+    operator()(
+        const double r) const
+        {
+            const double F_inv = 1.0/static_cast<double>(F);
+            return F_inv*Delta()(F_inv*r);
+        }
+};
+
+// Determine the stencil of the marker located at X (shifted by X_shift) and
+// compute the tensor product of the one-dimensional weights.  The weights are
+// evaluated at the same points and multiplied in the same order as in the
+// Fortran kernels.  Only stencil entries istart <= i <= istop lie within the
+// ghost box.
+template<class Delta>
+inline void
+compute_weights(
+    const Delta& delta,
+    const double* const X,
+    const double* const X_shift,
+    const int* const ilower,
+    const int* const ig_lower,
+    const int* const ig_upper,
+    const double* const x_lower,
+    const double* const dx,
+    int* const ic_lower,
+    int* const istart,
+    int* const istop,
+    double* const w)
+{
+    static const int W = Delta::width;
+    double w_1d[NDIM][W];
+    for (unsigned int d = 0; d < NDIM; ++d)
     {
-        s_sort_mode = SORT_INCREASING_LAG_IDX;
+        const double X_d = X[d]+X_shift[d];
+        const int ic_center = static_cast<int>(std::floor((X_d-x_lower[d])/dx[d]))+ilower[d];
+        const double X_center = x_lower[d]+(static_cast<double>(ic_center-ilower[d])+0.5)*dx[d];
+        ic_lower[d] = ic_center-W/2;
+        if (W%2 == 0 && !(X_d < X_center)) ic_lower[d] += 1;
+        istart[d] = std::max(ig_lower[d]-ic_lower[d],0);
+        istop [d] = W-1-std::max(ic_lower[d]+W-1-ig_upper[d],0);
+        for (int i = 0; i < W; ++i)
+        {
+            const double X_cell = x_lower[d]+(static_cast<double>(ic_lower[d]+i-ilower[d])+0.5)*dx[d];
+            w_1d[d][i] = delta((X_d-X_cell)/dx[d]);
+        }
     }
-    else if (debug_sort_mode_str == "SORT_DECREASING_LAG_IDX")
+#if (NDIM == 2)
+    for (int i1 = 0; i1 < W; ++i1)
     {
-        s_sort_mode = SORT_DECREASING_LAG_IDX;
+        IBTK_OMP_SIMD
+        for (int i0 = 0; i0 < W; ++i0)
+        {
+            w[i0+W*i1] = w_1d[0][i0]*w_1d[1][i1];
+        }
     }
-    else
+#endif
+#if (NDIM == 3)
+    for (int i2 = 0; i2 < W; ++i2)
     {
-        TBOX_ERROR("LEInteractor::setFromDatabase():\n"
-                   << ":  invalid debug_sort_mode: " << debug_sort_mode_str << ".\n"
-                   << "   Choices are: NO_SORT, SORT_INCREASING_LAG_IDX, SORT_DECREASING_LAG_IDX.\n");
+        for (int i1 = 0; i1 < W; ++i1)
+        {
+            IBTK_OMP_SIMD
+            for (int i0 = 0; i0 < W; ++i0)
+            {
+                w[i0+W*(i1+W*i2)] = w_1d[0][i0]*w_1d[1][i1]*w_1d[2][i2];
+            }
+        }
     }
+#endif
     return;
-}// setFromDatabase
+}// compute_weights
+
+// A component of the interpolation operation: q is the patch data array of
+// the given depth, and component d of the value at marker s is stored in
+// Q[d+s*Q_stride].
+struct InterpComponent
+{
+    double* Q;
+    int Q_stride;
+    const double* q;
+    int depth;
+};
 
+// Interpolate several components that share the same data layout onto the
+// markers specified by X using the specified kernel.  The weights are computed
+// once per marker and are applied to all of the components.
+template<class Delta>
 void
-LEInteractor::printClassData(
-    std::ostream& os)
+interpolate_components_with_kernel(
+    const Delta& delta,
+    const std::vector<InterpComponent>& components,
+    const double* const X,
+    const int* const ilower,
+    const int* const iupper,
+    const int* const u_gcw,
+    const double* const x_lower,
+    const double* const dx,
+    const int* const local_indices,
+    const double* const X_shift,
+    const int num_local_indices)
 {
-    os << "LEInteractor::printClassData():\n";
-    os << "  s_sort_mode = ";
-    if (s_sort_mode == NO_SORT)
-    {
-        os << "NO_SORT";
-    }
-    else if (s_sort_mode == SORT_INCREASING_LAG_IDX)
-    {
-        os << "SORT_INCREASING_LAG_IDX";
-    }
-    else if (s_sort_mode == SORT_DECREASING_LAG_IDX)
+    static const int W = Delta::width;
+    int ig_lower[NDIM], ig_upper[NDIM], u_stride[NDIM+1];
+    u_stride[0] = 1;
+    for (unsigned int d = 0; d < NDIM; ++d)
     {
-        os << "SORT_DECREASING_LAG_IDX";
+        ig_lower[d] = ilower[d]-u_gcw[d];
+        ig_upper[d] = iupper[d]+u_gcw[d];
+        u_stride[d+1] = u_stride[d]*(ig_upper[d]-ig_lower[d]+1);
     }
-    else
+    const int num_components = components.size();
+    int ic_lower[NDIM], istart[NDIM], istop[NDIM];
+#if (NDIM == 2)
+    double w[W*W];
+#endif
+#if (NDIM == 3)
+    double w[W*W*W];
+#endif
+    for (int l = 0; l < num_local_indices; ++l)
     {
-        os << "UNKNOWN";
+        const int s = local_indices[l];
+        compute_weights(delta, &X[NDIM*s], &X_shift[NDIM*l], ilower, ig_lower, ig_upper, x_lower, dx, ic_lower, istart, istop, w);
+        const int stencil_offset = (ic_lower[0]-ig_lower[0])+u_stride[1]*(ic_lower[1]-ig_lower[1])
+#if (NDIM == 3)
+            +u_stride[2]*(ic_lower[2]-ig_lower[2])
+#endif
+            ;
+        for (int c = 0; c < num_components; ++c)
+        {
+            const InterpComponent& component = components[c];
+            for (int d = 0; d < component.depth; ++d)
+            {
+                const double* const u_d = component.q+stencil_offset+u_stride[NDIM]*d;
+                double V_ds = 0.0;
+#if (NDIM == 3)
+                for (int i2 = istart[2]; i2 <= istop[2]; ++i2)
+                {
+#endif
+                    for (int i1 = istart[1]; i1 <= istop[1]; ++i1)
+                    {
+#if (NDIM == 2)
+                        const double* const w_row = &w[W*i1];
+                        const double* const u_row = u_d+u_stride[1]*i1;
+#endif
+#if (NDIM == 3)
+                        const double* const w_row = &w[W*(i1+W*i2)];
+                        const double* const u_row = u_d+u_stride[1]*i1+u_stride[2]*i2;
+#endif
+                        IBTK_OMP_SIMD_SUM(V_ds)
+                        for (int i0 = istart[0]; i0 <= istop[0]; ++i0)
+                        {
+                            V_ds += w_row[i0]*u_row[i0];
+                        }
+                    }
+#if (NDIM == 3)
+                }
+#endif
+                component.Q[d+s*component.Q_stride] = V_ds;
+            }
+        }
     }
-    os << "\n";
     return;
-}// printClassData
-
-/////////////////////////////// PUBLIC ///////////////////////////////////////
+}// interpolate_components_with_kernel
+
+// Interpolate u onto V at the positions specified by X using the specified
+// kernel.
+template<class Delta>
+inline void
+interpolate_with_kernel(
+    const Delta& delta,
+    double* const V,
+    const double* const X,
+    const double* const u,
+    const int* const ilower,
+    const int* const iupper,
+    const int* const u_gcw,
+    const int depth,
+    const double* const x_lower,
+    const double* const dx,
+    const int* const local_indices,
+    const double* const X_shift,
+    const int num_local_indices)
+{
+    const InterpComponent component = {V, depth, u, depth};
+    interpolate_components_with_kernel(delta, std::vector<InterpComponent>(1,component), X, ilower, iupper, u_gcw, x_lower, dx, local_indices, X_shift, num_local_indices);
+    return;
+}// interpolate_with_kernel
 
-int
-LEInteractor::getStencilSize(
-    const std::string& weighting_fcn)
+// Spread V onto u at the positions specified by X using the specified kernel.
+// The values are accumulated in the type T, which is double or float.
+template<class Delta, class T>
+void
+spread_with_kernel(
+    const Delta& delta,
+    T* const u,
+    const double* const X,
+    const double* const V,
+    const int* const ilower,
+    const int* const iupper,
+    const int* const u_gcw,
+    const int depth,
+    const double* const x_lower,
+    const double* const dx,
+    const int* const local_indices,
+    const double* const X_shift,
+    const int num_local_indices)
 {
-    if (weighting_fcn == "PIECEWISE_CONSTANT") return 1;
+    static const int W = Delta::width;
+    int ig_lower[NDIM], ig_upper[NDIM], u_stride[NDIM+1];
+    u_stride[0] = 1;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        ig_lower[d] = ilower[d]-u_gcw[d];
+        ig_upper[d] = iupper[d]+u_gcw[d];
+        u_stride[d+1] = u_stride[d]*(ig_upper[d]-ig_lower[d]+1);
+    }
 #if (NDIM == 2)
-    if (weighting_fcn == "PIECEWISE_LINEAR") return 2;
-    if (weighting_fcn == "WIDE4_PIECEWISE_LINEAR") return 4;
-    if (weighting_fcn == "PIECEWISE_CUBIC") return 4;
-    if (weighting_fcn == "WIDE8_PIECEWISE_CUBIC") return 8;
+    const double dV_c = dx[0]*dx[1];
 #endif
-    if (weighting_fcn == "IB_3") return 4;
-#if (NDIM == 2)
-    if (weighting_fcn == "WIDE6_IB_3") return 6;
+#if (NDIM == 3)
+    const double dV_c = dx[0]*dx[1]*dx[2];
 #endif
-    if (weighting_fcn == "IB_4") return 4;
-    if (weighting_fcn == "WIDE8_IB_4") return 8;
-    if (weighting_fcn == "WIDE16_IB_4") return 16;
-    if (weighting_fcn == "IB_6") return 6;
-    if (weighting_fcn == "USER_DEFINED") return s_delta_fcn_stencil_size;
-    TBOX_ERROR("LEInteractor::getStencilSize()\n"
-               << "  Unknown weighting function "
-               << weighting_fcn << std::endl);
-    return -1;
-}// getStencilSize
-
-double
-LEInteractor::getC(
-    const std::string& weighting_fcn)
-{
-    if (weighting_fcn == "PIECEWISE_CONSTANT") return 1.0;
+    int ic_lower[NDIM], istart[NDIM], istop[NDIM];
 #if (NDIM == 2)
-    if (weighting_fcn == "PIECEWISE_LINEAR" ||
-        weighting_fcn == "WIDE4_PIECEWISE_LINEAR" ||
-        weighting_fcn == "PIECEWISE_CUBIC" ||
-        weighting_fcn == "WIDE8_PIECEWISE_CUBIC")
+    double w[W*W];
+#endif
+#if (NDIM == 3)
+    double w[W*W*W];
+#endif
+    for (int l = 0; l < num_local_indices; ++l)
     {
-        TBOX_ERROR("LEInteractor::getC()\n"
-                   << "  Weighting function " << weighting_fcn << " does not satisfy the quadratic (sum-of-squares) condition.\n"
-                   << "  Consequently, the value of C = sum_{j} phi(r-j)^2 is dependent on the value of r." << std::endl);
-    }
+        const int s = local_indices[l];
+        compute_weights(delta, &X[NDIM*s], &X_shift[NDIM*l], ilower, ig_lower, ig_upper, x_lower, dx, ic_lower, istart, istop, w);
+        T* const u_stencil = u+(ic_lower[0]-ig_lower[0])+u_stride[1]*(ic_lower[1]-ig_lower[1])
+#if (NDIM == 3)
+            +u_stride[2]*(ic_lower[2]-ig_lower[2])
 #endif
-    if (weighting_fcn == "IB_3") return 0.5;
+            ;
+        for (int d = 0; d < depth; ++d)
+        {
+            T* const u_d = u_stencil+u_stride[NDIM]*d;
+            const double V_ds = V[d+s*depth];
+#if (NDIM == 3)
+            for (int i2 = istart[2]; i2 <= istop[2]; ++i2)
+            {
+#endif
+                for (int i1 = istart[1]; i1 <= istop[1]; ++i1)
+                {
 #if (NDIM == 2)
-    if (weighting_fcn == "WIDE6_IB_3") return 0.25*getC("IB_3");
+                    const double* const w_row = &w[W*i1];
+                    T* const u_row = u_d+u_stride[1]*i1;
 #endif
-    if (weighting_fcn == "IB_4") return 3.0/8.0;
-    if (weighting_fcn == "WIDE8_IB_4") return 0.25*getC("IB_4");
-    if (weighting_fcn == "WIDE16_IB_4") return 0.0625*getC("IB_4");
-    if (weighting_fcn == "IB_6") return 67.0/128.0;
-    if (weighting_fcn == "USER_DEFINED") return s_delta_fcn_C;
-    TBOX_ERROR("LEInteractor::getC()\n"
-               << "  Unknown weighting function "
-               << weighting_fcn << std::endl);
-    return -1;
-}// getC
-
-template<class T>
-void
-LEInteractor::interpolate(
-    Pointer<LData> Q_data,
-    const Pointer<LData> X_data,
-    const Pointer<LIndexSetData<T> > idx_data,
-    const Pointer<CellData<NDIM,double> > q_data,
-    const Pointer<Patch<NDIM> > patch,
-    const Box<NDIM>& interp_box,
-    const IntVector<NDIM>& periodic_shift,
-    const std::string& interp_fcn)
-{
-#ifdef DEBUG_CHECK_ASSERTIONS
-    TBOX_ASSERT(Q_data);
-    TBOX_ASSERT(q_data);
-    TBOX_ASSERT(X_data);
-    TBOX_ASSERT(idx_data);
-    TBOX_ASSERT(patch);
-    TBOX_ASSERT(Q_data->getDepth() == static_cast<unsigned int>(q_data->getDepth()));
-    TBOX_ASSERT(X_data->getDepth() == NDIM);
+#if (NDIM == 3)
+                    const double* const w_row = &w[W*(i1+W*i2)];
+                    T* const u_row = u_d+u_stride[1]*i1+u_stride[2]*i2;
 #endif
-    interpolate(Q_data->getGhostedLocalFormVecArray()->data(), Q_data->getDepth(),
-                X_data->getGhostedLocalFormVecArray()->data(), X_data->getDepth(),
-                idx_data,
-                q_data,
-                patch, interp_box, periodic_shift, interp_fcn);
-    Q_data->restoreArrays();
-    X_data->restoreArrays();
+                    IBTK_OMP_SIMD
+                    for (int i0 = istart[0]; i0 <= istop[0]; ++i0)
+                    {
+                        u_row[i0] += w_row[i0]*V_ds/dV_c;
+                    }
+                }
+#if (NDIM == 3)
+            }
+#endif
+        }
+    }
+    return;
+}// spread_with_kernel
+
+// Interpolate using the templated kernel corresponding to the specified
+// weighting function.  Returns false if there is no such kernel.
+inline bool
+templated_interpolate(
+    const std::string& interp_fcn,
+    const bool patch_touches_physical_bdry,
+    double* const V,
+    const double* const X,
+    const double* const u,
+    const int* const ilower,
+    const int* const iupper,
+    const int* const u_gcw,
+    const int depth,
+    const double* const x_lower,
+    const double* const dx,
+    const int* const local_indices,
+    const double* const X_shift,
+    const int num_local_indices)
+{
+#define INTERPOLATE_WITH_KERNEL(delta) interpolate_with_kernel(delta, V, X, u, ilower, iupper, u_gcw, depth, x_lower, dx, local_indices, X_shift, num_local_indices)
+    if      (interp_fcn == "IB_3"                  ) INTERPOLATE_WITH_KERNEL((IB3Delta()));
+    else if (interp_fcn == "WIDE8_IB_4"            ) INTERPOLATE_WITH_KERNEL((BroadenedDelta<IB4Delta,2>()));
+    else if (interp_fcn == "WIDE16_IB_4"           ) INTERPOLATE_WITH_KERNEL((BroadenedDelta<IB4Delta,4>()));
+    else if (interp_fcn == "IB_4" && !patch_touches_physical_bdry) INTERPOLATE_WITH_KERNEL((IB4Delta()));
+    else if (interp_fcn == "IB_6" && !patch_touches_physical_bdry) INTERPOLATE_WITH_KERNEL((IB6Delta()));
+#if (NDIM == 2)
+    else if (interp_fcn == "PIECEWISE_LINEAR"      ) INTERPOLATE_WITH_KERNEL((PiecewiseLinearDelta()));
+    else if (interp_fcn == "WIDE4_PIECEWISE_LINEAR") INTERPOLATE_WITH_KERNEL((BroadenedDelta<PiecewiseLinearDelta,2>()));
+    else if (interp_fcn == "PIECEWISE_CUBIC"       ) INTERPOLATE_WITH_KERNEL((PiecewiseCubicDelta()));
+    else if (interp_fcn == "WIDE8_PIECEWISE_CUBIC" ) INTERPOLATE_WITH_KERNEL((BroadenedDelta<PiecewiseCubicDelta,2>()));
+    else if (interp_fcn == "WIDE6_IB_3"            ) INTERPOLATE_WITH_KERNEL((BroadenedDelta<IB3Delta,2>()));
+#endif
+    else return false;
+#undef INTERPOLATE_WITH_KERNEL
+    return true;
+}// templated_interpolate
+
+// Interpolate several components that share the same data layout using the
+// templated kernel corresponding to the specified weighting function.  Returns
+// false if there is no such kernel.
+inline bool
+templated_interpolate_components(
+    const std::string& interp_fcn,
+    const bool patch_touches_physical_bdry,
+    const std::vector<InterpComponent>& components,
+    const double* const X,
+    const int* const ilower,
+    const int* const iupper,
+    const int* const u_gcw,
+    const double* const x_lower,
+    const double* const dx,
+    const int* const local_indices,
+    const double* const X_shift,
+    const int num_local_indices)
+{
+#define INTERPOLATE_WITH_KERNEL(delta) interpolate_components_with_kernel(delta, components, X, ilower, iupper, u_gcw, x_lower, dx, local_indices, X_shift, num_local_indices)
+    if      (interp_fcn == "IB_3"                  ) INTERPOLATE_WITH_KERNEL((IB3Delta()));
+    else if (interp_fcn == "WIDE8_IB_4"            ) INTERPOLATE_WITH_KERNEL((BroadenedDelta<IB4Delta,2>()));
+    else if (interp_fcn == "WIDE16_IB_4"           ) INTERPOLATE_WITH_KERNEL((BroadenedDelta<IB4Delta,4>()));
+    else if (interp_fcn == "IB_4" && !patch_touches_physical_bdry) INTERPOLATE_WITH_KERNEL((IB4Delta()));
+    else if (interp_fcn == "IB_6" && !patch_touches_physical_bdry) INTERPOLATE_WITH_KERNEL((IB6Delta()));
+#if (NDIM == 2)
+    else if (interp_fcn == "PIECEWISE_LINEAR"      ) INTERPOLATE_WITH_KERNEL((PiecewiseLinearDelta()));
+    else if (interp_fcn == "WIDE4_PIECEWISE_LINEAR") INTERPOLATE_WITH_KERNEL((BroadenedDelta<PiecewiseLinearDelta,2>()));
+    else if (interp_fcn == "PIECEWISE_CUBIC"       ) INTERPOLATE_WITH_KERNEL((PiecewiseCubicDelta()));
+    else if (interp_fcn == "WIDE8_PIECEWISE_CUBIC" ) INTERPOLATE_WITH_KERNEL((BroadenedDelta<PiecewiseCubicDelta,2>()));
+    else if (interp_fcn == "WIDE6_IB_3"            ) INTERPOLATE_WITH_KERNEL((BroadenedDelta<IB3Delta,2>()));
+#endif
+    else return false;
+#undef INTERPOLATE_WITH_KERNEL
+    return true;
+}// templated_interpolate_components
+
+// Returns true if the templated kernels support the specified weighting
+// function.
+inline bool
+has_templated_kernel(
+    const std::string& interp_fcn,
+    const bool patch_touches_physical_bdry)
+{
+    if (interp_fcn == "IB_4" || interp_fcn == "IB_6") return !patch_touches_physical_bdry;
+#if (NDIM == 2)
+    if (interp_fcn == "PIECEWISE_LINEAR"       ||
+        interp_fcn == "WIDE4_PIECEWISE_LINEAR" ||
+        interp_fcn == "PIECEWISE_CUBIC"        ||
+        interp_fcn == "WIDE8_PIECEWISE_CUBIC"  ||
+        interp_fcn == "WIDE6_IB_3"             ) return true;
+#endif
+    return (interp_fcn == "IB_3"                   ||
+            interp_fcn == "WIDE8_IB_4"             ||
+            interp_fcn == "WIDE16_IB_4"            );
+}// has_templated_kernel
+
+// A collection of interpolation components that share the same data layout,
+// and hence the same interpolation weights.
+struct InterpComponentGroup
+{
+    Box<NDIM> q_data_box;
+    IntVector<NDIM> q_gcw;
+    blitz::TinyVector<double,NDIM> x_lower, x_upper;
+    std::vector<InterpComponent> components;
+};
+
+// Add a component to the group with the specified data layout, creating a new
+// group if necessary.
+inline void
+add_interp_component(
+    std::vector<InterpComponentGroup>& groups,
+    const Box<NDIM>& q_data_box,
+    const IntVector<NDIM>& q_gcw,
+    const blitz::TinyVector<double,NDIM>& x_lower,
+    const blitz::TinyVector<double,NDIM>& x_upper,
+    const InterpComponent& component)
+{
+    for (std::vector<InterpComponentGroup>::iterator it = groups.begin(); it != groups.end(); ++it)
+    {
+        bool same_layout = it->q_data_box == q_data_box && it->q_gcw == q_gcw;
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            same_layout = same_layout && it->x_lower[d] == x_lower[d];
+        }
+        if (same_layout)
+        {
+            it->components.push_back(component);
+            return;
+        }
+    }
+    groups.push_back(InterpComponentGroup());
+    InterpComponentGroup& group = groups.back();
+    group.q_data_box = q_data_box;
+    group.q_gcw = q_gcw;
+    group.x_lower = x_lower;
+    group.x_upper = x_upper;
+    group.components.push_back(component);
+    return;
+}// add_interp_component
+
+// Append to op the rows of the interpolation operator corresponding to the
+// markers specified by X using the specified kernel.  The weights are those
+// used by interpolate_components_with_kernel(), and are stored in the order in
+// which they are applied.
+template<class Delta>
+void
+build_operator_with_kernel(
+    const Delta& delta,
+    LEInteractor::CSROperator& op,
+    const double* const X,
+    const int* const ilower,
+    const int* const iupper,
+    const int* const u_gcw,
+    const double* const x_lower,
+    const double* const dx,
+    const int* const local_indices,
+    const double* const X_shift,
+    const int num_local_indices)
+{
+    static const int W = Delta::width;
+    int ig_lower[NDIM], ig_upper[NDIM], u_stride[NDIM+1];
+    u_stride[0] = 1;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        ig_lower[d] = ilower[d]-u_gcw[d];
+        ig_upper[d] = iupper[d]+u_gcw[d];
+        u_stride[d+1] = u_stride[d]*(ig_upper[d]-ig_lower[d]+1);
+    }
+    int ic_lower[NDIM], istart[NDIM], istop[NDIM];
+#if (NDIM == 2)
+    double w[W*W];
+#endif
+#if (NDIM == 3)
+    double w[W*W*W];
+#endif
+    for (int l = 0; l < num_local_indices; ++l)
+    {
+        const int s = local_indices[l];
+        compute_weights(delta, &X[NDIM*s], &X_shift[NDIM*l], ilower, ig_lower, ig_upper, x_lower, dx, ic_lower, istart, istop, w);
+        const int stencil_offset = (ic_lower[0]-ig_lower[0])+u_stride[1]*(ic_lower[1]-ig_lower[1])
+#if (NDIM == 3)
+            +u_stride[2]*(ic_lower[2]-ig_lower[2])
+#endif
+            ;
+        op.node_idxs.push_back(s);
+#if (NDIM == 3)
+        for (int i2 = istart[2]; i2 <= istop[2]; ++i2)
+        {
+#endif
+            for (int i1 = istart[1]; i1 <= istop[1]; ++i1)
+            {
+#if (NDIM == 2)
+                const double* const w_row = &w[W*i1];
+                const int row_offset = stencil_offset+u_stride[1]*i1;
+#endif
+#if (NDIM == 3)
+                const double* const w_row = &w[W*(i1+W*i2)];
+                const int row_offset = stencil_offset+u_stride[1]*i1+u_stride[2]*i2;
+#endif
+                for (int i0 = istart[0]; i0 <= istop[0]; ++i0)
+                {
+                    if (w_row[i0] == 0.0) continue;
+                    op.offsets.push_back(row_offset+i0);
+                    op.weights.push_back(w_row[i0]);
+                }
+            }
+#if (NDIM == 3)
+        }
+#endif
+        op.row_ptr.push_back(op.offsets.size());
+    }
+    return;
+}// build_operator_with_kernel
+
+// Build the interpolation operator using the templated kernel corresponding to
+// the specified weighting function.  Returns false if there is no such kernel.
+inline bool
+templated_build_operator(
+    const std::string& weighting_fcn,
+    const bool patch_touches_physical_bdry,
+    LEInteractor::CSROperator& op,
+    const double* const X,
+    const int* const ilower,
+    const int* const iupper,
+    const int* const u_gcw,
+    const double* const x_lower,
+    const double* const dx,
+    const int* const local_indices,
+    const double* const X_shift,
+    const int num_local_indices)
+{
+#define BUILD_OPERATOR_WITH_KERNEL(delta) build_operator_with_kernel(delta, op, X, ilower, iupper, u_gcw, x_lower, dx, local_indices, X_shift, num_local_indices)
+    if      (weighting_fcn == "IB_3"                  ) BUILD_OPERATOR_WITH_KERNEL((IB3Delta()));
+    else if (weighting_fcn == "WIDE8_IB_4"            ) BUILD_OPERATOR_WITH_KERNEL((BroadenedDelta<IB4Delta,2>()));
+    else if (weighting_fcn == "WIDE16_IB_4"           ) BUILD_OPERATOR_WITH_KERNEL((BroadenedDelta<IB4Delta,4>()));
+    else if (weighting_fcn == "IB_4" && !patch_touches_physical_bdry) BUILD_OPERATOR_WITH_KERNEL((IB4Delta()));
+    else if (weighting_fcn == "IB_6" && !patch_touches_physical_bdry) BUILD_OPERATOR_WITH_KERNEL((IB6Delta()));
+#if (NDIM == 2)
+    else if (weighting_fcn == "PIECEWISE_LINEAR"      ) BUILD_OPERATOR_WITH_KERNEL((PiecewiseLinearDelta()));
+    else if (weighting_fcn == "WIDE4_PIECEWISE_LINEAR") BUILD_OPERATOR_WITH_KERNEL((BroadenedDelta<PiecewiseLinearDelta,2>()));
+    else if (weighting_fcn == "PIECEWISE_CUBIC"       ) BUILD_OPERATOR_WITH_KERNEL((PiecewiseCubicDelta()));
+    else if (weighting_fcn == "WIDE8_PIECEWISE_CUBIC" ) BUILD_OPERATOR_WITH_KERNEL((BroadenedDelta<PiecewiseCubicDelta,2>()));
+    else if (weighting_fcn == "WIDE6_IB_3"            ) BUILD_OPERATOR_WITH_KERNEL((BroadenedDelta<IB3Delta,2>()));
+#endif
+    else return false;
+#undef BUILD_OPERATOR_WITH_KERNEL
+    return true;
+}// templated_build_operator
+
+// Spread using the templated kernel corresponding to the specified weighting
+// function.  Returns false if there is no such kernel.
+template<class T>
+inline bool
+templated_spread(
+    const std::string& spread_fcn,
+    const bool patch_touches_physical_bdry,
+    T* const u,
+    const double* const X,
+    const double* const V,
+    const int* const ilower,
+    const int* const iupper,
+    const int* const u_gcw,
+    const int depth,
+    const double* const x_lower,
+    const double* const dx,
+    const int* const local_indices,
+    const double* const X_shift,
+    const int num_local_indices)
+{
+#define SPREAD_WITH_KERNEL(delta) spread_with_kernel(delta, u, X, V, ilower, iupper, u_gcw, depth, x_lower, dx, local_indices, X_shift, num_local_indices)
+    if      (spread_fcn == "IB_3"                  ) SPREAD_WITH_KERNEL((IB3Delta()));
+    else if (spread_fcn == "WIDE8_IB_4"            ) SPREAD_WITH_KERNEL((BroadenedDelta<IB4Delta,2>()));
+    else if (spread_fcn == "WIDE16_IB_4"           ) SPREAD_WITH_KERNEL((BroadenedDelta<IB4Delta,4>()));
+    else if (spread_fcn == "IB_4" && !patch_touches_physical_bdry) SPREAD_WITH_KERNEL((IB4Delta()));
+    else if (spread_fcn == "IB_6" && !patch_touches_physical_bdry) SPREAD_WITH_KERNEL((IB6Delta()));
+#if (NDIM == 2)
+    else if (spread_fcn == "PIECEWISE_LINEAR"      ) SPREAD_WITH_KERNEL((PiecewiseLinearDelta()));
+    else if (spread_fcn == "WIDE4_PIECEWISE_LINEAR") SPREAD_WITH_KERNEL((BroadenedDelta<PiecewiseLinearDelta,2>()));
+    else if (spread_fcn == "PIECEWISE_CUBIC"       ) SPREAD_WITH_KERNEL((PiecewiseCubicDelta()));
+    else if (spread_fcn == "WIDE8_PIECEWISE_CUBIC" ) SPREAD_WITH_KERNEL((BroadenedDelta<PiecewiseCubicDelta,2>()));
+    else if (spread_fcn == "WIDE6_IB_3"            ) SPREAD_WITH_KERNEL((BroadenedDelta<IB3Delta,2>()));
+#endif
+    else return false;
+#undef SPREAD_WITH_KERNEL
+    return true;
+}// templated_spread
+
+// Scratch buffer used by single_precision_spread().  The buffer is retained
+// between calls so that it is not reallocated for each patch.
+//
+// NOTE: single_precision_spread() is not reentrant; it is only called outside
+// of threaded regions.
+std::vector<float> s_single_precision_spread_buffer;
+
+// Spread into a zero-initialized single precision scratch buffer using the
+// templated kernel corresponding to the specified weighting function, and then
+// add the buffer to u.  The buffer spans only the index box touched by the
+// markers' stencils.  Returns false if there is no such kernel.
+bool
+single_precision_spread(
+    const std::string& spread_fcn,
+    const bool patch_touches_physical_bdry,
+    double* const u,
+    const double* const X,
+    const double* const V,
+    const int* const ilower,
+    const int* const iupper,
+    const int* const u_gcw,
+    const int depth,
+    const double* const x_lower,
+    const double* const dx,
+    const int* const local_indices,
+    const double* const X_shift,
+    const int num_local_indices)
+{
+    if (!has_templated_kernel(spread_fcn, patch_touches_physical_bdry)) return false;
+
+    // Determine the portion of the ghosted patch touched by the stencils, using
+    // the same cell index computation as compute_weights().
+    const int W = LEInteractor::getStencilSize(spread_fcn);
+    int ig_lower[NDIM], ig_upper[NDIM], ib_lower[NDIM], ib_upper[NDIM];
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        ig_lower[d] = ilower[d]-u_gcw[d];
+        ig_upper[d] = iupper[d]+u_gcw[d];
+        ib_lower[d] = std::numeric_limits<int>::max();
+        ib_upper[d] = std::numeric_limits<int>::min();
+    }
+    for (int l = 0; l < num_local_indices; ++l)
+    {
+        const int s = local_indices[l];
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            const double X_d = X[NDIM*s+d]+X_shift[NDIM*l+d];
+            const int ic_center = static_cast<int>(std::floor((X_d-x_lower[d])/dx[d]))+ilower[d];
+            ib_lower[d] = std::min(ib_lower[d],ic_center-W/2);
+            ib_upper[d] = std::max(ib_upper[d],ic_center-W/2+W);
+        }
+    }
+    int ib_size[NDIM], ib_stride[NDIM+1], ig_stride[NDIM+1];
+    ib_stride[0] = 1;
+    ig_stride[0] = 1;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        ib_lower[d] = std::max(ib_lower[d],ig_lower[d]);
+        ib_upper[d] = std::min(ib_upper[d],ig_upper[d]);
+        if (ib_upper[d] < ib_lower[d]) return true;
+        ib_size[d] = ib_upper[d]-ib_lower[d]+1;
+        ib_stride[d+1] = ib_stride[d]*ib_size[d];
+        ig_stride[d+1] = ig_stride[d]*(ig_upper[d]-ig_lower[d]+1);
+    }
+
+    // Spread into the buffer.  The index mapping is determined by ilower and
+    // x_lower, whereas the extents of the array are ilower-u_gcw and
+    // iupper+u_gcw, so we describe the buffer as a "ghost box" of the patch.
+    const int buffer_size = depth*ib_stride[NDIM];
+    std::vector<float>& u_buffer = s_single_precision_spread_buffer;
+    if (static_cast<int>(u_buffer.size()) < buffer_size) u_buffer.resize(buffer_size);
+    std::fill(u_buffer.begin(), u_buffer.begin()+buffer_size, 0.0f);
+    int ib_gcw[NDIM], ib_iupper[NDIM];
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        ib_gcw[d] = ilower[d]-ib_lower[d];
+        ib_iupper[d] = ib_upper[d]-ib_gcw[d];
+    }
+    templated_spread(spread_fcn, patch_touches_physical_bdry, &u_buffer[0], X, V, ilower, ib_iupper, ib_gcw, depth, x_lower, dx, local_indices, X_shift, num_local_indices);
+
+    // Add the buffer to the patch data.
+    int u_offset = 0;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        u_offset += (ib_lower[d]-ig_lower[d])*ig_stride[d];
+    }
+    for (int k = 0; k < depth; ++k)
+    {
+        const float* const u_buffer_k = &u_buffer[k*ib_stride[NDIM]];
+        double* const u_k = u+u_offset+k*ig_stride[NDIM];
+#if (NDIM == 3)
+        for (int i2 = 0; i2 < ib_size[2]; ++i2)
+        {
+#endif
+            for (int i1 = 0; i1 < ib_size[1]; ++i1)
+            {
+#if (NDIM == 2)
+                const float* const u_buffer_row = u_buffer_k+ib_stride[1]*i1;
+                double* const u_row = u_k+ig_stride[1]*i1;
+#endif
+#if (NDIM == 3)
+                const float* const u_buffer_row = u_buffer_k+ib_stride[1]*i1+ib_stride[2]*i2;
+                double* const u_row = u_k+ig_stride[1]*i1+ig_stride[2]*i2;
+#endif
+                for (int i0 = 0; i0 < ib_size[0]; ++i0)
+                {
+                    u_row[i0] += static_cast<double>(u_buffer_row[i0]);
+                }
+            }
+#if (NDIM == 3)
+        }
+#endif
+    }
+    return true;
+}// single_precision_spread
+
+// Tabulated values of the user-defined kernel LEInteractor::s_delta_fcn at
+// the points r_j = r_min + j/resolution.
+struct DeltaFcnTable
+{
+    double (*fcn)(double r);
+    int stencil_size;
+    int resolution;
+    double r_min;
+    std::vector<double> values;
+};
+
+DeltaFcnTable delta_fcn_table = {NULL, 0, 0, 0.0, std::vector<double>()};
+
+// Update the table of the user-defined kernel if the kernel, its stencil size,
+// or the table resolution have changed.  Returns false if tabulation is
+// disabled.
+//
+// NOTE: This function is not thread safe, and must be called before any
+// threaded spreading or interpolation.
+inline bool
+update_delta_fcn_table()
+{
+    const int resolution = LEInteractor::s_delta_fcn_table_resolution;
+    if (resolution <= 0 || !LEInteractor::s_delta_fcn) return false;
+    DeltaFcnTable& table = delta_fcn_table;
+    if (table.fcn == LEInteractor::s_delta_fcn &&
+        table.stencil_size == LEInteractor::s_delta_fcn_stencil_size &&
+        table.resolution == resolution) return true;
+
+    // The table covers the support of the kernel, along with two additional
+    // points at each end that are used by cubic interpolation.
+    table.fcn = LEInteractor::s_delta_fcn;
+    table.stencil_size = LEInteractor::s_delta_fcn_stencil_size;
+    table.resolution = resolution;
+    const double h = 1.0/static_cast<double>(resolution);
+    table.r_min = -0.5*static_cast<double>(table.stencil_size)-2.0*h;
+    const int num_values = table.stencil_size*resolution+5;
+    table.values.resize(num_values);
+    for (int j = 0; j < num_values; ++j)
+    {
+        table.values[j] = table.fcn(table.r_min+static_cast<double>(j)*h);
+    }
+    return true;
+}// update_delta_fcn_table
+
+// The user-defined kernel evaluated by linear or cubic interpolation in its
+// table.  The kernel is taken to vanish outside of the tabulated range.
+template<int W>
+struct TabulatedDelta
+{
+    static const int width = W;
+
+    TabulatedDelta(
+        const DeltaFcnTable& table,
+        const bool use_cubic)
+        : d_values(&table.values[0]),
+          d_num_values(table.values.size()),
+          d_r_min(table.r_min),
+          d_resolution(static_cast<double>(table.resolution)),
+          d_use_cubic(use_cubic)
+        {
+            // intentionally blank
+            return;
+        }
+
+    inline double
+    operator()(
+        const double r) const
+        {
+            const double x = (r-d_r_min)*d_resolution;
+            if (!(x >= 1.0 && x < static_cast<double>(d_num_values-2))) return 0.0;
+            const int k = static_cast<int>(x);
+            const double f = x-static_cast<double>(k);
+            const double* const v = &d_values[k];
+            if (!d_use_cubic) return v[0]+f*(v[1]-v[0]);
+            const double fp1 = f+1.0, fm1 = f-1.0, fm2 = f-2.0;
+            return (-f*fm1*fm2*v[-1]+3.0*fp1*fm1*fm2*v[0]-3.0*fp1*f*fm2*v[1]+fp1*f*fm1*v[2])/6.0;
+        }
+
+    const double* d_values;
+    int d_num_values;
+    double d_r_min, d_resolution;
+    bool d_use_cubic;
+};
+
+// Interpolate (or spread) using the tabulated user-defined kernel.  Returns
+// false if tabulation is disabled or if the stencil size is not supported.
+inline bool
+tabulated_interpolate_or_spread(
+    const bool spread,
+    double* const V_or_u,
+    const double* const X,
+    const double* const u_or_V,
+    const int* const ilower,
+    const int* const iupper,
+    const int* const u_gcw,
+    const int depth,
+    const double* const x_lower,
+    const double* const dx,
+    const int* const local_indices,
+    const double* const X_shift,
+    const int num_local_indices)
+{
+    const DeltaFcnTable& table = delta_fcn_table;
+    if (LEInteractor::s_delta_fcn_table_resolution <= 0 ||
+        table.fcn != LEInteractor::s_delta_fcn ||
+        table.stencil_size != LEInteractor::s_delta_fcn_stencil_size ||
+        table.resolution != LEInteractor::s_delta_fcn_table_resolution) return false;
+    const bool use_cubic = LEInteractor::s_delta_fcn_table_interp_mode == LEInteractor::CUBIC_TABLE_INTERP;
+#define TABULATED_CASE(W)                                               \
+    case W:                                                             \
+        if (spread) spread_with_kernel(TabulatedDelta<W>(table,use_cubic), V_or_u, X, u_or_V, ilower, iupper, u_gcw, depth, x_lower, dx, local_indices, X_shift, num_local_indices); \
+        else interpolate_with_kernel(TabulatedDelta<W>(table,use_cubic), V_or_u, X, u_or_V, ilower, iupper, u_gcw, depth, x_lower, dx, local_indices, X_shift, num_local_indices); \
+        return true
+    switch (table.stencil_size)
+    {
+        TABULATED_CASE(1);
+        TABULATED_CASE(2);
+        TABULATED_CASE(3);
+        TABULATED_CASE(4);
+        TABULATED_CASE(5);
+        TABULATED_CASE(6);
+        TABULATED_CASE(7);
+        TABULATED_CASE(8);
+        default:
+            return false;
+    }
+#undef TABULATED_CASE
+}// tabulated_interpolate_or_spread
+}
+
+double (*LEInteractor::s_delta_fcn)(double r) = &ib4_delta_fcn;
+int LEInteractor::s_delta_fcn_stencil_size = 4;
+double LEInteractor::s_delta_fcn_C = 3.0/8.0;
+LEInteractor::SortMode LEInteractor::s_sort_mode = NO_SORT;
+LEInteractor::SpreadThreadingMode LEInteractor::s_spread_threading_mode = SERIAL_SPREAD;
+int LEInteractor::s_spread_tile_size = 8;
+LEInteractor::InterpThreadingMode LEInteractor::s_interp_threading_mode = SERIAL_INTERP;
+int LEInteractor::s_interp_chunk_size = 256;
+int LEInteractor::s_num_threads = 0;
+bool LEInteractor::s_use_templated_kernels = true;
+int LEInteractor::s_delta_fcn_table_resolution = 0;
+LEInteractor::DeltaFcnTableInterpMode LEInteractor::s_delta_fcn_table_interp_mode = LINEAR_TABLE_INTERP;
+LEInteractor::SpreadPrecisionMode LEInteractor::s_spread_precision_mode = DOUBLE_PRECISION_SPREAD;
+
+void
+LEInteractor::setFromDatabase(
+    Pointer<Database> db)
+{
+    if (!db) return;
+
+    std::string sort_mode_str = "NO_SORT";
+    if      (db->keyExists("sort_mode"      )) sort_mode_str = db->getString("sort_mode"      );
+    else if (db->keyExists("debug_sort_mode")) sort_mode_str = db->getString("debug_sort_mode");
+    if (sort_mode_str == "NO_SORT")
+    {
+        s_sort_mode = NO_SORT;
+    }
+    else if (sort_mode_str == "SORT_INCREASING_LAG_IDX")
+    {
+        s_sort_mode = SORT_INCREASING_LAG_IDX;
+    }
+    else if (sort_mode_str == "SORT_DECREASING_LAG_IDX")
+    {
+        s_sort_mode = SORT_DECREASING_LAG_IDX;
+    }
+    else if (sort_mode_str == "SORT_MORTON_ORDER")
+    {
+        s_sort_mode = SORT_MORTON_ORDER;
+    }
+    else if (sort_mode_str == "SORT_HILBERT_ORDER")
+    {
+        s_sort_mode = SORT_HILBERT_ORDER;
+    }
+    else
+    {
+        TBOX_ERROR("LEInteractor::setFromDatabase():\n"
+                   << ":  invalid sort_mode: " << sort_mode_str << ".\n"
+                   << "   Choices are: NO_SORT, SORT_INCREASING_LAG_IDX, SORT_DECREASING_LAG_IDX, SORT_MORTON_ORDER, SORT_HILBERT_ORDER.\n");
+    }
+
+    std::string spread_threading_mode_str = "SERIAL_SPREAD";
+    if (db->keyExists("spread_threading_mode")) spread_threading_mode_str = db->getString("spread_threading_mode");
+    if (spread_threading_mode_str == "SERIAL_SPREAD")
+    {
+        s_spread_threading_mode = SERIAL_SPREAD;
+    }
+    else if (spread_threading_mode_str == "COLORED_TILE_SPREAD")
+    {
+        s_spread_threading_mode = COLORED_TILE_SPREAD;
+    }
+    else if (spread_threading_mode_str == "REDUCTION_BUFFER_SPREAD")
+    {
+        s_spread_threading_mode = REDUCTION_BUFFER_SPREAD;
+    }
+    else
+    {
+        TBOX_ERROR("LEInteractor::setFromDatabase():\n"
+                   << ":  invalid spread_threading_mode: " << spread_threading_mode_str << ".\n"
+                   << "   Choices are: SERIAL_SPREAD, COLORED_TILE_SPREAD, REDUCTION_BUFFER_SPREAD.\n");
+    }
+    if (db->keyExists("spread_tile_size")) s_spread_tile_size = db->getInteger("spread_tile_size");
+
+    std::string interp_threading_mode_str = "SERIAL_INTERP";
+    if (db->keyExists("interp_threading_mode")) interp_threading_mode_str = db->getString("interp_threading_mode");
+    if (interp_threading_mode_str == "SERIAL_INTERP")
+    {
+        s_interp_threading_mode = SERIAL_INTERP;
+    }
+    else if (interp_threading_mode_str == "CHUNKED_INTERP")
+    {
+        s_interp_threading_mode = CHUNKED_INTERP;
+    }
+    else
+    {
+        TBOX_ERROR("LEInteractor::setFromDatabase():\n"
+                   << ":  invalid interp_threading_mode: " << interp_threading_mode_str << ".\n"
+                   << "   Choices are: SERIAL_INTERP, CHUNKED_INTERP.\n");
+    }
+    if (db->keyExists("interp_chunk_size")) s_interp_chunk_size = db->getInteger("interp_chunk_size");
+    if (db->keyExists("num_threads")) s_num_threads = db->getInteger("num_threads");
+    if (db->keyExists("use_templated_kernels")) s_use_templated_kernels = db->getBool("use_templated_kernels");
+    if (db->keyExists("delta_fcn_table_resolution")) s_delta_fcn_table_resolution = db->getInteger("delta_fcn_table_resolution");
+    std::string delta_fcn_table_interp_mode_str = "LINEAR_TABLE_INTERP";
+    if (db->keyExists("delta_fcn_table_interp_mode")) delta_fcn_table_interp_mode_str = db->getString("delta_fcn_table_interp_mode");
+    if (delta_fcn_table_interp_mode_str == "LINEAR_TABLE_INTERP")
+    {
+        s_delta_fcn_table_interp_mode = LINEAR_TABLE_INTERP;
+    }
+    else if (delta_fcn_table_interp_mode_str == "CUBIC_TABLE_INTERP")
+    {
+        s_delta_fcn_table_interp_mode = CUBIC_TABLE_INTERP;
+    }
+    else
+    {
+        TBOX_ERROR("LEInteractor::setFromDatabase():\n"
+                   << ":  invalid delta_fcn_table_interp_mode: " << delta_fcn_table_interp_mode_str << ".\n"
+                   << "   Choices are: LINEAR_TABLE_INTERP, CUBIC_TABLE_INTERP.\n");
+    }
+    std::string spread_precision_mode_str = "DOUBLE_PRECISION_SPREAD";
+    if (db->keyExists("spread_precision_mode")) spread_precision_mode_str = db->getString("spread_precision_mode");
+    if (spread_precision_mode_str == "DOUBLE_PRECISION_SPREAD")
+    {
+        s_spread_precision_mode = DOUBLE_PRECISION_SPREAD;
+    }
+    else if (spread_precision_mode_str == "SINGLE_PRECISION_SPREAD")
+    {
+        s_spread_precision_mode = SINGLE_PRECISION_SPREAD;
+    }
+    else
+    {
+        TBOX_ERROR("LEInteractor::setFromDatabase():\n"
+                   << ":  invalid spread_precision_mode: " << spread_precision_mode_str << ".\n"
+                   << "   Choices are: DOUBLE_PRECISION_SPREAD, SINGLE_PRECISION_SPREAD.\n");
+    }
+    return;
+}// setFromDatabase
+
+void
+LEInteractor::printClassData(
+    std::ostream& os)
+{
+    os << "LEInteractor::printClassData():\n";
+    os << "  s_sort_mode = ";
+    if (s_sort_mode == NO_SORT)
+    {
+        os << "NO_SORT";
+    }
+    else if (s_sort_mode == SORT_INCREASING_LAG_IDX)
+    {
+        os << "SORT_INCREASING_LAG_IDX";
+    }
+    else if (s_sort_mode == SORT_DECREASING_LAG_IDX)
+    {
+        os << "SORT_DECREASING_LAG_IDX";
+    }
+    else if (s_sort_mode == SORT_MORTON_ORDER)
+    {
+        os << "SORT_MORTON_ORDER";
+    }
+    else if (s_sort_mode == SORT_HILBERT_ORDER)
+    {
+        os << "SORT_HILBERT_ORDER";
+    }
+    else
+    {
+        os << "UNKNOWN";
+    }
+    os << "\n";
+    os << "  s_spread_threading_mode = ";
+    if (s_spread_threading_mode == SERIAL_SPREAD)
+    {
+        os << "SERIAL_SPREAD";
+    }
+    else if (s_spread_threading_mode == COLORED_TILE_SPREAD)
+    {
+        os << "COLORED_TILE_SPREAD";
+    }
+    else if (s_spread_threading_mode == REDUCTION_BUFFER_SPREAD)
+    {
+        os << "REDUCTION_BUFFER_SPREAD";
+    }
+    else
+    {
+        os << "UNKNOWN";
+    }
+    os << "\n";
+    os << "  s_spread_tile_size = " << s_spread_tile_size << "\n";
+    os << "  s_interp_threading_mode = ";
+    if (s_interp_threading_mode == SERIAL_INTERP)
+    {
+        os << "SERIAL_INTERP";
+    }
+    else if (s_interp_threading_mode == CHUNKED_INTERP)
+    {
+        os << "CHUNKED_INTERP";
+    }
+    else
+    {
+        os << "UNKNOWN";
+    }
+    os << "\n";
+    os << "  s_interp_chunk_size = " << s_interp_chunk_size << "\n";
+    os << "  s_num_threads = " << s_num_threads << "\n";
+    os << "  s_use_templated_kernels = " << s_use_templated_kernels << "\n";
+    os << "  s_delta_fcn_table_resolution = " << s_delta_fcn_table_resolution << "\n";
+    os << "  s_delta_fcn_table_interp_mode = " << (s_delta_fcn_table_interp_mode == CUBIC_TABLE_INTERP ? "CUBIC_TABLE_INTERP" : "LINEAR_TABLE_INTERP") << "\n";
+    os << "  s_spread_precision_mode = ";
+    if (s_spread_precision_mode == DOUBLE_PRECISION_SPREAD)
+    {
+        os << "DOUBLE_PRECISION_SPREAD";
+    }
+    else if (s_spread_precision_mode == SINGLE_PRECISION_SPREAD)
+    {
+        os << "SINGLE_PRECISION_SPREAD";
+    }
+    else
+    {
+        os << "UNKNOWN";
+    }
+    os << "\n";
+    return;
+}// printClassData
+
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+bool
+LEInteractor::isAvailableWeightingFunction(
+    const std::string& weighting_fcn)
+{
+    if (weighting_fcn == "PIECEWISE_CONSTANT") return true;
+#if (NDIM == 2)
+    if (weighting_fcn == "PIECEWISE_LINEAR") return true;
+    if (weighting_fcn == "WIDE4_PIECEWISE_LINEAR") return true;
+    if (weighting_fcn == "PIECEWISE_CUBIC") return true;
+    if (weighting_fcn == "WIDE8_PIECEWISE_CUBIC") return true;
+#endif
+    if (weighting_fcn == "IB_3") return true;
+#if (NDIM == 2)
+    if (weighting_fcn == "WIDE6_IB_3") return true;
+#endif
+    if (weighting_fcn == "IB_4") return true;
+    if (weighting_fcn == "WIDE8_IB_4") return true;
+    if (weighting_fcn == "WIDE16_IB_4") return true;
+    if (weighting_fcn == "IB_6") return true;
+    if (weighting_fcn == "USER_DEFINED") return true;
+    return false;
+}// isAvailableWeightingFunction
+
+int
+LEInteractor::getStencilSize(
+    const std::string& weighting_fcn)
+{
+    if (weighting_fcn == "PIECEWISE_CONSTANT") return 1;
+#if (NDIM == 2)
+    if (weighting_fcn == "PIECEWISE_LINEAR") return 2;
+    if (weighting_fcn == "WIDE4_PIECEWISE_LINEAR") return 4;
+    if (weighting_fcn == "PIECEWISE_CUBIC") return 4;
+    if (weighting_fcn == "WIDE8_PIECEWISE_CUBIC") return 8;
+#endif
+    if (weighting_fcn == "IB_3") return 4;
+#if (NDIM == 2)
+    if (weighting_fcn == "WIDE6_IB_3") return 6;
+#endif
+    if (weighting_fcn == "IB_4") return 4;
+    if (weighting_fcn == "WIDE8_IB_4") return 8;
+    if (weighting_fcn == "WIDE16_IB_4") return 16;
+    if (weighting_fcn == "IB_6") return 6;
+    if (weighting_fcn == "USER_DEFINED") return s_delta_fcn_stencil_size;
+    TBOX_ERROR("LEInteractor::getStencilSize()\n"
+               << "  Unknown weighting function "
+               << weighting_fcn << std::endl);
+    return -1;
+}// getStencilSize
+
+double
+LEInteractor::getC(
+    const std::string& weighting_fcn)
+{
+    if (weighting_fcn == "PIECEWISE_CONSTANT") return 1.0;
+#if (NDIM == 2)
+    if (weighting_fcn == "PIECEWISE_LINEAR" ||
+        weighting_fcn == "WIDE4_PIECEWISE_LINEAR" ||
+        weighting_fcn == "PIECEWISE_CUBIC" ||
+        weighting_fcn == "WIDE8_PIECEWISE_CUBIC")
+    {
+        TBOX_ERROR("LEInteractor::getC()\n"
+                   << "  Weighting function " << weighting_fcn << " does not satisfy the quadratic (sum-of-squares) condition.\n"
+                   << "  Consequently, the value of C = sum_{j} phi(r-j)^2 is dependent on the value of r." << std::endl);
+    }
+#endif
+    if (weighting_fcn == "IB_3") return 0.5;
+#if (NDIM == 2)
+    if (weighting_fcn == "WIDE6_IB_3") return 0.25*getC("IB_3");
+#endif
+    if (weighting_fcn == "IB_4") return 3.0/8.0;
+    if (weighting_fcn == "WIDE8_IB_4") return 0.25*getC("IB_4");
+    if (weighting_fcn == "WIDE16_IB_4") return 0.0625*getC("IB_4");
+    if (weighting_fcn == "IB_6") return 67.0/128.0;
+    if (weighting_fcn == "USER_DEFINED") return s_delta_fcn_C;
+    TBOX_ERROR("LEInteractor::getC()\n"
+               << "  Unknown weighting function "
+               << weighting_fcn << std::endl);
+    return -1;
+}// getC
+
+template<class T>
+void
+LEInteractor::interpolate(
+    Pointer<LData> Q_data,
+    const Pointer<LData> X_data,
+    const Pointer<LIndexSetData<T> > idx_data,
+    const Pointer<CellData<NDIM,double> > q_data,
+    const Pointer<Patch<NDIM> > patch,
+    const Box<NDIM>& interp_box,
+    const IntVector<NDIM>& periodic_shift,
+    const std::string& interp_fcn)
+{
+#ifdef DEBUG_CHECK_ASSERTIONS
+    TBOX_ASSERT(Q_data);
+    TBOX_ASSERT(q_data);
+    TBOX_ASSERT(X_data);
+    TBOX_ASSERT(idx_data);
+    TBOX_ASSERT(patch);
+    TBOX_ASSERT(Q_data->getDepth() == static_cast<unsigned int>(q_data->getDepth()));
+    TBOX_ASSERT(X_data->getDepth() == NDIM);
+#endif
+    interpolate(Q_data->getGhostedLocalFormVecArray()->data(), Q_data->getDepth(),
+                X_data->getGhostedLocalFormVecArray()->data(), X_data->getDepth(),
+                idx_data,
+                q_data,
+                patch, interp_box, periodic_shift, interp_fcn);
+    Q_data->restoreArrays();
+    X_data->restoreArrays();
     return;
 }// interpolate
 
@@ -909,46 +2017,342 @@ LEInteractor::interpolate(
     blitz::TinyVector<int,NDIM> patch_touches_upper_physical_bdry(0);
     for (unsigned int axis = 0; axis < NDIM; ++axis)
     {
-        static const int lower = 0;
-        patch_touches_lower_physical_bdry[axis] = pgeom->getTouchesRegularBoundary(axis,lower);
-        static const int upper = 1;
-        patch_touches_upper_physical_bdry[axis] = pgeom->getTouchesRegularBoundary(axis,upper);
+        static const int lower = 0;
+        patch_touches_lower_physical_bdry[axis] = pgeom->getTouchesRegularBoundary(axis,lower);
+        static const int upper = 1;
+        patch_touches_upper_physical_bdry[axis] = pgeom->getTouchesRegularBoundary(axis,upper);
+    }
+
+    // Generate a list of local indices which lie in the specified box.
+    std::vector<int> local_indices;
+    std::vector<double> periodic_offsets;
+    buildLocalIndices(local_indices, periodic_offsets, interp_box, patch, periodic_shift, idx_data);
+
+    // Interpolate.
+    if (!local_indices.empty())
+    {
+        blitz::TinyVector<double,NDIM> x_lower_axis, x_upper_axis;
+        const int local_sz = (*std::max_element(local_indices.begin(),local_indices.end()))+1;
+        std::vector<double> Q_data_axis(local_sz);
+        for (unsigned int axis = 0; axis < NDIM; ++axis)
+        {
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                x_lower_axis[d] = x_lower[d];
+                x_upper_axis[d] = x_upper[d];
+            }
+            x_lower_axis[axis] -= 0.5*dx[axis];
+            x_upper_axis[axis] += 0.5*dx[axis];
+            interpolate(&Q_data_axis[0], 1, X_data,
+                        q_data->getPointer(axis), SideGeometry<NDIM>::toSideBox(q_data->getBox(), axis), q_data->getGhostCellWidth(), 1,
+                        x_lower_axis.data(), x_upper_axis.data(), dx,
+                        patch_touches_lower_physical_bdry, patch_touches_upper_physical_bdry,
+                        local_indices, periodic_offsets,
+                        interp_fcn);
+            for (unsigned int k = 0; k < local_indices.size(); ++k)
+            {
+                Q_data[NDIM*local_indices[k]+axis] = Q_data_axis[local_indices[k]];
+            }
+        }
+    }
+    return;
+}// interpolate
+
+template<class T>
+void
+LEInteractor::interpolate(
+    const std::vector<Pointer<LData> >& Q_data,
+    const Pointer<LData> X_data,
+    const Pointer<LIndexSetData<T> > idx_data,
+    const std::vector<Pointer<PatchData<NDIM> > >& q_data,
+    const Pointer<Patch<NDIM> > patch,
+    const Box<NDIM>& interp_box,
+    const IntVector<NDIM>& periodic_shift,
+    const std::string& interp_fcn)
+{
+#ifdef DEBUG_CHECK_ASSERTIONS
+    TBOX_ASSERT(X_data);
+    TBOX_ASSERT(idx_data);
+    TBOX_ASSERT(patch);
+    TBOX_ASSERT(X_data->getDepth() == NDIM);
+#endif
+    const unsigned int num_fields = Q_data.size();
+    if (q_data.size() != num_fields)
+    {
+        TBOX_ERROR("LEInteractor::interpolate():\n"
+                   << "  inconsistent numbers of Lagrangian and Eulerian quantities.\n");
+    }
+
+    // Determine the patch geometry.
+    const Pointer<CartesianPatchGeometry<NDIM> > pgeom = patch->getPatchGeometry();
+    const double* const x_lower = pgeom->getXLower();
+    const double* const x_upper = pgeom->getXUpper();
+    const double* const dx = pgeom->getDx();
+    blitz::TinyVector<int,NDIM> patch_touches_lower_physical_bdry(0);
+    blitz::TinyVector<int,NDIM> patch_touches_upper_physical_bdry(0);
+    bool patch_touches_physical_bdry = false;
+    for (unsigned int axis = 0; axis < NDIM; ++axis)
+    {
+        static const int lower = 0;
+        patch_touches_lower_physical_bdry[axis] = pgeom->getTouchesRegularBoundary(axis,lower);
+        static const int upper = 1;
+        patch_touches_upper_physical_bdry[axis] = pgeom->getTouchesRegularBoundary(axis,upper);
+        patch_touches_physical_bdry = patch_touches_physical_bdry || patch_touches_lower_physical_bdry[axis] || patch_touches_upper_physical_bdry[axis];
+    }
+
+    // Generate a list of local indices which lie in the specified box.
+    std::vector<int> local_indices;
+    std::vector<double> periodic_offsets;
+    buildLocalIndices(local_indices, periodic_offsets, interp_box, patch, periodic_shift, idx_data);
+    if (local_indices.empty()) return;
+    const int local_indices_size = local_indices.size();
+
+    // Group the components of the Eulerian quantities by data layout.
+    const double* const X = X_data->getGhostedLocalFormVecArray()->data();
+    std::vector<InterpComponentGroup> groups;
+    for (unsigned int k = 0; k < num_fields; ++k)
+    {
+#ifdef DEBUG_CHECK_ASSERTIONS
+        TBOX_ASSERT(Q_data[k]);
+        TBOX_ASSERT(q_data[k]);
+#endif
+        double* const Q = Q_data[k]->getGhostedLocalFormVecArray()->data();
+        const int Q_depth = Q_data[k]->getDepth();
+        const Pointer<CellData<NDIM,double> > q_cc_data = q_data[k];
+        const Pointer<NodeData<NDIM,double> > q_nc_data = q_data[k];
+        const Pointer<SideData<NDIM,double> > q_sc_data = q_data[k];
+        blitz::TinyVector<double,NDIM> x_lower_k, x_upper_k;
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            x_lower_k[d] = x_lower[d];
+            x_upper_k[d] = x_upper[d];
+        }
+        if (q_cc_data)
+        {
+            if (Q_depth != q_cc_data->getDepth())
+            {
+                TBOX_ERROR("LEInteractor::interpolate():\n"
+                           << "  inconsistent Lagrangian and Eulerian data depths.\n");
+            }
+            const InterpComponent component = {Q, Q_depth, q_cc_data->getPointer(), Q_depth};
+            add_interp_component(groups, q_cc_data->getBox(), q_cc_data->getGhostCellWidth(), x_lower_k, x_upper_k, component);
+        }
+        else if (q_nc_data)
+        {
+            if (Q_depth != q_nc_data->getDepth())
+            {
+                TBOX_ERROR("LEInteractor::interpolate():\n"
+                           << "  inconsistent Lagrangian and Eulerian data depths.\n");
+            }
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                x_lower_k[d] -= 0.5*dx[d];
+                x_upper_k[d] += 0.5*dx[d];
+            }
+            const InterpComponent component = {Q, Q_depth, q_nc_data->getPointer(), Q_depth};
+            add_interp_component(groups, NodeGeometry<NDIM>::toNodeBox(q_nc_data->getBox()), q_nc_data->getGhostCellWidth(), x_lower_k, x_upper_k, component);
+        }
+        else if (q_sc_data)
+        {
+            if (Q_depth != NDIM || q_sc_data->getDepth() != 1)
+            {
+                TBOX_ERROR("LEInteractor::interpolate():\n"
+                           << "  side-centered interpolation requires vector-valued data.\n");
+            }
+            for (unsigned int axis = 0; axis < NDIM; ++axis)
+            {
+                blitz::TinyVector<double,NDIM> x_lower_axis(x_lower_k), x_upper_axis(x_upper_k);
+                x_lower_axis[axis] -= 0.5*dx[axis];
+                x_upper_axis[axis] += 0.5*dx[axis];
+                const InterpComponent component = {Q+axis, NDIM, q_sc_data->getPointer(axis), 1};
+                add_interp_component(groups, SideGeometry<NDIM>::toSideBox(q_sc_data->getBox(), axis), q_sc_data->getGhostCellWidth(), x_lower_axis, x_upper_axis, component);
+            }
+        }
+        else
+        {
+            TBOX_ERROR("LEInteractor::interpolate():\n"
+                       << "  unsupported Eulerian data centering.\n");
+        }
+    }
+
+    // Interpolate.
+    const bool use_fused_kernels = s_use_templated_kernels && has_templated_kernel(interp_fcn, patch_touches_physical_bdry);
+    for (std::vector<InterpComponentGroup>::const_iterator it = groups.begin(); it != groups.end(); ++it)
+    {
+        const InterpComponentGroup& group = *it;
+        if (use_fused_kernels)
+        {
+            const IntVector<NDIM>& ilower = group.q_data_box.lower();
+            const IntVector<NDIM>& iupper = group.q_data_box.upper();
+#ifdef _OPENMP
+            const int chunk_size = std::max(s_interp_chunk_size,1);
+            const int num_chunks = (local_indices_size+chunk_size-1)/chunk_size;
+            const int num_threads = get_num_threads();
+            if (s_interp_threading_mode == CHUNKED_INTERP && num_threads > 1 && num_chunks > 1)
+            {
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic,1)
+                for (int k = 0; k < num_chunks; ++k)
+                {
+                    const int l_start = k*chunk_size;
+                    const int l_stop = std::min(l_start+chunk_size,local_indices_size);
+                    templated_interpolate_components(interp_fcn, patch_touches_physical_bdry,
+                                                     group.components, X,
+                                                     ilower, iupper, group.q_gcw,
+                                                     group.x_lower.data(), dx,
+                                                     &local_indices[l_start], &periodic_offsets[NDIM*l_start], l_stop-l_start);
+                }
+                continue;
+            }
+#endif
+            templated_interpolate_components(interp_fcn, patch_touches_physical_bdry,
+                                             group.components, X,
+                                             ilower, iupper, group.q_gcw,
+                                             group.x_lower.data(), dx,
+                                             &local_indices[0], &periodic_offsets[0], local_indices_size);
+        }
+        else
+        {
+            std::vector<double> Q_component;
+            for (std::vector<InterpComponent>::const_iterator cit = group.components.begin(); cit != group.components.end(); ++cit)
+            {
+                const InterpComponent& component = *cit;
+                if (component.Q_stride == component.depth)
+                {
+                    interpolate(component.Q, component.depth, X,
+                                component.q, group.q_data_box, group.q_gcw, component.depth,
+                                group.x_lower.data(), group.x_upper.data(), dx,
+                                patch_touches_lower_physical_bdry, patch_touches_upper_physical_bdry,
+                                local_indices, periodic_offsets,
+                                interp_fcn);
+                }
+                else
+                {
+                    const int local_sz = (*std::max_element(local_indices.begin(),local_indices.end()))+1;
+                    Q_component.resize(component.depth*local_sz);
+                    interpolate(&Q_component[0], component.depth, X,
+                                component.q, group.q_data_box, group.q_gcw, component.depth,
+                                group.x_lower.data(), group.x_upper.data(), dx,
+                                patch_touches_lower_physical_bdry, patch_touches_upper_physical_bdry,
+                                local_indices, periodic_offsets,
+                                interp_fcn);
+                    for (unsigned int l = 0; l < local_indices.size(); ++l)
+                    {
+                        const int s = local_indices[l];
+                        for (int d = 0; d < component.depth; ++d)
+                        {
+                            component.Q[d+s*component.Q_stride] = Q_component[d+s*component.depth];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    for (unsigned int k = 0; k < num_fields; ++k)
+    {
+        Q_data[k]->restoreArrays();
+    }
+    X_data->restoreArrays();
+    return;
+}// interpolate
+
+template<class T>
+bool
+LEInteractor::buildOperator(
+    std::vector<CSROperator>& ops,
+    const double* const X_data,
+    const int X_depth,
+    const Pointer<LIndexSetData<T> > idx_data,
+    const Pointer<PatchData<NDIM> > q_data,
+    const Pointer<Patch<NDIM> > patch,
+    const Box<NDIM>& box,
+    const IntVector<NDIM>& periodic_shift,
+    const std::string& weighting_fcn)
+{
+#ifdef DEBUG_CHECK_ASSERTIONS
+    TBOX_ASSERT(q_data);
+    TBOX_ASSERT(idx_data);
+    TBOX_ASSERT(patch);
+    TBOX_ASSERT(X_depth == NDIM);
+#else
+    NULL_USE(X_depth);
+#endif
+    ops.clear();
+
+    // The explicit operators reproduce the templated kernels, and so they are
+    // not used when the Fortran kernels have been requested.
+    if (!s_use_templated_kernels) return false;
+
+    // Determine the patch geometry.
+    const Pointer<CartesianPatchGeometry<NDIM> > pgeom = patch->getPatchGeometry();
+    const double* const x_lower = pgeom->getXLower();
+    const double* const dx = pgeom->getDx();
+    bool patch_touches_physical_bdry = false;
+    for (unsigned int axis = 0; axis < NDIM; ++axis)
+    {
+        static const int lower = 0;
+        static const int upper = 1;
+        patch_touches_physical_bdry = patch_touches_physical_bdry || pgeom->getTouchesRegularBoundary(axis,lower) || pgeom->getTouchesRegularBoundary(axis,upper);
+    }
+    if (!has_templated_kernel(weighting_fcn, patch_touches_physical_bdry)) return false;
+
+    // Determine the data layout.
+    const Pointer<CellData<NDIM,double> > q_cc_data = q_data;
+    const Pointer<NodeData<NDIM,double> > q_nc_data = q_data;
+    const Pointer<SideData<NDIM,double> > q_sc_data = q_data;
+    std::vector<Box<NDIM> > data_boxes;
+    std::vector<blitz::TinyVector<double,NDIM> > x_lower_shifted;
+    blitz::TinyVector<double,NDIM> x_lower_cell;
+    for (unsigned int d = 0; d < NDIM; ++d) x_lower_cell[d] = x_lower[d];
+    if (q_cc_data)
+    {
+        data_boxes.push_back(q_cc_data->getBox());
+        x_lower_shifted.push_back(x_lower_cell);
+    }
+    else if (q_nc_data)
+    {
+        data_boxes.push_back(NodeGeometry<NDIM>::toNodeBox(q_nc_data->getBox()));
+        x_lower_shifted.push_back(x_lower_cell);
+        for (unsigned int d = 0; d < NDIM; ++d) x_lower_shifted.back()[d] -= 0.5*dx[d];
+    }
+    else if (q_sc_data)
+    {
+        for (unsigned int axis = 0; axis < NDIM; ++axis)
+        {
+            data_boxes.push_back(SideGeometry<NDIM>::toSideBox(q_sc_data->getBox(), axis));
+            x_lower_shifted.push_back(x_lower_cell);
+            x_lower_shifted.back()[axis] -= 0.5*dx[axis];
+        }
+    }
+    else
+    {
+        TBOX_ERROR("LEInteractor::buildOperator():\n"
+                   << "  unsupported Eulerian data centering.\n");
     }
 
     // Generate a list of local indices which lie in the specified box.
     std::vector<int> local_indices;
     std::vector<double> periodic_offsets;
-    buildLocalIndices(local_indices, periodic_offsets, interp_box, patch, periodic_shift, idx_data);
+    buildLocalIndices(local_indices, periodic_offsets, box, patch, periodic_shift, idx_data);
+    const int local_indices_size = local_indices.size();
 
-    // Interpolate.
-    if (!local_indices.empty())
+    // Build the operators.
+    ops.resize(data_boxes.size());
+    for (unsigned int k = 0; k < ops.size(); ++k)
     {
-        blitz::TinyVector<double,NDIM> x_lower_axis, x_upper_axis;
-        const int local_sz = (*std::max_element(local_indices.begin(),local_indices.end()))+1;
-        std::vector<double> Q_data_axis(local_sz);
-        for (unsigned int axis = 0; axis < NDIM; ++axis)
-        {
-            for (unsigned int d = 0; d < NDIM; ++d)
-            {
-                x_lower_axis[d] = x_lower[d];
-                x_upper_axis[d] = x_upper[d];
-            }
-            x_lower_axis[axis] -= 0.5*dx[axis];
-            x_upper_axis[axis] += 0.5*dx[axis];
-            interpolate(&Q_data_axis[0], 1, X_data,
-                        q_data->getPointer(axis), SideGeometry<NDIM>::toSideBox(q_data->getBox(), axis), q_data->getGhostCellWidth(), 1,
-                        x_lower_axis.data(), x_upper_axis.data(), dx,
-                        patch_touches_lower_physical_bdry, patch_touches_upper_physical_bdry,
-                        local_indices, periodic_offsets,
-                        interp_fcn);
-            for (unsigned int k = 0; k < local_indices.size(); ++k)
-            {
-                Q_data[NDIM*local_indices[k]+axis] = Q_data_axis[local_indices[k]];
-            }
-        }
+        CSROperator& op = ops[k];
+        op.data_box = data_boxes[k];
+        op.gcw = q_data->getGhostCellWidth();
+        op.row_ptr.assign(1,0);
+        op.node_idxs.reserve(local_indices_size);
+        op.row_ptr.reserve(local_indices_size+1);
+        if (local_indices_size == 0) continue;
+        templated_build_operator(weighting_fcn, patch_touches_physical_bdry, op, X_data,
+                                 op.data_box.lower(), op.data_box.upper(), op.gcw,
+                                 x_lower_shifted[k].data(), dx,
+                                 &local_indices[0], &periodic_offsets[0], local_indices_size);
     }
-    return;
-}// interpolate
+    return true;
+}// buildOperator
 
 void
 LEInteractor::interpolate(
@@ -1743,6 +3147,114 @@ LEInteractor::spread(
     return;
 }// spread
 
+void
+LEInteractor::applyInterpolationOperator(
+    double* const Q_data,
+    const int Q_depth,
+    const std::vector<CSROperator>& ops,
+    const Pointer<PatchData<NDIM> > q_data)
+{
+    const Pointer<CellData<NDIM,double> > q_cc_data = q_data;
+    const Pointer<NodeData<NDIM,double> > q_nc_data = q_data;
+    const Pointer<SideData<NDIM,double> > q_sc_data = q_data;
+    const bool is_side_centered = !q_sc_data.isNull();
+    const int q_depth = (q_cc_data ? q_cc_data->getDepth() : q_nc_data ? q_nc_data->getDepth() : q_sc_data ? q_sc_data->getDepth() : 0);
+    if (( is_side_centered && (Q_depth != NDIM || q_depth != 1 || ops.size() != NDIM)) ||
+        (!is_side_centered && (Q_depth != q_depth || ops.size() != 1)))
+    {
+        TBOX_ERROR("LEInteractor::applyInterpolationOperator():\n"
+                   << "  operator is inconsistent with the Eulerian or Lagrangian data.\n");
+    }
+    for (unsigned int k = 0; k < ops.size(); ++k)
+    {
+        const CSROperator& op = ops[k];
+#ifdef DEBUG_CHECK_ASSERTIONS
+        TBOX_ASSERT(op.gcw == q_data->getGhostCellWidth());
+#endif
+        const double* const q = (q_cc_data ? q_cc_data->getPointer() : q_nc_data ? q_nc_data->getPointer() : q_sc_data->getPointer(k));
+        const int depth = (is_side_centered ? 1 : q_depth);
+        const int stride = (is_side_centered ? NDIM : Q_depth);
+        double* const Q = Q_data+(is_side_centered ? k : 0);
+        const int q_depth_stride = Box<NDIM>::grow(op.data_box, op.gcw).size();
+        const int num_rows = op.node_idxs.size();
+#ifdef _OPENMP
+        const int num_threads = get_num_threads();
+#pragma omp parallel for num_threads(num_threads) schedule(static) if (s_interp_threading_mode == CHUNKED_INTERP && num_threads > 1 && num_rows > s_interp_chunk_size)
+#endif
+        for (int r = 0; r < num_rows; ++r)
+        {
+            const int s = op.node_idxs[r];
+            for (int d = 0; d < depth; ++d)
+            {
+                const double* const q_d = q+q_depth_stride*d;
+                double Q_ds = 0.0;
+                for (int j = op.row_ptr[r]; j < op.row_ptr[r+1]; ++j)
+                {
+                    Q_ds += op.weights[j]*q_d[op.offsets[j]];
+                }
+                Q[d+s*stride] = Q_ds;
+            }
+        }
+    }
+    return;
+}// applyInterpolationOperator
+
+void
+LEInteractor::applySpreadingOperator(
+    const Pointer<PatchData<NDIM> > q_data,
+    const std::vector<CSROperator>& ops,
+    const double* const Q_data,
+    const int Q_depth,
+    const Pointer<Patch<NDIM> > patch)
+{
+    const Pointer<CellData<NDIM,double> > q_cc_data = q_data;
+    const Pointer<NodeData<NDIM,double> > q_nc_data = q_data;
+    const Pointer<SideData<NDIM,double> > q_sc_data = q_data;
+    const bool is_side_centered = !q_sc_data.isNull();
+    const int q_depth = (q_cc_data ? q_cc_data->getDepth() : q_nc_data ? q_nc_data->getDepth() : q_sc_data ? q_sc_data->getDepth() : 0);
+    if (( is_side_centered && (Q_depth != NDIM || q_depth != 1 || ops.size() != NDIM)) ||
+        (!is_side_centered && (Q_depth != q_depth || ops.size() != 1)))
+    {
+        TBOX_ERROR("LEInteractor::applySpreadingOperator():\n"
+                   << "  operator is inconsistent with the Eulerian or Lagrangian data.\n");
+    }
+    const Pointer<CartesianPatchGeometry<NDIM> > pgeom = patch->getPatchGeometry();
+    const double* const dx = pgeom->getDx();
+#if (NDIM == 2)
+    const double dV_c = dx[0]*dx[1];
+#endif
+#if (NDIM == 3)
+    const double dV_c = dx[0]*dx[1]*dx[2];
+#endif
+    for (unsigned int k = 0; k < ops.size(); ++k)
+    {
+        const CSROperator& op = ops[k];
+#ifdef DEBUG_CHECK_ASSERTIONS
+        TBOX_ASSERT(op.gcw == q_data->getGhostCellWidth());
+#endif
+        double* const q = (q_cc_data ? q_cc_data->getPointer() : q_nc_data ? q_nc_data->getPointer() : q_sc_data->getPointer(k));
+        const int depth = (is_side_centered ? 1 : q_depth);
+        const int stride = (is_side_centered ? NDIM : Q_depth);
+        const double* const Q = Q_data+(is_side_centered ? k : 0);
+        const int q_depth_stride = Box<NDIM>::grow(op.data_box, op.gcw).size();
+        const int num_rows = op.node_idxs.size();
+        for (int r = 0; r < num_rows; ++r)
+        {
+            const int s = op.node_idxs[r];
+            for (int d = 0; d < depth; ++d)
+            {
+                double* const q_d = q+q_depth_stride*d;
+                const double Q_ds = Q[d+s*stride];
+                for (int j = op.row_ptr[r]; j < op.row_ptr[r+1]; ++j)
+                {
+                    q_d[op.offsets[j]] += op.weights[j]*Q_ds/dV_c;
+                }
+            }
+        }
+    }
+    return;
+}// applySpreadingOperator
+
 /////////////////////////////// PROTECTED ////////////////////////////////////
 
 /////////////////////////////// PRIVATE //////////////////////////////////////
@@ -1766,9 +3278,76 @@ LEInteractor::interpolate(
     const std::string& interp_fcn)
 {
     if (local_indices.empty()) return;
+    if (interp_fcn == "USER_DEFINED") update_delta_fcn_table();
     const int local_indices_size = local_indices.size();
+#ifdef _OPENMP
+    // Each marker is written by exactly one chunk, so that the chunks may be
+    // processed concurrently without synchronization, and the result is
+    // independent of the number of threads.
+    const int chunk_size = std::max(s_interp_chunk_size,1);
+    const int num_chunks = (local_indices_size+chunk_size-1)/chunk_size;
+    const int num_threads = get_num_threads();
+    if (s_interp_threading_mode == CHUNKED_INTERP && num_threads > 1 && num_chunks > 1)
+    {
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic,1)
+        for (int k = 0; k < num_chunks; ++k)
+        {
+            const int l_start = k*chunk_size;
+            const int l_stop = std::min(l_start+chunk_size,local_indices_size);
+            interpolateKernel(Q_data, Q_depth, X_data,
+                              q_data, q_data_box, q_gcw, q_depth,
+                              x_lower, x_upper, dx,
+                              patch_touches_lower_physical_bdry, patch_touches_upper_physical_bdry,
+                              &local_indices[l_start], &periodic_offsets[NDIM*l_start], l_stop-l_start,
+                              interp_fcn);
+        }
+        return;
+    }
+#endif
+    interpolateKernel(Q_data, Q_depth, X_data,
+                      q_data, q_data_box, q_gcw, q_depth,
+                      x_lower, x_upper, dx,
+                      patch_touches_lower_physical_bdry, patch_touches_upper_physical_bdry,
+                      &local_indices[0], &periodic_offsets[0], local_indices_size,
+                      interp_fcn);
+    return;
+}// interpolate
+
+void
+LEInteractor::interpolateKernel(
+    double* const Q_data,
+    const int Q_depth,
+    const double* const X_data,
+    const double* const q_data,
+    const Box<NDIM>& q_data_box,
+    const IntVector<NDIM>& q_gcw,
+    const int q_depth,
+    const double* const x_lower,
+    const double* const x_upper,
+    const double* const dx,
+    const blitz::TinyVector<int,NDIM>& patch_touches_lower_physical_bdry,
+    const blitz::TinyVector<int,NDIM>& patch_touches_upper_physical_bdry,
+    const int* const local_indices,
+    const double* const periodic_offsets,
+    const int local_indices_size,
+    const std::string& interp_fcn)
+{
+    if (local_indices_size == 0) return;
     const IntVector<NDIM>& ilower = q_data_box.lower();
     const IntVector<NDIM>& iupper = q_data_box.upper();
+    if (s_use_templated_kernels)
+    {
+        bool patch_touches_physical_bdry = false;
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            patch_touches_physical_bdry = patch_touches_physical_bdry || patch_touches_lower_physical_bdry[d] || patch_touches_upper_physical_bdry[d];
+        }
+        if (templated_interpolate(interp_fcn, patch_touches_physical_bdry,
+                                  Q_data, X_data,
+                                  q_data, ilower, iupper, q_gcw, q_depth,
+                                  x_lower, dx,
+                                  local_indices, periodic_offsets, local_indices_size)) return;
+    }
     if (interp_fcn == "PIECEWISE_CONSTANT")
     {
         LAGRANGIAN_PIECEWISE_CONSTANT_INTERP_FC(
@@ -1782,7 +3361,7 @@ LEInteractor::interpolate(
             q_gcw(0),q_gcw(1),q_gcw(2),
 #endif
             q_data,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data, Q_data);
     }
     else if (interp_fcn == "PIECEWISE_LINEAR")
@@ -1799,7 +3378,7 @@ LEInteractor::interpolate(
             q_gcw(0),q_gcw(1),q_gcw(2),
 #endif
             q_data,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data,Q_data);
 #else
         TBOX_ERROR("LEInteractor::interpolate()\n" <<
@@ -1820,7 +3399,7 @@ LEInteractor::interpolate(
             q_gcw(0),q_gcw(1),q_gcw(2),
 #endif
             q_data,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data,Q_data);
 #else
         TBOX_ERROR("LEInteractor::interpolate()\n" <<
@@ -1841,7 +3420,7 @@ LEInteractor::interpolate(
             q_gcw(0),q_gcw(1),q_gcw(2),
 #endif
             q_data,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data,Q_data);
 #else
         TBOX_ERROR("LEInteractor::interpolate()\n" <<
@@ -1862,7 +3441,7 @@ LEInteractor::interpolate(
             q_gcw(0),q_gcw(1),q_gcw(2),
 #endif
             q_data,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data,Q_data);
 #else
         TBOX_ERROR("LEInteractor::interpolate()\n" <<
@@ -1882,7 +3461,7 @@ LEInteractor::interpolate(
             q_gcw(0),q_gcw(1),q_gcw(2),
 #endif
             q_data,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data,Q_data);
     }
     else if (interp_fcn == "WIDE6_IB_3")
@@ -1899,7 +3478,7 @@ LEInteractor::interpolate(
             q_gcw(0),q_gcw(1),q_gcw(2),
 #endif
             q_data,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data,Q_data);
 #else
         TBOX_ERROR("LEInteractor::interpolate()\n" <<
@@ -1923,7 +3502,7 @@ LEInteractor::interpolate(
             q_gcw(0),q_gcw(1),q_gcw(2),
 #endif
             q_data,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data,Q_data);
     }
     else if (interp_fcn == "WIDE8_IB_4")
@@ -1939,7 +3518,7 @@ LEInteractor::interpolate(
             q_gcw(0),q_gcw(1),q_gcw(2),
 #endif
             q_data,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data,Q_data);
     }
     else if (interp_fcn == "WIDE16_IB_4")
@@ -1955,7 +3534,7 @@ LEInteractor::interpolate(
             q_gcw(0),q_gcw(1),q_gcw(2),
 #endif
             q_data,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data,Q_data);
     }
     else if (interp_fcn == "IB_6")
@@ -1975,16 +3554,19 @@ LEInteractor::interpolate(
             q_gcw(0),q_gcw(1),q_gcw(2),
 #endif
             q_data,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data,Q_data);
     }
     else if (interp_fcn == "USER_DEFINED")
     {
+        if (Q_depth == q_depth &&
+            tabulated_interpolate_or_spread(false, Q_data, X_data, q_data, ilower, iupper, q_gcw, q_depth,
+                                            x_lower, dx, local_indices, periodic_offsets, local_indices_size)) return;
         userDefinedInterpolate(
             Q_data, Q_depth, X_data,
             q_data, q_data_box, q_gcw, q_depth,
             x_lower, x_upper, dx,
-            &local_indices[0], &periodic_offsets[0], local_indices_size);
+            local_indices, periodic_offsets, local_indices_size);
     }
     else
     {
@@ -1993,7 +3575,7 @@ LEInteractor::interpolate(
                    << interp_fcn << std::endl);
     }
     return;
-}// interpolate
+}// interpolateKernel
 
 void
 LEInteractor::spread(
@@ -2014,14 +3596,94 @@ LEInteractor::spread(
     const std::string& spread_fcn)
 {
     if (local_indices.empty()) return;
-    const int local_indices_size = local_indices.size();
+    if (spread_fcn == "USER_DEFINED") update_delta_fcn_table();
+    if (s_use_templated_kernels && s_spread_precision_mode != DOUBLE_PRECISION_SPREAD)
+    {
+        bool patch_touches_physical_bdry = false;
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            patch_touches_physical_bdry = patch_touches_physical_bdry || patch_touches_lower_physical_bdry[d] || patch_touches_upper_physical_bdry[d];
+        }
+        const IntVector<NDIM>& ilower = q_data_box.lower();
+        const IntVector<NDIM>& iupper = q_data_box.upper();
+        if (s_spread_precision_mode == SINGLE_PRECISION_SPREAD &&
+            single_precision_spread(spread_fcn, patch_touches_physical_bdry,
+                                    q_data, X_data, Q_data,
+                                    ilower, iupper, q_gcw, q_depth,
+                                    x_lower, dx,
+                                    &local_indices[0], &periodic_offsets[0], local_indices.size())) return;
+    }
+#ifdef _OPENMP
+    if (s_spread_threading_mode == COLORED_TILE_SPREAD)
+    {
+        coloredTileSpread(q_data, q_data_box, q_gcw, q_depth,
+                          Q_data, Q_depth, X_data,
+                          x_lower, x_upper, dx,
+                          patch_touches_lower_physical_bdry, patch_touches_upper_physical_bdry,
+                          local_indices, periodic_offsets,
+                          spread_fcn);
+        return;
+    }
+    if (s_spread_threading_mode == REDUCTION_BUFFER_SPREAD && get_num_threads() > 1)
+    {
+        reductionBufferSpread(q_data, q_data_box, q_gcw, q_depth,
+                              Q_data, Q_depth, X_data,
+                              x_lower, x_upper, dx,
+                              patch_touches_lower_physical_bdry, patch_touches_upper_physical_bdry,
+                              local_indices, periodic_offsets,
+                              spread_fcn);
+        return;
+    }
+#endif
+    spreadKernel(q_data, q_data_box, q_gcw, q_depth,
+                 Q_data, Q_depth, X_data,
+                 x_lower, x_upper, dx,
+                 patch_touches_lower_physical_bdry, patch_touches_upper_physical_bdry,
+                 &local_indices[0], &periodic_offsets[0], local_indices.size(),
+                 spread_fcn);
+    return;
+}// spread
+
+void
+LEInteractor::spreadKernel(
+    double* const q_data,
+    const Box<NDIM>& q_data_box,
+    const IntVector<NDIM>& q_gcw,
+    const int q_depth,
+    const double* const Q_data,
+    const int Q_depth,
+    const double* const X_data,
+    const double* const x_lower,
+    const double* const x_upper,
+    const double* const dx,
+    const blitz::TinyVector<int,NDIM>& patch_touches_lower_physical_bdry,
+    const blitz::TinyVector<int,NDIM>& patch_touches_upper_physical_bdry,
+    const int* const local_indices,
+    const double* const periodic_offsets,
+    const int local_indices_size,
+    const std::string& spread_fcn)
+{
+    if (local_indices_size == 0) return;
     const IntVector<NDIM>& ilower = q_data_box.lower();
     const IntVector<NDIM>& iupper = q_data_box.upper();
+    if (s_use_templated_kernels)
+    {
+        bool patch_touches_physical_bdry = false;
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            patch_touches_physical_bdry = patch_touches_physical_bdry || patch_touches_lower_physical_bdry[d] || patch_touches_upper_physical_bdry[d];
+        }
+        if (templated_spread(spread_fcn, patch_touches_physical_bdry,
+                             q_data, X_data,
+                             Q_data, ilower, iupper, q_gcw, q_depth,
+                             x_lower, dx,
+                             local_indices, periodic_offsets, local_indices_size)) return;
+    }
     if (spread_fcn == "PIECEWISE_CONSTANT")
     {
         LAGRANGIAN_PIECEWISE_CONSTANT_SPREAD_FC(
             dx,x_lower,x_upper,q_depth,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data, Q_data,
 #if (NDIM == 2)
             ilower(0),iupper(0),ilower(1),iupper(1),
@@ -2038,7 +3700,7 @@ LEInteractor::spread(
 #if (NDIM == 2)
         LAGRANGIAN_PIECEWISE_LINEAR_SPREAD_FC(
             dx,x_lower,x_upper,q_depth,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data, Q_data,
 #if (NDIM == 2)
             ilower(0),iupper(0),ilower(1),iupper(1),
@@ -2059,7 +3721,7 @@ LEInteractor::spread(
 #if (NDIM == 2)
         LAGRANGIAN_WIDE4_PIECEWISE_LINEAR_SPREAD_FC(
             dx,x_lower,x_upper,q_depth,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data, Q_data,
 #if (NDIM == 2)
             ilower(0),iupper(0),ilower(1),iupper(1),
@@ -2080,7 +3742,7 @@ LEInteractor::spread(
 #if (NDIM == 2)
         LAGRANGIAN_PIECEWISE_CUBIC_SPREAD_FC(
             dx,x_lower,x_upper,q_depth,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data, Q_data,
 #if (NDIM == 2)
             ilower(0),iupper(0),ilower(1),iupper(1),
@@ -2101,7 +3763,7 @@ LEInteractor::spread(
 #if (NDIM == 2)
         LAGRANGIAN_WIDE8_PIECEWISE_CUBIC_SPREAD_FC(
             dx,x_lower,x_upper,q_depth,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data, Q_data,
 #if (NDIM == 2)
             ilower(0),iupper(0),ilower(1),iupper(1),
@@ -2121,7 +3783,7 @@ LEInteractor::spread(
     {
         LAGRANGIAN_IB_3_SPREAD_FC(
             dx,x_lower,x_upper,q_depth,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data, Q_data,
 #if (NDIM == 2)
             ilower(0),iupper(0),ilower(1),iupper(1),
@@ -2138,7 +3800,7 @@ LEInteractor::spread(
 #if (NDIM == 2)
         LAGRANGIAN_WIDE6_IB_3_SPREAD_FC(
             dx,x_lower,x_upper,q_depth,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data, Q_data,
 #if (NDIM == 2)
             ilower(0),iupper(0),ilower(1),iupper(1),
@@ -2158,7 +3820,7 @@ LEInteractor::spread(
     {
         LAGRANGIAN_IB_4_SPREAD_FC(
             dx,x_lower,x_upper,q_depth,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data, Q_data,
 #if (NDIM == 2)
             ilower(0),iupper(0),ilower(1),iupper(1),
@@ -2178,7 +3840,7 @@ LEInteractor::spread(
     {
         LAGRANGIAN_WIDE8_IB_4_SPREAD_FC(
             dx,x_lower,x_upper,q_depth,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data, Q_data,
 #if (NDIM == 2)
             ilower(0),iupper(0),ilower(1),iupper(1),
@@ -2194,7 +3856,7 @@ LEInteractor::spread(
     {
         LAGRANGIAN_WIDE16_IB_4_SPREAD_FC(
             dx,x_lower,x_upper,q_depth,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data, Q_data,
 #if (NDIM == 2)
             ilower(0),iupper(0),ilower(1),iupper(1),
@@ -2210,7 +3872,7 @@ LEInteractor::spread(
     {
         LAGRANGIAN_IB_6_SPREAD_FC(
             dx,x_lower,x_upper,q_depth,
-            &local_indices[0], &periodic_offsets[0], local_indices_size,
+            local_indices, periodic_offsets, local_indices_size,
             X_data,Q_data,
 #if (NDIM == 2)
             ilower(0),iupper(0),ilower(1),iupper(1),
@@ -2228,11 +3890,14 @@ LEInteractor::spread(
     }
     else if (spread_fcn == "USER_DEFINED")
     {
+        if (Q_depth == q_depth &&
+            tabulated_interpolate_or_spread(true, q_data, X_data, Q_data, ilower, iupper, q_gcw, q_depth,
+                                            x_lower, dx, local_indices, periodic_offsets, local_indices_size)) return;
         userDefinedSpread(
             q_data, q_data_box, q_gcw, q_depth,
             x_lower, x_upper, dx,
             Q_data, Q_depth, X_data,
-            &local_indices[0], &periodic_offsets[0], local_indices_size);
+            local_indices, periodic_offsets, local_indices_size);
     }
     else
     {
@@ -2241,7 +3906,179 @@ LEInteractor::spread(
                    << spread_fcn << std::endl);
     }
     return;
-}// spread
+}// spreadKernel
+
+#ifdef _OPENMP
+void
+LEInteractor::coloredTileSpread(
+    double* const q_data,
+    const Box<NDIM>& q_data_box,
+    const IntVector<NDIM>& q_gcw,
+    const int q_depth,
+    const double* const Q_data,
+    const int Q_depth,
+    const double* const X_data,
+    const double* const x_lower,
+    const double* const x_upper,
+    const double* const dx,
+    const blitz::TinyVector<int,NDIM>& patch_touches_lower_physical_bdry,
+    const blitz::TinyVector<int,NDIM>& patch_touches_upper_physical_bdry,
+    const std::vector<int>& local_indices,
+    const std::vector<double>& periodic_offsets,
+    const std::string& spread_fcn)
+{
+    const int num_local_indices = local_indices.size();
+
+    // The tiles must be wider than the stencil so that the stencils of markers
+    // in distinct tiles of the same color cannot overlap.
+    const int tile_size = std::max(s_spread_tile_size, getStencilSize(spread_fcn)+1);
+    blitz::TinyVector<int,NDIM> num_tiles;
+    int total_num_tiles = 1;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        num_tiles[d] = (q_data_box.numberCells(d)+2*q_gcw(d)-1)/tile_size+1;
+        total_num_tiles *= num_tiles[d];
+    }
+
+    // Determine the tile containing each marker.  Markers that lie outside of
+    // the ghost box are assigned to the nearest tile.
+    std::vector<int> marker_tile(num_local_indices);
+    std::vector<int> tile_offset(total_num_tiles+1,0);
+    for (int l = 0; l < num_local_indices; ++l)
+    {
+        const int s = local_indices[l];
+        int t = 0;
+        for (int d = NDIM-1; d >= 0; --d)
+        {
+            const int ic = static_cast<int>(std::floor((X_data[d+s*NDIM]+periodic_offsets[d+l*NDIM]-x_lower[d])/dx[d]))+q_gcw(d);
+            const int it = std::min(std::max(ic,0)/tile_size,num_tiles[d]-1);
+            t = it+num_tiles[d]*t;
+        }
+        marker_tile[l] = t;
+        ++tile_offset[t+1];
+    }
+    for (int t = 0; t < total_num_tiles; ++t)
+    {
+        tile_offset[t+1] += tile_offset[t];
+    }
+
+    // Sort the markers by tile.  The relative order of the markers within each
+    // tile is preserved.
+    std::vector<int> tile_local_indices(num_local_indices);
+    std::vector<double> tile_periodic_offsets(NDIM*num_local_indices);
+    std::vector<int> tile_pos(tile_offset.begin(), tile_offset.end()-1);
+    for (int l = 0; l < num_local_indices; ++l)
+    {
+        const int k = tile_pos[marker_tile[l]]++;
+        tile_local_indices[k] = local_indices[l];
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            tile_periodic_offsets[d+k*NDIM] = periodic_offsets[d+l*NDIM];
+        }
+    }
+
+    // Color the nonempty tiles by the parity of the tile index.
+    static const int num_colors = 1 << NDIM;
+    std::vector<std::vector<int> > color_tiles(num_colors);
+    for (int t = 0; t < total_num_tiles; ++t)
+    {
+        if (tile_offset[t+1] == tile_offset[t]) continue;
+        int color = 0;
+        for (unsigned int d = 0, r = t; d < NDIM; ++d)
+        {
+            color += ((r%num_tiles[d])%2) << d;
+            r /= num_tiles[d];
+        }
+        color_tiles[color].push_back(t);
+    }
+
+    // Spread the markers in each color concurrently, one color at a time.
+    const int num_threads = get_num_threads();
+    for (int color = 0; color < num_colors; ++color)
+    {
+        const std::vector<int>& tiles = color_tiles[color];
+        const int num_color_tiles = tiles.size();
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic,1)
+        for (int k = 0; k < num_color_tiles; ++k)
+        {
+            const int t = tiles[k];
+            spreadKernel(q_data, q_data_box, q_gcw, q_depth,
+                         Q_data, Q_depth, X_data,
+                         x_lower, x_upper, dx,
+                         patch_touches_lower_physical_bdry, patch_touches_upper_physical_bdry,
+                         &tile_local_indices[tile_offset[t]], &tile_periodic_offsets[NDIM*tile_offset[t]], tile_offset[t+1]-tile_offset[t],
+                         spread_fcn);
+        }
+    }
+    return;
+}// coloredTileSpread
+
+void
+LEInteractor::reductionBufferSpread(
+    double* const q_data,
+    const Box<NDIM>& q_data_box,
+    const IntVector<NDIM>& q_gcw,
+    const int q_depth,
+    const double* const Q_data,
+    const int Q_depth,
+    const double* const X_data,
+    const double* const x_lower,
+    const double* const x_upper,
+    const double* const dx,
+    const blitz::TinyVector<int,NDIM>& patch_touches_lower_physical_bdry,
+    const blitz::TinyVector<int,NDIM>& patch_touches_upper_physical_bdry,
+    const std::vector<int>& local_indices,
+    const std::vector<double>& periodic_offsets,
+    const std::string& spread_fcn)
+{
+    const int num_local_indices = local_indices.size();
+    int q_size = q_depth;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        q_size *= q_data_box.numberCells(d)+2*q_gcw(d);
+    }
+
+    // Each thread spreads a contiguous block of markers into its own buffer.
+    // The buffers are allocated by the threads that use them.
+    const int num_threads = get_num_threads();
+    std::vector<std::vector<double> > q_bufs(num_threads);
+#pragma omp parallel num_threads(num_threads)
+    {
+        const int thread_num = omp_get_thread_num();
+        const int team_size = omp_get_num_threads();
+        const int l_start = (static_cast<long>(num_local_indices)* thread_num   )/team_size;
+        const int l_stop  = (static_cast<long>(num_local_indices)*(thread_num+1))/team_size;
+        if (l_stop > l_start)
+        {
+            q_bufs[thread_num].assign(q_size,0.0);
+            spreadKernel(&q_bufs[thread_num][0], q_data_box, q_gcw, q_depth,
+                         Q_data, Q_depth, X_data,
+                         x_lower, x_upper, dx,
+                         patch_touches_lower_physical_bdry, patch_touches_upper_physical_bdry,
+                         &local_indices[l_start], &periodic_offsets[NDIM*l_start], l_stop-l_start,
+                         spread_fcn);
+        }
+    }
+
+    // Accumulate the buffers in thread order.
+    std::vector<const double*> bufs;
+    bufs.reserve(num_threads);
+    for (int k = 0; k < num_threads; ++k)
+    {
+        if (!q_bufs[k].empty()) bufs.push_back(&q_bufs[k][0]);
+    }
+    const int num_bufs = bufs.size();
+#pragma omp parallel for num_threads(num_threads) schedule(static)
+    for (int i = 0; i < q_size; ++i)
+    {
+        for (int k = 0; k < num_bufs; ++k)
+        {
+            q_data[i] += bufs[k][i];
+        }
+    }
+    return;
+}// reductionBufferSpread
+#endif
 
 template<class T>
 void
@@ -2276,7 +4113,35 @@ LEInteractor::buildLocalIndices(
 
     blitz::TinyVector<int   ,NDIM>      offset;
     blitz::TinyVector<double,NDIM> node_offset;
-    if (s_sort_mode == NO_SORT)
+    if (s_sort_mode == SORT_MORTON_ORDER || s_sort_mode == SORT_HILBERT_ORDER)
+    {
+        // The curve ordering is cached by the index data and is reused until
+        // the nodes change cells.
+        idx_data->cacheCurveOrderedLocalIndices(s_sort_mode == SORT_HILBERT_ORDER ? LIndexSetData<T>::HILBERT_CURVE : LIndexSetData<T>::MORTON_CURVE);
+        if (box == patch_box)
+        {
+            local_indices = idx_data->getCurveOrderedInteriorLocalPETScIndices();
+            periodic_offsets.resize(NDIM*local_indices.size(),0.0);
+        }
+        else if (box == ghost_box)
+        {
+            local_indices = idx_data->getCurveOrderedLocalPETScIndices();
+            periodic_offsets = idx_data->getCurveOrderedPeriodicOffsets();
+        }
+        else
+        {
+            const std::vector<int>& curve_local_indices = idx_data->getCurveOrderedLocalPETScIndices();
+            const std::vector<double>& curve_periodic_offsets = idx_data->getCurveOrderedPeriodicOffsets();
+            const std::vector<Index<NDIM> >& curve_cell_indices = idx_data->getCurveOrderedCellIndices();
+            for (unsigned int k = 0; k < curve_local_indices.size(); ++k)
+            {
+                if (!box.contains(curve_cell_indices[k])) continue;
+                local_indices.push_back(curve_local_indices[k]);
+                periodic_offsets.insert(periodic_offsets.end(), &curve_periodic_offsets[NDIM*k], &curve_periodic_offsets[NDIM*k]+NDIM);
+            }
+        }
+    }
+    else if (s_sort_mode == NO_SORT)
     {
         if (box == patch_box)
         {
@@ -2731,6 +4596,27 @@ template void IBTK::LEInteractor::interpolate(
     const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
     const std::string& interp_fcn);
 
+template void IBTK::LEInteractor::interpolate(
+    const std::vector<SAMRAI::tbox::Pointer<LData> >& Q_data,
+    const SAMRAI::tbox::Pointer<LData> X_data,
+    const SAMRAI::tbox::Pointer<LIndexSetData<LNode> > idx_data,
+    const std::vector<SAMRAI::tbox::Pointer<SAMRAI::hier::PatchData<NDIM> > >& q_data,
+    const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
+    const SAMRAI::hier::Box<NDIM>& interp_box,
+    const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
+    const std::string& interp_fcn);
+
+template bool IBTK::LEInteractor::buildOperator(
+    std::vector<IBTK::LEInteractor::CSROperator>& ops,
+    const double* const X_data,
+    const int X_depth,
+    const SAMRAI::tbox::Pointer<LIndexSetData<LNode> > idx_data,
+    const SAMRAI::tbox::Pointer<SAMRAI::hier::PatchData<NDIM> > q_data,
+    const SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
+    const SAMRAI::hier::Box<NDIM>& box,
+    const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
+    const std::string& weighting_fcn);
+
 template void IBTK::LEInteractor::spread(
     SAMRAI::tbox::Pointer<SAMRAI::pdat::CellData<NDIM,double> > q_data,
     const SAMRAI::tbox::Pointer<LData> Q_data,
@@ -51,6 +51,7 @@ template <class T> class LIndexSetData;
 namespace SAMRAI {
 namespace hier {
 template <int DIM> class Patch;
+template <int DIM> class PatchData;
 }  // namespace hier
 namespace pdat {
 template <int DIM, class TYPE> class CellData;
@@ -83,16 +84,202 @@ public:
     static int s_delta_fcn_stencil_size;
     static double s_delta_fcn_C;
 
+    /*!
+     * \brief Resolution (number of table entries per grid spacing) of the
+     * table used to evaluate the user-defined kernel.
+     *
+     * When positive, s_delta_fcn is tabulated over its support, and the
+     * weights of the user-defined kernel are computed by interpolation in the
+     * table rather than by calling s_delta_fcn.  The table is rebuilt whenever
+     * s_delta_fcn, s_delta_fcn_stencil_size, or the resolution changes.
+     * Tabulation is used for stencil sizes of at most 8; the kernel is taken
+     * to vanish outside of its stencil.
+     *
+     * \note Default is: 0 (no tabulation).
+     */
+    static int s_delta_fcn_table_resolution;
+
+    /*!
+     * \brief Interpolation schemes used to evaluate the tabulated user-defined
+     * kernel.  With a table resolution of N, the interpolation error is
+     * O(N^-2) for LINEAR_TABLE_INTERP and O(N^-4) for CUBIC_TABLE_INTERP for
+     * smooth kernels.
+     *
+     * \note Default is: LINEAR_TABLE_INTERP.
+     */
+    enum DeltaFcnTableInterpMode {LINEAR_TABLE_INTERP=0, CUBIC_TABLE_INTERP=1};
+    static DeltaFcnTableInterpMode s_delta_fcn_table_interp_mode;
+
     /*!
      * \brief Sort modes used when interpolating and spreading values.
      *
+     * SORT_INCREASING_LAG_IDX and SORT_DECREASING_LAG_IDX are intended for
+     * debugging.  SORT_MORTON_ORDER and SORT_HILBERT_ORDER order the nodes
+     * along a space-filling curve over the cell indices of the patch, so that
+     * consecutive spreading and interpolation stencils access nearby grid
+     * values.  The curve ordering is cached by the LIndexSetData object and is
+     * reused until the nodes change cells.
+     *
      * \note Default is: NO_SORT.
      */
-    enum SortMode {NO_SORT=0, SORT_INCREASING_LAG_IDX=1, SORT_DECREASING_LAG_IDX=2};
+    enum SortMode {NO_SORT=0, SORT_INCREASING_LAG_IDX=1, SORT_DECREASING_LAG_IDX=2, SORT_MORTON_ORDER=3, SORT_HILBERT_ORDER=4};
     static SortMode s_sort_mode;
 
+    /*!
+     * \brief Threading modes used when spreading values.
+     *
+     * - SERIAL_SPREAD: all markers in the patch are spread by the calling
+     *   thread in the order in which they are stored.
+     *
+     * - COLORED_TILE_SPREAD: the markers in the patch are binned into tiles of
+     *   at least s_spread_tile_size cells per coordinate direction (and never
+     *   fewer than one stencil width plus one), and the tiles are assigned one
+     *   of 2^NDIM colors according to the parity of the tile index.  No two
+     *   tiles of the same color touch the same grid cell, so that the tiles of
+     *   each color are spread concurrently without synchronization.  Within a
+     *   tile, markers are spread in the order in which they are stored.  The
+     *   result is bitwise identical for any number of threads (including a
+     *   single thread), but because each grid value accumulates contributions
+     *   in tile order rather than in storage order, it may differ from that
+     *   obtained by SERIAL_SPREAD by the roundoff error of reordered
+     *   summation.
+     *
+     * - REDUCTION_BUFFER_SPREAD: each thread spreads a contiguous block of
+     *   markers into a private, zero-initialized copy of the patch data, and
+     *   the private copies are summed into the patch data in thread order.
+     *   For a grid value that receives contributions c_1, ..., c_n, the result
+     *   differs from that obtained by SERIAL_SPREAD by at most approximately
+     *   2*(n+T)*eps*sum_i |c_i|, in which T is the number of threads and eps
+     *   is the double precision machine epsilon.  This mode requires T
+     *   additional copies of the patch data.
+     *
+     * \note Default is: SERIAL_SPREAD.  The threaded modes revert to
+     * SERIAL_SPREAD when IBTK is not built with OpenMP support.
+     *
+     * \note When using a threaded spreading mode with a user-defined kernel,
+     * s_delta_fcn must be safe to call concurrently.
+     */
+    enum SpreadThreadingMode {SERIAL_SPREAD=0, COLORED_TILE_SPREAD=1, REDUCTION_BUFFER_SPREAD=2};
+    static SpreadThreadingMode s_spread_threading_mode;
+
+    /*!
+     * \brief Minimum tile width (in cells) used by COLORED_TILE_SPREAD.
+     *
+     * \note Default is: 8.
+     */
+    static int s_spread_tile_size;
+
+    /*!
+     * \brief Threading modes used when interpolating values.
+     *
+     * - SERIAL_INTERP: all markers in the patch are processed by the calling
+     *   thread.
+     *
+     * - CHUNKED_INTERP: the markers in the patch are split into chunks of
+     *   s_interp_chunk_size markers that are processed concurrently.  Because
+     *   each marker value is computed by exactly one thread, the result is
+     *   bitwise identical to that obtained by SERIAL_INTERP.
+     *
+     * \note Default is: SERIAL_INTERP.  CHUNKED_INTERP reverts to
+     * SERIAL_INTERP when IBTK is not built with OpenMP support.
+     */
+    enum InterpThreadingMode {SERIAL_INTERP=0, CHUNKED_INTERP=1};
+    static InterpThreadingMode s_interp_threading_mode;
+
+    /*!
+     * \brief Number of markers per chunk used by CHUNKED_INTERP.
+     *
+     * \note Default is: 256.
+     */
+    static int s_interp_chunk_size;
+
+    /*!
+     * \brief Number of threads used by the threaded interaction modes.  A
+     * nonpositive value indicates that the OpenMP default should be used.
+     *
+     * \note Default is: 0.
+     */
+    static int s_num_threads;
+
+    /*!
+     * \brief Whether to use the templated C++ spreading and interpolation
+     * kernels instead of the Fortran kernels.
+     *
+     * The templated kernels are generated from a one-dimensional kernel
+     * function and a compile-time stencil width.  They compute the tensor
+     * product of the one-dimensional weights once per marker and apply it with
+     * unit-stride inner loops.  They are provided for PIECEWISE_LINEAR,
+     * WIDE4_PIECEWISE_LINEAR, PIECEWISE_CUBIC, WIDE8_PIECEWISE_CUBIC, IB_3,
+     * WIDE6_IB_3, WIDE8_IB_4, and WIDE16_IB_4, and for IB_4 and IB_6 on patches
+     * that do not touch physical boundaries.  The Fortran kernels are used in
+     * all other cases.  When this flag is false, the Fortran kernels are used
+     * for all weighting functions, and multi-field interpolation is performed
+     * one component at a time.
+     *
+     * \note Default is: true.
+     */
+    static bool s_use_templated_kernels;
+
+    /*!
+     * \brief Precision modes used to accumulate spread values.
+     *
+     * - DOUBLE_PRECISION_SPREAD: values are accumulated directly into the
+     *   double precision patch data.
+     *
+     * - SINGLE_PRECISION_SPREAD: the values spread onto a patch are
+     *   accumulated into a zero-initialized single precision scratch buffer
+     *   that spans only the index box touched by the markers' stencils, and
+     *   the buffer is added to the patch data once all markers have been
+     *   spread.  This halves the memory traffic of the scattered
+     *   read-modify-write updates, at the cost of zeroing the buffer and adding
+     *   it to the patch data (one streaming pass each over the touched box).
+     *   It is therefore only beneficial when each grid value receives many
+     *   contributions, i.e., for dense markers and wide kernels.  For a grid
+     *   value that receives contributions c_1, ..., c_n, the result differs
+     *   from that obtained by DOUBLE_PRECISION_SPREAD by at most approximately
+     *   n*eps_s*sum_i |c_i|, in which eps_s is the single precision machine
+     *   epsilon.  Cancellation between contributions of opposite sign is not
+     *   compensated for, so the relative error in the spread value can be
+     *   much larger than eps_s.
+     *
+     * The reduced precision mode is only used with the templated kernels (see
+     * s_use_templated_kernels).  When it is used, spreading is performed
+     * serially within each patch.
+     *
+     * \note Default is: DOUBLE_PRECISION_SPREAD.
+     */
+    enum SpreadPrecisionMode {DOUBLE_PRECISION_SPREAD=0, SINGLE_PRECISION_SPREAD=1};
+    static SpreadPrecisionMode s_spread_precision_mode;
+
     /*!
      * \brief Set configuration options from a user-supplied database.
+     *
+     * Recognized keys are:
+     *
+     * - sort_mode (or debug_sort_mode): NO_SORT, SORT_INCREASING_LAG_IDX,
+     *   SORT_DECREASING_LAG_IDX, SORT_MORTON_ORDER, or SORT_HILBERT_ORDER
+     *
+     * - spread_threading_mode: SERIAL_SPREAD, COLORED_TILE_SPREAD, or
+     *   REDUCTION_BUFFER_SPREAD
+     *
+     * - spread_tile_size: minimum tile width used by COLORED_TILE_SPREAD
+     *
+     * - interp_threading_mode: SERIAL_INTERP or CHUNKED_INTERP
+     *
+     * - interp_chunk_size: number of markers per chunk used by CHUNKED_INTERP
+     *
+     * - num_threads: number of threads used by the threaded interaction modes
+     *
+     * - use_templated_kernels: whether to use the templated C++ kernels
+     *
+     * - delta_fcn_table_resolution: resolution of the table used to evaluate
+     *   the user-defined kernel
+     *
+     * - delta_fcn_table_interp_mode: LINEAR_TABLE_INTERP or
+     *   CUBIC_TABLE_INTERP
+     *
+     * - spread_precision_mode: DOUBLE_PRECISION_SPREAD or
+     *   SINGLE_PRECISION_SPREAD
      */
     static void
     setFromDatabase(
@@ -105,6 +292,17 @@ public:
     printClassData(
         std::ostream& os);
 
+    /*!
+     * \brief Returns true if the specified weighting function is available for
+     * the present spatial dimension.
+     *
+     * \note PIECEWISE_LINEAR, WIDE4_PIECEWISE_LINEAR, PIECEWISE_CUBIC,
+     * WIDE8_PIECEWISE_CUBIC, and WIDE6_IB_3 are only available when NDIM == 2.
+     */
+    static bool
+    isAvailableWeightingFunction(
+        const std::string& weighting_fcn);
+
     /*!
      * \brief Returns the interpolation/spreading stencil corresponding to the
      * specified weighting function.
@@ -293,6 +491,37 @@ public:
         const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
         const std::string& interp_fcn="IB_4");
 
+    /*!
+     * \brief Interpolate several Eulerian quantities to a Lagrangian mesh in a
+     * single pass.  The positions of the nodes of the Lagrangian mesh are
+     * specified by X_data, and the quantity stored in q_data[k] is interpolated
+     * into Q_data[k].
+     *
+     * The patch data may be cell-, node-, or side-centered, and may have
+     * different depths.  The local Lagrangian indices are determined only
+     * once, and, when templated kernels are enabled (the default) and one is
+     * available for the specified weighting function, the interpolation
+     * weights are computed only once per node for all quantities that share
+     * the same data layout.  Otherwise, this method is equivalent to
+     * interpolating each quantity separately.
+     *
+     * \note This method employs periodic boundary conditions where appropriate
+     * and when requested.  X_data must provide the canonical location of the
+     * node---i.e., each node location must lie within the extents of the
+     * physical domain.
+     */
+    template<class T>
+    static void
+    interpolate(
+        const std::vector<SAMRAI::tbox::Pointer<LData> >& Q_data,
+        SAMRAI::tbox::Pointer<LData> X_data,
+        SAMRAI::tbox::Pointer<LIndexSetData<T> > idx_data,
+        const std::vector<SAMRAI::tbox::Pointer<SAMRAI::hier::PatchData<NDIM> > >& q_data,
+        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
+        const SAMRAI::hier::Box<NDIM>& interp_box,
+        const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
+        const std::string& interp_fcn="IB_4");
+
     /*!
      * \brief Interpolate data from an Eulerian grid to a Lagrangian mesh.  The
      * positions of the nodes of the Lagrangian mesh are specified by X_data.
@@ -821,6 +1050,79 @@ public:
         const SAMRAI::hier::Box<NDIM>& spread_box,
         const std::string& spread_fcn="IB_4");
 
+    /*!
+     * \brief Explicit representation of the interpolation operator for a fixed
+     * set of Lagrangian node positions and a single component of a patch data
+     * layout, stored in compressed sparse row format.
+     *
+     * Row r of the operator corresponds to the Lagrangian node with local index
+     * node_idxs[r].  The entries weights[k], row_ptr[r] <= k < row_ptr[r+1],
+     * are the interpolation weights associated with the entries offsets[k] of
+     * the ghosted patch data array.  The corresponding spreading operator is
+     * the transpose of the interpolation operator, scaled by the reciprocal of
+     * the grid cell volume.
+     */
+    struct CSROperator
+    {
+        SAMRAI::hier::Box<NDIM> data_box;
+        SAMRAI::hier::IntVector<NDIM> gcw;
+        std::vector<int> node_idxs;
+        std::vector<int> row_ptr;
+        std::vector<int> offsets;
+        std::vector<double> weights;
+    };
+
+    /*!
+     * \brief Construct the explicit operators that interpolate data from the
+     * Eulerian grid to the Lagrangian nodes located within the provided box,
+     * or that spread data from those nodes to the Eulerian grid.  One operator
+     * is constructed for cell- or node-centered data, and NDIM operators (one
+     * for each data axis) are constructed for side-centered data.
+     *
+     * \return false if explicit operators are not available for the specified
+     * weighting function on this patch, or if the templated kernels are
+     * disabled (see s_use_templated_kernels), in which case ops is left empty.
+     * The explicit operators use the same weights as the templated kernels.
+     *
+     * \note The operators are only valid for the provided node positions and
+     * for patch data with the same centering and ghost cell width as q_data.
+     */
+    template<class T>
+    static bool
+    buildOperator(
+        std::vector<CSROperator>& ops,
+        const double* X_data,
+        int X_depth,
+        SAMRAI::tbox::Pointer<LIndexSetData<T> > idx_data,
+        SAMRAI::tbox::Pointer<SAMRAI::hier::PatchData<NDIM> > q_data,
+        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
+        const SAMRAI::hier::Box<NDIM>& box,
+        const SAMRAI::hier::IntVector<NDIM>& periodic_shift,
+        const std::string& weighting_fcn="IB_4");
+
+    /*!
+     * \brief Interpolate data from an Eulerian grid to a Lagrangian mesh using
+     * explicit operators constructed by buildOperator().
+     */
+    static void
+    applyInterpolationOperator(
+        double* Q_data,
+        int Q_depth,
+        const std::vector<CSROperator>& ops,
+        SAMRAI::tbox::Pointer<SAMRAI::hier::PatchData<NDIM> > q_data);
+
+    /*!
+     * \brief Spread data from a Lagrangian mesh to an Eulerian grid using
+     * explicit operators constructed by buildOperator().
+     */
+    static void
+    applySpreadingOperator(
+        SAMRAI::tbox::Pointer<SAMRAI::hier::PatchData<NDIM> > q_data,
+        const std::vector<CSROperator>& ops,
+        const double* Q_data,
+        int Q_depth,
+        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch);
+
 private:
     /*!
      * \brief Default constructor.
@@ -901,6 +1203,96 @@ private:
         const std::vector<double>& periodic_offsets,
         const std::string& spread_fcn);
 
+    /*!
+     * Dispatch the IB interpolation operation for a contiguous list of local
+     * indices to the kernel corresponding to the specified weighting function.
+     */
+    static void
+    interpolateKernel(
+        double* Q_data,
+        int Q_depth,
+        const double* X_data,
+        const double* q_data,
+        const SAMRAI::hier::Box<NDIM>& q_data_box,
+        const SAMRAI::hier::IntVector<NDIM>& q_gcw,
+        int q_depth,
+        const double* x_lower,
+        const double* x_upper,
+        const double* dx,
+        const blitz::TinyVector<int,NDIM>& patch_touches_lower_physical_bdry,
+        const blitz::TinyVector<int,NDIM>& patch_touches_upper_physical_bdry,
+        const int* local_indices,
+        const double* periodic_offsets,
+        int num_local_indices,
+        const std::string& interp_fcn);
+
+    /*!
+     * Dispatch the IB spreading operation for a contiguous list of local
+     * indices to the kernel corresponding to the specified weighting function.
+     */
+    static void
+    spreadKernel(
+        double* q_data,
+        const SAMRAI::hier::Box<NDIM>& q_data_box,
+        const SAMRAI::hier::IntVector<NDIM>& q_gcw,
+        int q_depth,
+        const double* Q_data,
+        int Q_depth,
+        const double* X_data,
+        const double* x_lower,
+        const double* x_upper,
+        const double* dx,
+        const blitz::TinyVector<int,NDIM>& patch_touches_lower_physical_bdry,
+        const blitz::TinyVector<int,NDIM>& patch_touches_upper_physical_bdry,
+        const int* local_indices,
+        const double* periodic_offsets,
+        int num_local_indices,
+        const std::string& spread_fcn);
+
+    /*!
+     * Implementation of the IB spreading operation using colored tiles (see
+     * COLORED_TILE_SPREAD).
+     */
+    static void
+    coloredTileSpread(
+        double* q_data,
+        const SAMRAI::hier::Box<NDIM>& q_data_box,
+        const SAMRAI::hier::IntVector<NDIM>& q_gcw,
+        int q_depth,
+        const double* Q_data,
+        int Q_depth,
+        const double* X_data,
+        const double* x_lower,
+        const double* x_upper,
+        const double* dx,
+        const blitz::TinyVector<int,NDIM>& patch_touches_lower_physical_bdry,
+        const blitz::TinyVector<int,NDIM>& patch_touches_upper_physical_bdry,
+        const std::vector<int>& local_indices,
+        const std::vector<double>& periodic_offsets,
+        const std::string& spread_fcn);
+
+    /*!
+     * Implementation of the IB spreading operation using thread-private
+     * reduction buffers (see REDUCTION_BUFFER_SPREAD).
+     */
+    static void
+    reductionBufferSpread(
+        double* q_data,
+        const SAMRAI::hier::Box<NDIM>& q_data_box,
+        const SAMRAI::hier::IntVector<NDIM>& q_gcw,
+        int q_depth,
+        const double* Q_data,
+        int Q_depth,
+        const double* X_data,
+        const double* x_lower,
+        const double* x_upper,
+        const double* dx,
+        const blitz::TinyVector<int,NDIM>& patch_touches_lower_physical_bdry,
+        const blitz::TinyVector<int,NDIM>& patch_touches_upper_physical_bdry,
+        const std::vector<int>& local_indices,
+        const std::vector<double>& periodic_offsets,
+        const std::string& spread_fcn);
+
     /*!
      * \brief Compute the local PETSc indices located within the provided box
      * based on the LNodeIndexSetData values.
@@ -0,0 +1,247 @@
+// Filename: LEdgeCutLoadBalancer.cpp
+// Created on 17 Oct 2026 by Boyce Griffith
+//
+//
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <algorithm>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Box.h"
+#include "BoxArray.h"
+#include "BoxList.h"
+#include "LEdgeCutLoadBalancer.h"
+#include "PatchHierarchy.h"
+#include "ProcessorMapping.h"
+#include "ibtk/LDataManager.h"
+#include "ibtk/namespaces.h" // IWYU pragma: keep
+#include "tbox/Array.h"
+#include "tbox/Database.h"
+#include "tbox/PIO.h"
+#include "tbox/SAMRAI_MPI.h"
+#include "tbox/Utilities.h"
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBTK
+{
+/////////////////////////////// STATIC ///////////////////////////////////////
+
+namespace
+{
+// Compute the total weight of the edges that connect boxes assigned to
+// different processors.
+inline int
+compute_edge_cut(
+    const std::vector<std::map<int,int> >& box_graph,
+    const std::vector<int>& box_procs)
+{
+    int edge_cut = 0;
+    const int num_boxes = box_graph.size();
+    for (int i = 0; i < num_boxes; ++i)
+    {
+        for (std::map<int,int>::const_iterator it = box_graph[i].begin(); it != box_graph[i].end(); ++it)
+        {
+            const int j = it->first;
+            if (i < j && box_procs[i] != box_procs[j]) edge_cut += it->second;
+        }
+    }
+    return edge_cut;
+}// compute_edge_cut
+}
+
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+LEdgeCutLoadBalancer::LEdgeCutLoadBalancer(
+    const std::string& object_name,
+    Pointer<Database> input_db)
+    : LoadBalancer<NDIM>(object_name, input_db),
+      d_object_name(object_name),
+      d_l_data_manager(NULL),
+      d_max_passes(4),
+      d_workload_tolerance(0.05),
+      d_do_log(false)
+{
+    if (input_db)
+    {
+        if (input_db->keyExists("edge_cut_max_passes")) d_max_passes = input_db->getInteger("edge_cut_max_passes");
+        if (input_db->keyExists("workload_tolerance")) d_workload_tolerance = input_db->getDouble("workload_tolerance");
+        if (input_db->keyExists("enable_logging")) d_do_log = input_db->getBool("enable_logging");
+    }
+    if (d_max_passes < 0)
+    {
+        TBOX_ERROR(d_object_name << "::LEdgeCutLoadBalancer():\n"
+                   << "  edge_cut_max_passes must be nonnegative" << std::endl);
+    }
+    if (d_workload_tolerance < 0.0)
+    {
+        TBOX_ERROR(d_object_name << "::LEdgeCutLoadBalancer():\n"
+                   << "  workload_tolerance must be nonnegative" << std::endl);
+    }
+    return;
+}// LEdgeCutLoadBalancer
+
+LEdgeCutLoadBalancer::~LEdgeCutLoadBalancer()
+{
+    // intentionally blank
+    return;
+}// ~LEdgeCutLoadBalancer
+
+void
+LEdgeCutLoadBalancer::registerLDataManager(
+    LDataManager* l_data_manager)
+{
+    d_l_data_manager = l_data_manager;
+    return;
+}// registerLDataManager
+
+void
+LEdgeCutLoadBalancer::loadBalanceBoxes(
+    BoxArray<NDIM>& out_boxes,
+    ProcessorMapping& mapping,
+    const BoxList<NDIM>& in_boxes,
+    const Pointer<PatchHierarchy<NDIM> > hierarchy,
+    const int level_number,
+    const BoxArray<NDIM>& physical_domain,
+    const IntVector<NDIM>& ratio_to_hierarchy_level_zero,
+    const IntVector<NDIM>& min_size,
+    const IntVector<NDIM>& max_size,
+    const IntVector<NDIM>& cut_factor,
+    const IntVector<NDIM>& bad_interval) const
+{
+    LoadBalancer<NDIM>::loadBalanceBoxes(out_boxes, mapping, in_boxes, hierarchy, level_number, physical_domain,
+                                         ratio_to_hierarchy_level_zero, min_size, max_size, cut_factor, bad_interval);
+    const int num_procs = SAMRAI_MPI::getNodes();
+    if (!d_l_data_manager || d_max_passes == 0 || num_procs == 1) return;
+
+    // Obtain the graph induced on the boxes by the Lagrangian connectivity.
+    //
+    // NOTE: computeLagrangianBoxGraph() returns the same data on all
+    // processors, and so each processor computes the same assignment below.
+    const int num_boxes = out_boxes.getNumberOfBoxes();
+    std::vector<int> box_node_counts;
+    std::vector<std::map<int,int> > box_graph;
+    if (!d_l_data_manager->computeLagrangianBoxGraph(box_node_counts, box_graph, out_boxes, physical_domain,
+                                                     ratio_to_hierarchy_level_zero, level_number))
+    {
+        return;
+    }
+
+    // Estimate the workload of each box and of each processor.
+    double node_weight, cell_weight;
+    d_l_data_manager->getWorkloadWeights(node_weight, cell_weight);
+    std::vector<double> box_workloads(num_boxes);
+    std::vector<int> box_procs(num_boxes);
+    std::vector<double> proc_workloads(num_procs, 0.0);
+    for (int i = 0; i < num_boxes; ++i)
+    {
+        box_workloads[i] = (1.0+cell_weight)*static_cast<double>(out_boxes[i].size()) + node_weight*static_cast<double>(box_node_counts[i]);
+        box_procs[i] = mapping.getProcessorAssignment(i);
+        proc_workloads[box_procs[i]] += box_workloads[i];
+    }
+    double total_workload = 0.0, max_workload = 0.0;
+    for (int p = 0; p < num_procs; ++p)
+    {
+        total_workload += proc_workloads[p];
+        max_workload = std::max(max_workload, proc_workloads[p]);
+    }
+    max_workload = std::max(max_workload, (1.0+d_workload_tolerance)*total_workload/static_cast<double>(num_procs));
+    const int initial_edge_cut = compute_edge_cut(box_graph, box_procs);
+
+    // Greedily move boxes to the processors to which they are most strongly
+    // connected, provided that doing so reduces the edge cut without exceeding
+    // the maximum allowable workload.
+    int num_moves = 0;
+    std::map<int,int> proc_edges;
+    for (int pass = 0; pass < d_max_passes; ++pass)
+    {
+        bool moved_box = false;
+        for (int i = 0; i < num_boxes; ++i)
+        {
+            if (box_graph[i].empty()) continue;
+            const int src_proc = box_procs[i];
+            proc_edges.clear();
+            for (std::map<int,int>::const_iterator it = box_graph[i].begin(); it != box_graph[i].end(); ++it)
+            {
+                proc_edges[box_procs[it->first]] += it->second;
+            }
+            const int internal_edges = proc_edges[src_proc];
+            int dst_proc = src_proc, max_gain = 0;
+            for (std::map<int,int>::const_iterator it = proc_edges.begin(); it != proc_edges.end(); ++it)
+            {
+                const int proc = it->first;
+                const int gain = it->second-internal_edges;
+                if (proc != src_proc && gain > max_gain && proc_workloads[proc]+box_workloads[i] <= max_workload)
+                {
+                    dst_proc = proc;
+                    max_gain = gain;
+                }
+            }
+            if (dst_proc == src_proc) continue;
+            proc_workloads[src_proc] -= box_workloads[i];
+            proc_workloads[dst_proc] += box_workloads[i];
+            box_procs[i] = dst_proc;
+            moved_box = true;
+            ++num_moves;
+        }
+        if (!moved_box) break;
+    }
+
+    if (d_do_log)
+    {
+        plog << d_object_name << "::loadBalanceBoxes(): level number " << level_number << "\n"
+             << "  reassigned " << num_moves << " of " << num_boxes << " boxes\n"
+             << "  Lagrangian edge cut reduced from " << initial_edge_cut << " to " << compute_edge_cut(box_graph, box_procs) << "\n";
+    }
+    if (num_moves == 0) return;
+
+    Array<int> proc_mapping(num_boxes);
+    for (int i = 0; i < num_boxes; ++i)
+    {
+        proc_mapping[i] = box_procs[i];
+    }
+    mapping.setProcessorMapping(proc_mapping);
+    return;
+}// loadBalanceBoxes
+
+/////////////////////////////// PROTECTED ////////////////////////////////////
+
+/////////////////////////////// PRIVATE //////////////////////////////////////
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+} // namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
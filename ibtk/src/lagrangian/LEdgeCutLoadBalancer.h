@@ -0,0 +1,192 @@
+// Filename: LEdgeCutLoadBalancer.h
+// Created on 17 Oct 2026 by Boyce Griffith
+//
+//
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef included_LEdgeCutLoadBalancer
+#define included_LEdgeCutLoadBalancer
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <string>
+
+#include "IntVector.h"
+#include "LoadBalancer.h"
+#include "tbox/Pointer.h"
+
+namespace IBTK {
+class LDataManager;
+}  // namespace IBTK
+namespace SAMRAI {
+namespace hier {
+class ProcessorMapping;
+template <int DIM> class BoxArray;
+template <int DIM> class BoxList;
+template <int DIM> class PatchHierarchy;
+}  // namespace hier
+namespace tbox {
+class Database;
+}  // namespace tbox
+}  // namespace SAMRAI
+
+/////////////////////////////// CLASS DEFINITION /////////////////////////////
+
+namespace IBTK
+{
+/*!
+ * \brief Class LEdgeCutLoadBalancer is a SAMRAI::mesh::LoadBalancer that
+ * refines the assignment of patches to processors to reduce the number of
+ * Lagrangian edges (e.g., springs and beams) that connect nodes owned by
+ * different processors.
+ *
+ * Lagrangian nodes are owned by the processor that owns the patch containing
+ * the node.  Consequently, a structure that is spread over patches assigned to
+ * many processors requires substantial ghost node communication each time
+ * forces are computed.  This class first computes a workload-balanced
+ * assignment of boxes to processors via the standard SAMRAI load balancer.
+ * The box graph induced by the connectivity of the Lagrangian structures is
+ * then obtained from the registered LDataManager, and boxes along the
+ * boundaries of the partition are greedily reassigned to the processors to
+ * which they are most strongly connected, subject to the constraint that no
+ * processor's estimated workload exceeds the larger of the present maximum
+ * workload and (1+workload_tolerance) times the average workload.
+ *
+ * Sample input:
+ * \verbatim
+ * LoadBalancer {
+ *    bin_pack_method     = "SPATIAL"
+ *    max_workload_factor = 1
+ *    edge_cut_max_passes = 4      // default value
+ *    workload_tolerance  = 0.05   // default value
+ *    enable_logging      = FALSE  // default value
+ * }
+ * \endverbatim
+ *
+ * \note The connectivity of the Lagrangian structures must be provided to the
+ * LDataManager via LDataManager::setLagrangianConnectivity().  Levels that do
+ * not contain Lagrangian data are balanced by the standard SAMRAI algorithm.
+ */
+class LEdgeCutLoadBalancer
+    : public SAMRAI::mesh::LoadBalancer<NDIM>
+{
+public:
+    /*!
+     * \brief Constructor.
+     */
+    LEdgeCutLoadBalancer(
+        const std::string& object_name,
+        SAMRAI::tbox::Pointer<SAMRAI::tbox::Database> input_db=SAMRAI::tbox::Pointer<SAMRAI::tbox::Database>(NULL));
+
+    /*!
+     * \brief Destructor.
+     */
+    ~LEdgeCutLoadBalancer();
+
+    /*!
+     * \brief Register the LDataManager that provides the connectivity of the
+     * Lagrangian structures.
+     *
+     * \note This method is called by LDataManager::registerLoadBalancer().
+     */
+    void
+    registerLDataManager(
+        LDataManager* l_data_manager);
+
+    /*!
+     * \brief Compute the boxes for a new patch level and their assignment to
+     * processors.
+     *
+     * \see SAMRAI::mesh::LoadBalancer::loadBalanceBoxes()
+     */
+    void
+    loadBalanceBoxes(
+        SAMRAI::hier::BoxArray<NDIM>& out_boxes,
+        SAMRAI::hier::ProcessorMapping& mapping,
+        const SAMRAI::hier::BoxList<NDIM>& in_boxes,
+        const SAMRAI::tbox::Pointer<SAMRAI::hier::PatchHierarchy<NDIM> > hierarchy,
+        int level_number,
+        const SAMRAI::hier::BoxArray<NDIM>& physical_domain,
+        const SAMRAI::hier::IntVector<NDIM>& ratio_to_hierarchy_level_zero,
+        const SAMRAI::hier::IntVector<NDIM>& min_size,
+        const SAMRAI::hier::IntVector<NDIM>& max_size,
+        const SAMRAI::hier::IntVector<NDIM>& cut_factor,
+        const SAMRAI::hier::IntVector<NDIM>& bad_interval) const;
+
+private:
+    /*!
+     * \brief Default constructor.
+     *
+     * \note This constructor is not implemented and should not be used.
+     */
+    LEdgeCutLoadBalancer();
+
+    /*!
+     * \brief Copy constructor.
+     *
+     * \note This constructor is not implemented and should not be used.
+     *
+     * \param from The value to copy to this object.
+     */
+    LEdgeCutLoadBalancer(
+        const LEdgeCutLoadBalancer& from);
+
+    /*!
+     * \brief Assignment operator.
+     *
+     * \note This operator is not implemented and should not be used.
+     *
+     * \param that The value to assign to this object.
+     *
+     * \return A reference to this object.
+     */
+    LEdgeCutLoadBalancer&
+    operator=(
+        const LEdgeCutLoadBalancer& that);
+
+    const std::string d_object_name;
+
+    /*
+     * The LDataManager that provides the Lagrangian connectivity.
+     */
+    LDataManager* d_l_data_manager;
+
+    /*
+     * Parameters controlling the refinement of the partition.
+     */
+    int d_max_passes;
+    double d_workload_tolerance;
+    bool d_do_log;
+};
+}// namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif //#ifndef included_LEdgeCutLoadBalancer
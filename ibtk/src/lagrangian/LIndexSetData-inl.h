@@ -113,6 +113,34 @@ LIndexSetData<T>::getGhostPeriodicOffsets() const
     return d_ghost_periodic_offsets;
 }// getGhostPeriodicOffsets
 
+template<class T>
+inline const std::vector<int>&
+LIndexSetData<T>::getCurveOrderedLocalPETScIndices() const
+{
+    return d_curve_local_petsc_indices;
+}// getCurveOrderedLocalPETScIndices
+
+template<class T>
+inline const std::vector<int>&
+LIndexSetData<T>::getCurveOrderedInteriorLocalPETScIndices() const
+{
+    return d_curve_interior_local_petsc_indices;
+}// getCurveOrderedInteriorLocalPETScIndices
+
+template<class T>
+inline const std::vector<double>&
+LIndexSetData<T>::getCurveOrderedPeriodicOffsets() const
+{
+    return d_curve_periodic_offsets;
+}// getCurveOrderedPeriodicOffsets
+
+template<class T>
+inline const std::vector<SAMRAI::hier::Index<NDIM> >&
+LIndexSetData<T>::getCurveOrderedCellIndices() const
+{
+    return d_curve_cell_indices;
+}// getCurveOrderedCellIndices
+
 //////////////////////////////////////////////////////////////////////////////
 
 }// namespace IBTK
@@ -32,6 +32,10 @@
 
 /////////////////////////////// INCLUDES /////////////////////////////////////
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
 #include "CartesianPatchGeometry.h"
 #include "CellIndex.h"
 #include "Index.h"
@@ -52,6 +56,93 @@ namespace IBTK
 {
 /////////////////////////////// STATIC ///////////////////////////////////////
 
+namespace
+{
+struct CurveCell
+{
+    blitz::TinyVector<unsigned int,NDIM> key;
+    Index<NDIM> index;
+    int offset, ghost_offset, num_ids;
+    bool is_interior;
+};
+
+// Returns true if the most significant set bit of x is lower than that of y.
+inline bool
+less_msb(
+    const unsigned int x,
+    const unsigned int y)
+{
+    return x < y && x < (x^y);
+}// less_msb
+
+// Orders cells by the bit-interleaved (Morton) ordering of their keys, with
+// the first coordinate the most significant.
+struct CurveCellComp
+    : std::binary_function<CurveCell,CurveCell,bool>
+{
+    inline bool
+    operator()(
+        const CurveCell& lhs,
+        const CurveCell& rhs) const
+        {
+            unsigned int d_msb = 0, x = 0;
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                const unsigned int y = lhs.key[d]^rhs.key[d];
+                if (less_msb(x,y))
+                {
+                    d_msb = d;
+                    x = y;
+                }
+            }
+            return lhs.key[d_msb] < rhs.key[d_msb];
+        }
+};
+
+// Converts cell coordinates to the transposed form of the corresponding
+// Hilbert index, so that the Hilbert ordering is given by the Morton ordering
+// of the transformed coordinates (J. Skilling, "Programming the Hilbert
+// curve", AIP Conf. Proc. 707, 2004).
+inline void
+hilbert_transpose(
+    blitz::TinyVector<unsigned int,NDIM>& X,
+    const unsigned int num_bits)
+{
+    const unsigned int M = 1u << (num_bits-1);
+    for (unsigned int Q = M; Q > 1; Q >>= 1)
+    {
+        const unsigned int P = Q-1;
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            if (X[d] & Q)
+            {
+                X[0] ^= P;
+            }
+            else
+            {
+                const unsigned int t = (X[0]^X[d]) & P;
+                X[0] ^= t;
+                X[d] ^= t;
+            }
+        }
+    }
+    for (unsigned int d = 1; d < NDIM; ++d)
+    {
+        X[d] ^= X[d-1];
+    }
+    unsigned int t = 0;
+    for (unsigned int Q = M; Q > 1; Q >>= 1)
+    {
+        if (X[NDIM-1] & Q) t ^= Q-1;
+    }
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        X[d] ^= t;
+    }
+    return;
+}// hilbert_transpose
+}
+
 /////////////////////////////// PUBLIC ///////////////////////////////////////
 
 template<class T>
@@ -68,7 +159,13 @@ LIndexSetData<T>::LIndexSetData(
       d_local_petsc_indices(),
       d_interior_local_petsc_indices(),
       d_ghost_local_petsc_indices(),
-      d_ghost_periodic_offsets()
+      d_ghost_periodic_offsets(),
+      d_curve_ordering_is_valid(false),
+      d_curve(MORTON_CURVE),
+      d_curve_local_petsc_indices(),
+      d_curve_interior_local_petsc_indices(),
+      d_curve_periodic_offsets(),
+      d_curve_cell_indices()
 {
     // intentionally blank
     return;
@@ -98,6 +195,12 @@ LIndexSetData<T>::cacheLocalIndices(
     d_ghost_local_petsc_indices    .clear();
     d_ghost_periodic_offsets       .clear();
 
+    d_curve_ordering_is_valid = false;
+    d_curve_local_petsc_indices         .clear();
+    d_curve_interior_local_petsc_indices.clear();
+    d_curve_periodic_offsets            .clear();
+    d_curve_cell_indices                .clear();
+
     const Box<NDIM>& patch_box = patch->getBox();
     const Index<NDIM>& ilower = patch_box.lower();
     const Index<NDIM>& iupper = patch_box.upper();
@@ -162,6 +265,83 @@ LIndexSetData<T>::cacheLocalIndices(
     return;
 }// cacheLocalIndices
 
+template<class T>
+void
+LIndexSetData<T>::cacheCurveOrderedLocalIndices(
+    const SpaceFillingCurve curve)
+{
+    if (d_curve_ordering_is_valid && d_curve == curve) return;
+    d_curve_ordering_is_valid = true;
+    d_curve = curve;
+    d_curve_local_petsc_indices         .clear();
+    d_curve_interior_local_petsc_indices.clear();
+    d_curve_periodic_offsets            .clear();
+    d_curve_cell_indices                .clear();
+
+    const Box<NDIM>& ghost_box = this->getGhostBox();
+    const Index<NDIM>& glower = ghost_box.lower();
+    unsigned int num_bits = 1;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        while ((1 << num_bits) < ghost_box.numberCells(d)) ++num_bits;
+    }
+
+    // Compute the curve coordinates of the cells that contain indices, and
+    // record the positions of the corresponding entries in the cached indexing
+    // data.  The iteration order is the same as in cacheLocalIndices().
+    std::vector<CurveCell> cells;
+    const Box<NDIM>& patch_box = this->getBox();
+    int offset = 0, ghost_offset = 0;
+    for (typename LSetData<T>::SetIterator it(*this); it; it++)
+    {
+        const CellIndex<NDIM>& i = it.getIndex();
+        const int num_ids = (*it).size();
+        if (num_ids == 0) continue;
+        CurveCell cell;
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            cell.key[d] = static_cast<unsigned int>(i(d)-glower(d));
+        }
+        if (curve == HILBERT_CURVE) hilbert_transpose(cell.key, num_bits);
+        cell.index = i;
+        cell.offset = offset;
+        cell.ghost_offset = ghost_offset;
+        cell.num_ids = num_ids;
+        cell.is_interior = patch_box.contains(i);
+        cells.push_back(cell);
+        offset += num_ids;
+        if (!cell.is_interior) ghost_offset += num_ids;
+    }
+    std::stable_sort(cells.begin(), cells.end(), CurveCellComp());
+
+    // Assemble the curve-ordered indexing data.
+    const int num_indices = d_local_petsc_indices.size();
+    d_curve_local_petsc_indices.reserve(num_indices);
+    d_curve_interior_local_petsc_indices.reserve(d_interior_local_petsc_indices.size());
+    d_curve_periodic_offsets.reserve(NDIM*num_indices);
+    d_curve_cell_indices.reserve(num_indices);
+    for (std::vector<CurveCell>::const_iterator it = cells.begin(); it != cells.end(); ++it)
+    {
+        for (int n = 0; n < it->num_ids; ++n)
+        {
+            const int local_petsc_idx = d_local_petsc_indices[it->offset+n];
+            d_curve_local_petsc_indices.push_back(local_petsc_idx);
+            d_curve_cell_indices.push_back(it->index);
+            if (it->is_interior)
+            {
+                d_curve_interior_local_petsc_indices.push_back(local_petsc_idx);
+                d_curve_periodic_offsets.insert(d_curve_periodic_offsets.end(), NDIM, 0.0);
+            }
+            else
+            {
+                const double* const ghost_periodic_offset = &d_ghost_periodic_offsets[NDIM*(it->ghost_offset+n)];
+                d_curve_periodic_offsets.insert(d_curve_periodic_offsets.end(), ghost_periodic_offset, ghost_periodic_offset+NDIM);
+            }
+        }
+    }
+    return;
+}// cacheCurveOrderedLocalIndices
+
 /////////////////////////////// PROTECTED ////////////////////////////////////
 
 /////////////////////////////// PRIVATE //////////////////////////////////////
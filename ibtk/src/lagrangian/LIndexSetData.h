@@ -38,6 +38,7 @@
 #include <vector>
 
 #include "Box.h"
+#include "Index.h"
 #include "IntVector.h"
 #include "ibtk/LSetData.h"
 #include "tbox/Pointer.h"
@@ -158,6 +159,63 @@ public:
     const std::vector<double>&
     getGhostPeriodicOffsets() const;
 
+    /*!
+     * \brief Space-filling curves that may be used to order the cached indexing
+     * data by cell index.
+     */
+    enum SpaceFillingCurve {MORTON_CURVE=0, HILBERT_CURVE=1};
+
+    /*!
+     * \brief Update the cached indexing data that is ordered along the
+     * specified space-filling curve over the cell indices of the patch data
+     * ghost box.  Indices that lie in the same cell retain their relative
+     * order.
+     *
+     * \note The ordering is only recomputed if the indexing data has been
+     * updated by cacheLocalIndices() or if a different curve is requested, so
+     * that it is reused until the nodes change cells.
+     */
+    void
+    cacheCurveOrderedLocalIndices(
+        SpaceFillingCurve curve);
+
+    /*!
+     * \return A constant reference to the set of local PETSc data indices that
+     * lie in the patch (including the ghost cell region), ordered along a
+     * space-filling curve.
+     *
+     * \see cacheCurveOrderedLocalIndices()
+     */
+    const std::vector<int>&
+    getCurveOrderedLocalPETScIndices() const;
+
+    /*!
+     * \return A constant reference to the set of local PETSc data indices that
+     * lie in the patch interior, ordered along a space-filling curve.
+     *
+     * \see cacheCurveOrderedLocalIndices()
+     */
+    const std::vector<int>&
+    getCurveOrderedInteriorLocalPETScIndices() const;
+
+    /*!
+     * \return A constant reference to the periodic shifts for the indices
+     * returned by getCurveOrderedLocalPETScIndices().
+     *
+     * \see cacheCurveOrderedLocalIndices()
+     */
+    const std::vector<double>&
+    getCurveOrderedPeriodicOffsets() const;
+
+    /*!
+     * \return A constant reference to the cell indices for the indices
+     * returned by getCurveOrderedLocalPETScIndices().
+     *
+     * \see cacheCurveOrderedLocalIndices()
+     */
+    const std::vector<SAMRAI::hier::Index<NDIM> >&
+    getCurveOrderedCellIndices() const;
+
 private:
     /*!
      * \brief Default constructor.
@@ -193,6 +251,15 @@ private:
     std::vector<int> d_global_petsc_indices, d_interior_global_petsc_indices, d_ghost_global_petsc_indices;
     std::vector<int> d_local_petsc_indices, d_interior_local_petsc_indices, d_ghost_local_petsc_indices;
     std::vector<double> d_ghost_periodic_offsets;
+
+    /*
+     * Cached indexing data ordered along a space-filling curve.
+     */
+    bool d_curve_ordering_is_valid;
+    SpaceFillingCurve d_curve;
+    std::vector<int> d_curve_local_petsc_indices, d_curve_interior_local_petsc_indices;
+    std::vector<double> d_curve_periodic_offsets;
+    std::vector<SAMRAI::hier::Index<NDIM> > d_curve_cell_indices;
 };
 }// namespace IBTK
 
@@ -36,6 +36,7 @@
 /////////////////////////////// INCLUDES /////////////////////////////////////
 
 #include "ibtk/LNodeIndex.h"
+#include "ibtk/SmallObjectArena.h"
 #include "tbox/AbstractStream.h"
 
 /////////////////////////////// NAMESPACE ////////////////////////////////////
@@ -106,6 +107,22 @@ LNodeIndex::operator=(
     return *this;
 }// operator=
 
+inline void*
+LNodeIndex::operator new(
+    const size_t size)
+{
+    return SmallObjectArena::allocate(size);
+}// operator new
+
+inline void
+LNodeIndex::operator delete(
+    void* const ptr,
+    const size_t size)
+{
+    SmallObjectArena::deallocate(ptr, size);
+    return;
+}// operator delete
+
 inline int
 LNodeIndex::getLagrangianIndex() const
 {
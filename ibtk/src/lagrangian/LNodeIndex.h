@@ -111,6 +111,22 @@ public:
     operator=(
         const LNodeIndex& that);
 
+    /*!
+     * \brief Allocate storage for LNodeIndex objects (including objects of derived
+     * classes) from the SmallObjectArena.
+     */
+    static void*
+    operator new(
+        size_t size);
+
+    /*!
+     * \brief Return storage for LNodeIndex objects to the SmallObjectArena.
+     */
+    static void
+    operator delete(
+        void* ptr,
+        size_t size);
+
     /*!
      * \return The Lagrangian index referenced by this LNodeIndex object.
      */
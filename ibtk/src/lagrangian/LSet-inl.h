@@ -276,7 +276,7 @@ LSet<T>::unpackStream(
     {
         d_set[k] = new T(stream,offset);
     }
-    typename LSet<T>::DataSet(d_set).swap(d_set); // trim-to-fit
+    if (d_set.capacity() > d_set.size()) typename LSet<T>::DataSet(d_set).swap(d_set); // trim-to-fit
     return;
 }// unpackStream
 
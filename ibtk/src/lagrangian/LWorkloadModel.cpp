@@ -0,0 +1,200 @@
+// Filename: LWorkloadModel.cpp
+// Created on 17 Oct 2026 by Boyce Griffith
+//
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "LWorkloadModel.h"
+#include "ibtk/namespaces.h" // IWYU pragma: keep
+#include "mpi.h"
+#include "tbox/SAMRAI_MPI.h"
+#include "tbox/Utilities.h"
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBTK
+{
+/////////////////////////////// STATIC ///////////////////////////////////////
+
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+LWorkloadModel::LWorkloadModel(
+    const std::string& object_name)
+    : d_object_name(object_name),
+      d_window_start_time(0.0),
+      d_patch_work_time(),
+      d_point_work_time(0.0),
+      d_sum_PP(0.0),
+      d_sum_PC(0.0),
+      d_sum_CC(0.0),
+      d_sum_PT(0.0),
+      d_sum_CT(0.0),
+      d_num_points(0.0),
+      d_num_samples(0.0)
+{
+    resetMeasurements();
+    return;
+}// LWorkloadModel
+
+LWorkloadModel::~LWorkloadModel()
+{
+    // intentionally blank
+    return;
+}// ~LWorkloadModel
+
+void
+LWorkloadModel::resetMeasurements()
+{
+    d_window_start_time = MPI_Wtime();
+    d_patch_work_time.clear();
+    d_point_work_time = 0.0;
+    d_sum_PP = 0.0;
+    d_sum_PC = 0.0;
+    d_sum_CC = 0.0;
+    d_sum_PT = 0.0;
+    d_sum_CT = 0.0;
+    d_num_points = 0.0;
+    d_num_samples = 0.0;
+    return;
+}// resetMeasurements
+
+void
+LWorkloadModel::addPatchWorkTime(
+    const int level_number,
+    const int patch_num,
+    const double work_time)
+{
+    d_patch_work_time[std::make_pair(level_number,patch_num)] += work_time;
+    return;
+}// addPatchWorkTime
+
+void
+LWorkloadModel::addPointWorkTime(
+    const double work_time)
+{
+    d_point_work_time += work_time;
+    return;
+}// addPointWorkTime
+
+double
+LWorkloadModel::getPatchWorkTime(
+    const int level_number,
+    const int patch_num) const
+{
+    std::map<std::pair<int,int>,double>::const_iterator it = d_patch_work_time.find(std::make_pair(level_number,patch_num));
+    return (it != d_patch_work_time.end() ? it->second : 0.0);
+}// getPatchWorkTime
+
+void
+LWorkloadModel::addPatchSample(
+    const int level_number,
+    const int patch_num,
+    const double num_points,
+    const double num_cells)
+{
+    const double T = getPatchWorkTime(level_number, patch_num);
+    const double P = num_points;
+    const double C = num_cells;
+    d_sum_PP += P*P;
+    d_sum_PC += P*C;
+    d_sum_CC += C*C;
+    d_sum_PT += P*T;
+    d_sum_CT += C*T;
+    d_num_points += P;
+    d_num_samples += 1.0;
+    return;
+}// addPatchSample
+
+bool
+LWorkloadModel::computeWorkloadWeights(
+    double& point_weight,
+    double& cell_weight,
+    const double num_local_cells)
+{
+    // Estimate the cost per cell of the non-Lagrangian work performed by each
+    // processor during the measurement window.
+    const double elapsed_time = MPI_Wtime()-d_window_start_time;
+    double lag_work_time = d_point_work_time;
+    for (std::map<std::pair<int,int>,double>::const_iterator it = d_patch_work_time.begin(); it != d_patch_work_time.end(); ++it)
+    {
+        lag_work_time += it->second;
+    }
+    static const double max_time = std::numeric_limits<double>::max();
+    double cell_time = (num_local_cells > 0.0 ? (elapsed_time-lag_work_time)/num_local_cells : max_time);
+    cell_time = SAMRAI_MPI::minReduction(cell_time);
+
+    // Combine the normal equations from all processors.
+    static const int NSUMS = 8;
+    double sums[NSUMS] = { d_sum_PP , d_sum_PC , d_sum_CC , d_sum_PT , d_sum_CT , d_point_work_time , d_num_points , d_num_samples };
+    SAMRAI_MPI::sumReduction(sums, NSUMS);
+    const double sum_PP = sums[0], sum_PC = sums[1], sum_CC = sums[2], sum_PT = sums[3], sum_CT = sums[4];
+    const double point_work_time = sums[5], num_points = sums[6], num_samples = sums[7];
+    if (num_samples < 2.0 || num_points <= 0.0 || cell_time <= 0.0 || cell_time == max_time) return false;
+    if (sum_PP <= 0.0 || (sum_PT <= 0.0 && point_work_time <= 0.0)) return false;
+
+    // Solve the least-squares problem.  If the two-parameter fit is
+    // ill-conditioned or yields a negative coefficient, fall back to a model
+    // that only includes the per-point cost.
+    double point_coef = -1.0, cell_coef = -1.0;
+    const double det = sum_PP*sum_CC-sum_PC*sum_PC;
+    if (det > std::sqrt(std::numeric_limits<double>::epsilon())*sum_PP*sum_CC)
+    {
+        point_coef = (sum_PT*sum_CC-sum_CT*sum_PC)/det;
+        cell_coef  = (sum_CT*sum_PP-sum_PT*sum_PC)/det;
+    }
+    if (point_coef < 0.0 || cell_coef < 0.0)
+    {
+        point_coef = std::max(sum_PT/sum_PP, 0.0);
+        cell_coef  = 0.0;
+    }
+    point_coef += point_work_time/num_points;
+
+    point_weight = point_coef/cell_time;
+    cell_weight  =  cell_coef/cell_time;
+    return true;
+}// computeWorkloadWeights
+
+/////////////////////////////// PROTECTED ////////////////////////////////////
+
+/////////////////////////////// PRIVATE //////////////////////////////////////
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+} // namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
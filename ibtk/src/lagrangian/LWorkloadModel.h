@@ -0,0 +1,200 @@
+// Filename: LWorkloadModel.h
+// Created on 17 Oct 2026 by Boyce Griffith
+//
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef included_LWorkloadModel
+#define included_LWorkloadModel
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "tbox/DescribedClass.h"
+
+/////////////////////////////// CLASS DEFINITION /////////////////////////////
+
+namespace IBTK
+{
+/*!
+ * \brief Class LWorkloadModel estimates the computational cost of the
+ * Lagrangian operations performed on each patch from measured execution times.
+ *
+ * Over a measurement window (typically the interval between two regridding
+ * operations), the times spent performing Lagrangian operations on each local
+ * patch are accumulated via addPatchWorkTime(), and the times spent performing
+ * operations that are not associated with particular patches but that scale
+ * with the number of local Lagrangian points (e.g., force computations) are
+ * accumulated via addPointWorkTime().  At the end of the window, the patch
+ * times are fit to the model
+ *
+ *    T = point_coef*num_points + cell_coef*num_cells
+ *
+ * by least squares over all patches on all processors.  The coefficients are
+ * normalized by an estimate of the cost per Cartesian grid cell of all of the
+ * remaining (i.e., Eulerian) work, so that they can be added to a workload
+ * estimate in which each cell has unit weight.  The cost of the Eulerian work
+ * is taken to be the smallest per-cell non-Lagrangian time over all
+ * processors, which is the processor that spends the least time waiting on
+ * others.
+ */
+class LWorkloadModel
+    : public SAMRAI::tbox::DescribedClass
+{
+public:
+    /*!
+     * \brief Constructor.
+     */
+    LWorkloadModel(
+        const std::string& object_name);
+
+    /*!
+     * \brief Destructor.
+     */
+    ~LWorkloadModel();
+
+    /*!
+     * \brief Discard all accumulated timings and begin a new measurement
+     * window.
+     */
+    void
+    resetMeasurements();
+
+    /*!
+     * \brief Add to the time spent performing Lagrangian operations on the
+     * specified local patch.
+     */
+    void
+    addPatchWorkTime(
+        int level_number,
+        int patch_num,
+        double work_time);
+
+    /*!
+     * \brief Add to the time spent performing Lagrangian operations that scale
+     * with the number of local Lagrangian points but that are not associated
+     * with particular patches.
+     */
+    void
+    addPointWorkTime(
+        double work_time);
+
+    /*!
+     * \brief Return the time accumulated for the specified local patch in the
+     * present measurement window.
+     */
+    double
+    getPatchWorkTime(
+        int level_number,
+        int patch_num) const;
+
+    /*!
+     * \brief Add a sample for the present measurement window corresponding to
+     * a local patch with the specified numbers of Lagrangian points and
+     * Cartesian grid cells.
+     */
+    void
+    addPatchSample(
+        int level_number,
+        int patch_num,
+        double num_points,
+        double num_cells);
+
+    /*!
+     * \brief Fit the model to the samples added to the present measurement
+     * window and compute the workload weights per Lagrangian point and per
+     * Cartesian grid cell, relative to the unit weight of a Cartesian grid
+     * cell.
+     *
+     * \return false if the measurements are insufficient to determine the
+     * weights, in which case the weights are unchanged.
+     *
+     * \note This is a collective operation.  All samples must be added before
+     * calling this method.  num_local_cells is the total number of Cartesian
+     * grid cells owned by this processor on all levels of the patch hierarchy.
+     */
+    bool
+    computeWorkloadWeights(
+        double& point_weight,
+        double& cell_weight,
+        double num_local_cells);
+
+private:
+    /*!
+     * \brief Copy constructor.
+     *
+     * \note This constructor is not implemented and should not be used.
+     *
+     * \param from The value to copy to this object.
+     */
+    LWorkloadModel(
+        const LWorkloadModel& from);
+
+    /*!
+     * \brief Assignment operator.
+     *
+     * \note This operator is not implemented and should not be used.
+     *
+     * \param that The value to assign to this object.
+     *
+     * \return A reference to this object.
+     */
+    LWorkloadModel&
+    operator=(
+        const LWorkloadModel& that);
+
+    const std::string d_object_name;
+
+    /*
+     * The wall clock time at the start of the present measurement window.
+     */
+    double d_window_start_time;
+
+    /*
+     * Accumulated timings for each (level number, patch number) pair, and for
+     * operations not associated with particular patches.
+     */
+    std::map<std::pair<int,int>,double> d_patch_work_time;
+    double d_point_work_time;
+
+    /*
+     * Accumulated normal equations for the least-squares fit.
+     */
+    double d_sum_PP, d_sum_PC, d_sum_CC, d_sum_PT, d_sum_CT;
+    double d_num_points, d_num_samples;
+};
+
+}// namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif //#ifndef included_LWorkloadModel
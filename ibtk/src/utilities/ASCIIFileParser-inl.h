@@ -0,0 +1,235 @@
+// Filename: ASCIIFileParser-inl.h
+// Created on 17 Oct 2026 by Boyce Griffith
+//
+//
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef included_ASCIIFileParser_inl_h
+#define included_ASCIIFileParser_inl_h
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <limits>
+
+#include "ibtk/ASCIIFileParser.h"
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBTK
+{
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+inline
+ASCIIFileParser::LineStream::LineStream(
+    const char* const begin,
+    const char* const end)
+    : d_pos(begin),
+      d_end(end),
+      d_failed(false)
+{
+    // intentionally blank
+    return;
+}// LineStream
+
+inline bool
+ASCIIFileParser::LineStream::read(
+    int& value)
+{
+    skipWhitespace();
+    if (d_failed) return false;
+    const char* p = d_pos;
+    const bool negative = (p != d_end && *p == '-');
+    if (p != d_end && (*p == '-' || *p == '+')) ++p;
+    if (p == d_end || *p < '0' || *p > '9')
+    {
+        d_failed = true;
+        return false;
+    }
+    const long long max_magnitude = static_cast<long long>(std::numeric_limits<int>::max())+(negative ? 1 : 0);
+    long long magnitude = 0;
+    for ( ; p != d_end && *p >= '0' && *p <= '9'; ++p)
+    {
+        magnitude = 10*magnitude+(*p-'0');
+        if (magnitude > max_magnitude)
+        {
+            d_failed = true;
+            return false;
+        }
+    }
+    value = static_cast<int>(negative ? -magnitude : magnitude);
+    d_pos = p;
+    return true;
+}// read
+
+inline bool
+ASCIIFileParser::LineStream::read(
+    double& value)
+{
+    // Powers of ten that are exactly representable in double precision.
+    static const double POW10[] =
+        { 1.0e0 , 1.0e1 , 1.0e2 , 1.0e3 , 1.0e4 , 1.0e5 , 1.0e6 , 1.0e7 ,
+          1.0e8 , 1.0e9 , 1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+          1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22 };
+    static const int MAX_EXACT_POW10 = 22;
+    static const unsigned long long MAX_EXACT_MANTISSA = 9007199254740992ULL; // 2^53
+    static const int MAX_MANTISSA_DIGITS = 19;
+
+    skipWhitespace();
+    if (d_failed) return false;
+
+    // Determine the decimal mantissa and exponent of the value.
+    const char* p = d_pos;
+    const bool negative = (p != d_end && *p == '-');
+    if (p != d_end && (*p == '-' || *p == '+')) ++p;
+    unsigned long long mantissa = 0;
+    int num_mantissa_digits = 0, exponent = 0;
+    bool found_digits = false, truncated = false;
+    for ( ; p != d_end && *p >= '0' && *p <= '9'; ++p)
+    {
+        found_digits = true;
+        if (mantissa == 0 && *p == '0') continue;
+        if (num_mantissa_digits < MAX_MANTISSA_DIGITS)
+        {
+            mantissa = 10*mantissa+(*p-'0');
+            ++num_mantissa_digits;
+        }
+        else
+        {
+            ++exponent;
+            truncated = true;
+        }
+    }
+    if (p != d_end && *p == '.')
+    {
+        for (++p; p != d_end && *p >= '0' && *p <= '9'; ++p)
+        {
+            found_digits = true;
+            if (mantissa == 0 && *p == '0')
+            {
+                --exponent;
+                continue;
+            }
+            if (num_mantissa_digits < MAX_MANTISSA_DIGITS)
+            {
+                mantissa = 10*mantissa+(*p-'0');
+                ++num_mantissa_digits;
+                --exponent;
+            }
+            else
+            {
+                truncated = true;
+            }
+        }
+    }
+    if (!found_digits)
+    {
+        d_failed = true;
+        return false;
+    }
+    if (p != d_end && (*p == 'e' || *p == 'E'))
+    {
+        const char* q = p+1;
+        const bool negative_exponent = (q != d_end && *q == '-');
+        if (q != d_end && (*q == '-' || *q == '+')) ++q;
+        if (q == d_end || *q < '0' || *q > '9')
+        {
+            d_failed = true;
+            return false;
+        }
+        int explicit_exponent = 0;
+        for ( ; q != d_end && *q >= '0' && *q <= '9'; ++q)
+        {
+            if (explicit_exponent < 100000) explicit_exponent = 10*explicit_exponent+(*q-'0');
+        }
+        exponent += (negative_exponent ? -explicit_exponent : explicit_exponent);
+        p = q;
+    }
+
+    // A single rounded multiplication or division yields the correctly rounded
+    // value when both the mantissa and the power of ten are exactly
+    // representable.  Otherwise, fall back to the C library.
+    if (mantissa == 0)
+    {
+        value = (negative ? -0.0 : 0.0);
+    }
+    else if (!truncated && mantissa <= MAX_EXACT_MANTISSA && exponent >= -MAX_EXACT_POW10 && exponent <= MAX_EXACT_POW10)
+    {
+        const double magnitude = static_cast<double>(mantissa);
+        value = (exponent < 0 ? magnitude/POW10[-exponent] : magnitude*POW10[exponent]);
+        if (negative) value = -value;
+    }
+    else if (parseDouble(d_pos, p, value) != p)
+    {
+        d_failed = true;
+        return false;
+    }
+    d_pos = p;
+    return true;
+}// read
+
+inline void
+ASCIIFileParser::LineStream::skipWhitespace()
+{
+    while (d_pos != d_end && (*d_pos == ' ' || (*d_pos >= '\t' && *d_pos <= '\r'))) ++d_pos;
+    return;
+}// skipWhitespace
+
+inline int
+ASCIIFileParser::getNumberOfLines() const
+{
+    return static_cast<int>(d_line_start.size())-1;
+}// getNumberOfLines
+
+inline ASCIIFileParser::LineStream
+ASCIIFileParser::getLineStream(
+    const int line) const
+{
+    const char* const begin = d_map+d_line_start[line];
+    const char* end = d_map+d_line_start[line+1]-1;
+
+    // Discard any text following a '!', '#', or '%' character.
+    for (const char* p = begin; p != end; ++p)
+    {
+        if (*p == '!' || *p == '#' || *p == '%')
+        {
+            end = p;
+            break;
+        }
+    }
+    return LineStream(begin, end);
+}// getLineStream
+
+//////////////////////////////////////////////////////////////////////////////
+
+}// namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif //#ifndef included_ASCIIFileParser_inl_h
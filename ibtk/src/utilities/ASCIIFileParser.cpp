@@ -0,0 +1,258 @@
+// Filename: ASCIIFileParser.cpp
+// Created on 17 Oct 2026 by Boyce Griffith
+//
+//
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <errno.h>
+#include <fcntl.h>
+#include <locale.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "ASCIIFileParser.h"
+#include "ibtk/namespaces.h" // IWYU pragma: keep
+#include "tbox/Utilities.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBTK
+{
+/////////////////////////////// STATIC ///////////////////////////////////////
+
+namespace
+{
+// The number of chunks processed by each thread when splitting a file into
+// lines.
+static const int CHUNKS_PER_THREAD = 4;
+
+// The size of the buffer used to parse values that require strtod().
+static const size_t TOKEN_BUFFER_SIZE = 64;
+
+inline int
+get_num_threads(
+    const int num_threads)
+{
+#ifdef _OPENMP
+    return (num_threads > 0 ? num_threads : omp_get_max_threads());
+#else
+    NULL_USE(num_threads);
+    return 1;
+#endif
+}// get_num_threads
+
+inline size_t
+count_newlines(
+    const char* p,
+    const char* const end)
+{
+    size_t count = 0;
+    while (p != end && (p = static_cast<const char*>(std::memchr(p, '\n', end-p))))
+    {
+        ++count;
+        ++p;
+    }
+    return count;
+}// count_newlines
+}
+
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+ASCIIFileParser::ASCIIFileParser()
+    : d_map(NULL),
+      d_map_size(0),
+      d_line_start()
+{
+    // intentionally blank
+    return;
+}// ASCIIFileParser
+
+ASCIIFileParser::~ASCIIFileParser()
+{
+    close();
+    return;
+}// ~ASCIIFileParser
+
+bool
+ASCIIFileParser::open(
+    const std::string& filename,
+    const int num_threads)
+{
+    close();
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    if (st.st_size > 0)
+    {
+        void* const map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+        {
+            ::close(fd);
+            return false;
+        }
+        d_map = static_cast<const char*>(map);
+        d_map_size = st.st_size;
+    }
+    ::close(fd);
+
+    // Split the file into chunks, count the newline characters in each chunk,
+    // and then record the positions of the lines that start in each chunk.
+    // Each line starts at the beginning of the file or after a newline.
+    const int nthreads = get_num_threads(num_threads);
+    const int num_chunks = std::max(1, static_cast<int>(std::min<size_t>(CHUNKS_PER_THREAD*nthreads, d_map_size)));
+    std::vector<size_t> chunk_offset(num_chunks+1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+    for (int c = 0; c < num_chunks; ++c)
+    {
+        const size_t chunk_begin = (d_map_size*c)/num_chunks;
+        const size_t chunk_end = (d_map_size*(c+1))/num_chunks;
+        chunk_offset[c+1] = count_newlines(d_map+chunk_begin, d_map+chunk_end);
+    }
+    for (int c = 0; c < num_chunks; ++c)
+    {
+        chunk_offset[c+1] += chunk_offset[c];
+    }
+    const size_t num_newlines = chunk_offset[num_chunks];
+    d_line_start.resize(num_newlines+1);
+    d_line_start[0] = 0;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nthreads) schedule(static,1)
+#endif
+    for (int c = 0; c < num_chunks; ++c)
+    {
+        const char* const chunk_end = d_map+(d_map_size*(c+1))/num_chunks;
+        const char* p = d_map+(d_map_size*c)/num_chunks;
+        size_t k = chunk_offset[c]+1;
+        while (p != chunk_end && (p = static_cast<const char*>(std::memchr(p, '\n', chunk_end-p))))
+        {
+            d_line_start[k++] = (++p)-d_map;
+        }
+    }
+
+    // As with std::getline(), a final line that is not terminated by a newline
+    // character is a line, but an empty file has no lines.  The end of the last
+    // line is indicated by a (possibly virtual) terminating newline.
+    if (d_map_size > 0 && d_map[d_map_size-1] != '\n')
+    {
+        d_line_start.push_back(d_map_size+1);
+    }
+    return true;
+}// open
+
+void
+ASCIIFileParser::close()
+{
+    if (d_map) munmap(const_cast<char*>(d_map), d_map_size);
+    d_map = NULL;
+    d_map_size = 0;
+    d_line_start.clear();
+    return;
+}// close
+
+const char*
+ASCIIFileParser::parseDouble(
+    const char* const begin,
+    const char* const end,
+    double& value)
+{
+    // strtod() requires a null-terminated string, and it uses the decimal point
+    // character of the current C locale.  To parse the value in the "C"
+    // locale, the token is copied with each '.' replaced by the decimal point
+    // of the current locale.  The copy ends at any character that is the
+    // decimal point of the current locale but not of the "C" locale.  Short
+    // tokens are copied to a buffer on the stack to avoid allocating memory.
+    const char* const decimal_point = localeconv()->decimal_point;
+    const size_t decimal_point_length = std::max<size_t>(std::strlen(decimal_point), 1);
+    const bool c_decimal_point = decimal_point_length == 1 && decimal_point[0] == '.';
+    const size_t max_length = (end-begin)*decimal_point_length+1;
+    char buffer[TOKEN_BUFFER_SIZE];
+    std::string long_token;
+    char* token = buffer;
+    if (max_length > TOKEN_BUFFER_SIZE)
+    {
+        long_token.resize(max_length);
+        token = &long_token[0];
+    }
+    char* q = token;
+    for (const char* p = begin; p != end; ++p)
+    {
+        if (c_decimal_point || *p != '.')
+        {
+            if (!c_decimal_point && *p == decimal_point[0]) break;
+            *q++ = *p;
+        }
+        else
+        {
+            std::memcpy(q, decimal_point, decimal_point_length);
+            q += decimal_point_length;
+        }
+    }
+    *q = '\0';
+    char* token_end = NULL;
+    errno = 0;
+    value = strtod(token, &token_end);
+
+    // As with stream extraction, values that overflow or that underflow to zero
+    // are errors, but subnormal values are not.
+    if (errno == ERANGE && (value == 0.0 || std::abs(value) == HUGE_VAL)) return begin;
+
+    // Determine the position in the original string that corresponds to the
+    // end of the parsed value.
+    const char* p = begin;
+    for (const char* t = token; t < token_end; ++p)
+    {
+        t += (!c_decimal_point && *p == '.') ? decimal_point_length : 1;
+    }
+    return p;
+}// parseDouble
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+} // namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,220 @@
+// Filename: ASCIIFileParser.h
+// Created on 17 Oct 2026 by Boyce Griffith
+//
+//
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef included_ASCIIFileParser
+#define included_ASCIIFileParser
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/////////////////////////////// CLASS DEFINITION /////////////////////////////
+
+namespace IBTK
+{
+/*!
+ * \brief Class ASCIIFileParser provides fast random access to the lines of a
+ * memory-mapped ASCII input file, together with a locale-independent parser for
+ * the numeric values stored in each line.
+ *
+ * The file is split into lines when it is opened.  Large files are split into
+ * chunks at arbitrary byte positions that are processed by multiple threads
+ * (when the library is built with OpenMP).  Because the lines may be parsed in
+ * any order, the lines of a file may also be processed by multiple threads.
+ *
+ * Lines are split in the same way as by std::getline(), and any text following
+ * a '!', '#', or '%' character is discarded from each line.
+ */
+class ASCIIFileParser
+{
+public:
+    /*!
+     * \brief Class LineStream extracts numeric values from a single line of the
+     * input file.
+     *
+     * Values are extracted in the same way as by the stream extraction
+     * operators of an std::istringstream object initialized with the line,
+     * except that numbers are always parsed in the "C" locale.  In particular,
+     * once an extraction fails, all subsequent extractions also fail.
+     */
+    class LineStream
+    {
+    public:
+        /*!
+         * \brief Constructor.
+         */
+        LineStream(
+            const char* begin,
+            const char* end);
+
+        /*!
+         * \brief Extract an integer value.
+         *
+         * \return Whether the value was successfully extracted.
+         */
+        bool
+        read(
+            int& value);
+
+        /*!
+         * \brief Extract a double precision value.
+         *
+         * \return Whether the value was successfully extracted.
+         */
+        bool
+        read(
+            double& value);
+
+    private:
+        /*!
+         * \brief Skip any whitespace before the next value.
+         */
+        void
+        skipWhitespace();
+
+        /*
+         * The unread part of the line and whether an extraction has failed.
+         */
+        const char* d_pos;
+        const char* d_end;
+        bool d_failed;
+    };
+
+    /*!
+     * \brief Default constructor.
+     */
+    ASCIIFileParser();
+
+    /*!
+     * \brief Destructor.
+     */
+    ~ASCIIFileParser();
+
+    /*!
+     * \brief Map the specified file into memory and determine the positions of
+     * its lines using the specified number of threads.
+     *
+     * A nonpositive number of threads indicates that the default number of
+     * OpenMP threads is to be used.
+     *
+     * \return Whether the file could be opened.
+     */
+    bool
+    open(
+        const std::string& filename,
+        int num_threads=1);
+
+    /*!
+     * \brief Unmap the file (if any).
+     */
+    void
+    close();
+
+    /*!
+     * \brief Return the number of lines in the file.
+     */
+    int
+    getNumberOfLines() const;
+
+    /*!
+     * \brief Return a stream for reading the specified (zero-based) line of
+     * the file, with any comments discarded.
+     */
+    LineStream
+    getLineStream(
+        int line) const;
+
+    /*!
+     * \brief Parse the double precision value stored in a string.
+     *
+     * This is the fallback used by LineStream for values that cannot be parsed
+     * exactly using fast double precision arithmetic.  The value is parsed in
+     * the "C" locale, regardless of the current locale.
+     *
+     * \return The position following the parsed value, or \a begin if no value
+     * could be parsed or if the value overflows or underflows to zero.
+     */
+    static const char*
+    parseDouble(
+        const char* begin,
+        const char* end,
+        double& value);
+
+private:
+    /*!
+     * \brief Copy constructor.
+     *
+     * \note This constructor is not implemented and should not be used.
+     *
+     * \param from The value to copy to this object.
+     */
+    ASCIIFileParser(
+        const ASCIIFileParser& from);
+
+    /*!
+     * \brief Assignment operator.
+     *
+     * \note This operator is not implemented and should not be used.
+     *
+     * \param that The value to assign to this object.
+     *
+     * \return A reference to this object.
+     */
+    ASCIIFileParser&
+    operator=(
+        const ASCIIFileParser& that);
+
+    /*
+     * The mapped file.
+     */
+    const char* d_map;
+    size_t d_map_size;
+
+    /*
+     * The position of the first character of each line of the file.  The last
+     * entry is the position that follows the newline character terminating the
+     * last line (which need not be present in the file).
+     */
+    std::vector<size_t> d_line_start;
+};
+}// namespace IBTK
+
+/////////////////////////////// INLINE ///////////////////////////////////////
+
+#include "ibtk/ASCIIFileParser-inl.h"  // IWYU pragma: keep
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif //#ifndef included_ASCIIFileParser
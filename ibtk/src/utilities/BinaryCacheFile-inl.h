@@ -0,0 +1,92 @@
+// Filename: BinaryCacheFile-inl.h
+// Created on 17 Oct 2026 by Boyce Griffith
+//
+//
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef included_BinaryCacheFile_inl_h
+#define included_BinaryCacheFile_inl_h
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include "ibtk/BinaryCacheFile.h"
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBTK
+{
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+template<typename T>
+inline void
+BinaryCacheFile::read(
+    T* const data,
+    const size_t n)
+{
+    readBytes(data, n*sizeof(T));
+    return;
+}// read
+
+template<typename T>
+inline T
+BinaryCacheFile::read()
+{
+    T value = T();
+    readBytes(&value, sizeof(T));
+    return value;
+}// read
+
+template<typename T>
+inline void
+BinaryCacheFile::write(
+    const T* const data,
+    const size_t n)
+{
+    const char* const bytes = reinterpret_cast<const char*>(data);
+    d_buffer.insert(d_buffer.end(), bytes, bytes+n*sizeof(T));
+    return;
+}// write
+
+template<typename T>
+inline void
+BinaryCacheFile::write(
+    const T& value)
+{
+    write(&value, 1);
+    return;
+}// write
+
+//////////////////////////////////////////////////////////////////////////////
+
+}// namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif //#ifndef included_BinaryCacheFile_inl_h
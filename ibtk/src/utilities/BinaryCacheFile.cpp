@@ -0,0 +1,211 @@
+// Filename: BinaryCacheFile.cpp
+// Created on 17 Oct 2026 by Boyce Griffith
+//
+//
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "BinaryCacheFile.h"
+#include "ibtk/namespaces.h" // IWYU pragma: keep
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBTK
+{
+/////////////////////////////// STATIC ///////////////////////////////////////
+
+namespace
+{
+static const unsigned long long FNV_PRIME = 1099511628211ULL;
+static const size_t HASH_BUFFER_SIZE = 1048576;
+}
+
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+BinaryCacheFile::BinaryCacheFile()
+    : d_map(NULL),
+      d_map_size(0),
+      d_map_pos(0),
+      d_read_failed(false),
+      d_buffer()
+{
+    // intentionally blank
+    return;
+}// BinaryCacheFile
+
+BinaryCacheFile::~BinaryCacheFile()
+{
+    close();
+    return;
+}// ~BinaryCacheFile
+
+bool
+BinaryCacheFile::openForReading(
+    const std::string& filename)
+{
+    close();
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+    void* const map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) return false;
+    d_map = static_cast<const char*>(map);
+    d_map_size = st.st_size;
+    d_map_pos = 0;
+    d_read_failed = false;
+    return true;
+}// openForReading
+
+void
+BinaryCacheFile::close()
+{
+    if (d_map) munmap(const_cast<char*>(d_map), d_map_size);
+    d_map = NULL;
+    d_map_size = 0;
+    d_map_pos = 0;
+    d_read_failed = false;
+    d_buffer.clear();
+    return;
+}// close
+
+bool
+BinaryCacheFile::good() const
+{
+    return d_map && !d_read_failed;
+}// good
+
+bool
+BinaryCacheFile::commit(
+    const std::string& filename)
+{
+    std::ostringstream tmp_filename;
+    tmp_filename << filename << ".tmp." << getpid();
+    std::ofstream os(tmp_filename.str().c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!os.is_open()) return false;
+    if (!d_buffer.empty()) os.write(&d_buffer[0], d_buffer.size());
+    os.close();
+    if (!os || rename(tmp_filename.str().c_str(), filename.c_str()) != 0)
+    {
+        unlink(tmp_filename.str().c_str());
+        return false;
+    }
+    return true;
+}// commit
+
+BinaryCacheFile::FileStamp
+BinaryCacheFile::getFileStamp(
+    const std::string& filename,
+    const bool compute_hash)
+{
+    FileStamp stamp;
+    stamp.exists = 0;
+    stamp.size = 0;
+    stamp.mtime = 0;
+    stamp.hash = 0;
+    struct stat st;
+    if (stat(filename.c_str(), &st) == 0)
+    {
+        stamp.exists = 1;
+        stamp.size = st.st_size;
+        stamp.mtime = st.st_mtime;
+        if (compute_hash) stamp.hash = computeFileHash(filename);
+    }
+    return stamp;
+}// getFileStamp
+
+unsigned long long
+BinaryCacheFile::hashBytes(
+    const void* const data,
+    const size_t n,
+    unsigned long long hash)
+{
+    const unsigned char* const bytes = static_cast<const unsigned char*>(data);
+    for (size_t k = 0; k < n; ++k)
+    {
+        hash ^= bytes[k];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}// hashBytes
+
+unsigned long long
+BinaryCacheFile::computeFileHash(
+    const std::string& filename)
+{
+    unsigned long long hash = hashBytes(NULL, 0);
+    std::ifstream is(filename.c_str(), std::ios::in | std::ios::binary);
+    std::vector<char> buffer(HASH_BUFFER_SIZE);
+    while (is)
+    {
+        is.read(&buffer[0], buffer.size());
+        hash = hashBytes(&buffer[0], is.gcount(), hash);
+    }
+    return hash;
+}// computeFileHash
+
+/////////////////////////////// PRIVATE //////////////////////////////////////
+
+void
+BinaryCacheFile::readBytes(
+    void* const data,
+    const size_t n)
+{
+    if (d_read_failed || !d_map || n > d_map_size-d_map_pos)
+    {
+        d_read_failed = true;
+        std::memset(data, 0, n);
+        return;
+    }
+    std::memcpy(data, d_map+d_map_pos, n);
+    d_map_pos += n;
+    return;
+}// readBytes
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+} // namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
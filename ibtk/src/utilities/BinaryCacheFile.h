@@ -0,0 +1,232 @@
+// Filename: BinaryCacheFile.h
+// Created on 17 Oct 2026 by Boyce Griffith
+//
+//
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef included_BinaryCacheFile
+#define included_BinaryCacheFile
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/////////////////////////////// CLASS DEFINITION /////////////////////////////
+
+namespace IBTK
+{
+/*!
+ * \brief Class BinaryCacheFile provides simple sequential reading and writing
+ * of the flat binary files used to cache preprocessed input data (e.g., parsed
+ * Lagrangian structures) between runs.
+ *
+ * Data are written to an in-memory buffer that is committed to disk in a single
+ * step.  The file is first written under a temporary name and then renamed, so
+ * that a partially written cache file is never observed by concurrent runs.
+ * Cache files are read by mapping them into memory.
+ *
+ * The class also provides the file "stamps" (size, modification time, and
+ * content hash) that are used to determine whether a cache file is still
+ * consistent with the input files from which it was generated.
+ *
+ * \warning Values are stored in the native binary machine format.  Cache files
+ * are therefore not portable between machines with different data
+ * representations; a cache file that fails validation is simply regenerated.
+ */
+class BinaryCacheFile
+{
+public:
+    /*!
+     * \brief Identifying information for an input file.
+     */
+    struct FileStamp
+    {
+        int exists;
+        unsigned long long size;
+        long long mtime;
+        unsigned long long hash;
+    };
+
+    /*!
+     * \brief Default constructor.
+     */
+    BinaryCacheFile();
+
+    /*!
+     * \brief Destructor.
+     */
+    ~BinaryCacheFile();
+
+    /*!
+     * \brief Map the specified file into memory for reading.
+     *
+     * \return Whether the file could be opened and mapped.
+     */
+    bool
+    openForReading(
+        const std::string& filename);
+
+    /*!
+     * \brief Unmap the file (if any) and discard any buffered data.
+     */
+    void
+    close();
+
+    /*!
+     * \brief Return whether all reads have been satisfied by the data stored in
+     * the file.
+     */
+    bool
+    good() const;
+
+    /*!
+     * \brief Read an array of values from the file.
+     */
+    template<typename T>
+    void
+    read(
+        T* data,
+        size_t n);
+
+    /*!
+     * \brief Read a single value from the file.
+     */
+    template<typename T>
+    T
+    read();
+
+    /*!
+     * \brief Append an array of values to the write buffer.
+     */
+    template<typename T>
+    void
+    write(
+        const T* data,
+        size_t n);
+
+    /*!
+     * \brief Append a single value to the write buffer.
+     */
+    template<typename T>
+    void
+    write(
+        const T& value);
+
+    /*!
+     * \brief Write the contents of the write buffer to the specified file.
+     *
+     * \return Whether the file was successfully written.
+     */
+    bool
+    commit(
+        const std::string& filename);
+
+    /*!
+     * \brief Return the size and modification time of the specified file.
+     *
+     * The content hash is computed only if \a compute_hash is true; otherwise it
+     * is set to zero.
+     */
+    static FileStamp
+    getFileStamp(
+        const std::string& filename,
+        bool compute_hash);
+
+    /*!
+     * \brief Compute a 64-bit FNV-1a hash of a sequence of bytes.
+     */
+    static unsigned long long
+    hashBytes(
+        const void* data,
+        size_t n,
+        unsigned long long hash=14695981039346656037ULL);
+
+    /*!
+     * \brief Compute a 64-bit FNV-1a hash of the contents of a file.
+     */
+    static unsigned long long
+    computeFileHash(
+        const std::string& filename);
+
+private:
+    /*!
+     * \brief Copy constructor.
+     *
+     * \note This constructor is not implemented and should not be used.
+     *
+     * \param from The value to copy to this object.
+     */
+    BinaryCacheFile(
+        const BinaryCacheFile& from);
+
+    /*!
+     * \brief Assignment operator.
+     *
+     * \note This operator is not implemented and should not be used.
+     *
+     * \param that The value to assign to this object.
+     *
+     * \return A reference to this object.
+     */
+    BinaryCacheFile&
+    operator=(
+        const BinaryCacheFile& that);
+
+    /*!
+     * \brief Copy the next \a n bytes of the mapped file.
+     */
+    void
+    readBytes(
+        void* data,
+        size_t n);
+
+    /*
+     * The mapped file.
+     */
+    const char* d_map;
+    size_t d_map_size, d_map_pos;
+    bool d_read_failed;
+
+    /*
+     * The write buffer.
+     */
+    std::vector<char> d_buffer;
+};
+}// namespace IBTK
+
+/////////////////////////////// INLINE ///////////////////////////////////////
+
+#include "ibtk/BinaryCacheFile-inl.h"  // IWYU pragma: keep
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif //#ifndef included_BinaryCacheFile
@@ -0,0 +1,133 @@
+// Filename: SmallObjectArena-inl.h
+// Created on 17 Oct 2026 by Boyce Griffith
+//
+//
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef included_SmallObjectArena_inl_h
+#define included_SmallObjectArena_inl_h
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <new>
+
+#include "ibtk/SmallObjectArena.h"
+#include "ibtk/compiler_hints.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBTK
+{
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+inline void*
+SmallObjectArena::allocate(
+    const size_t size)
+{
+    if (UNLIKELY(size == 0 || size > MAX_OBJECT_SIZE)) return ::operator new(size);
+    const size_t size_class = (size-1)/ALIGNMENT;
+#ifdef _OPENMP
+    if (omp_in_parallel())
+    {
+        void* ptr;
+#pragma omp critical(IBTK_SmallObjectArena)
+        ptr = popBlock(size_class);
+        return ptr;
+    }
+#endif
+    return popBlock(size_class);
+}// allocate
+
+inline void
+SmallObjectArena::deallocate(
+    void* const ptr,
+    const size_t size)
+{
+    if (!ptr) return;
+    if (UNLIKELY(size == 0 || size > MAX_OBJECT_SIZE))
+    {
+        ::operator delete(ptr);
+        return;
+    }
+    const size_t size_class = (size-1)/ALIGNMENT;
+#ifdef _OPENMP
+    if (omp_in_parallel())
+    {
+#pragma omp critical(IBTK_SmallObjectArena)
+        pushBlock(ptr, size_class);
+        return;
+    }
+#endif
+    pushBlock(ptr, size_class);
+    return;
+}// deallocate
+
+inline size_t
+SmallObjectArena::getNumberOfAllocatedObjects()
+{
+    return s_num_allocated_objects;
+}// getNumberOfAllocatedObjects
+
+/////////////////////////////// PRIVATE //////////////////////////////////////
+
+inline void*
+SmallObjectArena::popBlock(
+    const size_t size_class)
+{
+    if (UNLIKELY(!s_free_list[size_class])) allocateChunk(size_class);
+    FreeBlock* const block = s_free_list[size_class];
+    s_free_list[size_class] = block->next;
+    ++s_num_allocated_objects;
+    return block;
+}// popBlock
+
+inline void
+SmallObjectArena::pushBlock(
+    void* const ptr,
+    const size_t size_class)
+{
+    FreeBlock* const block = static_cast<FreeBlock*>(ptr);
+    block->next = s_free_list[size_class];
+    s_free_list[size_class] = block;
+    --s_num_allocated_objects;
+    return;
+}// pushBlock
+
+//////////////////////////////////////////////////////////////////////////////
+
+}// namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif //#ifndef included_SmallObjectArena_inl_h
@@ -0,0 +1,197 @@
+// Filename: SmallObjectArena.cpp
+// Created on 17 Oct 2026 by Boyce Griffith
+//
+//
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+#include "SmallObjectArena.h"
+#include "ibtk/namespaces.h" // IWYU pragma: keep
+#include "tbox/ShutdownRegistry.h"
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+namespace IBTK
+{
+/////////////////////////////// STATIC ///////////////////////////////////////
+
+SmallObjectArena::FreeBlock* SmallObjectArena::s_free_list[SmallObjectArena::NUM_SIZE_CLASSES] = { NULL };
+std::vector<SmallObjectArena::Chunk>* SmallObjectArena::s_chunks = NULL;
+size_t SmallObjectArena::s_num_allocated_objects = 0;
+bool SmallObjectArena::s_registered_callback = false;
+unsigned char SmallObjectArena::s_shutdown_priority = 250;
+
+/////////////////////////////// PUBLIC ///////////////////////////////////////
+
+size_t
+SmallObjectArena::getReservedBytes()
+{
+    return (s_chunks ? s_chunks->size()*CHUNK_SIZE : 0);
+}// getReservedBytes
+
+void
+SmallObjectArena::releaseUnusedChunks()
+{
+#ifdef _OPENMP
+#pragma omp critical(IBTK_SmallObjectArena)
+#endif
+    {
+        if (s_chunks)
+        {
+            std::vector<Chunk> retained_chunks;
+            for (size_t size_class = 0; size_class < NUM_SIZE_CLASSES; ++size_class)
+            {
+                std::vector<char*> chunks;
+                for (std::vector<Chunk>::const_iterator it = s_chunks->begin(); it != s_chunks->end(); ++it)
+                {
+                    if (it->second == size_class) chunks.push_back(it->first);
+                }
+
+                // Chunks of size classes without free blocks are entirely in
+                // use.
+                if (!s_free_list[size_class])
+                {
+                    for (size_t k = 0; k < chunks.size(); ++k)
+                    {
+                        retained_chunks.push_back(std::make_pair(chunks[k], size_class));
+                    }
+                    continue;
+                }
+
+                // Sort the chunks and the free blocks of this size class by
+                // address.
+                std::sort(chunks.begin(), chunks.end());
+                std::vector<char*> blocks;
+                for (FreeBlock* block = s_free_list[size_class]; block; block = block->next)
+                {
+                    blocks.push_back(reinterpret_cast<char*>(block));
+                }
+                std::sort(blocks.begin(), blocks.end());
+
+                // Count the free blocks in each chunk.  A chunk is unused if
+                // all of its blocks are free.
+                const size_t block_size = (size_class+1)*ALIGNMENT;
+                const size_t num_blocks = CHUNK_SIZE/block_size;
+                std::vector<size_t> num_free_blocks(chunks.size(), 0);
+                for (std::vector<char*>::const_iterator it = blocks.begin(); it != blocks.end(); ++it)
+                {
+                    const size_t k = std::upper_bound(chunks.begin(), chunks.end(), *it)-chunks.begin()-1;
+                    ++num_free_blocks[k];
+                }
+
+                // Rebuild the free list from the blocks of the retained chunks
+                // and release the unused chunks.
+                FreeBlock* head = NULL;
+                for (std::vector<char*>::const_reverse_iterator it = blocks.rbegin(); it != blocks.rend(); ++it)
+                {
+                    const size_t k = std::upper_bound(chunks.begin(), chunks.end(), *it)-chunks.begin()-1;
+                    if (num_free_blocks[k] == num_blocks) continue;
+                    FreeBlock* const block = reinterpret_cast<FreeBlock*>(*it);
+                    block->next = head;
+                    head = block;
+                }
+                s_free_list[size_class] = head;
+                for (size_t k = 0; k < chunks.size(); ++k)
+                {
+                    if (num_free_blocks[k] == num_blocks)
+                    {
+                        ::operator delete(chunks[k]);
+                    }
+                    else
+                    {
+                        retained_chunks.push_back(std::make_pair(chunks[k], size_class));
+                    }
+                }
+            }
+            s_chunks->swap(retained_chunks);
+        }
+    }
+    return;
+}// releaseUnusedChunks
+
+void
+SmallObjectArena::releaseMemory()
+{
+    // The callback is removed from the ShutdownRegistry once it is invoked.
+    s_registered_callback = false;
+
+    // Objects that are still in use may reside in any chunk, so the chunks can
+    // be released only once all objects have been freed.
+    if (s_num_allocated_objects != 0 || !s_chunks) return;
+    for (std::vector<Chunk>::iterator it = s_chunks->begin(); it != s_chunks->end(); ++it)
+    {
+        ::operator delete(it->first);
+    }
+    delete s_chunks;
+    s_chunks = NULL;
+    std::fill(s_free_list, s_free_list+NUM_SIZE_CLASSES, static_cast<FreeBlock*>(NULL));
+    return;
+}// releaseMemory
+
+/////////////////////////////// PRIVATE //////////////////////////////////////
+
+void
+SmallObjectArena::allocateChunk(
+    const size_t size_class)
+{
+    if (!s_registered_callback)
+    {
+        ShutdownRegistry::registerShutdownRoutine(releaseMemory, s_shutdown_priority);
+        s_registered_callback = true;
+    }
+    if (!s_chunks) s_chunks = new std::vector<Chunk>();
+
+    // The chunk is obtained from the global operator new, so that each block
+    // is suitably aligned for any object of the corresponding size.
+    const size_t block_size = (size_class+1)*ALIGNMENT;
+    const size_t num_blocks = CHUNK_SIZE/block_size;
+    char* const chunk = static_cast<char*>(::operator new(CHUNK_SIZE));
+    s_chunks->push_back(std::make_pair(chunk, size_class));
+    FreeBlock* head = s_free_list[size_class];
+    for (size_t k = num_blocks; k > 0; --k)
+    {
+        FreeBlock* const block = reinterpret_cast<FreeBlock*>(chunk+(k-1)*block_size);
+        block->next = head;
+        head = block;
+    }
+    s_free_list[size_class] = head;
+    return;
+}// allocateChunk
+
+/////////////////////////////// NAMESPACE ////////////////////////////////////
+
+} // namespace IBTK
+
+//////////////////////////////////////////////////////////////////////////////
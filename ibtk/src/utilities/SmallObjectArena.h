@@ -0,0 +1,219 @@
+// Filename: SmallObjectArena.h
+// Created on 17 Oct 2026 by Boyce Griffith
+//
+//
+// Copyright (c) 2002-2013, Boyce Griffith
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright notice,
+//      this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of New York University nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+
+#ifndef included_SmallObjectArena
+#define included_SmallObjectArena
+
+/////////////////////////////// INCLUDES /////////////////////////////////////
+
+#include <stddef.h>
+#include <utility>
+#include <vector>
+
+/////////////////////////////// CLASS DEFINITION /////////////////////////////
+
+namespace IBTK
+{
+/*!
+ * \brief Class SmallObjectArena provides chunked storage for the small,
+ * individually allocated objects that describe the Lagrangian mesh (e.g.,
+ * LNode and Streamable objects).
+ *
+ * Storage is segregated by object size and carved out of large contiguous
+ * chunks.  Freed objects are returned to a per-size free list and are reused
+ * by subsequent allocations of the same size.  Consequently, the nodes that
+ * are created together (e.g., when the Lagrangian data are unpacked following
+ * redistribution) are stored together, and repeatedly redistributing millions
+ * of nodes per processor does not fragment the heap.
+ *
+ * Requests that are larger than MAX_OBJECT_SIZE are forwarded to the global
+ * operator new and operator delete.
+ *
+ * The arena may be used from within OpenMP parallel regions.  In that case,
+ * allocation and deallocation are serialized by a named critical section; the
+ * arena is not synchronized outside of parallel regions.
+ *
+ * \note Chunks are not returned to the heap automatically.  Chunks that no
+ * longer contain any objects in use are released by releaseUnusedChunks(),
+ * which LDataManager calls after redistributing the Lagrangian data; all
+ * chunks are released by releaseMemory() once all objects have been freed.
+ */
+class SmallObjectArena
+{
+public:
+    /*!
+     * \brief The largest object size (in bytes) that is allocated from the
+     * arena.
+     */
+    static const size_t MAX_OBJECT_SIZE = 256;
+
+    /*!
+     * \brief Allocate storage for an object of the specified size.
+     */
+    static void*
+    allocate(
+        size_t size);
+
+    /*!
+     * \brief Return storage that was obtained from allocate().
+     *
+     * \note The size must be the same as the size used to allocate the object.
+     */
+    static void
+    deallocate(
+        void* ptr,
+        size_t size);
+
+    /*!
+     * \return The number of objects presently allocated from the arena.
+     */
+    static size_t
+    getNumberOfAllocatedObjects();
+
+    /*!
+     * \return The total number of bytes presently reserved by the arena.
+     */
+    static size_t
+    getReservedBytes();
+
+    /*!
+     * \brief Release the chunks that do not contain any objects in use.
+     *
+     * The free lists of the size classes are rebuilt in address order, so that
+     * subsequent allocations of the same size are stored contiguously.
+     *
+     * \note The cost of this method grows with the number of free blocks held
+     * by the arena, so it should be called only occasionally (e.g., after the
+     * Lagrangian data have been redistributed).
+     */
+    static void
+    releaseUnusedChunks();
+
+    /*!
+     * \brief Release all chunks held by the arena, provided that no objects
+     * allocated from the arena remain in use.
+     *
+     * This method is automatically called by the ShutdownRegistry class.
+     */
+    static void
+    releaseMemory();
+
+private:
+    /*!
+     * \brief Default constructor.
+     *
+     * \note This constructor is not implemented and should not be used.
+     */
+    SmallObjectArena();
+
+    /*!
+     * \brief Copy constructor.
+     *
+     * \note This constructor is not implemented and should not be used.
+     *
+     * \param from The value to copy to this object.
+     */
+    SmallObjectArena(
+        const SmallObjectArena& from);
+
+    /*!
+     * \brief Assignment operator.
+     *
+     * \note This operator is not implemented and should not be used.
+     *
+     * \param that The value to assign to this object.
+     *
+     * \return A reference to this object.
+     */
+    SmallObjectArena&
+    operator=(
+        const SmallObjectArena& that);
+
+    /*!
+     * \brief Remove a block from the free list of the specified size class,
+     * allocating a new chunk if necessary.  This method is not synchronized.
+     */
+    static void*
+    popBlock(
+        size_t size_class);
+
+    /*!
+     * \brief Return a block to the free list of the specified size class.  This
+     * method is not synchronized.
+     */
+    static void
+    pushBlock(
+        void* ptr,
+        size_t size_class);
+
+    /*!
+     * \brief Allocate a new chunk for the specified size class and thread its
+     * blocks onto the corresponding free list.
+     */
+    static void
+    allocateChunk(
+        size_t size_class);
+
+    /*
+     * Objects are rounded up to a multiple of ALIGNMENT bytes.  Each size class
+     * is assigned its own free list.
+     */
+    static const size_t ALIGNMENT = 16;
+    static const size_t NUM_SIZE_CLASSES = MAX_OBJECT_SIZE/ALIGNMENT;
+    static const size_t CHUNK_SIZE = 64*1024;
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    /*
+     * The chunks held by the arena, along with the size class of each chunk.
+     */
+    typedef std::pair<char*,size_t> Chunk;
+
+    static FreeBlock* s_free_list[NUM_SIZE_CLASSES];
+    static std::vector<Chunk>* s_chunks;
+    static size_t s_num_allocated_objects;
+    static bool s_registered_callback;
+    static unsigned char s_shutdown_priority;
+};
+}// namespace IBTK
+
+/////////////////////////////// INLINE ///////////////////////////////////////
+
+#include "ibtk/SmallObjectArena-inl.h"  // IWYU pragma: keep
+
+//////////////////////////////////////////////////////////////////////////////
+
+#endif //#ifndef included_SmallObjectArena
@@ -33,6 +33,7 @@
 /////////////////////////////// INCLUDES /////////////////////////////////////
 
 #include "Streamable.h"
+#include "ibtk/SmallObjectArena.h"
 #include "ibtk/namespaces.h" // IWYU pragma: keep
 
 namespace SAMRAI {
@@ -64,6 +65,22 @@ Streamable::~Streamable()
     return;
 }// ~Streamable
 
+void*
+Streamable::operator new(
+    const size_t size)
+{
+    return SmallObjectArena::allocate(size);
+}// operator new
+
+void
+Streamable::operator delete(
+    void* const ptr,
+    const size_t size)
+{
+    SmallObjectArena::deallocate(ptr, size);
+    return;
+}// operator delete
+
 void
 Streamable::registerPeriodicShift(
     const IntVector<NDIM>& /*offset*/,
@@ -86,6 +86,22 @@ public:
     virtual
     ~Streamable();
 
+    /*!
+     * \brief Allocate storage for Streamable objects from the
+     * SmallObjectArena.
+     */
+    static void*
+    operator new(
+        size_t size);
+
+    /*!
+     * \brief Return storage for Streamable objects to the SmallObjectArena.
+     */
+    static void
+    operator delete(
+        void* ptr,
+        size_t size);
+
     /*!
      * \brief Return the unique class identifier used to specify the
      * StreamableFactory object used by the StreamableManager to extract
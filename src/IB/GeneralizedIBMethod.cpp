@@ -276,11 +276,12 @@ GeneralizedIBMethod::interpolateVelocity(
     const std::vector<Pointer<RefineSchedule<NDIM> > >& u_ghost_fill_scheds,
     const double data_time)
 {
-    // Interpolate the linear velocities.
-    IBMethod::interpolateVelocity(u_data_idx, u_synch_scheds, u_ghost_fill_scheds, data_time);
+    const int coarsest_ln = 0;
+    const int finest_ln = d_hierarchy->getFinestLevelNumber();
 
-    // Interpolate the angular velocities.
-    std::vector<Pointer<LData> >* W_data = NULL;
+    // Determine the Lagrangian data to be computed.
+    std::vector<Pointer<LData> >* U_data, * W_data = NULL;
+    getVelocityData(&U_data, data_time);
     if (MathUtilities<double>::equalEps(data_time, d_current_time))
     {
         W_data = &d_W_current_data;
@@ -296,6 +297,25 @@ GeneralizedIBMethod::interpolateVelocity(
         W_data = &d_W_new_data;
     }
 
+    // Synchronize and fill ghost values of the linear velocity, which are
+    // required to compute the angular velocity.
+    for (int ln = finest_ln; ln > coarsest_ln; --ln)
+    {
+        if (ln < static_cast<int>(u_synch_scheds.size()) && u_synch_scheds[ln])
+        {
+            u_synch_scheds[ln]->coarsenData();
+        }
+    }
+    for (int ln = coarsest_ln; ln <= finest_ln; ++ln)
+    {
+        if (!d_l_data_manager->levelContainsLagrangianData(ln)) continue;
+        if (ln < static_cast<int>(u_ghost_fill_scheds.size()) && u_ghost_fill_scheds[ln])
+        {
+            u_ghost_fill_scheds[ln]->fillData(data_time);
+        }
+    }
+
+    // Compute the angular velocity on the Eulerian grid.
     Pointer<Variable<NDIM> > u_var = d_ib_solver->getVelocityVariable();
     Pointer<CellVariable<NDIM,double> > u_cc_var = u_var;
     Pointer<SideVariable<NDIM,double> > u_sc_var = u_var;
@@ -314,12 +334,24 @@ GeneralizedIBMethod::interpolateVelocity(
         TBOX_ERROR(d_object_name << "::interpolateVelocity():\n"
                    << "  unsupported velocity data centering" << std::endl);
     }
+    getVelocityHierarchyDataOps()->scale(d_w_idx, 0.5, d_w_idx);
+
+    // Interpolate the linear and angular velocities in a single pass.
     std::vector<Pointer<LData> >* X_LE_data;
     bool* X_LE_needs_ghost_fill;
     getLECouplingPositionData(&X_LE_data, &X_LE_needs_ghost_fill, data_time);
-    getVelocityHierarchyDataOps()->scale(d_w_idx, 0.5, d_w_idx);
-    d_l_data_manager->interp(d_w_idx, *W_data, *X_LE_data, std::vector<Pointer<CoarsenSchedule<NDIM> > >(), getGhostfillRefineSchedules(d_object_name+"::w"), data_time);
-    resetAnchorPointValues(*W_data, /*coarsest_ln*/ 0, /*finest_ln*/ d_hierarchy->getFinestLevelNumber());
+    std::vector<int> f_data_idxs(2);
+    f_data_idxs[0] = u_data_idx;
+    f_data_idxs[1] = d_w_idx;
+    std::vector<std::vector<Pointer<LData> > > F_data(2);
+    F_data[0] = *U_data;
+    F_data[1] = *W_data;
+    std::vector<std::vector<Pointer<RefineSchedule<NDIM> > > > f_ghost_fill_scheds(2);
+    f_ghost_fill_scheds[1] = getGhostfillRefineSchedules(d_object_name+"::w");
+    d_l_data_manager->interp(f_data_idxs, F_data, *X_LE_data, std::vector<std::vector<Pointer<CoarsenSchedule<NDIM> > > >(), f_ghost_fill_scheds, data_time);
+    resetAnchorPointValues(*U_data, coarsest_ln, finest_ln);
+    resetAnchorPointValues(*W_data, coarsest_ln, finest_ln);
+    d_U_half_needs_reinit = !MathUtilities<double>::equalEps(data_time, d_half_time);
     return;
 }// interpolateVelocity
 
@@ -40,6 +40,7 @@
 #include "ibtk/IBTK_CHKERRQ.h"
 #include "ibtk/IndexUtilities.h"
 #include "ibtk/LEInteractor.h"
+#include "ibtk/LWorkloadModel.h"
 #include "ibtk/libmesh_utilities.h"
 #include "libmesh/boundary_info.h"
 #include "libmesh/dense_vector.h"
@@ -553,7 +554,10 @@ IBFEMethod::computeLagrangianForce(
         }
         else
         {
+            Pointer<LWorkloadModel> workload_model = d_fe_data_managers[part]->getWorkloadModel();
+            const double start_time = (workload_model ? MPI_Wtime() : 0.0);
             computeInteriorForceDensity(*d_F_half_vecs[part], *d_X_half_vecs[part], data_time, part);
+            if (workload_model) workload_model->addPointWorkTime(MPI_Wtime()-start_time);
         }
     }
     return;
@@ -1855,6 +1859,7 @@ IBFEMethod::commonConstructor(
     d_fe_order = INVALID_ORDER;
     d_quad_type = QGAUSS;
     d_quad_order = FIFTH;
+    d_use_measured_workload_estimates = false;
     d_do_log = false;
 
     // Indicate that all of the parts are unconstrained by default and set some
@@ -1951,6 +1956,7 @@ IBFEMethod::commonConstructor(
         d_equation_systems[part] = new EquationSystems(*d_meshes[part]);
         EquationSystems* equation_systems = d_equation_systems[part];
         d_fe_data_managers[part]->setEquationSystems(equation_systems, max_level_number-1);
+        d_fe_data_managers[part]->setUseMeasuredWorkloadEstimates(d_use_measured_workload_estimates);
     }
 
     // Reset the current time step interval.
@@ -1980,6 +1986,16 @@ IBFEMethod::getFromInput(
         if      (db->isString("interp_delta_fcn"       )) d_interp_delta_fcn = db->getString("interp_delta_fcn"       );
         else if (db->isString("interpolation_delta_fcn")) d_interp_delta_fcn = db->getString("interpolation_delta_fcn");
         else if (db->isString("delta_fcn"              )) d_interp_delta_fcn = db->getString("delta_fcn"              );
+        if (!LEInteractor::isAvailableWeightingFunction(d_spread_delta_fcn))
+        {
+            TBOX_ERROR(d_object_name << "::getFromInput():\n"
+                       << "  spreading delta function " << d_spread_delta_fcn << " is not available for NDIM = " << NDIM << std::endl);
+        }
+        if (!LEInteractor::isAvailableWeightingFunction(d_interp_delta_fcn))
+        {
+            TBOX_ERROR(d_object_name << "::getFromInput():\n"
+                       << "  interpolation delta function " << d_interp_delta_fcn << " is not available for NDIM = " << NDIM << std::endl);
+        }
 
         if (db->isBool("split_forces")) d_split_forces = db->getBool("split_forces");
         if (db->isBool("use_jump_conditions")) d_use_jump_conditions = db->getBool("use_jump_conditions");
@@ -1999,6 +2015,7 @@ IBFEMethod::getFromInput(
     if      (db->keyExists("do_log"        )) d_do_log = db->getBool("do_log"        );
     else if (db->keyExists("enable_logging")) d_do_log = db->getBool("enable_logging");
 
+    if (db->isBool("use_measured_workload_estimates")) d_use_measured_workload_estimates = db->getBool("use_measured_workload_estimates");
     if (db->isDouble("constraint_omega")) d_constraint_omega = db->getDouble("constraint_omega");
     return;
 }// getFromInput
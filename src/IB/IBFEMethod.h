@@ -577,6 +577,7 @@ protected:
     libMeshEnums::Order d_fe_order;
     libMeshEnums::QuadratureType d_quad_type;
     libMeshEnums::Order d_quad_order;
+    bool d_use_measured_workload_estimates;
 
     /*
      * Data related to handling constrained body constraints.
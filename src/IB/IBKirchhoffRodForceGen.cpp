@@ -74,6 +74,10 @@
 #include "tbox/Utilities.h"
 // IWYU pragma: no_include "petsc-private/vecimpl.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 // FORTRAN ROUTINES
 #define DSQRTM_FC FC_FUNC(dsqrtm,DSQRTM)
 extern "C"
@@ -207,7 +211,9 @@ IBKirchhoffRodForceGen::IBKirchhoffRodForceGen(
       d_petsc_curr_node_idxs(),
       d_petsc_next_node_idxs(),
       d_material_params(),
-      d_is_initialized()
+      d_is_initialized(),
+      d_petsc_mapping_version(),
+      d_num_threads(1)
 {
     // Initialize object with data read from the input database.
     getFromInput(input_db);
@@ -270,6 +276,17 @@ IBKirchhoffRodForceGen::initializeLevelData(
     d_petsc_next_node_idxs.resize(new_size);
     d_material_params.resize(new_size);
     d_is_initialized.resize(new_size, false);
+    d_petsc_mapping_version.resize(new_size, -1);
+
+    // The cached data only depend on the force specifications of the local
+    // nodes and on the global PETSc ordering, and so they remain valid if the
+    // ordering has not changed since the data were last initialized.
+    const int petsc_mapping_version = l_data_manager->getPETScMappingVersion(level_num);
+    if (d_is_initialized[level_num] && d_petsc_mapping_version[level_num] == petsc_mapping_version)
+    {
+        IBAMR_TIMER_STOP(t_initialize_level_data);
+        return;
+    }
 
     Mat& D_next_mat = d_D_next_mats[level_num];
     Mat& X_next_mat = d_X_next_mats[level_num];
@@ -421,6 +438,7 @@ IBKirchhoffRodForceGen::initializeLevelData(
 
     // Indicate that the level data has been initialized.
     d_is_initialized[level_num] = true;
+    d_petsc_mapping_version[level_num] = petsc_mapping_version;
 
     IBAMR_TIMER_STOP(t_initialize_level_data);
     return;
@@ -494,7 +512,14 @@ IBKirchhoffRodForceGen::computeLagrangianForceAndTorque(
     std::vector<double> F_next_node_vals(NDIM*local_sz,0.0);
     std::vector<double> N_next_node_vals(NDIM*local_sz,0.0);
 
-    for (unsigned int k = 0; k < local_sz; ++k)
+    // The forces and torques generated by each rod are stored separately, and
+    // so the rods may be processed concurrently without coloring; they are
+    // accumulated at the nodes below by VecSetValuesBlocked().
+#ifdef _OPENMP
+    const int num_threads = (d_num_threads > 0 ? d_num_threads : omp_get_max_threads());
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic,64)
+#endif
+    for (int k = 0; k < static_cast<int>(local_sz); ++k)
     {
         // Compute the forces applied by the rod to the "current" and "next"
         // nodes.
@@ -567,7 +592,7 @@ IBKirchhoffRodForceGen::getFromInput(
 {
     if (db)
     {
-        // intentionally blank
+        if (db->keyExists("num_threads")) d_num_threads = db->getInteger("num_threads");
     }
     return;
 }// getFromInput
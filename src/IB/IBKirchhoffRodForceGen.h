@@ -67,6 +67,10 @@ namespace IBAMR
  *
  * \note Class IBKirchhoffRodForceGen DOES NOT correct for periodic
  * displacements of IB points.
+ *
+ * \note When IBAMR is built with OpenMP support, the rod forces and torques
+ * may be computed by multiple threads by setting the input database key \p
+ * num_threads (zero indicates the OpenMP default; the default value is one).
  */
 class IBKirchhoffRodForceGen
     : public SAMRAI::tbox::DescribedClass
@@ -154,7 +158,13 @@ private:
     std::vector<std::vector<int> > d_petsc_curr_node_idxs, d_petsc_next_node_idxs;
     std::vector<std::vector<blitz::TinyVector<double,IBRodForceSpec::NUM_MATERIAL_PARAMS> > > d_material_params;
     std::vector<bool> d_is_initialized;
+    std::vector<int> d_petsc_mapping_version;
     //\}
+
+    /*!
+     * \brief The number of threads used to compute the forces and torques.
+     */
+    int d_num_threads;
 };
 }// namespace IBAMR
 
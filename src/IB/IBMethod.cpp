@@ -87,6 +87,7 @@
 #include "ibtk/LNodeIndex-inl.h"
 #include "ibtk/LNode-inl.h"
 #include "ibtk/LSiloDataWriter.h"
+#include "ibtk/LWorkloadModel.h"
 #include "petscsys.h"
 #include "tbox/Array.h"
 #include "tbox/Database.h"
@@ -165,6 +166,9 @@ IBMethod::IBMethod(
     const int stencil_size = std::max(LEInteractor::getStencilSize(d_interp_delta_fcn),LEInteractor::getStencilSize(d_spread_delta_fcn));
     d_ghosts = static_cast<int>(floor(0.5*static_cast<double>(stencil_size)))+1;
     d_do_log = false;
+    d_use_cached_le_operators = false;
+    d_le_operator_displacement_threshold = 0.0;
+    d_use_measured_workload_estimates = false;
 
     // Initialize object with data read from the input and restart databases.
     bool from_restart = RestartManager::getManager()->isFromRestart();
@@ -181,6 +185,8 @@ IBMethod::IBMethod(
     // Get the Lagrangian Data Manager.
     d_l_data_manager = LDataManager::getManager(d_object_name+"::LDataManager", d_interp_delta_fcn, d_spread_delta_fcn, d_ghosts, d_registered_for_restart);
     d_ghosts = d_l_data_manager->getGhostCellWidth();
+    d_l_data_manager->setUseCachedLEOperators(d_use_cached_le_operators, d_le_operator_displacement_threshold);
+    d_l_data_manager->setUseMeasuredWorkloadEstimates(d_use_measured_workload_estimates);
 
     // Create the instrument panel object.
     d_instrument_panel = new IBInstrumentPanel(d_object_name+"::IBInstrumentPanel", (input_db->isDatabase("IBInstrumentPanel") ? input_db->getDatabase("IBInstrumentPanel") : Pointer<Database>(NULL)));
@@ -501,6 +507,7 @@ IBMethod::updateFixedLEOperators()
     }
     d_X_LE_new_needs_ghost_fill = true;
     d_X_LE_half_needs_reinit    = true;
+    d_l_data_manager->resetCachedLEOperators();
     return;
 }// updateFixedLEOperators
 
@@ -629,7 +636,10 @@ IBMethod::computeLagrangianForce(
         ierr = VecSet((*F_data)[ln]->getVec(), 0.0);  IBTK_CHKERRQ(ierr);
         if (d_ib_force_fcn)
         {
+            Pointer<LWorkloadModel> workload_model = d_l_data_manager->getWorkloadModel();
+            const double start_time = (workload_model ? MPI_Wtime() : 0.0);
             d_ib_force_fcn->computeLagrangianForce((*F_data)[ln], (*X_data)[ln], (*U_data)[ln], d_hierarchy, ln, data_time, d_l_data_manager);
+            if (workload_model) workload_model->addPointWorkTime(MPI_Wtime()-start_time);
         }
     }
     *F_needs_ghost_fill = true;
@@ -1696,6 +1706,16 @@ IBMethod::getFromInput(
             d_interp_delta_fcn = db->getString("delta_fcn");
             d_spread_delta_fcn = db->getString("delta_fcn");
         }
+        if (!LEInteractor::isAvailableWeightingFunction(d_interp_delta_fcn))
+        {
+            TBOX_ERROR(d_object_name << "::getFromInput():\n"
+                       << "  interpolation delta function " << d_interp_delta_fcn << " is not available for NDIM = " << NDIM << std::endl);
+        }
+        if (!LEInteractor::isAvailableWeightingFunction(d_spread_delta_fcn))
+        {
+            TBOX_ERROR(d_object_name << "::getFromInput():\n"
+                       << "  spreading delta function " << d_spread_delta_fcn << " is not available for NDIM = " << NDIM << std::endl);
+        }
 
         if (db->isInteger("min_ghost_cell_width"))
         {
@@ -1710,6 +1730,9 @@ IBMethod::getFromInput(
     }
     if      (db->keyExists("do_log"        )) d_do_log = db->getBool("do_log"        );
     else if (db->keyExists("enable_logging")) d_do_log = db->getBool("enable_logging");
+    if (db->keyExists("use_cached_le_operators")) d_use_cached_le_operators = db->getBool("use_cached_le_operators");
+    if (db->keyExists("le_operator_displacement_threshold")) d_le_operator_displacement_threshold = db->getDouble("le_operator_displacement_threshold");
+    if (db->keyExists("use_measured_workload_estimates")) d_use_measured_workload_estimates = db->getBool("use_measured_workload_estimates");
     return;
 }// getFromInput
 
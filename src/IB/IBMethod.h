@@ -554,6 +554,20 @@ protected:
     std::string d_interp_delta_fcn, d_spread_delta_fcn;
     SAMRAI::hier::IntVector<NDIM> d_ghosts;
 
+    /*
+     * Whether the LDataManager caches explicit interpolation and spreading
+     * operators, and the node displacement (in units of the grid spacing) that
+     * triggers the reconstruction of those operators.
+     */
+    bool d_use_cached_le_operators;
+    double d_le_operator_displacement_threshold;
+
+    /*
+     * Whether the Lagrangian contribution to the workload estimates is
+     * calibrated from timings measured during the simulation.
+     */
+    bool d_use_measured_workload_estimates;
+
     /*
      * Lagrangian variables.
      */
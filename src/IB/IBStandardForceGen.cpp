@@ -43,6 +43,7 @@
 #include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "IBStandardForceGen.h"
 #include "PatchHierarchy.h"
@@ -72,9 +73,14 @@
 #include "ibtk/compiler_hints.h"
 #include "petscsys.h"
 #include "petscvec.h"
+#include "tbox/Database.h"
 #include "tbox/Utilities.h"
 // IWYU pragma: no_include "petsc-private/vecimpl.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /////////////////////////////// NAMESPACE ////////////////////////////////////
 
 namespace IBAMR
@@ -134,12 +140,735 @@ resetLocalOrNonlocalPETScIndices(
     }
     return;
 }// resetLocalOrNonlocalPETScIndices
+
+template<class T>
+void
+permuteArray(
+    blitz::Array<T,1>& array,
+    const std::vector<int>& perm)
+{
+#ifdef DEBUG_CHECK_ASSERTIONS
+    TBOX_ASSERT(array.size() == static_cast<int>(perm.size()));
+#endif
+    const blitz::Array<T,1> array_copy(array.copy());
+    for (unsigned int k = 0; k < perm.size(); ++k)
+    {
+        array(k) = array_copy(perm[k]);
+    }
+    return;
+}// permuteArray
+
+inline int
+get_num_threads(
+    const int num_threads)
+{
+#ifdef _OPENMP
+    return (num_threads > 0 ? num_threads : omp_get_max_threads());
+#else
+    NULL_USE(num_threads);
+    return 1;
+#endif
+}// get_num_threads
+
+// Greedily color the force elements k_begin <= k < k_end so that no two
+// elements of the same color share a node.  The elements are appended to perm
+// grouped by color, and the position of the first element of each color is
+// appended to color_offsets.  The node indices are local PETSc indices that
+// correspond to a data depth of NDIM.
+//
+// NOTE: node_color must be initialized to -1 and may be reused for
+// consecutive ranges of force elements provided that num_colors is also
+// reused.
+void
+color_force_elements(
+    std::vector<int>& perm,
+    std::vector<int>& color_offsets,
+    std::vector<int>& node_color,
+    int& num_colors,
+    const int k_begin,
+    const int k_end,
+    const std::vector<const blitz::Array<int,1>*>& node_idxs)
+{
+    std::vector<int> uncolored, deferred;
+    uncolored.reserve(k_end-k_begin);
+    for (int k = k_begin; k < k_end; ++k)
+    {
+        uncolored.push_back(k);
+    }
+    while (!uncolored.empty())
+    {
+        const int color = num_colors++;
+        color_offsets.push_back(perm.size());
+        deferred.clear();
+        for (std::vector<int>::const_iterator cit = uncolored.begin(); cit != uncolored.end(); ++cit)
+        {
+            const int k = *cit;
+            bool conflict = false;
+            for (unsigned int i = 0; i < node_idxs.size() && !conflict; ++i)
+            {
+                conflict = (node_color[(*node_idxs[i])(k)/NDIM] == color);
+            }
+            if (conflict)
+            {
+                deferred.push_back(k);
+                continue;
+            }
+            for (unsigned int i = 0; i < node_idxs.size(); ++i)
+            {
+                node_color[(*node_idxs[i])(k)/NDIM] = color;
+            }
+            perm.push_back(k);
+        }
+        uncolored.swap(deferred);
+    }
+    return;
+}// color_force_elements
+
+// Apply the kernel to the force elements k_begin <= k < k_end.  When multiple
+// threads are used, the colors are processed one after another, and the
+// elements of each color are split into chunks that are processed
+// concurrently.  An empty set of color offsets indicates that the elements have
+// not been colored, in which case they are processed serially.
+template<class Kernel>
+void
+apply_force_kernel(
+    const Kernel& kernel,
+    const int k_begin,
+    const int k_end,
+    const std::vector<int>& color_offsets,
+    const int num_threads)
+{
+    if (k_end <= k_begin) return;
+#ifdef _OPENMP
+    if (num_threads > 1 && !color_offsets.empty())
+    {
+        static const int CHUNK_SIZE = 256;  // This parameter needs to be tuned.
+        std::vector<int>::const_iterator next_color = std::upper_bound(color_offsets.begin(), color_offsets.end(), k_begin);
+        int color_begin = k_begin;
+        while (color_begin < k_end)
+        {
+            const int color_end = (next_color != color_offsets.end() && *next_color < k_end ? *next_color++ : k_end);
+            const int num_chunks = (color_end-color_begin+CHUNK_SIZE-1)/CHUNK_SIZE;
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic,1)
+            for (int chunk = 0; chunk < num_chunks; ++chunk)
+            {
+                const int chunk_begin = color_begin+chunk*CHUNK_SIZE;
+                kernel(chunk_begin, std::min(chunk_begin+CHUNK_SIZE,color_end));
+            }
+            color_begin = color_end;
+        }
+        return;
+    }
+#else
+    NULL_USE(color_offsets);
+    NULL_USE(num_threads);
+#endif
+    kernel(k_begin, k_end);
+    return;
+}// apply_force_kernel
+
+// Compute the forces generated by springs with arbitrary force functions.
+struct SpringForceKernel
+{
+    const int* lag_mastr_node_idxs;
+    const int* lag_slave_node_idxs;
+    const int* petsc_mastr_node_idxs;
+    const int* petsc_slave_node_idxs;
+    const SpringForceFcnPtr* force_fcns;
+    const double** parameters;
+    double* F_node;
+    const double* X_node;
+
+    void
+    operator()(
+        const int k_begin,
+        const int k_end) const
+    {
+        const int num_springs = k_end-k_begin;
+        const int*               const restrict   lag_mastr_node_idxs = this->lag_mastr_node_idxs  +k_begin;
+        const int*               const restrict   lag_slave_node_idxs = this->lag_slave_node_idxs  +k_begin;
+        const int*               const restrict petsc_mastr_node_idxs = this->petsc_mastr_node_idxs+k_begin;
+        const int*               const restrict petsc_slave_node_idxs = this->petsc_slave_node_idxs+k_begin;
+        const SpringForceFcnPtr* const restrict            force_fcns = this->force_fcns           +k_begin;
+        const double**           const restrict            parameters = this->parameters           +k_begin;
+        double*                  const restrict                F_node = this->F_node;
+        const double*            const restrict                X_node = this->X_node;
+
+        static const int BLOCKSIZE = 16;  // This parameter needs to be tuned.
+        int k, kblock, kunroll, mastr_idx, slave_idx;
+        double F[NDIM], D[NDIM], R, T_over_R;
+        kblock = 0;
+        for ( ; kblock < (num_springs-1)/BLOCKSIZE; ++kblock)  // ensure that the last block is NOT handled by this first loop
+        {
+            PREFETCH_READ_NTA_BLOCK(  lag_mastr_node_idxs+BLOCKSIZE*(kblock+1), BLOCKSIZE);
+            PREFETCH_READ_NTA_BLOCK(  lag_slave_node_idxs+BLOCKSIZE*(kblock+1), BLOCKSIZE);
+            PREFETCH_READ_NTA_BLOCK(petsc_mastr_node_idxs+BLOCKSIZE*(kblock+1), BLOCKSIZE);
+            PREFETCH_READ_NTA_BLOCK(petsc_slave_node_idxs+BLOCKSIZE*(kblock+1), BLOCKSIZE);
+            PREFETCH_READ_NTA_BLOCK(           force_fcns+BLOCKSIZE*(kblock+1), BLOCKSIZE);
+            PREFETCH_READ_NTA_BLOCK(           parameters+BLOCKSIZE*(kblock+1), BLOCKSIZE);
+            for (kunroll = 0; kunroll < BLOCKSIZE; ++kunroll)
+            {
+                k = kblock*BLOCKSIZE+kunroll;
+                mastr_idx = petsc_mastr_node_idxs[k];
+                slave_idx = petsc_slave_node_idxs[k];
+#ifdef DEBUG_CHECK_ASSERTIONS
+                TBOX_ASSERT(mastr_idx != slave_idx);
+#endif
+                PREFETCH_READ_NTA_NDIM_BLOCK(F_node+petsc_mastr_node_idxs[k+1]);
+                PREFETCH_READ_NTA_NDIM_BLOCK(F_node+petsc_slave_node_idxs[k+1]);
+                PREFETCH_READ_NTA_NDIM_BLOCK(X_node+petsc_mastr_node_idxs[k+1]);
+                PREFETCH_READ_NTA_NDIM_BLOCK(X_node+petsc_slave_node_idxs[k+1]);
+                PREFETCH_READ_NTA(                             parameters[k+1]);
+                D[0] = X_node[slave_idx+0] - X_node[mastr_idx+0];
+                D[1] = X_node[slave_idx+1] - X_node[mastr_idx+1];
+#if (NDIM == 3)
+                D[2] = X_node[slave_idx+2] - X_node[mastr_idx+2];
+#endif
+#if (NDIM == 2)
+                R = sqrt(D[0]*D[0]+D[1]*D[1]);
+#endif
+#if (NDIM == 3)
+                R = sqrt(D[0]*D[0]+D[1]*D[1]+D[2]*D[2]);
+#endif
+                if (UNLIKELY(R < std::numeric_limits<double>::epsilon())) continue;
+                T_over_R = (force_fcns[k])(R,parameters[k],lag_mastr_node_idxs[k],lag_slave_node_idxs[k])/R;
+                F[0] = T_over_R*D[0];
+                F[1] = T_over_R*D[1];
+#if (NDIM == 3)
+                F[2] = T_over_R*D[2];
+#endif
+                F_node[mastr_idx+0] += F[0];
+                F_node[mastr_idx+1] += F[1];
+#if (NDIM == 3)
+                F_node[mastr_idx+2] += F[2];
+#endif
+                F_node[slave_idx+0] -= F[0];
+                F_node[slave_idx+1] -= F[1];
+#if (NDIM == 3)
+                F_node[slave_idx+2] -= F[2];
+#endif
+            }
+        }
+        for (k = kblock*BLOCKSIZE; k < num_springs; ++k)
+        {
+            mastr_idx = petsc_mastr_node_idxs[k];
+            slave_idx = petsc_slave_node_idxs[k];
+#ifdef DEBUG_CHECK_ASSERTIONS
+            TBOX_ASSERT(mastr_idx != slave_idx);
+#endif
+            D[0] = X_node[slave_idx+0] - X_node[mastr_idx+0];
+            D[1] = X_node[slave_idx+1] - X_node[mastr_idx+1];
+#if (NDIM == 3)
+            D[2] = X_node[slave_idx+2] - X_node[mastr_idx+2];
+#endif
+#if (NDIM == 2)
+            R = sqrt(D[0]*D[0]+D[1]*D[1]);
+#endif
+#if (NDIM == 3)
+            R = sqrt(D[0]*D[0]+D[1]*D[1]+D[2]*D[2]);
+#endif
+            if (UNLIKELY(R < std::numeric_limits<double>::epsilon())) continue;
+            T_over_R = (force_fcns[k])(R,parameters[k],lag_mastr_node_idxs[k],lag_slave_node_idxs[k])/R;
+            F[0] = T_over_R*D[0];
+            F[1] = T_over_R*D[1];
+#if (NDIM == 3)
+            F[2] = T_over_R*D[2];
+#endif
+            F_node[mastr_idx+0] += F[0];
+            F_node[mastr_idx+1] += F[1];
+#if (NDIM == 3)
+            F_node[mastr_idx+2] += F[2];
+#endif
+            F_node[slave_idx+0] -= F[0];
+            F_node[slave_idx+1] -= F[1];
+#if (NDIM == 3)
+            F_node[slave_idx+2] -= F[2];
+#endif
+        }
+        return;
+    }// operator()
+};
+
+// Compute the forces generated by springs that use default_spring_force().
+//
+// The springs are processed in blocks.  For each block, the node positions and
+// spring parameters are first gathered into contiguous arrays.  The spring
+// forces are then computed by a loop that involves neither function calls nor
+// indirect memory accesses, which permits the compiler to vectorize it.
+// Finally, the forces are accumulated at the nodes.
+//
+// NOTE: The parameters are read from the force specification objects each time
+// the forces are computed, so that modifications to the parameters take effect
+// immediately.
+struct DefaultSpringForceKernel
+{
+    const int* petsc_mastr_node_idxs;
+    const int* petsc_slave_node_idxs;
+    const double** parameters;
+    double* F_node;
+    const double* X_node;
+
+    void
+    operator()(
+        const int k_begin,
+        const int k_end) const
+    {
+        const int num_springs = k_end-k_begin;
+        const int*     const restrict petsc_mastr_node_idxs = this->petsc_mastr_node_idxs+k_begin;
+        const int*     const restrict petsc_slave_node_idxs = this->petsc_slave_node_idxs+k_begin;
+        const double** const restrict            parameters = this->parameters           +k_begin;
+        double*        const restrict                F_node = this->F_node;
+        const double*  const restrict                X_node = this->X_node;
+
+        static const int BLOCKSIZE = 64;  // This parameter needs to be tuned.
+        static const double eps = std::numeric_limits<double>::epsilon();
+        double D[NDIM][BLOCKSIZE], kappa[BLOCKSIZE], rest_length[BLOCKSIZE], T_over_R[BLOCKSIZE];
+        for (int kblock = 0; kblock < num_springs; kblock += BLOCKSIZE)
+        {
+            const int block_size = std::min(BLOCKSIZE, num_springs-kblock);
+            const int* const restrict mastr_idxs = petsc_mastr_node_idxs+kblock;
+            const int* const restrict slave_idxs = petsc_slave_node_idxs+kblock;
+            for (int j = 0; j < block_size; ++j)
+            {
+                const double* const restrict X_mastr = X_node+mastr_idxs[j];
+                const double* const restrict X_slave = X_node+slave_idxs[j];
+#ifdef DEBUG_CHECK_ASSERTIONS
+                TBOX_ASSERT(mastr_idxs[j] != slave_idxs[j]);
+#endif
+                for (unsigned int d = 0; d < NDIM; ++d)
+                {
+                    D[d][j] = X_slave[d] - X_mastr[d];
+                }
+                kappa      [j] = parameters[kblock+j][0];
+                rest_length[j] = parameters[kblock+j][1];
+            }
+            for (int j = 0; j < block_size; ++j)
+            {
+#if (NDIM == 2)
+                const double R = sqrt(D[0][j]*D[0][j]+D[1][j]*D[1][j]);
+#endif
+#if (NDIM == 3)
+                const double R = sqrt(D[0][j]*D[0][j]+D[1][j]*D[1][j]+D[2][j]*D[2][j]);
+#endif
+                T_over_R[j] = (R < eps ? 0.0 : kappa[j]*(R-rest_length[j])/R);
+            }
+            for (int j = 0; j < block_size; ++j)
+            {
+                double* const F_mastr = F_node+mastr_idxs[j];
+                double* const F_slave = F_node+slave_idxs[j];
+                for (unsigned int d = 0; d < NDIM; ++d)
+                {
+                    const double F = T_over_R[j]*D[d][j];
+                    F_mastr[d] += F;
+                    F_slave[d] -= F;
+                }
+            }
+        }
+        return;
+    }// operator()
+};
+
+// Compute the blocks of the Jacobian of the spring forces.  The block for
+// spring k is the Jacobian of the force applied to the "master" node with
+// respect to the position of the "slave" node; is_valid[k] is zero for springs
+// of zero length, which do not contribute to the Jacobian.
+struct SpringForceJacobianKernel
+{
+    const int* lag_mastr_node_idxs;
+    const int* lag_slave_node_idxs;
+    const int* petsc_mastr_node_idxs;
+    const int* petsc_slave_node_idxs;
+    const SpringForceFcnPtr* force_fcns;
+    const SpringForceDerivFcnPtr* force_deriv_fcns;
+    const double** parameters;
+    const double* X_node;
+    double X_coef;
+    double* dF_dX_blocks;
+    int* is_valid;
+
+    void
+    operator()(
+        const int k_begin,
+        const int k_end) const
+    {
+        double D[NDIM], R, T, dT_dR, eps;
+        for (int k = k_begin; k < k_end; ++k)
+        {
+            const int& lag_mastr_idx = lag_mastr_node_idxs[k];
+            const int& lag_slave_idx = lag_slave_node_idxs[k];
+            const int petsc_mastr_idx = petsc_mastr_node_idxs[k];
+            const int petsc_slave_idx = petsc_slave_node_idxs[k];
+            const SpringForceFcnPtr force_fcn = force_fcns[k];
+            const SpringForceDerivFcnPtr force_deriv_fcn = force_deriv_fcns[k];
+            const double* const params = parameters[k];
+
+            D[0] = X_node[petsc_slave_idx+0] - X_node[petsc_mastr_idx+0];
+            D[1] = X_node[petsc_slave_idx+1] - X_node[petsc_mastr_idx+1];
+#if (NDIM == 3)
+            D[2] = X_node[petsc_slave_idx+2] - X_node[petsc_mastr_idx+2];
+#endif
+#if (NDIM == 2)
+            R = sqrt(D[0]*D[0]+D[1]*D[1]);
+#endif
+#if (NDIM == 3)
+            R = sqrt(D[0]*D[0]+D[1]*D[1]+D[2]*D[2]);
+#endif
+            is_valid[k] = !(R < std::numeric_limits<double>::epsilon());
+            if (UNLIKELY(!is_valid[k])) continue;
+            T = force_fcn(R,params,lag_mastr_idx,lag_slave_idx);
+            if (!force_deriv_fcn)
+            {
+                // Use finite differences to approximate dT/dR.
+                eps = std::max(R,1.0)*pow(std::numeric_limits<double>::epsilon(),1.0/3.0);
+                dT_dR = (force_fcn(R+eps,params,lag_mastr_idx,lag_slave_idx) -
+                         force_fcn(R-eps,params,lag_mastr_idx,lag_slave_idx))/(2.0*eps);
+            }
+            else
+            {
+                dT_dR = force_deriv_fcn(R,params,lag_mastr_idx,lag_slave_idx);
+            }
+
+            double* const dF_dX = dF_dX_blocks+k*NDIM*NDIM;
+            for (unsigned int i = 0; i < NDIM; ++i)
+            {
+                for (unsigned int j = 0; j < NDIM; ++j)
+                {
+                    dF_dX[i*NDIM+j] = X_coef*( (T/R)*((i == j ? 1.0 : 0.0)) + (dT_dR - T/R)*D[i]*D[j]/(R*R) );
+                }
+            }
+        }
+        return;
+    }// operator()
+};
+
+// Compute the forces generated by beams.
+//
+// The beams are processed in blocks in the same manner as the springs in
+// DefaultSpringForceKernel: gather, compute, and accumulate.
+struct BeamForceKernel
+{
+    const int* petsc_mastr_node_idxs;
+    const int* petsc_next_node_idxs;
+    const int* petsc_prev_node_idxs;
+    const double** rigidities;
+    const blitz::TinyVector<double,NDIM>** curvatures;
+    double* F_node;
+    const double* X_node;
+
+    void
+    operator()(
+        const int k_begin,
+        const int k_end) const
+    {
+        const int num_beams = k_end-k_begin;
+        const int*                             const restrict petsc_mastr_node_idxs = this->petsc_mastr_node_idxs+k_begin;
+        const int*                             const restrict  petsc_next_node_idxs = this->petsc_next_node_idxs +k_begin;
+        const int*                             const restrict  petsc_prev_node_idxs = this->petsc_prev_node_idxs +k_begin;
+        const double**                         const restrict            rigidities = this->rigidities           +k_begin;
+        const blitz::TinyVector<double,NDIM>** const restrict            curvatures = this->curvatures           +k_begin;
+        double*                                const restrict                F_node = this->F_node;
+        const double*                          const restrict                X_node = this->X_node;
+
+        static const int BLOCKSIZE = 64;  // This parameter needs to be tuned.
+        double D2X[NDIM][BLOCKSIZE], K[BLOCKSIZE];
+        for (int kblock = 0; kblock < num_beams; kblock += BLOCKSIZE)
+        {
+            const int block_size = std::min(BLOCKSIZE, num_beams-kblock);
+            const int* const restrict mastr_idxs = petsc_mastr_node_idxs+kblock;
+            const int* const restrict  next_idxs =  petsc_next_node_idxs+kblock;
+            const int* const restrict  prev_idxs =  petsc_prev_node_idxs+kblock;
+            for (int j = 0; j < block_size; ++j)
+            {
+#ifdef DEBUG_CHECK_ASSERTIONS
+                TBOX_ASSERT(mastr_idxs[j] != next_idxs[j]);
+                TBOX_ASSERT(mastr_idxs[j] != prev_idxs[j]);
+#endif
+                const double* const restrict X_mastr = X_node+mastr_idxs[j];
+                const double* const restrict X_next  = X_node+ next_idxs[j];
+                const double* const restrict X_prev  = X_node+ prev_idxs[j];
+                const double* const restrict D2X0 = curvatures[kblock+j]->data();
+                for (unsigned int d = 0; d < NDIM; ++d)
+                {
+                    D2X[d][j] = X_next[d]+X_prev[d]-2.0*X_mastr[d]-D2X0[d];
+                }
+                K[j] = *rigidities[kblock+j];
+            }
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                for (int j = 0; j < block_size; ++j)
+                {
+                    D2X[d][j] *= K[j];
+                }
+            }
+            for (int j = 0; j < block_size; ++j)
+            {
+                double* const F_mastr = F_node+mastr_idxs[j];
+                double* const F_next  = F_node+ next_idxs[j];
+                double* const F_prev  = F_node+ prev_idxs[j];
+                for (unsigned int d = 0; d < NDIM; ++d)
+                {
+                    const double F = D2X[d][j];
+                    F_mastr[d] += 2.0*F;
+                    F_next [d] -=     F;
+                    F_prev [d] -=     F;
+                }
+            }
+        }
+        return;
+    }// operator()
+};
+
+// Compute the forces generated by target points.
+struct TargetPointForceKernel
+{
+    const int* petsc_node_idxs;
+    const double** kappa;
+    const double** eta;
+    const blitz::TinyVector<double,NDIM>** X0;
+    double* F_node;
+    const double* X_node;
+    const double* U_node;
+
+    void
+    operator()(
+        const int k_begin,
+        const int k_end) const
+    {
+        const int num_target_points = k_end-k_begin;
+        const int*                             const restrict petsc_node_idxs = this->petsc_node_idxs+k_begin;
+        const double**                         const restrict           kappa = this->kappa          +k_begin;
+        const double**                         const restrict             eta = this->eta            +k_begin;
+        const blitz::TinyVector<double,NDIM>** const restrict              X0 = this->X0             +k_begin;
+        double*                                const restrict          F_node = this->F_node;
+        const double*                          const restrict          X_node = this->X_node;
+        const double*                          const restrict          U_node = this->U_node;
+
+        static const int BLOCKSIZE = 16;  // This parameter needs to be tuned.
+        int k, kblock, kunroll, idx;
+        double K, E;
+        const double* restrict X_target;
+        kblock = 0;
+        for ( ; kblock < (num_target_points-1)/BLOCKSIZE; ++kblock)  // ensure that the last block is NOT handled by this first loop
+        {
+            PREFETCH_READ_NTA_BLOCK(petsc_node_idxs+BLOCKSIZE*(kblock+1), BLOCKSIZE);
+            PREFETCH_READ_NTA_BLOCK(          kappa+BLOCKSIZE*(kblock+1), BLOCKSIZE);
+            PREFETCH_READ_NTA_BLOCK(            eta+BLOCKSIZE*(kblock+1), BLOCKSIZE);
+            PREFETCH_READ_NTA_BLOCK(             X0+BLOCKSIZE*(kblock+1), BLOCKSIZE);
+            for (kunroll = 0; kunroll < BLOCKSIZE; ++kunroll)
+            {
+                k = kblock*BLOCKSIZE+kunroll;
+                idx = petsc_node_idxs[k];
+                PREFETCH_READ_NTA_NDIM_BLOCK(F_node+petsc_node_idxs[k+1]);
+                PREFETCH_READ_NTA_NDIM_BLOCK(X_node+petsc_node_idxs[k+1]);
+                PREFETCH_READ_NTA(                            kappa[k+1]);
+                PREFETCH_READ_NTA(                              eta[k+1]);
+                PREFETCH_READ_NTA(                               X0[k+1]);
+                K = *kappa[k];
+                E = *eta  [k];
+                X_target = X0[k]->data();
+                F_node[idx+0] += K*(X_target[0] - X_node[idx+0]) - E*U_node[idx+0];
+                F_node[idx+1] += K*(X_target[1] - X_node[idx+1]) - E*U_node[idx+1];
+#if (NDIM == 3)
+                F_node[idx+2] += K*(X_target[2] - X_node[idx+2]) - E*U_node[idx+2];
+#endif
+            }
+        }
+        for (k = kblock*BLOCKSIZE; k < num_target_points; ++k)
+        {
+            idx = petsc_node_idxs[k];
+            K = *kappa[k];
+            E = *eta  [k];
+            X_target = X0[k]->data();
+            F_node[idx+0] += K*(X_target[0] - X_node[idx+0]) - E*U_node[idx+0];
+            F_node[idx+1] += K*(X_target[1] - X_node[idx+1]) - E*U_node[idx+1];
+#if (NDIM == 3)
+            F_node[idx+2] += K*(X_target[2] - X_node[idx+2]) - E*U_node[idx+2];
+#endif
+        }
+        return;
+    }// operator()
+};
+
+// The positions of the entries of the force Jacobian within the storage of an
+// AIJ matrix.  For each locally owned row of each element matrix, and for each
+// node of the element, the position of the first of the NDIM consecutive
+// entries is stored.  Nonnegative positions refer to the diagonal block of the
+// matrix, and negative positions p refer to position -p-1 of the off-diagonal
+// block.
+struct JacobianStructureCache
+{
+    const void* owner;
+    int structure_version;
+    PetscInt diag_nnz, offdiag_nnz;
+    std::vector<int> positions;
+};
+
+PetscErrorCode
+destroy_jacobian_structure_cache(
+    void* ctx)
+{
+    delete static_cast<JacobianStructureCache*>(ctx);
+    return 0;
+}// destroy_jacobian_structure_cache
+
+// Get the sequential matrices that store the locally owned rows of an AIJ
+// matrix.  The off-diagonal matrix is NULL for sequential matrices.  Returns
+// false if the matrix is not stored in AIJ format.
+bool
+get_aij_blocks(
+    Mat& mat,
+    Mat& A_diag,
+    Mat& A_offdiag,
+    PetscInt*& colmap)
+{
+    int ierr;
+    PetscBool is_seqaij, is_mpiaij;
+    ierr = PetscObjectTypeCompare(reinterpret_cast<PetscObject>(mat), MATSEQAIJ, &is_seqaij);  IBTK_CHKERRQ(ierr);
+    ierr = PetscObjectTypeCompare(reinterpret_cast<PetscObject>(mat), MATMPIAIJ, &is_mpiaij);  IBTK_CHKERRQ(ierr);
+    A_diag = NULL;
+    A_offdiag = NULL;
+    colmap = NULL;
+    if (is_seqaij)
+    {
+        A_diag = mat;
+        return true;
+    }
+    if (is_mpiaij)
+    {
+        ierr = MatMPIAIJGetSeqAIJ(mat, &A_diag, &A_offdiag, &colmap);  IBTK_CHKERRQ(ierr);
+        return true;
+    }
+    return false;
+}// get_aij_blocks
+
+// Get the number of entries stored in a sequential AIJ matrix.
+PetscInt
+get_aij_nnz(
+    Mat& A)
+{
+    if (!A) return 0;
+    int ierr;
+    PetscInt m;
+    PetscInt* ia;
+    PetscInt* ja;
+    PetscBool done;
+    ierr = MatGetRowIJ(A, 0, PETSC_FALSE, PETSC_FALSE, &m, &ia, &ja, &done);  IBTK_CHKERRQ(ierr);
+    const PetscInt nnz = (done ? ia[m] : -1);
+    ierr = MatRestoreRowIJ(A, 0, PETSC_FALSE, PETSC_FALSE, &m, &ia, &ja, &done);  IBTK_CHKERRQ(ierr);
+    return nnz;
+}// get_aij_nnz
+
+// Find the position of the entry in the specified row and column of a
+// sequential AIJ matrix.  Returns -1 unless the entries in columns col to
+// col+depth-1 are stored consecutively.
+int
+find_aij_position(
+    const PetscInt* const ia,
+    const PetscInt* const ja,
+    const int row,
+    const int col,
+    const int depth)
+{
+    const PetscInt* const begin = ja+ia[row];
+    const PetscInt* const end   = ja+ia[row+1];
+    const PetscInt* const posn = std::lower_bound(begin, end, col);
+    if (end-posn < depth) return -1;
+    for (int d = 0; d < depth; ++d)
+    {
+        if (posn[d] != col+d) return -1;
+    }
+    return posn-ja;
+}// find_aij_position
+
+// Record the positions of the entries of the element matrices within the
+// storage of an AIJ matrix.  Returns false if any entry is not stored in the
+// matrix.
+bool
+record_jacobian_structure(
+    std::vector<int>& positions,
+    const std::vector<int>& elem_idx_offsets,
+    const std::vector<int>& elem_idxs,
+    Mat& J_mat,
+    Mat& A_diag,
+    Mat& A_offdiag,
+    const PetscInt* const colmap)
+{
+    int ierr;
+    PetscInt row_begin, row_end, col_begin, col_end;
+    ierr = MatGetOwnershipRange      (J_mat, &row_begin, &row_end);  IBTK_CHKERRQ(ierr);
+    ierr = MatGetOwnershipRangeColumn(J_mat, &col_begin, &col_end);  IBTK_CHKERRQ(ierr);
+    PetscInt m_diag = 0, m_offdiag = 0, num_offdiag_cols = 0;
+    PetscInt* ia_diag = NULL;
+    PetscInt* ja_diag = NULL;
+    PetscInt* ia_offdiag = NULL;
+    PetscInt* ja_offdiag = NULL;
+    PetscBool done_diag, done_offdiag = PETSC_TRUE;
+    ierr = MatGetRowIJ(A_diag, 0, PETSC_FALSE, PETSC_FALSE, &m_diag, &ia_diag, &ja_diag, &done_diag);  IBTK_CHKERRQ(ierr);
+    if (A_offdiag)
+    {
+        PetscInt m;
+        ierr = MatGetSize(A_offdiag, &m, &num_offdiag_cols);  IBTK_CHKERRQ(ierr);
+        ierr = MatGetRowIJ(A_offdiag, 0, PETSC_FALSE, PETSC_FALSE, &m_offdiag, &ia_offdiag, &ja_offdiag, &done_offdiag);  IBTK_CHKERRQ(ierr);
+    }
+    bool success = done_diag && done_offdiag;
+    positions.clear();
+    const int num_elems = elem_idx_offsets.size()-1;
+    for (int e = 0; e < num_elems && success; ++e)
+    {
+        const int n = elem_idx_offsets[e+1]-elem_idx_offsets[e];
+        const int* const idxs = &elem_idxs[elem_idx_offsets[e]];
+        for (int a = 0; a < n && success; ++a)
+        {
+            if (NDIM*idxs[a] < row_begin || NDIM*idxs[a] >= row_end) continue;
+            for (unsigned int i = 0; i < NDIM && success; ++i)
+            {
+                const int row = NDIM*idxs[a]+i-row_begin;
+                for (int b = 0; b < n && success; ++b)
+                {
+                    // NOTE: The NDIM entries of each block of a row are
+                    // stored consecutively.
+                    const int col = NDIM*idxs[b];
+                    if (col >= col_begin && col < col_end)
+                    {
+                        const int posn = find_aij_position(ia_diag, ja_diag, row, col-col_begin, NDIM);
+                        success = (posn >= 0);
+                        positions.push_back(posn);
+                    }
+                    else if (A_offdiag)
+                    {
+                        const PetscInt* const colmap_posn = std::lower_bound(colmap, colmap+num_offdiag_cols, col);
+                        const int offdiag_col = colmap_posn-colmap;
+                        success = (offdiag_col+NDIM <= num_offdiag_cols && colmap[offdiag_col] == col && colmap[offdiag_col+NDIM-1] == col+NDIM-1);
+                        const int posn = (success ? find_aij_position(ia_offdiag, ja_offdiag, row, offdiag_col, NDIM) : -1);
+                        success = success && (posn >= 0);
+                        positions.push_back(-posn-1);
+                    }
+                    else
+                    {
+                        success = false;
+                    }
+                }
+            }
+        }
+    }
+    ierr = MatRestoreRowIJ(A_diag, 0, PETSC_FALSE, PETSC_FALSE, &m_diag, &ia_diag, &ja_diag, &done_diag);  IBTK_CHKERRQ(ierr);
+    if (A_offdiag)
+    {
+        ierr = MatRestoreRowIJ(A_offdiag, 0, PETSC_FALSE, PETSC_FALSE, &m_offdiag, &ia_offdiag, &ja_offdiag, &done_offdiag);  IBTK_CHKERRQ(ierr);
+    }
+    return success;
+}// record_jacobian_structure
 }
 
 /////////////////////////////// PUBLIC ///////////////////////////////////////
 
-IBStandardForceGen::IBStandardForceGen()
+IBStandardForceGen::IBStandardForceGen(
+    Pointer<Database> input_db)
+    : d_num_threads(1)
 {
+    // Initialize object with data read from the input database.
+    getFromInput(input_db);
+
     // Setup the default force generation functions.
     registerSpringForceFunction(0, &default_spring_force, &default_spring_force_deriv);
     return;
@@ -187,6 +916,11 @@ IBStandardForceGen::initializeLevelData(
     d_X_ghost_data     .resize(new_size);
     d_F_ghost_data     .resize(new_size);
     d_is_initialized   .resize(new_size, false);
+    d_jacobian_structure_version.resize(new_size, 0);
+
+    // Indicate that the positions of the entries of any previously assembled
+    // Jacobian matrices are no longer valid.
+    ++d_jacobian_structure_version[level_number];
 
     // Keep track of all of the nonlocal PETSc indices required to compute the
     // forces.
@@ -197,6 +931,36 @@ IBStandardForceGen::initializeLevelData(
     initializeBeamLevelData(       nonlocal_petsc_idx_set, hierarchy, level_number, init_data_time, initial_time, l_data_manager);
     initializeTargetPointLevelData(nonlocal_petsc_idx_set, hierarchy, level_number, init_data_time, initial_time, l_data_manager);
 
+    // Provide the connectivity of the springs and beams to the Lagrangian data
+    // manager, so that it may be used to determine the distribution of the
+    // Lagrangian data.
+    //
+    // NOTE: mapPETScToLagrangian() is a collective operation, and so it must be
+    // called on all processors.
+    std::vector<std::pair<int,int> > lag_edges;
+    const SpringData& spring_data = d_spring_data[level_number];
+    const int num_springs = spring_data.lag_mastr_node_idxs.size();
+    for (int k = 0; k < num_springs; ++k)
+    {
+        lag_edges.push_back(std::make_pair(spring_data.lag_mastr_node_idxs(k), spring_data.lag_slave_node_idxs(k)));
+    }
+    const BeamData& beam_data = d_beam_data[level_number];
+    const int num_beams = beam_data.petsc_mastr_node_idxs.size();
+    std::vector<int> beam_lag_idxs(3*num_beams);
+    for (int k = 0; k < num_beams; ++k)
+    {
+        beam_lag_idxs[3*k  ] = beam_data.petsc_mastr_node_idxs(k);
+        beam_lag_idxs[3*k+1] = beam_data.petsc_next_node_idxs (k);
+        beam_lag_idxs[3*k+2] = beam_data.petsc_prev_node_idxs (k);
+    }
+    l_data_manager->mapPETScToLagrangian(beam_lag_idxs, level_number);
+    for (int k = 0; k < num_beams; ++k)
+    {
+        lag_edges.push_back(std::make_pair(beam_lag_idxs[3*k], beam_lag_idxs[3*k+1]));
+        lag_edges.push_back(std::make_pair(beam_lag_idxs[3*k], beam_lag_idxs[3*k+2]));
+    }
+    l_data_manager->setLagrangianConnectivity("IBStandardForceGen", lag_edges, level_number);
+
     // Put the nonlocal PETSc indices into a vector.
     std::vector<int> nonlocal_petsc_idxs(nonlocal_petsc_idx_set.begin(),nonlocal_petsc_idx_set.end());
 
@@ -235,6 +999,127 @@ IBStandardForceGen::initializeLevelData(
     std::transform(d_target_point_data[level_number].petsc_node_idxs.begin(), d_target_point_data[level_number].petsc_node_idxs.end(),
                    d_target_point_data[level_number].petsc_node_idxs.begin(), std::bind2nd(std::multiplies<int>(),NDIM));
 
+    // Reorder the springs and beams so that the force elements that involve
+    // only locally owned nodes come first.  The forces generated by these
+    // elements may be computed while the values of the ghost nodes are being
+    // communicated.
+    //
+    // NOTE: Master nodes are always locally owned, and locally owned nodes
+    // precede ghost nodes in the ghosted local form of the data.
+    const int num_local_idxs = NDIM*num_local_nodes;
+    {
+        SpringData& spring_data = d_spring_data[level_number];
+        const int num_springs = spring_data.petsc_slave_node_idxs.size();
+        // Within each group, the springs that use the default force function
+        // come first, so that their forces may be computed by a specialized
+        // kernel that does not call the force function through a pointer.
+        std::vector<int> perm;
+        perm.reserve(num_springs);
+        for (int pass = 0; pass < 4; ++pass)
+        {
+            const bool local_pass = (pass < 2);
+            const bool default_pass = (pass % 2 == 0);
+            for (int k = 0; k < num_springs; ++k)
+            {
+                const bool is_local = (spring_data.petsc_slave_node_idxs(k) < num_local_idxs);
+                const bool is_default = (spring_data.force_fcns(k) == &default_spring_force);
+                if (is_local == local_pass && is_default == default_pass) perm.push_back(k);
+            }
+            if (pass == 0) spring_data.num_local_default_springs = perm.size();
+            if (pass == 1) spring_data.num_local_springs = perm.size();
+            if (pass == 2) spring_data.num_nonlocal_default_springs = perm.size()-spring_data.num_local_springs;
+        }
+        permuteArray(spring_data.lag_mastr_node_idxs  , perm);
+        permuteArray(spring_data.lag_slave_node_idxs  , perm);
+        permuteArray(spring_data.petsc_mastr_node_idxs, perm);
+        permuteArray(spring_data.petsc_slave_node_idxs, perm);
+        permuteArray(spring_data.force_fcns           , perm);
+        permuteArray(spring_data.force_deriv_fcns     , perm);
+        permuteArray(spring_data.parameters           , perm);
+    }
+    {
+        BeamData& beam_data = d_beam_data[level_number];
+        const int num_beams = beam_data.petsc_mastr_node_idxs.size();
+        std::vector<int> perm;
+        perm.reserve(num_beams);
+        for (int k = 0; k < num_beams; ++k)
+        {
+            const bool is_local = (beam_data.petsc_next_node_idxs(k) < num_local_idxs &&
+                                   beam_data.petsc_prev_node_idxs(k) < num_local_idxs);
+            if ( is_local) perm.push_back(k);
+        }
+        beam_data.num_local_beams = perm.size();
+        for (int k = 0; k < num_beams; ++k)
+        {
+            const bool is_local = (beam_data.petsc_next_node_idxs(k) < num_local_idxs &&
+                                   beam_data.petsc_prev_node_idxs(k) < num_local_idxs);
+            if (!is_local) perm.push_back(k);
+        }
+        permuteArray(beam_data.petsc_mastr_node_idxs, perm);
+        permuteArray(beam_data.petsc_next_node_idxs , perm);
+        permuteArray(beam_data.petsc_prev_node_idxs , perm);
+        permuteArray(beam_data.rigidities           , perm);
+        permuteArray(beam_data.curvatures           , perm);
+    }
+
+    // When the forces are computed by multiple threads, color the springs and
+    // beams so that no two force elements of the same color share a node.  The
+    // forces generated by the force elements of a single color may then be
+    // accumulated concurrently.  Coloring is done separately for each group of
+    // force elements determined above, so that the groups are preserved.
+    d_spring_data[level_number].color_offsets.clear();
+    d_beam_data  [level_number].color_offsets.clear();
+    if (get_num_threads(d_num_threads) > 1)
+    {
+        const int num_nodes = num_local_nodes+nonlocal_petsc_idxs.size();
+        {
+            SpringData& spring_data = d_spring_data[level_number];
+            const int num_springs = spring_data.petsc_slave_node_idxs.size();
+            std::vector<const blitz::Array<int,1>*> node_idxs(2);
+            node_idxs[0] = &spring_data.petsc_mastr_node_idxs;
+            node_idxs[1] = &spring_data.petsc_slave_node_idxs;
+            std::vector<int> node_color(num_nodes,-1);
+            int num_colors = 0;
+            std::vector<int> perm;
+            perm.reserve(num_springs);
+            const int group_begin[4] = { 0,
+                                         spring_data.num_local_default_springs,
+                                         spring_data.num_local_springs,
+                                         spring_data.num_local_springs+spring_data.num_nonlocal_default_springs };
+            for (int group = 0; group < 4; ++group)
+            {
+                const int group_end = (group < 3 ? group_begin[group+1] : num_springs);
+                color_force_elements(perm, spring_data.color_offsets, node_color, num_colors, group_begin[group], group_end, node_idxs);
+            }
+            permuteArray(spring_data.lag_mastr_node_idxs  , perm);
+            permuteArray(spring_data.lag_slave_node_idxs  , perm);
+            permuteArray(spring_data.petsc_mastr_node_idxs, perm);
+            permuteArray(spring_data.petsc_slave_node_idxs, perm);
+            permuteArray(spring_data.force_fcns           , perm);
+            permuteArray(spring_data.force_deriv_fcns     , perm);
+            permuteArray(spring_data.parameters           , perm);
+        }
+        {
+            BeamData& beam_data = d_beam_data[level_number];
+            const int num_beams = beam_data.petsc_mastr_node_idxs.size();
+            std::vector<const blitz::Array<int,1>*> node_idxs(3);
+            node_idxs[0] = &beam_data.petsc_mastr_node_idxs;
+            node_idxs[1] = &beam_data.petsc_next_node_idxs;
+            node_idxs[2] = &beam_data.petsc_prev_node_idxs;
+            std::vector<int> node_color(num_nodes,-1);
+            int num_colors = 0;
+            std::vector<int> perm;
+            perm.reserve(num_beams);
+            color_force_elements(perm, beam_data.color_offsets, node_color, num_colors, 0, beam_data.num_local_beams, node_idxs);
+            color_force_elements(perm, beam_data.color_offsets, node_color, num_colors, beam_data.num_local_beams, num_beams, node_idxs);
+            permuteArray(beam_data.petsc_mastr_node_idxs, perm);
+            permuteArray(beam_data.petsc_next_node_idxs , perm);
+            permuteArray(beam_data.petsc_prev_node_idxs , perm);
+            permuteArray(beam_data.rigidities           , perm);
+            permuteArray(beam_data.curvatures           , perm);
+        }
+    }
+
     // Indicate that the level data has been initialized.
     d_is_initialized[level_number] = true;
     return;
@@ -264,12 +1149,28 @@ IBStandardForceGen::computeLagrangianForce(
     Pointer<LData> X_ghost_data = d_X_ghost_data[level_number];
     ierr = VecCopy(X_data->getVec(), X_ghost_data->getVec());  IBTK_CHKERRQ(ierr);
     ierr = VecGhostUpdateBegin(X_ghost_data->getVec(), INSERT_VALUES, SCATTER_FORWARD);  IBTK_CHKERRQ(ierr);
-    ierr = VecGhostUpdateEnd(  X_ghost_data->getVec(), INSERT_VALUES, SCATTER_FORWARD);  IBTK_CHKERRQ(ierr);
 
-    // Compute the forces.
-    computeLagrangianSpringForce(       F_ghost_data, X_ghost_data,         hierarchy, level_number, data_time, l_data_manager);
-    computeLagrangianBeamForce(         F_ghost_data, X_ghost_data,         hierarchy, level_number, data_time, l_data_manager);
-    computeLagrangianTargetPointForce(  F_ghost_data, X_ghost_data, U_data, hierarchy, level_number, data_time, l_data_manager);
+    // Compute the forces generated by the force elements that involve only
+    // locally owned nodes while the ghost node values are being communicated.
+    // These forces only require locally owned values of X, which are read
+    // directly from X_data.
+    const int num_springs       = d_spring_data[level_number].petsc_mastr_node_idxs.size();
+    const int num_local_springs = d_spring_data[level_number].num_local_springs;
+    const int num_beams         = d_beam_data  [level_number].petsc_mastr_node_idxs.size();
+    const int num_local_beams   = d_beam_data  [level_number].num_local_beams;
+    const int num_local_default_springs    = d_spring_data[level_number].num_local_default_springs;
+    const int num_nonlocal_default_springs = d_spring_data[level_number].num_nonlocal_default_springs;
+    computeLagrangianDefaultSpringForce(F_ghost_data, X_data,         0, num_local_default_springs, level_number);
+    computeLagrangianSpringForce(       F_ghost_data, X_data,         num_local_default_springs, num_local_springs, hierarchy, level_number, data_time, l_data_manager);
+    computeLagrangianBeamForce(         F_ghost_data, X_data,         0, num_local_beams  , hierarchy, level_number, data_time, l_data_manager);
+    computeLagrangianTargetPointForce(  F_ghost_data, X_data, U_data,                       hierarchy, level_number, data_time, l_data_manager);
+
+    // Compute the forces generated by the remaining force elements once the
+    // ghost node values are available.
+    ierr = VecGhostUpdateEnd(  X_ghost_data->getVec(), INSERT_VALUES, SCATTER_FORWARD);  IBTK_CHKERRQ(ierr);
+    computeLagrangianDefaultSpringForce(F_ghost_data, X_ghost_data, num_local_springs, num_local_springs+num_nonlocal_default_springs, level_number);
+    computeLagrangianSpringForce(       F_ghost_data, X_ghost_data, num_local_springs+num_nonlocal_default_springs, num_springs, hierarchy, level_number, data_time, l_data_manager);
+    computeLagrangianBeamForce(         F_ghost_data, X_ghost_data, num_local_beams  , num_beams  , hierarchy, level_number, data_time, l_data_manager);
 
     // Add the locally computed forces to the Lagrangian force vector.
     //
@@ -467,86 +1368,73 @@ IBStandardForceGen::computeLagrangianForceJacobian(
 
     int ierr;
 
+    // The Jacobian is assembled from dense element matrices.  Element e
+    // couples the nodes with block indices elem_idxs[elem_idx_offsets[e]] to
+    // elem_idxs[elem_idx_offsets[e+1]-1], and its (row-major) element matrix is
+    // stored in elem_vals starting at elem_vals_offsets[e].
+    //
+    // NOTE: Element matrices are generated for all force elements, including
+    // springs of zero length (whose element matrices are zero), so that the
+    // sequence of matrix entries does not depend on the configuration of the
+    // structure.
+    std::vector<int> elem_idx_offsets(1,0), elem_vals_offsets(1,0), elem_idxs;
+    std::vector<double> elem_vals;
+
     {   // Spring forces.
 
-        const blitz::Array<int,1>&                 lag_mastr_node_idxs = d_spring_data[level_number].lag_mastr_node_idxs;
-        const blitz::Array<int,1>&                 lag_slave_node_idxs = d_spring_data[level_number].lag_slave_node_idxs;
-        const blitz::Array<int,1>&               petsc_mastr_node_idxs = d_spring_data[level_number].petsc_mastr_node_idxs;
-        const blitz::Array<int,1>&               petsc_slave_node_idxs = d_spring_data[level_number].petsc_slave_node_idxs;
-        const blitz::Array<SpringForceFcnPtr,1>&            force_fcns = d_spring_data[level_number].force_fcns;
-        const blitz::Array<SpringForceDerivFcnPtr,1>& force_deriv_fcns = d_spring_data[level_number].force_deriv_fcns;
-        const blitz::Array<const double*,1>&                parameters = d_spring_data[level_number].parameters;
-        const double* const restrict X_node = X_data->getGhostedLocalFormVecArray()->data();
-        blitz::TinyMatrix<double,NDIM,NDIM> dF_dX;
-        blitz::TinyVector<double,NDIM> D;
-        double R, T, dT_dR, eps;
-        for (int k = 0; k < petsc_mastr_node_idxs.extent(0); ++k)
+        // Compute the Jacobian blocks of the spring forces, possibly using
+        // multiple threads.  Because each spring writes only its own block, the
+        // springs need not be colored here.
+        SpringData& spring_data = d_spring_data[level_number];
+        const int num_springs = spring_data.petsc_mastr_node_idxs.size();
+        std::vector<double> dF_dX_blocks(NDIM*NDIM*num_springs);
+        std::vector<int> is_valid(num_springs);
+        if (num_springs > 0)
         {
-            // Compute the Jacobian of the force applied by the spring to the
-            // "master" node with respect to the position of the "slave" node.
-            const int& lag_mastr_idx = lag_mastr_node_idxs(k);
-            const int& lag_slave_idx = lag_slave_node_idxs(k);
-            int petsc_mastr_idx = petsc_mastr_node_idxs(k);
-            int petsc_slave_idx = petsc_slave_node_idxs(k);
-            const SpringForceFcnPtr force_fcn = force_fcns(k);
-            const SpringForceDerivFcnPtr force_deriv_fcn = force_deriv_fcns(k);
-            const double* const params = parameters(k);
-
-            D[0] = X_node[petsc_slave_idx+0] - X_node[petsc_mastr_idx+0];
-            D[1] = X_node[petsc_slave_idx+1] - X_node[petsc_mastr_idx+1];
-#if (NDIM == 3)
-            D[2] = X_node[petsc_slave_idx+2] - X_node[petsc_mastr_idx+2];
-#endif
-#if (NDIM == 2)
-            R = sqrt(D[0]*D[0]+D[1]*D[1]);
-#endif
-#if (NDIM == 3)
-            R = sqrt(D[0]*D[0]+D[1]*D[1]+D[2]*D[2]);
-#endif
-            if (UNLIKELY(R < std::numeric_limits<double>::epsilon())) continue;
-            T = force_fcn(R,params,lag_mastr_idx,lag_slave_idx);
-            if (!force_deriv_fcn)
-            {
-                // Use finite differences to approximate dT/dR.
-                eps = std::max(R,1.0)*pow(std::numeric_limits<double>::epsilon(),1.0/3.0);
-                dT_dR = (force_fcn(R+eps,params,lag_mastr_idx,lag_slave_idx) -
-                         force_fcn(R-eps,params,lag_mastr_idx,lag_slave_idx))/(2.0*eps);
-            }
-            else
-            {
-                dT_dR = force_deriv_fcn(R,params,lag_mastr_idx,lag_slave_idx);
-            }
-
-            for (unsigned int i = 0; i < NDIM; ++i)
-            {
-                for (unsigned int j = 0; j < NDIM; ++j)
+            const SpringForceJacobianKernel kernel =
                 {
-                    dF_dX(i,j) = X_coef*( (T/R)*((i == j ? 1.0 : 0.0)) + (dT_dR - T/R)*D[i]*D[j]/(R*R) );
-                }
-            }
-
-            // Change the indices to block indices.
-            petsc_mastr_idx /= NDIM;
-            petsc_slave_idx /= NDIM;
-
-            // Accumulate the off-diagonal parts of the matrix.
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_mastr_idx,1,&petsc_slave_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_slave_idx,1,&petsc_mastr_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
+                    spring_data.lag_mastr_node_idxs  .data(),
+                    spring_data.lag_slave_node_idxs  .data(),
+                    spring_data.petsc_mastr_node_idxs.data(),
+                    spring_data.petsc_slave_node_idxs.data(),
+                    spring_data.force_fcns           .data(),
+                    spring_data.force_deriv_fcns     .data(),
+                    spring_data.parameters           .data(),
+                    X_data->getGhostedLocalFormVecArray()->data(),
+                    X_coef,
+                    &dF_dX_blocks[0],
+                    &is_valid[0]
+                };
+            apply_force_kernel(kernel, 0, num_springs, std::vector<int>(1,0), get_num_threads(d_num_threads));
+            X_data->restoreArrays();
+        }
 
-            // Negate dF_dX to obtain the Jacobian of the force applied by the
-            // spring to the "master" node with respect to the position of the
-            // "master" node.
-            for (unsigned int i = 0; i < NDIM; ++i)
+        // The element matrix of a spring couples the "master" and "slave"
+        // nodes.  The off-diagonal blocks are the Jacobian of the force applied
+        // by the spring to the "master" node with respect to the position of
+        // the "slave" node, and the diagonal blocks are their negation.
+        static const int N = 2;
+        for (int k = 0; k < num_springs; ++k)
+        {
+            elem_idxs.push_back(spring_data.petsc_mastr_node_idxs(k)/NDIM);  // block indices
+            elem_idxs.push_back(spring_data.petsc_slave_node_idxs(k)/NDIM);
+            const double* const dF_dX = &dF_dX_blocks[k*NDIM*NDIM];
+            for (int a = 0; a < N; ++a)
             {
-                for (unsigned int j = 0; j < NDIM; ++j)
+                for (unsigned int i = 0; i < NDIM; ++i)
                 {
-                    dF_dX(i,j) *= -1.0;
+                    for (int b = 0; b < N; ++b)
+                    {
+                        for (unsigned int j = 0; j < NDIM; ++j)
+                        {
+                            const double val = (is_valid[k] ? dF_dX[i*NDIM+j] : 0.0);
+                            elem_vals.push_back(a == b ? -val : val);
+                        }
+                    }
                 }
             }
-
-            // Accumulate the diagonal parts of the matrix.
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_mastr_idx,1,&petsc_mastr_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_slave_idx,1,&petsc_slave_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
+            elem_idx_offsets .push_back(elem_idxs.size());
+            elem_vals_offsets.push_back(elem_vals.size());
         }
 
     }
@@ -557,37 +1445,34 @@ IBStandardForceGen::computeLagrangianForceJacobian(
         const blitz::Array<int,1>& petsc_next_node_idxs = d_beam_data[level_number].petsc_next_node_idxs;
         const blitz::Array<int,1>& petsc_prev_node_idxs = d_beam_data[level_number].petsc_prev_node_idxs;
         const blitz::Array<const double*,1>& rigidities = d_beam_data[level_number].rigidities;
-        blitz::TinyMatrix<double,NDIM,NDIM> dF_dX;  dF_dX = 0.0;
+
+        // The element matrix of a beam couples the "previous", "next", and
+        // "master" nodes.
+        static const int N = 3;
+        static const double coefs[N][N] = { { -1.0 , -1.0 , +2.0 } ,
+                                            { -1.0 , -1.0 , +2.0 } ,
+                                            { +2.0 , +2.0 , -4.0 } };
         for (int k = 0; k < petsc_mastr_node_idxs.extent(0); ++k)
         {
-            const int petsc_mastr_idx = petsc_mastr_node_idxs(k)/NDIM;  // block indices
-            const int petsc_next_idx  = petsc_next_node_idxs (k)/NDIM;
-            const int petsc_prev_idx  = petsc_prev_node_idxs (k)/NDIM;
+            elem_idxs.push_back(petsc_prev_node_idxs (k)/NDIM);  // block indices
+            elem_idxs.push_back(petsc_next_node_idxs (k)/NDIM);
+            elem_idxs.push_back(petsc_mastr_node_idxs(k)/NDIM);
             const double& bend = *rigidities(k);
-
-            for (unsigned int alpha = 0; alpha < NDIM; ++alpha)
+            for (int a = 0; a < N; ++a)
             {
-                dF_dX(alpha,alpha) = -1.0*bend*X_coef;
-            }
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_prev_idx,1,&petsc_prev_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_prev_idx,1,&petsc_next_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_next_idx,1,&petsc_prev_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_next_idx,1,&petsc_next_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
-
-            for (unsigned int alpha = 0; alpha < NDIM; ++alpha)
-            {
-                dF_dX(alpha,alpha) = +2.0*bend*X_coef;
-            }
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_prev_idx,1,&petsc_mastr_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_next_idx,1,&petsc_mastr_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_mastr_idx,1,&petsc_prev_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_mastr_idx,1,&petsc_next_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
-
-            for (unsigned int alpha = 0; alpha < NDIM; ++alpha)
-            {
-                dF_dX(alpha,alpha) = -4.0*bend*X_coef;
+                for (unsigned int i = 0; i < NDIM; ++i)
+                {
+                    for (int b = 0; b < N; ++b)
+                    {
+                        for (unsigned int j = 0; j < NDIM; ++j)
+                        {
+                            elem_vals.push_back(i == j ? coefs[a][b]*bend*X_coef : 0.0);
+                        }
+                    }
+                }
             }
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_mastr_idx,1,&petsc_mastr_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
+            elem_idx_offsets .push_back(elem_idxs.size());
+            elem_vals_offsets.push_back(elem_vals.size());
         }
 
     }
@@ -597,24 +1482,148 @@ IBStandardForceGen::computeLagrangianForceJacobian(
         const blitz::Array<int,1>& petsc_node_idxs = d_target_point_data[level_number].petsc_node_idxs;
         const blitz::Array<const double*,1>& kappa = d_target_point_data[level_number].kappa;
         const  blitz::Array<const double*,1>&  eta = d_target_point_data[level_number].eta;
-        blitz::TinyMatrix<double,NDIM,NDIM> dF_dX;  dF_dX = 0.0;
         for (int k = 0; k < petsc_node_idxs.extent(0); ++k)
         {
-            const int petsc_node_idx = petsc_node_idxs(k)/NDIM;  // block index
+            elem_idxs.push_back(petsc_node_idxs(k)/NDIM);  // block index
             const double& K = *kappa(k);
             const double& E = *eta  (k);
-            for (unsigned int alpha = 0; alpha < NDIM; ++alpha)
+            for (unsigned int i = 0; i < NDIM; ++i)
+            {
+                for (unsigned int j = 0; j < NDIM; ++j)
+                {
+                    elem_vals.push_back(i == j ? -X_coef*K-U_coef*E : 0.0);
+                }
+            }
+            elem_idx_offsets .push_back(elem_idxs.size());
+            elem_vals_offsets.push_back(elem_vals.size());
+        }
+
+    }
+
+    // Determine whether the positions of the matrix entries within the storage
+    // of the matrix have been recorded during a previous assembly.  The
+    // positions are attached to the matrix, so that they are discarded along
+    // with the matrix, and they are valid only if neither the force elements
+    // nor the nonzero structure of the matrix have changed since they were
+    // recorded.
+    Mat A_diag, A_offdiag;
+    PetscInt* colmap;
+    const bool is_aij = get_aij_blocks(J_mat, A_diag, A_offdiag, colmap);
+    std::ostringstream cache_name_stream;
+    cache_name_stream << "IBStandardForceGen::jacobian_structure_" << level_number;
+    const std::string cache_name = cache_name_stream.str();
+    JacobianStructureCache* cache = NULL;
+    if (is_aij)
+    {
+        PetscContainer container = NULL;
+        ierr = PetscObjectQuery(reinterpret_cast<PetscObject>(J_mat), cache_name.c_str(), reinterpret_cast<PetscObject*>(&container));  IBTK_CHKERRQ(ierr);
+        if (container)
+        {
+            void* ptr;
+            ierr = PetscContainerGetPointer(container, &ptr);  IBTK_CHKERRQ(ierr);
+            cache = static_cast<JacobianStructureCache*>(ptr);
+            if (cache->owner != this ||
+                cache->structure_version != d_jacobian_structure_version[level_number] ||
+                cache->diag_nnz    != get_aij_nnz(A_diag   ) ||
+                cache->offdiag_nnz != get_aij_nnz(A_offdiag))
             {
-                dF_dX(alpha,alpha) = -X_coef*K-U_coef*E;
+                cache = NULL;
             }
-            ierr = MatSetValuesBlocked(J_mat,1,&petsc_node_idx,1,&petsc_node_idx,dF_dX.data(),ADD_VALUES);  IBTK_CHKERRQ(ierr);
         }
+    }
 
+    PetscInt row_begin, row_end;
+    ierr = MatGetOwnershipRange(J_mat, &row_begin, &row_end);  IBTK_CHKERRQ(ierr);
+    const int num_elems = elem_idx_offsets.size()-1;
+    if (cache)
+    {
+        // Accumulate the element matrices directly in the storage of the
+        // matrix.  Only rows owned by other processes are communicated via
+        // MatSetValuesBlocked().
+        PetscScalar* a_diag = NULL;
+        PetscScalar* a_offdiag = NULL;
+        ierr = MatSeqAIJGetArray(A_diag, &a_diag);  IBTK_CHKERRQ(ierr);
+        if (A_offdiag)
+        {
+            ierr = MatSeqAIJGetArray(A_offdiag, &a_offdiag);  IBTK_CHKERRQ(ierr);
+        }
+        const int* posn = cache->positions.empty() ? NULL : &cache->positions[0];
+        for (int e = 0; e < num_elems; ++e)
+        {
+            const int n = elem_idx_offsets[e+1]-elem_idx_offsets[e];
+            const int* const idxs = &elem_idxs[elem_idx_offsets[e]];
+            const double* const vals = &elem_vals[elem_vals_offsets[e]];
+            for (int a = 0; a < n; ++a)
+            {
+                const double* const vals_a = vals+a*NDIM*n*NDIM;
+                if (NDIM*idxs[a] < row_begin || NDIM*idxs[a] >= row_end)
+                {
+                    ierr = MatSetValuesBlocked(J_mat,1,&idxs[a],n,idxs,vals_a,ADD_VALUES);  IBTK_CHKERRQ(ierr);
+                    continue;
+                }
+                for (unsigned int i = 0; i < NDIM; ++i)
+                {
+                    for (int b = 0; b < n; ++b, ++posn)
+                    {
+                        PetscScalar* const a_row = (*posn >= 0 ? a_diag+(*posn) : a_offdiag-(*posn)-1);
+                        const double* const vals_ab = vals_a+i*n*NDIM+b*NDIM;
+                        for (unsigned int j = 0; j < NDIM; ++j)
+                        {
+                            a_row[j] += vals_ab[j];
+                        }
+                    }
+                }
+            }
+        }
+#ifdef DEBUG_CHECK_ASSERTIONS
+        TBOX_ASSERT(posn == (cache->positions.empty() ? NULL : &cache->positions[0]+cache->positions.size()));
+#endif
+        ierr = MatSeqAIJRestoreArray(A_diag, &a_diag);  IBTK_CHKERRQ(ierr);
+        if (A_offdiag)
+        {
+            ierr = MatSeqAIJRestoreArray(A_offdiag, &a_offdiag);  IBTK_CHKERRQ(ierr);
+        }
+    }
+    else
+    {
+        // Accumulate each element matrix with a single call to
+        // MatSetValuesBlocked().
+        for (int e = 0; e < num_elems; ++e)
+        {
+            const int n = elem_idx_offsets[e+1]-elem_idx_offsets[e];
+            const int* const idxs = &elem_idxs[elem_idx_offsets[e]];
+            ierr = MatSetValuesBlocked(J_mat,n,idxs,n,idxs,&elem_vals[elem_vals_offsets[e]],ADD_VALUES);  IBTK_CHKERRQ(ierr);
+        }
     }
 
     // Assemble the matrix.
     ierr = MatAssemblyBegin(J_mat, assembly_type); IBTK_CHKERRQ(ierr);
     ierr = MatAssemblyEnd(  J_mat, assembly_type); IBTK_CHKERRQ(ierr);
+
+    // Record the positions of the matrix entries so that subsequent assemblies
+    // may bypass MatSetValuesBlocked().
+    if (is_aij && !cache && assembly_type == MAT_FINAL_ASSEMBLY)
+    {
+        get_aij_blocks(J_mat, A_diag, A_offdiag, colmap);
+        JacobianStructureCache* new_cache = new JacobianStructureCache();
+        new_cache->owner = this;
+        new_cache->structure_version = d_jacobian_structure_version[level_number];
+        if (record_jacobian_structure(new_cache->positions, elem_idx_offsets, elem_idxs, J_mat, A_diag, A_offdiag, colmap))
+        {
+            new_cache->diag_nnz    = get_aij_nnz(A_diag   );
+            new_cache->offdiag_nnz = get_aij_nnz(A_offdiag);
+            PetscContainer container;
+            ierr = PetscContainerCreate(PETSC_COMM_SELF, &container);  IBTK_CHKERRQ(ierr);
+            ierr = PetscContainerSetPointer(container, new_cache);  IBTK_CHKERRQ(ierr);
+            ierr = PetscContainerSetUserDestroy(container, &destroy_jacobian_structure_cache);  IBTK_CHKERRQ(ierr);
+            ierr = PetscObjectCompose(reinterpret_cast<PetscObject>(J_mat), cache_name.c_str(), reinterpret_cast<PetscObject>(container));  IBTK_CHKERRQ(ierr);
+            ierr = PetscContainerDestroy(&container);  IBTK_CHKERRQ(ierr);
+        }
+        else
+        {
+            delete new_cache;
+        }
+    }
     return;
 }// computeLagrangianForceJacobian
 
@@ -755,118 +1764,58 @@ void
 IBStandardForceGen::computeLagrangianSpringForce(
     Pointer<LData> F_data,
     Pointer<LData> X_data,
+    const int k_begin,
+    const int k_end,
     const Pointer<PatchHierarchy<NDIM> > /*hierarchy*/,
     const int level_number,
     const double /*data_time*/,
     LDataManager* const /*l_data_manager*/)
 {
-    const int num_springs = d_spring_data[level_number].lag_mastr_node_idxs.size();
-    const int*               const restrict   lag_mastr_node_idxs = d_spring_data[level_number].lag_mastr_node_idxs  .data();
-    const int*               const restrict   lag_slave_node_idxs = d_spring_data[level_number].lag_slave_node_idxs  .data();
-    const int*               const restrict petsc_mastr_node_idxs = d_spring_data[level_number].petsc_mastr_node_idxs.data();
-    const int*               const restrict petsc_slave_node_idxs = d_spring_data[level_number].petsc_slave_node_idxs.data();
-    const SpringForceFcnPtr* const restrict            force_fcns = d_spring_data[level_number].force_fcns           .data();
-    const double**           const restrict            parameters = d_spring_data[level_number].parameters           .data();
-    double*                  const restrict                F_node = F_data->getLocalFormVecArray()       ->data();
-    const double*            const restrict                X_node = X_data->getGhostedLocalFormVecArray()->data();
-
-    static const int BLOCKSIZE = 16;  // This parameter needs to be tuned.
-    int k, kblock, kunroll, mastr_idx, slave_idx;
-    double F[NDIM], D[NDIM], R, T_over_R;
-    kblock = 0;
-    for ( ; kblock < (num_springs-1)/BLOCKSIZE; ++kblock)  // ensure that the last block is NOT handled by this first loop
-    {
-        PREFETCH_READ_NTA_BLOCK(  lag_mastr_node_idxs+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(  lag_slave_node_idxs+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(petsc_mastr_node_idxs+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(petsc_slave_node_idxs+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(           force_fcns+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(           parameters+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        for (kunroll = 0; kunroll < BLOCKSIZE; ++kunroll)
+    const int num_springs = k_end-k_begin;
+    if (num_springs <= 0) return;
+    SpringData& spring_data = d_spring_data[level_number];
+    const SpringForceKernel kernel =
         {
-            k = kblock*BLOCKSIZE+kunroll;
-            mastr_idx = petsc_mastr_node_idxs[k];
-            slave_idx = petsc_slave_node_idxs[k];
-#ifdef DEBUG_CHECK_ASSERTIONS
-            TBOX_ASSERT(mastr_idx != slave_idx);
-#endif
-            PREFETCH_READ_NTA_NDIM_BLOCK(F_node+petsc_mastr_node_idxs[k+1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(F_node+petsc_slave_node_idxs[k+1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(X_node+petsc_mastr_node_idxs[k+1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(X_node+petsc_slave_node_idxs[k+1]);
-            PREFETCH_READ_NTA(                             parameters[k+1]);
-            D[0] = X_node[slave_idx+0] - X_node[mastr_idx+0];
-            D[1] = X_node[slave_idx+1] - X_node[mastr_idx+1];
-#if (NDIM == 3)
-            D[2] = X_node[slave_idx+2] - X_node[mastr_idx+2];
-#endif
-#if (NDIM == 2)
-            R = sqrt(D[0]*D[0]+D[1]*D[1]);
-#endif
-#if (NDIM == 3)
-            R = sqrt(D[0]*D[0]+D[1]*D[1]+D[2]*D[2]);
-#endif
-            if (UNLIKELY(R < std::numeric_limits<double>::epsilon())) continue;
-            T_over_R = (force_fcns[k])(R,parameters[k],lag_mastr_node_idxs[k],lag_slave_node_idxs[k])/R;
-            F[0] = T_over_R*D[0];
-            F[1] = T_over_R*D[1];
-#if (NDIM == 3)
-            F[2] = T_over_R*D[2];
-#endif
-            F_node[mastr_idx+0] += F[0];
-            F_node[mastr_idx+1] += F[1];
-#if (NDIM == 3)
-            F_node[mastr_idx+2] += F[2];
-#endif
-            F_node[slave_idx+0] -= F[0];
-            F_node[slave_idx+1] -= F[1];
-#if (NDIM == 3)
-            F_node[slave_idx+2] -= F[2];
-#endif
-        }
-    }
-    for (k = kblock*BLOCKSIZE; k < num_springs; ++k)
-    {
-        mastr_idx = petsc_mastr_node_idxs[k];
-        slave_idx = petsc_slave_node_idxs[k];
-#ifdef DEBUG_CHECK_ASSERTIONS
-        TBOX_ASSERT(mastr_idx != slave_idx);
-#endif
-        D[0] = X_node[slave_idx+0] - X_node[mastr_idx+0];
-        D[1] = X_node[slave_idx+1] - X_node[mastr_idx+1];
-#if (NDIM == 3)
-        D[2] = X_node[slave_idx+2] - X_node[mastr_idx+2];
-#endif
-#if (NDIM == 2)
-        R = sqrt(D[0]*D[0]+D[1]*D[1]);
-#endif
-#if (NDIM == 3)
-        R = sqrt(D[0]*D[0]+D[1]*D[1]+D[2]*D[2]);
-#endif
-        if (UNLIKELY(R < std::numeric_limits<double>::epsilon())) continue;
-        T_over_R = (force_fcns[k])(R,parameters[k],lag_mastr_node_idxs[k],lag_slave_node_idxs[k])/R;
-        F[0] = T_over_R*D[0];
-        F[1] = T_over_R*D[1];
-#if (NDIM == 3)
-        F[2] = T_over_R*D[2];
-#endif
-        F_node[mastr_idx+0] += F[0];
-        F_node[mastr_idx+1] += F[1];
-#if (NDIM == 3)
-        F_node[mastr_idx+2] += F[2];
-#endif
-        F_node[slave_idx+0] -= F[0];
-        F_node[slave_idx+1] -= F[1];
-#if (NDIM == 3)
-        F_node[slave_idx+2] -= F[2];
-#endif
-    }
-
+            spring_data.lag_mastr_node_idxs  .data(),
+            spring_data.lag_slave_node_idxs  .data(),
+            spring_data.petsc_mastr_node_idxs.data(),
+            spring_data.petsc_slave_node_idxs.data(),
+            spring_data.force_fcns           .data(),
+            spring_data.parameters           .data(),
+            F_data->getLocalFormVecArray()       ->data(),
+            X_data->getGhostedLocalFormVecArray()->data()
+        };
+    apply_force_kernel(kernel, k_begin, k_end, spring_data.color_offsets, get_num_threads(d_num_threads));
     F_data->restoreArrays();
     X_data->restoreArrays();
     return;
 }// computeLagrangianSpringForce
 
+void
+IBStandardForceGen::computeLagrangianDefaultSpringForce(
+    Pointer<LData> F_data,
+    Pointer<LData> X_data,
+    const int k_begin,
+    const int k_end,
+    const int level_number)
+{
+    const int num_springs = k_end-k_begin;
+    if (num_springs <= 0) return;
+    SpringData& spring_data = d_spring_data[level_number];
+    const DefaultSpringForceKernel kernel =
+        {
+            spring_data.petsc_mastr_node_idxs.data(),
+            spring_data.petsc_slave_node_idxs.data(),
+            spring_data.parameters           .data(),
+            F_data->getLocalFormVecArray()       ->data(),
+            X_data->getGhostedLocalFormVecArray()->data()
+        };
+    apply_force_kernel(kernel, k_begin, k_end, spring_data.color_offsets, get_num_threads(d_num_threads));
+    F_data->restoreArrays();
+    X_data->restoreArrays();
+    return;
+}// computeLagrangianDefaultSpringForce
+
 void
 IBStandardForceGen::initializeBeamLevelData(
     std::set<int>& nonlocal_petsc_idx_set,
@@ -983,108 +1932,27 @@ void
 IBStandardForceGen::computeLagrangianBeamForce(
     Pointer<LData> F_data,
     Pointer<LData> X_data,
+    const int k_begin,
+    const int k_end,
     const Pointer<PatchHierarchy<NDIM> > /*hierarchy*/,
     const int level_number,
     const double /*data_time*/,
     LDataManager* const /*l_data_manager*/)
 {
-    const int num_beams = d_beam_data[level_number].petsc_mastr_node_idxs.size();
-    const int*                             const restrict petsc_mastr_node_idxs = d_beam_data[level_number].petsc_mastr_node_idxs.data();
-    const int*                             const restrict  petsc_next_node_idxs = d_beam_data[level_number].petsc_next_node_idxs .data();
-    const int*                             const restrict  petsc_prev_node_idxs = d_beam_data[level_number].petsc_prev_node_idxs .data();
-    const double**                         const restrict            rigidities = d_beam_data[level_number].rigidities           .data();
-    const blitz::TinyVector<double,NDIM>** const restrict            curvatures = d_beam_data[level_number].curvatures           .data();
-    double*                                const restrict                F_node = F_data->getLocalFormVecArray()       ->data();
-    const double*                          const restrict                X_node = X_data->getGhostedLocalFormVecArray()->data();
-
-    static const int BLOCKSIZE = 16;  // This parameter needs to be tuned.
-    int k, kblock, kunroll, mastr_idx, next_idx, prev_idx;
-    double K;
-    const double* restrict D2X0;
-    double F[NDIM];
-    kblock = 0;
-    for ( ; kblock < (num_beams-1)/BLOCKSIZE; ++kblock)  // ensure that the last block is NOT handled by this first loop
-    {
-        PREFETCH_READ_NTA_BLOCK(petsc_mastr_node_idxs+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK( petsc_next_node_idxs+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK( petsc_prev_node_idxs+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(           rigidities+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(           curvatures+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        for (kunroll = 0; kunroll < BLOCKSIZE; ++kunroll)
+    const int num_beams = k_end-k_begin;
+    if (num_beams <= 0) return;
+    BeamData& beam_data = d_beam_data[level_number];
+    const BeamForceKernel kernel =
         {
-            k = kblock*BLOCKSIZE+kunroll;
-            mastr_idx = petsc_mastr_node_idxs[k];
-            next_idx  = petsc_next_node_idxs [k];
-            prev_idx  = petsc_prev_node_idxs [k];
-#ifdef DEBUG_CHECK_ASSERTIONS
-            TBOX_ASSERT(mastr_idx != next_idx);
-            TBOX_ASSERT(mastr_idx != prev_idx);
-#endif
-            PREFETCH_READ_NTA_NDIM_BLOCK(F_node+petsc_mastr_node_idxs[k+1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(F_node+ petsc_next_node_idxs[k+1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(F_node+ petsc_prev_node_idxs[k+1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(X_node+petsc_mastr_node_idxs[k+1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(X_node+ petsc_next_node_idxs[k+1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(X_node+ petsc_prev_node_idxs[k+1]);
-            PREFETCH_READ_NTA(                             rigidities[k+1]);
-            PREFETCH_READ_NTA(                             curvatures[k+1]);
-            K = *rigidities[k];
-            D2X0 = curvatures[k]->data();
-            F[0] = K*(X_node[next_idx+0]+X_node[prev_idx+0]-2.0*X_node[mastr_idx+0]-D2X0[0]);
-            F[1] = K*(X_node[next_idx+1]+X_node[prev_idx+1]-2.0*X_node[mastr_idx+1]-D2X0[1]);
-#if (NDIM == 3)
-            F[2] = K*(X_node[next_idx+2]+X_node[prev_idx+2]-2.0*X_node[mastr_idx+2]-D2X0[2]);
-#endif
-            F_node[mastr_idx+0] += 2.0*F[0];
-            F_node[mastr_idx+1] += 2.0*F[1];
-#if (NDIM == 3)
-            F_node[mastr_idx+2] += 2.0*F[2];
-#endif
-            F_node[next_idx +0] -=     F[0];
-            F_node[next_idx +1] -=     F[1];
-#if (NDIM == 3)
-            F_node[next_idx +2] -=     F[2];
-#endif
-            F_node[prev_idx +0] -=     F[0];
-            F_node[prev_idx +1] -=     F[1];
-#if (NDIM == 3)
-            F_node[prev_idx +2] -=     F[2];
-#endif
-        }
-    }
-    for (k = kblock*BLOCKSIZE; k < num_beams; ++k)
-    {
-        mastr_idx = petsc_mastr_node_idxs[k];
-        next_idx  = petsc_next_node_idxs [k];
-        prev_idx  = petsc_prev_node_idxs [k];
-#ifdef DEBUG_CHECK_ASSERTIONS
-        TBOX_ASSERT(mastr_idx != next_idx);
-        TBOX_ASSERT(mastr_idx != prev_idx);
-#endif
-        K = *rigidities[k];
-        D2X0 = curvatures[k]->data();
-        F[0] = K*(X_node[next_idx+0]+X_node[prev_idx+0]-2.0*X_node[mastr_idx+0]-D2X0[0]);
-        F[1] = K*(X_node[next_idx+1]+X_node[prev_idx+1]-2.0*X_node[mastr_idx+1]-D2X0[1]);
-#if (NDIM == 3)
-        F[2] = K*(X_node[next_idx+2]+X_node[prev_idx+2]-2.0*X_node[mastr_idx+2]-D2X0[2]);
-#endif
-        F_node[mastr_idx+0] += 2.0*F[0];
-        F_node[mastr_idx+1] += 2.0*F[1];
-#if (NDIM == 3)
-        F_node[mastr_idx+2] += 2.0*F[2];
-#endif
-        F_node[next_idx +0] -=     F[0];
-        F_node[next_idx +1] -=     F[1];
-#if (NDIM == 3)
-        F_node[next_idx +2] -=     F[2];
-#endif
-        F_node[prev_idx +0] -=     F[0];
-        F_node[prev_idx +1] -=     F[1];
-#if (NDIM == 3)
-        F_node[prev_idx +2] -=     F[2];
-#endif
-    }
-
+            beam_data.petsc_mastr_node_idxs.data(),
+            beam_data.petsc_next_node_idxs .data(),
+            beam_data.petsc_prev_node_idxs .data(),
+            beam_data.rigidities           .data(),
+            beam_data.curvatures           .data(),
+            F_data->getLocalFormVecArray()       ->data(),
+            X_data->getGhostedLocalFormVecArray()->data()
+        };
+    apply_force_kernel(kernel, k_begin, k_end, beam_data.color_offsets, get_num_threads(d_num_threads));
     F_data->restoreArrays();
     X_data->restoreArrays();
     return;
@@ -1165,64 +2033,40 @@ IBStandardForceGen::computeLagrangianTargetPointForce(
     const double /*data_time*/,
     LDataManager* const /*l_data_manager*/)
 {
-    const int num_target_points = d_target_point_data[level_number].petsc_node_idxs.size();
-    const int*                             const restrict petsc_node_idxs = d_target_point_data[level_number].petsc_node_idxs.data();
-    const double**                         const restrict           kappa = d_target_point_data[level_number].kappa          .data();
-    const double**                         const restrict             eta = d_target_point_data[level_number].eta            .data();
-    const blitz::TinyVector<double,NDIM>** const restrict              X0 = d_target_point_data[level_number].X0             .data();
-    double*                                const restrict          F_node = F_data->getLocalFormVecArray()->data();
-    const double*                          const restrict          X_node = X_data->getLocalFormVecArray()->data();
-    const double*                          const restrict          U_node = U_data->getLocalFormVecArray()->data();
-
-    static const int BLOCKSIZE = 16;  // This parameter needs to be tuned.
-    int k, kblock, kunroll, idx;
-    double K, E;
-    const double* restrict X_target;
-    kblock = 0;
-    for ( ; kblock < (num_target_points-1)/BLOCKSIZE; ++kblock)  // ensure that the last block is NOT handled by this first loop
-    {
-        PREFETCH_READ_NTA_BLOCK(petsc_node_idxs+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(          kappa+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(            eta+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        PREFETCH_READ_NTA_BLOCK(             X0+BLOCKSIZE*(kblock+1), BLOCKSIZE);
-        for (kunroll = 0; kunroll < BLOCKSIZE; ++kunroll)
+    TargetPointData& target_point_data = d_target_point_data[level_number];
+    const int num_target_points = target_point_data.petsc_node_idxs.size();
+    const TargetPointForceKernel kernel =
         {
-            k = kblock*BLOCKSIZE+kunroll;
-            idx = petsc_node_idxs[k];
-            PREFETCH_READ_NTA_NDIM_BLOCK(F_node+petsc_node_idxs[k+1]);
-            PREFETCH_READ_NTA_NDIM_BLOCK(X_node+petsc_node_idxs[k+1]);
-            PREFETCH_READ_NTA(                            kappa[k+1]);
-            PREFETCH_READ_NTA(                              eta[k+1]);
-            PREFETCH_READ_NTA(                               X0[k+1]);
-            K = *kappa[k];
-            E = *eta  [k];
-            X_target = X0[k]->data();
-            F_node[idx+0] += K*(X_target[0] - X_node[idx+0]) - E*U_node[idx+0];
-            F_node[idx+1] += K*(X_target[1] - X_node[idx+1]) - E*U_node[idx+1];
-#if (NDIM == 3)
-            F_node[idx+2] += K*(X_target[2] - X_node[idx+2]) - E*U_node[idx+2];
-#endif
-        }
-    }
-    for (k = kblock*BLOCKSIZE; k < num_target_points; ++k)
-    {
-        idx = petsc_node_idxs[k];
-        K = *kappa[k];
-        E = *eta  [k];
-        X_target = X0[k]->data();
-        F_node[idx+0] += K*(X_target[0] - X_node[idx+0]) - E*U_node[idx+0];
-        F_node[idx+1] += K*(X_target[1] - X_node[idx+1]) - E*U_node[idx+1];
-#if (NDIM == 3)
-        F_node[idx+2] += K*(X_target[2] - X_node[idx+2]) - E*U_node[idx+2];
-#endif
-    }
-
+            target_point_data.petsc_node_idxs.data(),
+            target_point_data.kappa          .data(),
+            target_point_data.eta            .data(),
+            target_point_data.X0             .data(),
+            F_data->getLocalFormVecArray()->data(),
+            X_data->getLocalFormVecArray()->data(),
+            U_data->getLocalFormVecArray()->data()
+        };
+
+    // Each target point is associated with a distinct node, and so all target
+    // points may be processed concurrently (i.e., they all have the same
+    // "color").
+    apply_force_kernel(kernel, 0, num_target_points, std::vector<int>(1,0), get_num_threads(d_num_threads));
     F_data->restoreArrays();
     X_data->restoreArrays();
     U_data->restoreArrays();
     return;
 }// computeLagrangianTargetPointForce
 
+void
+IBStandardForceGen::getFromInput(
+    Pointer<Database> db)
+{
+    if (db)
+    {
+        if (db->keyExists("num_threads")) d_num_threads = db->getInteger("num_threads");
+    }
+    return;
+}// getFromInput
+
 /////////////////////////////// NAMESPACE ////////////////////////////////////
 
 } // namespace IBAMR
@@ -44,6 +44,7 @@
 #include "ibamr/IBLagrangianForceStrategy.h"
 #include "ibamr/IBSpringForceFunctions.h"
 #include "petscmat.h"
+#include "tbox/Database.h"
 #include "tbox/Pointer.h"
 
 namespace IBTK {
@@ -78,15 +79,26 @@ namespace IBAMR
  * force function with any function that implements the interface required by
  * registerSpringForceFunction().  Users may also specify additional force
  * functions that may be associated with arbitrary integer indices.
+ *
+ * \note When IBAMR is built with OpenMP support, the spring, beam, and target
+ * point forces may be computed by multiple threads.  To enable threaded force
+ * evaluation, set the input database key \p num_threads to the number of
+ * threads to use, or to zero to use the OpenMP default.  (By default, \p
+ * num_threads is one, and the forces are computed serially.)  In this case, the
+ * springs and beams are colored at initialization so that no two force
+ * elements of the same color share a node, and the force elements of each
+ * color are processed concurrently.  User-supplied spring force functions must
+ * be thread safe when threaded force evaluation is enabled.
  */
 class IBStandardForceGen
     : public IBLagrangianForceStrategy
 {
 public:
     /*!
-     * \brief Default constructor.
+     * \brief Constructor.
      */
-    IBStandardForceGen();
+    explicit IBStandardForceGen(
+        SAMRAI::tbox::Pointer<SAMRAI::tbox::Database> input_db=NULL);
 
     /*!
      * \brief Destructor.
@@ -158,6 +170,13 @@ public:
      *
      * \note The elements of the Jacobian should be "accumulated" in the
      * provided matrix J.
+     *
+     * \note When J is stored in AIJ format, the positions of the matrix entries
+     * within the storage of the matrix are recorded during the first final
+     * assembly, and subsequent assemblies accumulate the values directly in
+     * the storage of the matrix.  The recorded positions are discarded when
+     * the level data are reinitialized or when the nonzero structure of the
+     * matrix changes.
      */
     void
     computeLagrangianForceJacobian(
@@ -220,6 +239,10 @@ private:
         blitz::Array<SpringForceFcnPtr,1> force_fcns;
         blitz::Array<SpringForceDerivFcnPtr,1> force_deriv_fcns;
         blitz::Array<const double*,1> parameters;
+        int num_local_springs;  // the number of springs involving only local nodes
+        int num_local_default_springs;     // the number of local springs that use default_spring_force()
+        int num_nonlocal_default_springs;  // the number of nonlocal springs that use default_spring_force()
+        std::vector<int> color_offsets;  // the first spring of each color (empty unless threaded)
     };
     std::vector<SpringData> d_spring_data;
 
@@ -228,6 +251,8 @@ private:
         blitz::Array<int,1> petsc_mastr_node_idxs, petsc_next_node_idxs, petsc_prev_node_idxs;
         blitz::Array<const double*,1> rigidities;
         blitz::Array<const blitz::TinyVector<double,NDIM>*,1> curvatures;
+        int num_local_beams;  // the number of beams involving only local nodes
+        std::vector<int> color_offsets;  // the first beam of each color (empty unless threaded)
     };
     std::vector<BeamData> d_beam_data;
 
@@ -241,6 +266,7 @@ private:
 
     std::vector<SAMRAI::tbox::Pointer<IBTK::LData> > d_X_ghost_data, d_F_ghost_data;
     std::vector<bool> d_is_initialized;
+    std::vector<int> d_jacobian_structure_version;
     //\}
 
     /*!
@@ -258,10 +284,19 @@ private:
     computeLagrangianSpringForce(
         SAMRAI::tbox::Pointer<IBTK::LData> F_data,
         SAMRAI::tbox::Pointer<IBTK::LData> X_data,
+        int k_begin,
+        int k_end,
         SAMRAI::tbox::Pointer<SAMRAI::hier::PatchHierarchy<NDIM> > hierarchy,
         int level_number,
         double data_time,
         IBTK::LDataManager* l_data_manager);
+    void
+    computeLagrangianDefaultSpringForce(
+        SAMRAI::tbox::Pointer<IBTK::LData> F_data,
+        SAMRAI::tbox::Pointer<IBTK::LData> X_data,
+        int k_begin,
+        int k_end,
+        int level_number);
 
     /*!
      * Beam force routines.
@@ -278,6 +313,8 @@ private:
     computeLagrangianBeamForce(
         SAMRAI::tbox::Pointer<IBTK::LData> F_data,
         SAMRAI::tbox::Pointer<IBTK::LData> X_data,
+        int k_begin,
+        int k_end,
         SAMRAI::tbox::Pointer<SAMRAI::hier::PatchHierarchy<NDIM> > hierarchy,
         int level_number,
         double data_time,
@@ -304,6 +341,18 @@ private:
         double data_time,
         IBTK::LDataManager* l_data_manager);
 
+    /*!
+     * Read input values from a given database.
+     */
+    void
+    getFromInput(
+        SAMRAI::tbox::Pointer<SAMRAI::tbox::Database> db);
+
+    /*!
+     * \brief The number of threads used to compute the forces.
+     */
+    int d_num_threads;
+
     /*!
      * \brief Spring force functions.
      */
@@ -58,6 +58,7 @@
 #include "PatchLevel.h"
 #include "SAMRAI_config.h"
 #include "blitz/array.h"
+#include "hdf5.h"
 #include "ibamr/IBAnchorPointSpec.h"
 #include "ibamr/IBAnchorPointSpec-inl.h"
 #include "ibamr/IBBeamForceSpec.h"
@@ -74,6 +75,10 @@
 #include "ibamr/IBTargetPointForceSpec.h"
 #include "ibamr/IBTargetPointForceSpec-inl.h"
 #include "ibamr/namespaces.h" // IWYU pragma: keep
+#include "ibtk/ASCIIFileParser.h"
+#include "ibtk/ASCIIFileParser-inl.h"
+#include "ibtk/BinaryCacheFile.h"
+#include "ibtk/BinaryCacheFile-inl.h"
 #include "ibtk/IndexUtilities.h"
 #include "ibtk/IndexUtilities-inl.h"
 #include "ibtk/LData.h"
@@ -92,6 +97,10 @@
 #include "tbox/SAMRAI_MPI.h"
 #include "tbox/Utilities.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace IBTK {
 class LDataManager;
 }  // namespace IBTK
@@ -129,6 +138,299 @@ discard_comments(
     string_stream.clear();
     return output_string;
 }// discard_comments
+
+inline bool
+hdf5_input_file_exists(
+    const std::string& filename)
+{
+    // Only the root process tests for the file so that all processes agree on
+    // whether the (collective) HDF5 reader is to be used.
+    int file_exists = 0;
+    if (SAMRAI_MPI::getRank() == 0)
+    {
+        std::ifstream file_stream(filename.c_str(), std::ios::in);
+        file_exists = file_stream.is_open() ? 1 : 0;
+    }
+    return SAMRAI_MPI::sumReduction(file_exists) > 0;
+}// hdf5_input_file_exists
+
+inline hid_t
+open_hdf5_input_file(
+    const std::string& filename)
+{
+    hid_t fapl_id = H5Pcreate(H5P_FILE_ACCESS);
+#ifdef H5_HAVE_PARALLEL
+    H5Pset_fapl_mpio(fapl_id, SAMRAI_MPI::getCommunicator(), MPI_INFO_NULL);
+#endif
+    hid_t file_id = H5Fopen(filename.c_str(), H5F_ACC_RDONLY, fapl_id);
+    H5Pclose(fapl_id);
+    return file_id;
+}// open_hdf5_input_file
+
+inline std::string
+get_hdf5_group_name(
+    const std::string& base_filename)
+{
+    // ascii2hdf stores the data for structure "foo" in group "/foo" of file
+    // "foo.h5"; any leading path components are not part of the group name.
+    const std::string::size_type pos = base_filename.find_last_of('/');
+    return "/" + (pos == std::string::npos ? base_filename : base_filename.substr(pos+1));
+}// get_hdf5_group_name
+
+inline bool
+hdf5_link_exists(
+    hid_t loc_id,
+    const std::string& name)
+{
+    return H5Lexists(loc_id, name.c_str(), H5P_DEFAULT) > 0;
+}// hdf5_link_exists
+
+/*!
+ * Read a one- or two-dimensional dataset from an HDF5 file and make the full
+ * contents available on every MPI process.
+ *
+ * Each process reads a contiguous block of rows of the dataset (collectively,
+ * when parallel HDF5 is available) and the blocks are subsequently assembled
+ * on all processes.
+ */
+template<typename T>
+void
+read_hdf5_dataset(
+    hid_t file_id,
+    const std::string& dset_name,
+    hid_t mem_type_id,
+    std::vector<T>& data,
+    int& num_rows)
+{
+    const int rank = SAMRAI_MPI::getRank();
+    const int nodes = SAMRAI_MPI::getNodes();
+
+    hid_t dset_id = H5Dopen2(file_id, dset_name.c_str(), H5P_DEFAULT);
+    if (dset_id < 0)
+    {
+        TBOX_ERROR("IBStandardInitializer::read_hdf5_dataset():\n  Unable to open dataset " << dset_name << std::endl);
+    }
+    hid_t filespace = H5Dget_space(dset_id);
+    const int ndims = H5Sget_simple_extent_ndims(filespace);
+    if (ndims < 1 || ndims > 2)
+    {
+        TBOX_ERROR("IBStandardInitializer::read_hdf5_dataset():\n  Dataset " << dset_name << " has unsupported rank " << ndims << std::endl);
+    }
+    hsize_t dims[2] = { 0 , 1 };
+    H5Sget_simple_extent_dims(filespace, dims, NULL);
+    num_rows = static_cast<int>(dims[0]);
+    const int num_cols = static_cast<int>(dims[1]);
+
+    // Determine the block of rows to be read by this process.
+    const hsize_t row_begin = (dims[0]*static_cast<hsize_t>(rank  ))/static_cast<hsize_t>(nodes);
+    const hsize_t row_end   = (dims[0]*static_cast<hsize_t>(rank+1))/static_cast<hsize_t>(nodes);
+    const hsize_t local_num_rows = row_end-row_begin;
+    std::vector<T> local_data(std::max(local_num_rows,static_cast<hsize_t>(1))*num_cols);
+
+    hsize_t offsetf[2] = { row_begin , 0 };
+    hsize_t countf[2] = { local_num_rows , dims[1] };
+    hsize_t dimsm[2] = { std::max(local_num_rows,static_cast<hsize_t>(1)) , dims[1] };
+    hid_t memspace = H5Screate_simple(ndims, dimsm, NULL);
+    if (local_num_rows > 0)
+    {
+        H5Sselect_hyperslab(filespace, H5S_SELECT_SET, offsetf, NULL, countf, NULL);
+    }
+    else
+    {
+        // Processes without any rows to read must still participate in
+        // collective reads.
+        H5Sselect_none(filespace);
+        H5Sselect_none(memspace);
+    }
+
+    hid_t dxpl_id = H5Pcreate(H5P_DATASET_XFER);
+#ifdef H5_HAVE_PARALLEL
+    H5Pset_dxpl_mpio(dxpl_id, H5FD_MPIO_COLLECTIVE);
+#endif
+    if (H5Dread(dset_id, mem_type_id, memspace, filespace, dxpl_id, &local_data[0]) < 0)
+    {
+        TBOX_ERROR("IBStandardInitializer::read_hdf5_dataset():\n  Unable to read dataset " << dset_name << std::endl);
+    }
+    H5Pclose(dxpl_id);
+    H5Sclose(memspace);
+    H5Sclose(filespace);
+    H5Dclose(dset_id);
+
+    // Assemble the complete dataset on each process.
+    data.resize(std::max(num_rows,1)*num_cols);
+    const int local_size = static_cast<int>(local_num_rows)*num_cols;
+    SAMRAI_MPI::allGather(&local_data[0], local_size, &data[0], num_rows*num_cols);
+    data.resize(num_rows*num_cols);
+    return;
+}// read_hdf5_dataset
+
+inline int
+get_hdf5_dataset_num_rows(
+    hid_t file_id,
+    const std::string& dset_name)
+{
+    hid_t dset_id = H5Dopen2(file_id, dset_name.c_str(), H5P_DEFAULT);
+    if (dset_id < 0)
+    {
+        TBOX_ERROR("IBStandardInitializer::get_hdf5_dataset_num_rows():\n  Unable to open dataset " << dset_name << std::endl);
+    }
+    hid_t filespace = H5Dget_space(dset_id);
+    hsize_t dims[2] = { 0 , 1 };
+    H5Sget_simple_extent_dims(filespace, dims, NULL);
+    H5Sclose(filespace);
+    H5Dclose(dset_id);
+    return static_cast<int>(dims[0]);
+}// get_hdf5_dataset_num_rows
+
+/*!
+ * Independently read rows [row_begin,row_end) of a one- or two-dimensional
+ * dataset from an HDF5 file.
+ */
+template<typename T>
+void
+read_hdf5_rows(
+    hid_t file_id,
+    const std::string& dset_name,
+    hid_t mem_type_id,
+    const int row_begin,
+    const int row_end,
+    std::vector<T>& data)
+{
+    hid_t dset_id = H5Dopen2(file_id, dset_name.c_str(), H5P_DEFAULT);
+    if (dset_id < 0)
+    {
+        TBOX_ERROR("IBStandardInitializer::read_hdf5_rows():\n  Unable to open dataset " << dset_name << std::endl);
+    }
+    hid_t filespace = H5Dget_space(dset_id);
+    const int ndims = H5Sget_simple_extent_ndims(filespace);
+    hsize_t dims[2] = { 0 , 1 };
+    H5Sget_simple_extent_dims(filespace, dims, NULL);
+    const hsize_t num_rows = static_cast<hsize_t>(row_end-row_begin);
+    data.resize(num_rows*dims[1]);
+    if (num_rows > 0)
+    {
+        hsize_t offsetf[2] = { static_cast<hsize_t>(row_begin) , 0 };
+        hsize_t countf[2] = { num_rows , dims[1] };
+        H5Sselect_hyperslab(filespace, H5S_SELECT_SET, offsetf, NULL, countf, NULL);
+        hid_t memspace = H5Screate_simple(ndims, countf, NULL);
+        if (H5Dread(dset_id, mem_type_id, memspace, filespace, H5P_DEFAULT, &data[0]) < 0)
+        {
+            TBOX_ERROR("IBStandardInitializer::read_hdf5_rows():\n  Unable to read dataset " << dset_name << std::endl);
+        }
+        H5Sclose(memspace);
+    }
+    H5Sclose(filespace);
+    H5Dclose(dset_id);
+    return;
+}// read_hdf5_rows
+
+/*!
+ * Independently read the specified rows of a one- or two-dimensional dataset
+ * from an HDF5 file.  The rows are returned in the order in which they are
+ * specified.
+ */
+template<typename T>
+void
+read_hdf5_selected_rows(
+    hid_t file_id,
+    const std::string& dset_name,
+    hid_t mem_type_id,
+    const std::vector<int>& rows,
+    std::vector<T>& data)
+{
+    hid_t dset_id = H5Dopen2(file_id, dset_name.c_str(), H5P_DEFAULT);
+    if (dset_id < 0)
+    {
+        TBOX_ERROR("IBStandardInitializer::read_hdf5_selected_rows():\n  Unable to open dataset " << dset_name << std::endl);
+    }
+    hid_t filespace = H5Dget_space(dset_id);
+    const int ndims = H5Sget_simple_extent_ndims(filespace);
+    hsize_t dims[2] = { 0 , 1 };
+    H5Sget_simple_extent_dims(filespace, dims, NULL);
+    const hsize_t num_elements = rows.size()*dims[1];
+    data.resize(num_elements);
+    if (num_elements > 0)
+    {
+        std::vector<hsize_t> coords(num_elements*ndims);
+        for (unsigned int k = 0, e = 0; k < rows.size(); ++k)
+        {
+            for (hsize_t d = 0; d < dims[1]; ++d, ++e)
+            {
+                coords[ndims*e] = static_cast<hsize_t>(rows[k]);
+                if (ndims == 2) coords[ndims*e+1] = d;
+            }
+        }
+        H5Sselect_elements(filespace, H5S_SELECT_SET, num_elements, &coords[0]);
+        hid_t memspace = H5Screate_simple(1, &num_elements, NULL);
+        if (H5Dread(dset_id, mem_type_id, memspace, filespace, H5P_DEFAULT, &data[0]) < 0)
+        {
+            TBOX_ERROR("IBStandardInitializer::read_hdf5_selected_rows():\n  Unable to read dataset " << dset_name << std::endl);
+        }
+        H5Sclose(memspace);
+    }
+    H5Sclose(filespace);
+    H5Dclose(dset_id);
+    return;
+}// read_hdf5_selected_rows
+
+// Identifying string and version number of binary structure cache files.  The
+// version number must be incremented whenever the layout of the cache files is
+// changed.
+static const char* const STRUCTURE_CACHE_MAGIC = "IBSCACHE";
+static const int STRUCTURE_CACHE_MAGIC_LENGTH = 8;
+static const int STRUCTURE_CACHE_VERSION = 1;
+
+// The extensions of the input files whose contents are stored in binary
+// structure cache files.
+static const int NUM_CACHED_FILE_EXTENSIONS = 8;
+static const char* const CACHED_FILE_EXTENSIONS[NUM_CACHED_FILE_EXTENSIONS] =
+{ ".vertex", ".spring", ".beam", ".rod", ".target", ".anchor", ".mass", ".director" };
+
+template<typename T>
+inline void
+hash_value(
+    const T& value,
+    unsigned long long& hash)
+{
+    hash = BinaryCacheFile::hashBytes(&value, sizeof(T), hash);
+    return;
+}// hash_value
+
+inline int
+get_num_threads(
+    const int num_threads)
+{
+#ifdef _OPENMP
+    return (num_threads > 0 ? num_threads : omp_get_max_threads());
+#else
+    NULL_USE(num_threads);
+    return 1;
+#endif
+}// get_num_threads
+
+inline void
+write_file_stamp(
+    BinaryCacheFile& cache_file,
+    const BinaryCacheFile::FileStamp& stamp)
+{
+    cache_file.write(stamp.exists);
+    cache_file.write(stamp.size);
+    cache_file.write(stamp.mtime);
+    cache_file.write(stamp.hash);
+    return;
+}// write_file_stamp
+
+inline BinaryCacheFile::FileStamp
+read_file_stamp(
+    BinaryCacheFile& cache_file)
+{
+    BinaryCacheFile::FileStamp stamp;
+    stamp.exists = cache_file.read<int>();
+    stamp.size = cache_file.read<unsigned long long>();
+    stamp.mtime = cache_file.read<long long>();
+    stamp.hash = cache_file.read<unsigned long long>();
+    return stamp;
+}// read_file_stamp
 }
 
 /////////////////////////////// PUBLIC ///////////////////////////////////////
@@ -138,15 +440,26 @@ IBStandardInitializer::IBStandardInitializer(
     Pointer<Database> input_db)
     : d_object_name(object_name),
       d_use_file_batons(true),
+      d_use_hdf5_input(false),
+      d_use_spatial_filtering(false),
+      d_spatial_filter_ghost_width(1.0),
+      d_use_structure_cache(false),
+      d_use_parallel_ascii_parser(false),
+      d_ascii_parser_num_threads(1),
       d_max_levels(-1),
       d_level_is_initialized(),
       d_silo_writer(NULL),
       d_base_filename(),
+      d_using_hdf5_input(),
+      d_using_structure_cache(),
+      d_using_spatial_filtering(),
+      d_bucket_index(),
       d_length_scale_factor(1.0),
       d_posn_shift(0.0),
       d_num_vertex(),
       d_vertex_offset(),
       d_vertex_posn(),
+      d_local_vertex_posn(),
       d_enable_springs(),
       d_spring_edge_map(),
       d_spring_spec_data(),
@@ -178,6 +491,7 @@ IBStandardInitializer::IBStandardInitializer(
       d_uniform_rod_properties(),
       d_enable_target_points(),
       d_target_spec_data(),
+      d_local_target_spec_data(),
       d_using_uniform_target_stiffness(),
       d_uniform_target_stiffness(),
       d_using_uniform_target_damping(),
@@ -186,6 +500,7 @@ IBStandardInitializer::IBStandardInitializer(
       d_anchor_spec_data(),
       d_enable_bdry_mass(),
       d_bdry_mass_spec_data(),
+      d_local_bdry_mass_spec_data(),
       d_using_uniform_bdry_mass(),
       d_uniform_bdry_mass(),
       d_using_uniform_bdry_mass_stiffness(),
@@ -248,6 +563,9 @@ IBStandardInitializer::IBStandardInitializer(
         // Process the directors information.
         readDirectorFiles(".director");
 
+        // Cache the parsed structure data for subsequent runs.
+        if (d_use_structure_cache) writeStructureCacheFiles();
+
         // Process the instrumentation information.
         readInstrumentationFiles(".inst");
 
@@ -319,6 +637,7 @@ IBStandardInitializer::computeLocalNodeCountOnPatchLevel(
 
         // Count the number of vertices whose initial locations will be within
         // the given patch.
+        loadPatchBuckets(patch, level_number);
         std::vector<std::pair<int,int> > patch_vertices;
         getPatchVertices(patch_vertices, patch, level_number, can_be_refined);
         local_node_count += patch_vertices.size();
@@ -391,6 +710,7 @@ IBStandardInitializer::initializeDataOnPatchLevel(
 
         // Initialize the vertices whose initial locations will be within the
         // given patch.
+        loadPatchBuckets(patch, level_number);
         std::vector<std::pair<int,int> > patch_vertices;
         getPatchVertices(patch_vertices, patch, level_number, can_be_refined);
         local_node_count += patch_vertices.size();
@@ -488,6 +808,7 @@ IBStandardInitializer::initializeMassDataOnPatchLevel(
 
         // Initialize the vertices whose initial locations will be within the
         // given patch.
+        loadPatchBuckets(patch, level_number);
         std::vector<std::pair<int,int> > patch_vertices;
         getPatchVertices(patch_vertices, patch, level_number, can_be_refined);
         local_node_count += patch_vertices.size();
@@ -544,6 +865,7 @@ IBStandardInitializer::initializeDirectorDataOnPatchLevel(
 
         // Initialize the vertices whose initial locations will be within the
         // given patch.
+        loadPatchBuckets(patch, level_number);
         std::vector<std::pair<int,int> > patch_vertices;
         getPatchVertices(patch_vertices, patch, level_number, can_be_refined);
         local_node_count += patch_vertices.size();
@@ -594,6 +916,7 @@ IBStandardInitializer::tagCellsForInitialRefinement(
         const bool can_be_refined = level_number+2 < d_max_levels;
         for (int ln = level_number+1; ln < d_max_levels; ++ln)
         {
+            loadPatchBuckets(patch, ln);
             std::vector<std::pair<int,int> > patch_vertices;
             getPatchVertices(patch_vertices, patch, ln, can_be_refined);
             for (std::vector<std::pair<int,int> >::const_iterator it = patch_vertices.begin(); it != patch_vertices.end(); ++it)
@@ -655,7 +978,9 @@ IBStandardInitializer::initializeLSiloDataWriter(
         bool registered_spring_edge_map = false;
         for (unsigned int j = 0; j < d_num_vertex[level_number].size(); ++j)
         {
-            if (d_spring_edge_map[level_number][j].size() > 0)
+            // The spring connectivity of spatially filtered structures is not
+            // available on any single process.
+            if (d_spring_edge_map[level_number][j].size() > 0 && !d_using_spatial_filtering[level_number][j])
             {
                 registered_spring_edge_map = true;
                 const std::string postfix = "_mesh";
@@ -706,11 +1031,29 @@ IBStandardInitializer::readVertexFiles(
         d_num_vertex[ln].resize(num_base_filename,0);
         d_vertex_offset[ln].resize(num_base_filename,std::numeric_limits<int>::max());
         d_vertex_posn[ln].resize(num_base_filename);
+        d_using_hdf5_input[ln].resize(num_base_filename,false);
+        d_using_structure_cache[ln].resize(num_base_filename,false);
+        d_using_spatial_filtering[ln].resize(num_base_filename,false);
+        d_bucket_index[ln].resize(num_base_filename);
+        d_local_vertex_posn[ln].resize(num_base_filename);
+        d_local_target_spec_data[ln].resize(num_base_filename);
+        d_local_bdry_mass_spec_data[ln].resize(num_base_filename);
+        if (d_use_structure_cache)
+        {
+            // Structure cache files also provide the data that are otherwise
+            // read by the other readers.
+            d_spring_edge_map[ln].resize(num_base_filename);
+            d_spring_spec_data[ln].resize(num_base_filename);
+            d_beam_spec_data[ln].resize(num_base_filename);
+            d_rod_edge_map[ln].resize(num_base_filename);
+            d_rod_spec_data[ln].resize(num_base_filename);
+            d_target_spec_data[ln].resize(num_base_filename);
+            d_anchor_spec_data[ln].resize(num_base_filename);
+            d_bdry_mass_spec_data[ln].resize(num_base_filename);
+            d_directors[ln].resize(num_base_filename);
+        }
         for (unsigned int j = 0; j < num_base_filename; ++j)
         {
-            // Wait for the previous MPI process to finish reading the current file.
-            if (d_use_file_batons && rank != 0) SAMRAI_MPI::recv(&flag, sz, rank-1, false, j);
-
             if (j == 0)
             {
                 d_vertex_offset[ln][j] = 0;
@@ -720,6 +1063,33 @@ IBStandardInitializer::readVertexFiles(
                 d_vertex_offset[ln][j] = d_vertex_offset[ln][j-1]+d_num_vertex[ln][j-1];
             }
 
+            // Use the HDF5 input file for this structure if one is available.
+            // HDF5 files are read by all processes together, so no file batons
+            // are used in this case.
+            d_using_hdf5_input[ln][j] = d_use_hdf5_input && hdf5_input_file_exists(d_base_filename[ln][j] + ".h5");
+            if (d_using_hdf5_input[ln][j])
+            {
+                readVertexHDF5File(ln, j);
+                continue;
+            }
+
+            // Use the binary structure cache file for this structure if it is
+            // consistent with the input files.  In this case, all of the data
+            // stored in the cache file are read here.
+            d_using_structure_cache[ln][j] = d_use_structure_cache && readStructureCacheFile(ln, j);
+            if (d_using_structure_cache[ln][j]) continue;
+
+            // The parallel ASCII parser maps the input file into memory, so all
+            // processes read the file at the same time without file batons.
+            if (d_use_parallel_ascii_parser)
+            {
+                parseVertexFile(ln, j, d_base_filename[ln][j] + extension);
+                continue;
+            }
+
+            // Wait for the previous MPI process to finish reading the current file.
+            if (d_use_file_batons && rank != 0) SAMRAI_MPI::recv(&flag, sz, rank-1, false, j);
+
             // Ensure that the file exists.
             const std::string vertex_filename = d_base_filename[ln][j] + extension;
             std::ifstream file_stream;
@@ -816,6 +1186,23 @@ IBStandardInitializer::readSpringFiles(
             const int min_idx = 0;
             const int max_idx = (input_uses_global_idxs ? std::accumulate(d_num_vertex[ln].begin(), d_num_vertex[ln].end(), 0) : d_num_vertex[ln][j]);
 
+            // Structures provided in HDF5 format are read collectively.
+            if (d_using_hdf5_input[ln][j])
+            {
+                if (!d_using_spatial_filtering[ln][j]) readSpringHDF5File(ln, j, input_uses_global_idxs);
+                continue;
+            }
+
+            // Cached structures have already been read.
+            if (d_using_structure_cache[ln][j]) continue;
+
+            // The parallel ASCII parser does not use file batons.
+            if (d_use_parallel_ascii_parser)
+            {
+                parseSpringFile(ln, j, d_base_filename[ln][j] + extension, input_uses_global_idxs);
+                continue;
+            }
+
             // Wait for the previous MPI process to finish reading the current file.
             if (d_use_file_batons && rank != 0) SAMRAI_MPI::recv(&flag, sz, rank-1, false, j);
 
@@ -1197,6 +1584,23 @@ IBStandardInitializer::readBeamFiles(
             const int min_idx = 0;
             const int max_idx = (input_uses_global_idxs ? std::accumulate(d_num_vertex[ln].begin(), d_num_vertex[ln].end(), 0) : d_num_vertex[ln][j]);
 
+            // Structures provided in HDF5 format are read collectively.
+            if (d_using_hdf5_input[ln][j])
+            {
+                if (!d_using_spatial_filtering[ln][j]) readBeamHDF5File(ln, j, input_uses_global_idxs);
+                continue;
+            }
+
+            // Cached structures have already been read.
+            if (d_using_structure_cache[ln][j]) continue;
+
+            // The parallel ASCII parser does not use file batons.
+            if (d_use_parallel_ascii_parser)
+            {
+                parseBeamFile(ln, j, d_base_filename[ln][j] + extension, input_uses_global_idxs);
+                continue;
+            }
+
             // Wait for the previous MPI process to finish reading the current file.
             if (d_use_file_batons && rank != 0) SAMRAI_MPI::recv(&flag, sz, rank-1, false, j);
 
@@ -1386,6 +1790,9 @@ IBStandardInitializer::readRodFiles(
             const int min_idx = 0;
             const int max_idx = (input_uses_global_idxs ? std::accumulate(d_num_vertex[ln].begin(), d_num_vertex[ln].end(), 0) : d_num_vertex[ln][j]);
 
+            // Cached structures have already been read.
+            if (d_using_structure_cache[ln][j]) continue;
+
             // Wait for the previous MPI process to finish reading the current file.
             if (d_use_file_batons && rank != 0) SAMRAI_MPI::recv(&flag, sz, rank-1, false, j);
 
@@ -1644,8 +2051,12 @@ IBStandardInitializer::readTargetPointFiles(
             const int min_idx = 0;
             const int max_idx = d_num_vertex[ln][j];
 
+            // Data for spatially filtered structures are loaded on demand, and
+            // cached structures have already been read.
+            if (d_using_spatial_filtering[ln][j] || d_using_structure_cache[ln][j]) continue;
+
             // Wait for the previous MPI process to finish reading the current file.
-            if (d_use_file_batons && rank != 0) SAMRAI_MPI::recv(&flag, sz, rank-1, false, j);
+            if (d_use_file_batons && !d_using_hdf5_input[ln][j] && rank != 0) SAMRAI_MPI::recv(&flag, sz, rank-1, false, j);
 
             TargetSpec default_spec;
             default_spec.stiffness = 0.0;
@@ -1653,8 +2064,12 @@ IBStandardInitializer::readTargetPointFiles(
             d_target_spec_data[ln][j].resize(d_num_vertex[ln][j], default_spec);
 
             const std::string target_point_stiffness_filename = d_base_filename[ln][j] + extension;
+            if (d_using_hdf5_input[ln][j])
+            {
+                readTargetPointHDF5File(ln, j);
+            }
             std::ifstream file_stream;
-            file_stream.open(target_point_stiffness_filename.c_str(), std::ios::in);
+            if (!d_using_hdf5_input[ln][j]) file_stream.open(target_point_stiffness_filename.c_str(), std::ios::in);
             if (file_stream.is_open())
             {
                 plog << d_object_name << ":  "
@@ -1775,7 +2190,7 @@ IBStandardInitializer::readTargetPointFiles(
             }
 
             // Free the next MPI process to start reading the current file.
-            if (d_use_file_batons && rank != nodes-1) SAMRAI_MPI::send(&flag, sz, rank+1, false, j);
+            if (d_use_file_batons && !d_using_hdf5_input[ln][j] && rank != nodes-1) SAMRAI_MPI::send(&flag, sz, rank+1, false, j);
         }
     }
 
@@ -1804,6 +2219,9 @@ IBStandardInitializer::readAnchorPointFiles(
             const int min_idx = 0;
             const int max_idx = d_num_vertex[ln][j];
 
+            // Cached structures have already been read.
+            if (d_using_structure_cache[ln][j]) continue;
+
             // Wait for the previous MPI process to finish reading the current file.
             if (d_use_file_batons && rank != 0) SAMRAI_MPI::recv(&flag, sz, rank-1, false, j);
 
@@ -1904,8 +2322,12 @@ IBStandardInitializer::readBoundaryMassFiles(
             const int min_idx = 0;
             const int max_idx = d_num_vertex[ln][j];
 
+            // Data for spatially filtered structures are loaded on demand, and
+            // cached structures have already been read.
+            if (d_using_spatial_filtering[ln][j] || d_using_structure_cache[ln][j]) continue;
+
             // Wait for the previous MPI process to finish reading the current file.
-            if (d_use_file_batons && rank != 0) SAMRAI_MPI::recv(&flag, sz, rank-1, false, j);
+            if (d_use_file_batons && !d_using_hdf5_input[ln][j] && rank != 0) SAMRAI_MPI::recv(&flag, sz, rank-1, false, j);
 
             BdryMassSpec default_spec;
             default_spec.bdry_mass = 0.0;
@@ -1913,8 +2335,12 @@ IBStandardInitializer::readBoundaryMassFiles(
             d_bdry_mass_spec_data[ln][j].resize(d_num_vertex[ln][j], default_spec);
 
             const std::string bdry_mass_filename = d_base_filename[ln][j] + extension;
+            if (d_using_hdf5_input[ln][j])
+            {
+                readBoundaryMassHDF5File(ln, j);
+            }
             std::ifstream file_stream;
-            file_stream.open(bdry_mass_filename.c_str(), std::ios::in);
+            if (!d_using_hdf5_input[ln][j]) file_stream.open(bdry_mass_filename.c_str(), std::ios::in);
             if (file_stream.is_open())
             {
                 plog << d_object_name << ":  "
@@ -2027,7 +2453,7 @@ IBStandardInitializer::readBoundaryMassFiles(
             }
 
             // Free the next MPI process to start reading the current file.
-            if (d_use_file_batons && rank != nodes-1) SAMRAI_MPI::send(&flag, sz, rank+1, false, j);
+            if (d_use_file_batons && !d_using_hdf5_input[ln][j] && rank != nodes-1) SAMRAI_MPI::send(&flag, sz, rank+1, false, j);
         }
     }
     return;
@@ -2049,6 +2475,9 @@ IBStandardInitializer::readDirectorFiles(
         d_directors[ln].resize(num_base_filename);
         for (unsigned int j = 0; j < num_base_filename; ++j)
         {
+            // Cached structures have already been read.
+            if (d_using_structure_cache[ln][j]) continue;
+
             // Wait for the previous MPI process to finish reading the current file.
             if (d_use_file_batons && rank != 0) SAMRAI_MPI::recv(&flag, sz, rank-1, false, j);
 
@@ -2535,133 +2964,1628 @@ IBStandardInitializer::readSourceFiles(
 }// readSourceFiles
 
 void
-IBStandardInitializer::getPatchVertices(
-    std::vector<std::pair<int,int> >& patch_vertices,
-    const Pointer<Patch<NDIM> > patch,
-    const int level_number,
-    const bool /*can_be_refined*/) const
+IBStandardInitializer::readVertexHDF5File(
+    const int ln,
+    const unsigned int j)
 {
-    // Loop over all of the vertices to determine the indices of those vertices
-    // within the present patch.
-    //
-    // NOTE: This is clearly not the best way to do this, but it will work for
-    // now.
-    const Pointer<CartesianPatchGeometry<NDIM> > patch_geom = patch->getPatchGeometry();
-    const double* const xLower = patch_geom->getXLower();
-    const double* const xUpper = patch_geom->getXUpper();
+    const std::string hdf5_filename = d_base_filename[ln][j] + ".h5";
+    const std::string group_name = get_hdf5_group_name(d_base_filename[ln][j]);
+    plog << d_object_name << ":  "
+         << "processing vertex data from HDF5 input file named " << hdf5_filename << std::endl;
 
-    for (unsigned int j = 0; j < d_num_vertex[level_number].size(); ++j)
+    hid_t file_id = open_hdf5_input_file(hdf5_filename);
+    if (file_id < 0)
     {
-        for (int k = 0; k < d_num_vertex[level_number][j]; ++k)
+        TBOX_ERROR(d_object_name << ":\n  Unable to open HDF5 input file " << hdf5_filename << std::endl);
+    }
+    if (!hdf5_link_exists(file_id, group_name) || !hdf5_link_exists(file_id, group_name + "/vertex"))
+    {
+        TBOX_ERROR(d_object_name << ":\n  Vertex data group " << group_name << "/vertex not found in HDF5 input file " << hdf5_filename << std::endl);
+    }
+
+    // When spatial filtering is enabled and the file provides a spatial bucket
+    // index, only the index is read here.  The structure data are loaded bucket
+    // by bucket as the patches that require them are encountered.
+    d_using_spatial_filtering[ln][j] = d_use_spatial_filtering && hdf5_link_exists(file_id, group_name + "/bucket");
+    if (d_using_spatial_filtering[ln][j])
+    {
+        const int num_vertex = get_hdf5_dataset_num_rows(file_id, group_name + "/vertex/posn");
+        if (num_vertex <= 0)
         {
-            const blitz::TinyVector<double,NDIM>& X = d_vertex_posn[level_number][j][k];
-            const bool patch_owns_node =
-                ((  xLower[0] <= X[0])&&(X[0] < xUpper[0]))
-#if (NDIM > 1)
-                &&((xLower[1] <= X[1])&&(X[1] < xUpper[1]))
-#if (NDIM > 2)
-                &&((xLower[2] <= X[2])&&(X[2] < xUpper[2]))
-#endif
-#endif
-                ;
-            if (patch_owns_node) patch_vertices.push_back(std::make_pair(j,k));
+            TBOX_ERROR(d_object_name << ":\n  Invalid vertex data in HDF5 input file " << hdf5_filename << std::endl);
+        }
+        d_num_vertex[ln][j] = num_vertex;
+
+        BucketIndex& bucket_index = d_bucket_index[ln][j];
+        std::vector<double> lower, upper;
+        std::vector<int> num_buckets;
+        int n;
+        read_hdf5_dataset(file_id, group_name + "/bucket/lower"      , H5T_NATIVE_DOUBLE, lower      , n);
+        read_hdf5_dataset(file_id, group_name + "/bucket/upper"      , H5T_NATIVE_DOUBLE, upper      , n);
+        read_hdf5_dataset(file_id, group_name + "/bucket/num_buckets", H5T_NATIVE_INT   , num_buckets, n);
+        int total_num_buckets = 1;
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            bucket_index.lower      [d] = lower      [d];
+            bucket_index.upper      [d] = upper      [d];
+            bucket_index.num_buckets[d] = num_buckets[d];
+            total_num_buckets *= num_buckets[d];
+        }
+        static const char* const bucket_items[5] = { "vertex" , "spring" , "beam" , "target_point" , "mass_point" };
+        std::vector<int>* const bucket_offsets[5] = { &bucket_index.vertex_offsets , &bucket_index.spring_offsets , &bucket_index.beam_offsets , &bucket_index.target_point_offsets , &bucket_index.mass_point_offsets };
+        for (int i = 0; i < 5; ++i)
+        {
+            const std::string dset_name = group_name + "/bucket/" + bucket_items[i] + "_offsets";
+            if (hdf5_link_exists(file_id, dset_name))
+            {
+                read_hdf5_dataset(file_id, dset_name, H5T_NATIVE_INT, *bucket_offsets[i], n);
+                if (n != total_num_buckets+1)
+                {
+                    TBOX_ERROR(d_object_name << ":\n  Invalid spatial bucket index " << dset_name << " in HDF5 input file " << hdf5_filename << std::endl);
+                }
+            }
         }
+        H5Fclose(file_id);
+
+        plog << d_object_name << ":  "
+             << "read spatial bucket index for " << d_num_vertex[ln][j] << " vertices from HDF5 input file named " << hdf5_filename << std::endl;
+        return;
     }
-    return;
-}// getPatchVertices
 
-int
-IBStandardInitializer::getCanonicalLagrangianIndex(
-    const std::pair<int,int>& point_index,
-    const int level_number) const
-{
-    return d_vertex_offset[level_number][point_index.first]+point_index.second;
-}// getCanonicalLagrangianIndex
+    std::vector<double> posn;
+    int num_vertex;
+    read_hdf5_dataset(file_id, group_name + "/vertex/posn", H5T_NATIVE_DOUBLE, posn, num_vertex);
+    H5Fclose(file_id);
 
-blitz::TinyVector<double,NDIM>
-IBStandardInitializer::getVertexPosn(
-    const std::pair<int,int>& point_index,
-    const int level_number) const
-{
-    return d_vertex_posn[level_number][point_index.first][point_index.second];
-}// getVertexPosn
+    if (num_vertex <= 0 || static_cast<int>(posn.size()) != num_vertex*NDIM)
+    {
+        TBOX_ERROR(d_object_name << ":\n  Invalid vertex data in HDF5 input file " << hdf5_filename << std::endl);
+    }
 
-const IBStandardInitializer::TargetSpec&
-IBStandardInitializer::getVertexTargetSpec(
-    const std::pair<int,int>& point_index,
-    const int level_number) const
-{
-    return d_target_spec_data[level_number][point_index.first][point_index.second];
-}// getVertexTargetSpec
+    d_num_vertex[ln][j] = num_vertex;
+    d_vertex_posn[ln][j].resize(num_vertex);
+    for (int k = 0; k < num_vertex; ++k)
+    {
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            d_vertex_posn[ln][j][k][d] = d_length_scale_factor*(posn[NDIM*k+d] + d_posn_shift[d]);
+        }
+    }
 
-const IBStandardInitializer::AnchorSpec&
-IBStandardInitializer::getVertexAnchorSpec(
-    const std::pair<int,int>& point_index,
-    const int level_number) const
-{
-    return d_anchor_spec_data[level_number][point_index.first][point_index.second];
-}// getVertexAnchorSpec
+    plog << d_object_name << ":  "
+         << "read " << d_num_vertex[ln][j] << " vertices from HDF5 input file named " << hdf5_filename << std::endl;
+    return;
+}// readVertexHDF5File
 
-const IBStandardInitializer::BdryMassSpec&
-IBStandardInitializer::getVertexBdryMassSpec(
-    const std::pair<int,int>& point_index,
-    const int level_number) const
+void
+IBStandardInitializer::readSpringHDF5File(
+    const int ln,
+    const unsigned int j,
+    const bool input_uses_global_idxs)
 {
-    return d_bdry_mass_spec_data[level_number][point_index.first][point_index.second];
-}// getVertexBdryMassSpec
+    const std::string hdf5_filename = d_base_filename[ln][j] + ".h5";
+    const std::string group_name = get_hdf5_group_name(d_base_filename[ln][j]);
+    hid_t file_id = open_hdf5_input_file(hdf5_filename);
+    if (file_id < 0)
+    {
+        TBOX_ERROR(d_object_name << ":\n  Unable to open HDF5 input file " << hdf5_filename << std::endl);
+    }
+    if (!hdf5_link_exists(file_id, group_name + "/spring"))
+    {
+        H5Fclose(file_id);
+        return;
+    }
 
-const std::vector<double>&
-IBStandardInitializer::getVertexDirectors(
-    const std::pair<int,int>& point_index,
-    const int level_number) const
-{
-    return d_directors[level_number][point_index.first][point_index.second];
-}// getVertexDirectors
+    plog << d_object_name << ":  "
+         << "processing spring data from HDF5 input file named " << hdf5_filename << std::endl;
 
-std::pair<int,int>
-IBStandardInitializer::getVertexInstrumentationIndices(
-    const std::pair<int,int>& point_index,
-    const int level_number) const
+    std::vector<int> node1_idx, node2_idx, force_fcn_idx;
+    std::vector<double> stiffness, rest_length;
+    int num_edges, n;
+    read_hdf5_dataset(file_id, group_name + "/spring/node1_idx"    , H5T_NATIVE_INT   , node1_idx    , num_edges);
+    read_hdf5_dataset(file_id, group_name + "/spring/node2_idx"    , H5T_NATIVE_INT   , node2_idx    , n);
+    read_hdf5_dataset(file_id, group_name + "/spring/force_fcn_idx", H5T_NATIVE_INT   , force_fcn_idx, n);
+    read_hdf5_dataset(file_id, group_name + "/spring/stiffness"    , H5T_NATIVE_DOUBLE, stiffness    , n);
+    read_hdf5_dataset(file_id, group_name + "/spring/rest_length"  , H5T_NATIVE_DOUBLE, rest_length  , n);
+    H5Fclose(file_id);
+
+    addHDF5SpringData(ln, j, input_uses_global_idxs, node1_idx, node2_idx, force_fcn_idx, stiffness, rest_length, hdf5_filename);
+
+    plog << d_object_name << ":  "
+         << "read " << num_edges << " edges from HDF5 input file named " << hdf5_filename << std::endl;
+    return;
+}// readSpringHDF5File
+
+void
+IBStandardInitializer::readBeamHDF5File(
+    const int ln,
+    const unsigned int j,
+    const bool input_uses_global_idxs)
 {
-    std::map<int,std::pair<int,int> >::const_iterator it = d_instrument_idx[level_number][point_index.first].find(point_index.second);
-    if (it != d_instrument_idx[level_number][point_index.first].end())
+    const std::string hdf5_filename = d_base_filename[ln][j] + ".h5";
+    const std::string group_name = get_hdf5_group_name(d_base_filename[ln][j]);
+    hid_t file_id = open_hdf5_input_file(hdf5_filename);
+    if (file_id < 0)
     {
-        return it->second;
+        TBOX_ERROR(d_object_name << ":\n  Unable to open HDF5 input file " << hdf5_filename << std::endl);
     }
-    else
+    if (!hdf5_link_exists(file_id, group_name + "/beam"))
     {
-        return std::make_pair(-1,-1);
+        H5Fclose(file_id);
+        return;
     }
-}// getVertexInstrumentationIndices
 
-int
-IBStandardInitializer::getVertexSourceIndices(
-    const std::pair<int,int>& point_index,
-    const int level_number) const
+    plog << d_object_name << ":  "
+         << "processing beam data from HDF5 input file named " << hdf5_filename << std::endl;
+
+    std::vector<int> node1_idx, node2_idx, node3_idx;
+    std::vector<double> bend_rigidity;
+    std::vector<std::vector<double> > rest_curvature(NDIM);
+    int num_beams, n;
+    read_hdf5_dataset(file_id, group_name + "/beam/node1_idx"    , H5T_NATIVE_INT   , node1_idx    , num_beams);
+    read_hdf5_dataset(file_id, group_name + "/beam/node2_idx"    , H5T_NATIVE_INT   , node2_idx    , n);
+    read_hdf5_dataset(file_id, group_name + "/beam/node3_idx"    , H5T_NATIVE_INT   , node3_idx    , n);
+    read_hdf5_dataset(file_id, group_name + "/beam/bend_rigidity", H5T_NATIVE_DOUBLE, bend_rigidity, n);
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        std::ostringstream os;
+        os << d;
+        read_hdf5_dataset(file_id, group_name + "/beam/rest_curvature" + os.str(), H5T_NATIVE_DOUBLE, rest_curvature[d], n);
+    }
+    H5Fclose(file_id);
+
+    addHDF5BeamData(ln, j, input_uses_global_idxs, node1_idx, node2_idx, node3_idx, bend_rigidity, rest_curvature, hdf5_filename);
+
+    plog << d_object_name << ":  "
+         << "read " << num_beams << " beams from HDF5 input file named " << hdf5_filename << std::endl;
+    return;
+}// readBeamHDF5File
+
+void
+IBStandardInitializer::readTargetPointHDF5File(
+    const int ln,
+    const unsigned int j)
 {
-    std::map<int,int>::const_iterator it = d_source_idx[level_number][point_index.first].find(point_index.second);
-    if (it != d_source_idx[level_number][point_index.first].end())
+    const std::string hdf5_filename = d_base_filename[ln][j] + ".h5";
+    const std::string group_name = get_hdf5_group_name(d_base_filename[ln][j]);
+    hid_t file_id = open_hdf5_input_file(hdf5_filename);
+    if (file_id < 0)
     {
-        return it->second;
+        TBOX_ERROR(d_object_name << ":\n  Unable to open HDF5 input file " << hdf5_filename << std::endl);
     }
-    else
+    if (!hdf5_link_exists(file_id, group_name + "/target_point"))
     {
-        return -1;
+        H5Fclose(file_id);
+        return;
     }
-}// getVertexSourceIndices
 
-std::vector<Pointer<Streamable> >
-IBStandardInitializer::initializeSpecs(
-    const std::pair<int,int>& point_index,
-    const unsigned int global_index_offset,
-    const int level_number) const
-{
-    std::vector<Pointer<Streamable> > vertex_specs;
+    plog << d_object_name << ":  "
+         << "processing target point data from HDF5 input file named " << hdf5_filename << std::endl;
 
-    const int j = point_index.first;
-    const int mastr_idx = getCanonicalLagrangianIndex(point_index, level_number);
+    std::vector<int> node_idx;
+    std::vector<double> stiffness, damping;
+    int num_target_points, n;
+    read_hdf5_dataset(file_id, group_name + "/target_point/node_idx" , H5T_NATIVE_INT   , node_idx , num_target_points);
+    read_hdf5_dataset(file_id, group_name + "/target_point/stiffness", H5T_NATIVE_DOUBLE, stiffness, n);
+    read_hdf5_dataset(file_id, group_name + "/target_point/damping"  , H5T_NATIVE_DOUBLE, damping  , n);
+    H5Fclose(file_id);
 
-    // Initialize any spring specifications associated with the present vertex.
+    addHDF5TargetPointData(ln, j, node_idx, stiffness, damping, hdf5_filename);
+
+    plog << d_object_name << ":  "
+         << "read " << num_target_points << " target points from HDF5 input file named " << hdf5_filename << std::endl;
+    return;
+}// readTargetPointHDF5File
+
+void
+IBStandardInitializer::readBoundaryMassHDF5File(
+    const int ln,
+    const unsigned int j)
+{
+    const std::string hdf5_filename = d_base_filename[ln][j] + ".h5";
+    const std::string group_name = get_hdf5_group_name(d_base_filename[ln][j]);
+    hid_t file_id = open_hdf5_input_file(hdf5_filename);
+    if (file_id < 0)
+    {
+        TBOX_ERROR(d_object_name << ":\n  Unable to open HDF5 input file " << hdf5_filename << std::endl);
+    }
+    if (!hdf5_link_exists(file_id, group_name + "/mass_point"))
+    {
+        H5Fclose(file_id);
+        return;
+    }
+
+    plog << d_object_name << ":  "
+         << "processing boundary mass data from HDF5 input file named " << hdf5_filename << std::endl;
+
+    std::vector<int> node_idx;
+    std::vector<double> bdry_mass, stiffness;
+    int num_bdry_mass_pts, n;
+    read_hdf5_dataset(file_id, group_name + "/mass_point/node_idx" , H5T_NATIVE_INT   , node_idx , num_bdry_mass_pts);
+    read_hdf5_dataset(file_id, group_name + "/mass_point/bdry_mass", H5T_NATIVE_DOUBLE, bdry_mass, n);
+    read_hdf5_dataset(file_id, group_name + "/mass_point/stiffness", H5T_NATIVE_DOUBLE, stiffness, n);
+    H5Fclose(file_id);
+
+    addHDF5BoundaryMassData(ln, j, node_idx, bdry_mass, stiffness, hdf5_filename);
+
+    plog << d_object_name << ":  "
+         << "read " << num_bdry_mass_pts << " boundary mass points from HDF5 input file named " << hdf5_filename << std::endl;
+    return;
+}// readBoundaryMassHDF5File
+
+void
+IBStandardInitializer::addHDF5SpringData(
+    const int ln,
+    const unsigned int j,
+    const bool input_uses_global_idxs,
+    const std::vector<int>& node1_idx,
+    const std::vector<int>& node2_idx,
+    const std::vector<int>& force_fcn_idx,
+    const std::vector<double>& stiffness,
+    const std::vector<double>& rest_length,
+    const std::string& hdf5_filename)
+{
+    const int min_idx = 0;
+    const int max_idx = (input_uses_global_idxs ? std::accumulate(d_num_vertex[ln].begin(), d_num_vertex[ln].end(), 0) : d_num_vertex[ln][j]);
+    bool warned = d_using_spatial_filtering[ln][j];
+    for (unsigned int k = 0; k < node1_idx.size(); ++k)
+    {
+        Edge e(node1_idx[k],node2_idx[k]);
+        if ((e.first  < min_idx) || (e.first  >= max_idx) ||
+            (e.second < min_idx) || (e.second >= max_idx))
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid spring data in HDF5 input file " << hdf5_filename << std::endl
+                       << "  vertex index is out of range" << std::endl);
+        }
+        if (stiffness[k] < 0.0)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid spring data in HDF5 input file " << hdf5_filename << std::endl
+                       << "  spring constant is negative" << std::endl);
+        }
+        if (rest_length[k] < 0.0)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid spring data in HDF5 input file " << hdf5_filename << std::endl
+                       << "  spring resting length is negative" << std::endl);
+        }
+
+        std::vector<double> parameters(2);
+        parameters[0] = stiffness[k];
+        parameters[1] = d_length_scale_factor*rest_length[k];
+        int fcn_idx = force_fcn_idx[k];
+
+        // Modify kappa and length according to whether uniform values are to
+        // be employed for this particular structure.
+        if (d_using_uniform_spring_stiffness[ln][j])
+        {
+            parameters[0] = d_uniform_spring_stiffness[ln][j];
+        }
+        if (d_using_uniform_spring_rest_length[ln][j])
+        {
+            parameters[1] = d_uniform_spring_rest_length[ln][j];
+        }
+        if (d_using_uniform_spring_force_fcn_idx[ln][j])
+        {
+            fcn_idx = d_uniform_spring_force_fcn_idx[ln][j];
+        }
+
+        // Check to see if the spring constant is zero and, if so, emit a
+        // warning.
+        if (!warned && d_enable_springs[ln][j] && (parameters[0] == 0.0 || MathUtilities<double>::equalEps(parameters[0],0.0)))
+        {
+            TBOX_WARNING(d_object_name << ":\n  Spring with zero spring constant encountered in HDF5 input file named " << hdf5_filename << "." << std::endl);
+            warned = true;
+        }
+
+        // Correct the edge numbers to be in the global Lagrangian indexing
+        // scheme.
+        if (!input_uses_global_idxs)
+        {
+            e.first  += d_vertex_offset[ln][j];
+            e.second += d_vertex_offset[ln][j];
+        }
+
+        // Initialize the map data corresponding to the present edge.
+        if (e.first > e.second)
+        {
+            std::swap<int>(e.first, e.second);
+        }
+        d_spring_edge_map[ln][j].insert(std::make_pair(e.first,e));
+        SpringSpec spec_data;
+        spec_data.parameters = parameters;
+        spec_data.force_fcn_idx = fcn_idx;
+        d_spring_spec_data[ln][j].insert(std::make_pair(e,spec_data));
+    }
+    return;
+}// addHDF5SpringData
+
+void
+IBStandardInitializer::addHDF5BeamData(
+    const int ln,
+    const unsigned int j,
+    const bool input_uses_global_idxs,
+    const std::vector<int>& node1_idx,
+    const std::vector<int>& node2_idx,
+    const std::vector<int>& node3_idx,
+    const std::vector<double>& bend_rigidity,
+    const std::vector<std::vector<double> >& rest_curvature,
+    const std::string& hdf5_filename)
+{
+    const int min_idx = 0;
+    const int max_idx = (input_uses_global_idxs ? std::accumulate(d_num_vertex[ln].begin(), d_num_vertex[ln].end(), 0) : d_num_vertex[ln][j]);
+    bool warned = d_using_spatial_filtering[ln][j];
+    for (unsigned int k = 0; k < node1_idx.size(); ++k)
+    {
+        int prev_idx = node1_idx[k];
+        int curr_idx = node2_idx[k];
+        int next_idx = node3_idx[k];
+        if ((prev_idx < min_idx) || (prev_idx >= max_idx) ||
+            (curr_idx < min_idx) || (curr_idx >= max_idx) ||
+            (next_idx < min_idx) || (next_idx >= max_idx))
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid beam data in HDF5 input file " << hdf5_filename << std::endl
+                       << "  vertex index is out of range" << std::endl);
+        }
+        double bend = bend_rigidity[k];
+        if (bend < 0.0)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid beam data in HDF5 input file " << hdf5_filename << std::endl
+                       << "  beam constant is negative" << std::endl);
+        }
+        blitz::TinyVector<double,NDIM> curv;
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            curv[d] = rest_curvature[d][k];
+        }
+
+        // Modify bend and curvature according to whether uniform values are to
+        // be employed for this particular structure.
+        if (d_using_uniform_beam_bend_rigidity[ln][j])
+        {
+            bend = d_uniform_beam_bend_rigidity[ln][j];
+        }
+        if (d_using_uniform_beam_curvature[ln][j])
+        {
+            curv = d_uniform_beam_curvature[ln][j];
+        }
+
+        // Check to see if the bending rigidity is zero and, if so, emit a
+        // warning.
+        if (!warned && d_enable_beams[ln][j] && (bend == 0.0 || MathUtilities<double>::equalEps(bend,0.0)))
+        {
+            TBOX_WARNING(d_object_name << ":\n  Beam with zero bending rigidity encountered in HDF5 input file named " << hdf5_filename << "." << std::endl);
+            warned = true;
+        }
+
+        // Correct the node numbers to be in the global Lagrangian indexing
+        // scheme.
+        if (!input_uses_global_idxs)
+        {
+            prev_idx += d_vertex_offset[ln][j];
+            curr_idx += d_vertex_offset[ln][j];
+            next_idx += d_vertex_offset[ln][j];
+        }
+
+        // Initialize the map data corresponding to the present beam.
+        BeamSpec spec_data;
+        spec_data.neighbor_idxs = std::make_pair(next_idx,prev_idx);
+        spec_data.bend_rigidity = bend;
+        spec_data.curvature     = curv;
+        d_beam_spec_data[ln][j].insert(std::make_pair(curr_idx,spec_data));
+    }
+    return;
+}// addHDF5BeamData
+
+void
+IBStandardInitializer::addHDF5TargetPointData(
+    const int ln,
+    const unsigned int j,
+    const std::vector<int>& node_idx,
+    const std::vector<double>& stiffness,
+    const std::vector<double>& damping,
+    const std::string& hdf5_filename)
+{
+    bool warned = d_using_spatial_filtering[ln][j];
+    for (unsigned int k = 0; k < node_idx.size(); ++k)
+    {
+        const int idx = node_idx[k];
+        if ((idx < 0) || (idx >= d_num_vertex[ln][j]))
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid target point data in HDF5 input file " << hdf5_filename << std::endl
+                       << "  vertex index " << idx << " is out of range" << std::endl);
+        }
+        if (stiffness[k] < 0.0)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid target point data in HDF5 input file " << hdf5_filename << std::endl
+                       << "  target point spring constant is negative" << std::endl);
+        }
+        if (damping[k] < 0.0)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid target point data in HDF5 input file " << hdf5_filename << std::endl
+                       << "  target point damping coefficient is negative" << std::endl);
+        }
+        TargetSpec& spec = (d_using_spatial_filtering[ln][j] ? d_local_target_spec_data[ln][j][idx] : d_target_spec_data[ln][j][idx]);
+        spec.stiffness = stiffness[k];
+        spec.damping   = damping  [k];
+
+        // Check to see if the penalty spring constant is zero and, if so, emit
+        // a warning.
+        if (!warned && d_enable_target_points[ln][j] && (stiffness[k] == 0.0 || MathUtilities<double>::equalEps(stiffness[k],0.0)))
+        {
+            TBOX_WARNING(d_object_name << ":\n  Target point with zero penalty spring constant encountered in HDF5 input file named " << hdf5_filename << "." << std::endl);
+            warned = true;
+        }
+    }
+    return;
+}// addHDF5TargetPointData
+
+void
+IBStandardInitializer::addHDF5BoundaryMassData(
+    const int ln,
+    const unsigned int j,
+    const std::vector<int>& node_idx,
+    const std::vector<double>& bdry_mass,
+    const std::vector<double>& stiffness,
+    const std::string& hdf5_filename)
+{
+    for (unsigned int k = 0; k < node_idx.size(); ++k)
+    {
+        const int idx = node_idx[k];
+        if ((idx < 0) || (idx >= d_num_vertex[ln][j]))
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid boundary mass data in HDF5 input file " << hdf5_filename << std::endl
+                       << "  vertex index " << idx << " is out of range" << std::endl);
+        }
+        if (bdry_mass[k] < 0.0)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid boundary mass data in HDF5 input file " << hdf5_filename << std::endl
+                       << "  boundary mass is negative" << std::endl);
+        }
+        if (stiffness[k] < 0.0)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid boundary mass data in HDF5 input file " << hdf5_filename << std::endl
+                       << "  boundary mass spring constant is negative" << std::endl);
+        }
+        BdryMassSpec& spec = (d_using_spatial_filtering[ln][j] ? d_local_bdry_mass_spec_data[ln][j][idx] : d_bdry_mass_spec_data[ln][j][idx]);
+        spec.bdry_mass = bdry_mass[k];
+        spec.stiffness = stiffness[k];
+    }
+    return;
+}// addHDF5BoundaryMassData
+
+void
+IBStandardInitializer::getPatchBuckets(
+    std::vector<int>& patch_buckets,
+    const Pointer<Patch<NDIM> > patch,
+    const int level_number,
+    const unsigned int j) const
+{
+    // Determine the extents of the patch, including a ghost margin, in the
+    // (unshifted and unscaled) coordinates of the input file.
+    const BucketIndex& bucket_index = d_bucket_index[level_number][j];
+    const Pointer<CartesianPatchGeometry<NDIM> > patch_geom = patch->getPatchGeometry();
+    const double* const xLower = patch_geom->getXLower();
+    const double* const xUpper = patch_geom->getXUpper();
+    const double* const dx = patch_geom->getDx();
+    blitz::TinyVector<int,NDIM> i_lower, i_upper;
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        const double margin = d_spatial_filter_ghost_width*dx[d];
+        const double x_lower = (xLower[d]-margin)/d_length_scale_factor - d_posn_shift[d];
+        const double x_upper = (xUpper[d]+margin)/d_length_scale_factor - d_posn_shift[d];
+        if (x_upper < bucket_index.lower[d] || x_lower > bucket_index.upper[d])
+        {
+            patch_buckets.clear();
+            return;
+        }
+        const double h = (bucket_index.upper[d]-bucket_index.lower[d])/static_cast<double>(bucket_index.num_buckets[d]);
+        i_lower[d] = (h > 0.0 ? static_cast<int>(floor((x_lower-bucket_index.lower[d])/h)) : 0);
+        i_upper[d] = (h > 0.0 ? static_cast<int>(floor((x_upper-bucket_index.lower[d])/h)) : 0);
+        i_lower[d] = std::max(0,std::min(bucket_index.num_buckets[d]-1,i_lower[d]));
+        i_upper[d] = std::max(0,std::min(bucket_index.num_buckets[d]-1,i_upper[d]));
+    }
+
+    // Enumerate the buckets, which are numbered with the first index varying
+    // fastest.
+    patch_buckets.clear();
+    blitz::TinyVector<int,NDIM> i = i_lower;
+    while (true)
+    {
+        int b = 0;
+        for (int d = NDIM-1; d >= 0; --d)
+        {
+            b = b*bucket_index.num_buckets[d]+i[d];
+        }
+        patch_buckets.push_back(b);
+
+        unsigned int d = 0;
+        for ( ; d < NDIM; ++d)
+        {
+            if (++i[d] <= i_upper[d]) break;
+            i[d] = i_lower[d];
+        }
+        if (d == NDIM) break;
+    }
+    return;
+}// getPatchBuckets
+
+void
+IBStandardInitializer::loadPatchBuckets(
+    const Pointer<Patch<NDIM> > patch,
+    const int level_number)
+{
+    for (unsigned int j = 0; j < d_num_vertex[level_number].size(); ++j)
+    {
+        if (!d_using_spatial_filtering[level_number][j]) continue;
+
+        // Determine which of the buckets overlapping the patch have not yet
+        // been loaded.
+        BucketIndex& bucket_index = d_bucket_index[level_number][j];
+        std::vector<int> patch_buckets;
+        getPatchBuckets(patch_buckets, patch, level_number, j);
+        std::vector<int> new_buckets;
+        for (std::vector<int>::const_iterator it = patch_buckets.begin(); it != patch_buckets.end(); ++it)
+        {
+            if (bucket_index.bucket_vertices.find(*it) == bucket_index.bucket_vertices.end()) new_buckets.push_back(*it);
+        }
+        if (new_buckets.empty()) continue;
+
+        loadBuckets(level_number, j, new_buckets);
+    }
+    return;
+}// loadPatchBuckets
+
+void
+IBStandardInitializer::loadBuckets(
+    const int ln,
+    const unsigned int j,
+    const std::vector<int>& buckets)
+{
+    // Each process reads only the buckets that it requires, so the file is
+    // accessed independently (i.e., not collectively) here.
+    const std::string hdf5_filename = d_base_filename[ln][j] + ".h5";
+    const std::string group_name = get_hdf5_group_name(d_base_filename[ln][j]);
+    hid_t file_id = H5Fopen(hdf5_filename.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (file_id < 0)
+    {
+        TBOX_ERROR(d_object_name << ":\n  Unable to open HDF5 input file " << hdf5_filename << std::endl);
+    }
+
+    BucketIndex& bucket_index = d_bucket_index[ln][j];
+    std::vector<int> idxs;
+    for (std::vector<int>::const_iterator it = buckets.begin(); it != buckets.end(); ++it)
+    {
+        const int b = *it;
+
+        // Load the vertex positions.
+        std::vector<int>& vertices = bucket_index.bucket_vertices[b];
+        read_hdf5_rows(file_id, group_name + "/bucket/vertex_idx", H5T_NATIVE_INT, bucket_index.vertex_offsets[b], bucket_index.vertex_offsets[b+1], vertices);
+        std::vector<double> posn;
+        read_hdf5_selected_rows(file_id, group_name + "/vertex/posn", H5T_NATIVE_DOUBLE, vertices, posn);
+        for (unsigned int k = 0; k < vertices.size(); ++k)
+        {
+            blitz::TinyVector<double,NDIM>& X = d_local_vertex_posn[ln][j][vertices[k]];
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                X[d] = d_length_scale_factor*(posn[NDIM*k+d] + d_posn_shift[d]);
+            }
+        }
+
+        // Load the springs and beams whose "master" vertices are in the bucket.
+        //
+        // NOTE: Spring and beam files are always read using structure-local
+        // indices.
+        if (!bucket_index.spring_offsets.empty() && bucket_index.spring_offsets[b] < bucket_index.spring_offsets[b+1])
+        {
+            read_hdf5_rows(file_id, group_name + "/bucket/spring_idx", H5T_NATIVE_INT, bucket_index.spring_offsets[b], bucket_index.spring_offsets[b+1], idxs);
+            std::vector<int> node1_idx, node2_idx, force_fcn_idx;
+            std::vector<double> stiffness, rest_length;
+            read_hdf5_selected_rows(file_id, group_name + "/spring/node1_idx"    , H5T_NATIVE_INT   , idxs, node1_idx    );
+            read_hdf5_selected_rows(file_id, group_name + "/spring/node2_idx"    , H5T_NATIVE_INT   , idxs, node2_idx    );
+            read_hdf5_selected_rows(file_id, group_name + "/spring/force_fcn_idx", H5T_NATIVE_INT   , idxs, force_fcn_idx);
+            read_hdf5_selected_rows(file_id, group_name + "/spring/stiffness"    , H5T_NATIVE_DOUBLE, idxs, stiffness    );
+            read_hdf5_selected_rows(file_id, group_name + "/spring/rest_length"  , H5T_NATIVE_DOUBLE, idxs, rest_length  );
+            addHDF5SpringData(ln, j, /*input_uses_global_idxs*/ false, node1_idx, node2_idx, force_fcn_idx, stiffness, rest_length, hdf5_filename);
+        }
+        if (!bucket_index.beam_offsets.empty() && bucket_index.beam_offsets[b] < bucket_index.beam_offsets[b+1])
+        {
+            read_hdf5_rows(file_id, group_name + "/bucket/beam_idx", H5T_NATIVE_INT, bucket_index.beam_offsets[b], bucket_index.beam_offsets[b+1], idxs);
+            std::vector<int> node1_idx, node2_idx, node3_idx;
+            std::vector<double> bend_rigidity;
+            std::vector<std::vector<double> > rest_curvature(NDIM);
+            read_hdf5_selected_rows(file_id, group_name + "/beam/node1_idx"    , H5T_NATIVE_INT   , idxs, node1_idx    );
+            read_hdf5_selected_rows(file_id, group_name + "/beam/node2_idx"    , H5T_NATIVE_INT   , idxs, node2_idx    );
+            read_hdf5_selected_rows(file_id, group_name + "/beam/node3_idx"    , H5T_NATIVE_INT   , idxs, node3_idx    );
+            read_hdf5_selected_rows(file_id, group_name + "/beam/bend_rigidity", H5T_NATIVE_DOUBLE, idxs, bend_rigidity);
+            for (unsigned int d = 0; d < NDIM; ++d)
+            {
+                std::ostringstream os;
+                os << d;
+                read_hdf5_selected_rows(file_id, group_name + "/beam/rest_curvature" + os.str(), H5T_NATIVE_DOUBLE, idxs, rest_curvature[d]);
+            }
+            addHDF5BeamData(ln, j, /*input_uses_global_idxs*/ false, node1_idx, node2_idx, node3_idx, bend_rigidity, rest_curvature, hdf5_filename);
+        }
+
+        // Load the target point and boundary mass data associated with the
+        // vertices in the bucket.
+        TargetSpec default_target_spec;
+        default_target_spec.stiffness = 0.0;
+        default_target_spec.damping = 0.0;
+        BdryMassSpec default_bdry_mass_spec;
+        default_bdry_mass_spec.bdry_mass = 0.0;
+        default_bdry_mass_spec.stiffness = 0.0;
+        for (unsigned int k = 0; k < vertices.size(); ++k)
+        {
+            d_local_target_spec_data   [ln][j][vertices[k]] = default_target_spec;
+            d_local_bdry_mass_spec_data[ln][j][vertices[k]] = default_bdry_mass_spec;
+        }
+        if (!bucket_index.target_point_offsets.empty() && bucket_index.target_point_offsets[b] < bucket_index.target_point_offsets[b+1])
+        {
+            read_hdf5_rows(file_id, group_name + "/bucket/target_point_idx", H5T_NATIVE_INT, bucket_index.target_point_offsets[b], bucket_index.target_point_offsets[b+1], idxs);
+            std::vector<int> node_idx;
+            std::vector<double> stiffness, damping;
+            read_hdf5_selected_rows(file_id, group_name + "/target_point/node_idx" , H5T_NATIVE_INT   , idxs, node_idx );
+            read_hdf5_selected_rows(file_id, group_name + "/target_point/stiffness", H5T_NATIVE_DOUBLE, idxs, stiffness);
+            read_hdf5_selected_rows(file_id, group_name + "/target_point/damping"  , H5T_NATIVE_DOUBLE, idxs, damping  );
+            addHDF5TargetPointData(ln, j, node_idx, stiffness, damping, hdf5_filename);
+        }
+        if (!bucket_index.mass_point_offsets.empty() && bucket_index.mass_point_offsets[b] < bucket_index.mass_point_offsets[b+1])
+        {
+            read_hdf5_rows(file_id, group_name + "/bucket/mass_point_idx", H5T_NATIVE_INT, bucket_index.mass_point_offsets[b], bucket_index.mass_point_offsets[b+1], idxs);
+            std::vector<int> node_idx;
+            std::vector<double> bdry_mass, stiffness;
+            read_hdf5_selected_rows(file_id, group_name + "/mass_point/node_idx" , H5T_NATIVE_INT   , idxs, node_idx );
+            read_hdf5_selected_rows(file_id, group_name + "/mass_point/bdry_mass", H5T_NATIVE_DOUBLE, idxs, bdry_mass);
+            read_hdf5_selected_rows(file_id, group_name + "/mass_point/stiffness", H5T_NATIVE_DOUBLE, idxs, stiffness);
+            addHDF5BoundaryMassData(ln, j, node_idx, bdry_mass, stiffness, hdf5_filename);
+        }
+
+        // Modify the target point and boundary mass data according to whether they
+        // are enabled, or whether uniform values are to be employed, for this
+        // particular structure.
+        for (unsigned int k = 0; k < vertices.size(); ++k)
+        {
+            TargetSpec& target_spec = d_local_target_spec_data[ln][j][vertices[k]];
+            if (!d_enable_target_points[ln][j])
+            {
+                target_spec = default_target_spec;
+            }
+            else
+            {
+                if (d_using_uniform_target_stiffness[ln][j]) target_spec.stiffness = d_uniform_target_stiffness[ln][j];
+                if (d_using_uniform_target_damping  [ln][j]) target_spec.damping   = d_uniform_target_damping  [ln][j];
+            }
+
+            BdryMassSpec& bdry_mass_spec = d_local_bdry_mass_spec_data[ln][j][vertices[k]];
+            if (!d_enable_bdry_mass[ln][j])
+            {
+                bdry_mass_spec = default_bdry_mass_spec;
+            }
+            else
+            {
+                if (d_using_uniform_bdry_mass          [ln][j]) bdry_mass_spec.bdry_mass = d_uniform_bdry_mass          [ln][j];
+                if (d_using_uniform_bdry_mass_stiffness[ln][j]) bdry_mass_spec.stiffness = d_uniform_bdry_mass_stiffness[ln][j];
+            }
+        }
+    }
+    H5Fclose(file_id);
+    return;
+}// loadBuckets
+
+void
+IBStandardInitializer::parseVertexFile(
+    const int ln,
+    const unsigned int j,
+    const std::string& vertex_filename)
+{
+    ASCIIFileParser parser;
+    if (parser.open(vertex_filename, d_ascii_parser_num_threads))
+    {
+        plog << d_object_name << ":  "
+             << "processing vertex data from ASCII input file named " << vertex_filename << std::endl
+             << "  on MPI process " << SAMRAI_MPI::getRank() << std::endl;
+
+        // The first entry in the file is the number of vertices.
+        if (parser.getNumberOfLines() < 1)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Premature end to input file encountered before line 1 of file " << vertex_filename << std::endl);
+        }
+        if (!parser.getLineStream(0).read(d_num_vertex[ln][j]) || d_num_vertex[ln][j] <= 0)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line 1 of file " << vertex_filename << std::endl);
+        }
+
+        // Each successive line provides the initial position of each vertex in
+        // the input file.  The lines are parsed in parallel, and any errors are
+        // subsequently reported in the order in which they occur in the file.
+        const int num_vertex = d_num_vertex[ln][j];
+        const int num_parsed = std::min(num_vertex, parser.getNumberOfLines()-1);
+        d_vertex_posn[ln][j].resize(num_vertex);
+        std::vector<char> parsed(num_parsed);
+        const int num_threads = get_num_threads(d_ascii_parser_num_threads);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(num_threads) schedule(static)
+#else
+        NULL_USE(num_threads);
+#endif
+        for (int k = 0; k < num_parsed; ++k)
+        {
+            ASCIIFileParser::LineStream line_stream = parser.getLineStream(k+1);
+            blitz::TinyVector<double,NDIM>& X = d_vertex_posn[ln][j][k];
+            bool ok = true;
+            for (unsigned int d = 0; d < NDIM && ok; ++d)
+            {
+                ok = line_stream.read(X[d]);
+                if (ok) X[d] = d_length_scale_factor*(X[d] + d_posn_shift[d]);
+            }
+            parsed[k] = ok;
+        }
+        for (int k = 0; k < num_parsed; ++k)
+        {
+            if (!parsed[k])
+            {
+                TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line " << k+2 << " of file " << vertex_filename << std::endl);
+            }
+        }
+        if (num_parsed < num_vertex)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Premature end to input file encountered before line " << num_parsed+2 << " of file " << vertex_filename << std::endl);
+        }
+    }
+
+    plog << d_object_name << ":  "
+         << "read " << d_num_vertex[ln][j] << " vertices from ASCII input file named " << vertex_filename << std::endl
+         << "  on MPI process " << SAMRAI_MPI::getRank() << std::endl;
+    return;
+}// parseVertexFile
+
+void
+IBStandardInitializer::parseSpringFile(
+    const int ln,
+    const unsigned int j,
+    const std::string& spring_filename,
+    const bool input_uses_global_idxs)
+{
+    ASCIIFileParser parser;
+    if (!parser.open(spring_filename, d_ascii_parser_num_threads)) return;
+
+    plog << d_object_name << ":  "
+         << "processing spring data from ASCII input file named " << spring_filename << std::endl
+         << "  on MPI process " << SAMRAI_MPI::getRank() << std::endl;
+
+    // Determine min/max index ranges.
+    const int min_idx = 0;
+    const int max_idx = (input_uses_global_idxs ? std::accumulate(d_num_vertex[ln].begin(), d_num_vertex[ln].end(), 0) : d_num_vertex[ln][j]);
+
+    // The first line in the file indicates the number of edges in the input
+    // file.
+    int num_edges = 0;
+    if (parser.getNumberOfLines() < 1)
+    {
+        TBOX_ERROR(d_object_name << ":\n  Premature end to input file encountered before line 1 of file " << spring_filename << std::endl);
+    }
+    if (!parser.getLineStream(0).read(num_edges) || num_edges <= 0)
+    {
+        TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line 1 of file " << spring_filename << std::endl);
+    }
+
+    // Each successive line provides the connectivity and material parameter
+    // information for each spring in the structure.  The lines are parsed in
+    // parallel, and the springs are subsequently checked and added in the
+    // order in which they occur in the file.
+    const int num_parsed = std::min(num_edges, parser.getNumberOfLines()-1);
+    std::vector<Edge> edges(num_parsed);
+    std::vector<std::vector<double> > parameters(num_parsed);
+    std::vector<int> force_fcn_idxs(num_parsed);
+    std::vector<char> parsed(num_parsed);
+    const int num_threads = get_num_threads(d_ascii_parser_num_threads);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(num_threads) schedule(static)
+#else
+    NULL_USE(num_threads);
+#endif
+    for (int k = 0; k < num_parsed; ++k)
+    {
+        ASCIIFileParser::LineStream line_stream = parser.getLineStream(k+1);
+        std::vector<double>& params = parameters[k];
+        params.resize(2);
+        parsed[k] = (line_stream.read(edges[k].first ) &&
+                     line_stream.read(edges[k].second) &&
+                     line_stream.read(params[0]) &&
+                     line_stream.read(params[1]));
+        if (!parsed[k]) continue;
+        if (!line_stream.read(force_fcn_idxs[k]))
+        {
+            force_fcn_idxs[k] = 0;  // default force function specification.
+        }
+        double param;
+        while (line_stream.read(param))
+        {
+            params.push_back(param);
+        }
+    }
+
+    bool warned = false;
+    for (int k = 0; k < num_parsed; ++k)
+    {
+        Edge e = edges[k];
+        if (!parsed[k])
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line " << k+2 << " of file " << spring_filename << std::endl);
+        }
+        if ((e.first < min_idx) || (e.first >= max_idx))
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line " << k+2 << " of file " << spring_filename << std::endl
+                       << "  vertex index " << e.first << " is out of range" << std::endl);
+        }
+        if ((e.second < min_idx) || (e.second >= max_idx))
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line " << k+2 << " of file " << spring_filename << std::endl
+                       << "  vertex index " << e.second << " is out of range" << std::endl);
+        }
+        if (parameters[k][0] < 0.0)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line " << k+2 << " of file " << spring_filename << std::endl
+                       << "  spring constant is negative" << std::endl);
+        }
+        if (parameters[k][1] < 0.0)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line " << k+2 << " of file " << spring_filename << std::endl
+                       << "  spring resting length is negative" << std::endl);
+        }
+        parameters[k][1] *= d_length_scale_factor;
+        int force_fcn_idx = force_fcn_idxs[k];
+
+        // Modify kappa and length according to whether uniform values are to
+        // be employed for this particular structure.
+        if (d_using_uniform_spring_stiffness[ln][j])
+        {
+            parameters[k][0] = d_uniform_spring_stiffness[ln][j];
+        }
+        if (d_using_uniform_spring_rest_length[ln][j])
+        {
+            parameters[k][1] = d_uniform_spring_rest_length[ln][j];
+        }
+        if (d_using_uniform_spring_force_fcn_idx[ln][j])
+        {
+            force_fcn_idx = d_uniform_spring_force_fcn_idx[ln][j];
+        }
+
+        // Check to see if the spring constant is zero and, if so, emit a
+        // warning.
+        if (!warned && d_enable_springs[ln][j] && (parameters[k][0] == 0.0 || MathUtilities<double>::equalEps(parameters[k][0],0.0)))
+        {
+            TBOX_WARNING(d_object_name << ":\n  Spring with zero spring constant encountered in ASCII input file named " << spring_filename << "." << std::endl);
+            warned = true;
+        }
+
+        // Correct the edge numbers to be in the global Lagrangian indexing
+        // scheme.
+        if (!input_uses_global_idxs)
+        {
+            e.first  += d_vertex_offset[ln][j];
+            e.second += d_vertex_offset[ln][j];
+        }
+
+        // Initialize the map data corresponding to the present edge.
+        //
+        // Note that in the edge map, each edge is associated with only the
+        // first vertex.
+        if (e.first > e.second)
+        {
+            std::swap<int>(e.first, e.second);
+        }
+        d_spring_edge_map[ln][j].insert(std::make_pair(e.first,e));
+        SpringSpec spec_data;
+        spec_data.parameters.swap(parameters[k]);
+        spec_data.force_fcn_idx = force_fcn_idx;
+        d_spring_spec_data[ln][j].insert(std::make_pair(e,spec_data));
+    }
+    if (num_parsed < num_edges)
+    {
+        TBOX_ERROR(d_object_name << ":\n  Premature end to input file encountered before line " << num_parsed+2 << " of file " << spring_filename << std::endl);
+    }
+
+    plog << d_object_name << ":  "
+         << "read " << num_edges << " edges from ASCII input file named " << spring_filename << std::endl
+         << "  on MPI process " << SAMRAI_MPI::getRank() << std::endl;
+    return;
+}// parseSpringFile
+
+void
+IBStandardInitializer::parseBeamFile(
+    const int ln,
+    const unsigned int j,
+    const std::string& beam_filename,
+    const bool input_uses_global_idxs)
+{
+    ASCIIFileParser parser;
+    if (!parser.open(beam_filename, d_ascii_parser_num_threads)) return;
+
+    plog << d_object_name << ":  "
+         << "processing beam data from ASCII input file named " << beam_filename << std::endl
+         << "  on MPI process " << SAMRAI_MPI::getRank() << std::endl;
+
+    // Determine min/max index ranges.
+    const int min_idx = 0;
+    const int max_idx = (input_uses_global_idxs ? std::accumulate(d_num_vertex[ln].begin(), d_num_vertex[ln].end(), 0) : d_num_vertex[ln][j]);
+
+    // The first line in the file indicates the number of beams in the input
+    // file.
+    int num_beams = 0;
+    if (parser.getNumberOfLines() < 1)
+    {
+        TBOX_ERROR(d_object_name << ":\n  Premature end to input file encountered before line 1 of file " << beam_filename << std::endl);
+    }
+    if (!parser.getLineStream(0).read(num_beams) || num_beams <= 0)
+    {
+        TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line 1 of file " << beam_filename << std::endl);
+    }
+
+    // Each successive line provides the connectivity and material parameter
+    // information for each beam in the structure.  The lines are parsed in
+    // parallel, and the beams are subsequently checked and added in the order
+    // in which they occur in the file.
+    //
+    // The parse status of each line is 0 if the line is valid, 1 if the line
+    // contains an invalid entry, and 2 if the curvature specification is
+    // incomplete.
+    const int num_parsed = std::min(num_beams, parser.getNumberOfLines()-1);
+    std::vector<int> prev_idxs(num_parsed), curr_idxs(num_parsed), next_idxs(num_parsed);
+    std::vector<double> bends(num_parsed);
+    std::vector<blitz::TinyVector<double,NDIM> > curvs(num_parsed);
+    std::vector<char> status(num_parsed);
+    const int num_threads = get_num_threads(d_ascii_parser_num_threads);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(num_threads) schedule(static)
+#else
+    NULL_USE(num_threads);
+#endif
+    for (int k = 0; k < num_parsed; ++k)
+    {
+        ASCIIFileParser::LineStream line_stream = parser.getLineStream(k+1);
+        status[k] = (line_stream.read(prev_idxs[k]) &&
+                     line_stream.read(curr_idxs[k]) &&
+                     line_stream.read(next_idxs[k]) &&
+                     line_stream.read(bends[k])) ? 0 : 1;
+        curvs[k] = 0.0;
+        bool curv_found_in_input = false;
+        for (unsigned int d = 0; d < NDIM && status[k] == 0; ++d)
+        {
+            double c;
+            if (line_stream.read(c))
+            {
+                curv_found_in_input = true;
+                curvs[k][d] = c;
+            }
+            else if (curv_found_in_input)
+            {
+                status[k] = 2;
+            }
+        }
+    }
+
+    bool warned = false;
+    for (int k = 0; k < num_parsed; ++k)
+    {
+        int prev_idx = prev_idxs[k];
+        int curr_idx = curr_idxs[k];
+        int next_idx = next_idxs[k];
+        double bend = bends[k];
+        blitz::TinyVector<double,NDIM> curv = curvs[k];
+        if (status[k] == 1)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line " << k+2 << " of file " << beam_filename << std::endl);
+        }
+        if ((prev_idx < min_idx) || (prev_idx >= max_idx))
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line " << k+2 << " of file " << beam_filename << std::endl
+                       << "  vertex index " << prev_idx << " is out of range" << std::endl);
+        }
+        if ((curr_idx < min_idx) || (curr_idx >= max_idx))
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line " << k+2 << " of file " << beam_filename << std::endl
+                       << "  vertex index " << curr_idx << " is out of range" << std::endl);
+        }
+        if ((next_idx < min_idx) || (next_idx >= max_idx))
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line " << k+2 << " of file " << beam_filename << std::endl
+                       << "  vertex index " << next_idx << " is out of range" << std::endl);
+        }
+        if (bend < 0.0)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line " << k+2 << " of file " << beam_filename << std::endl
+                       << "  beam constant is negative" << std::endl);
+        }
+        if (status[k] == 2)
+        {
+            TBOX_ERROR(d_object_name << ":\n  Invalid entry in input file encountered on line " << k+2 << " of file " << beam_filename << std::endl
+                       << "  incomplete beam curvature specification" << std::endl);
+        }
+
+        // Modify bend and curvature according to whether uniform values are to
+        // be employed for this particular structure.
+        if (d_using_uniform_beam_bend_rigidity[ln][j])
+        {
+            bend = d_uniform_beam_bend_rigidity[ln][j];
+        }
+        if (d_using_uniform_beam_curvature[ln][j])
+        {
+            curv = d_uniform_beam_curvature[ln][j];
+        }
+
+        // Check to see if the bending rigidity is zero and, if so, emit a
+        // warning.
+        if (!warned && d_enable_beams[ln][j] && (bend == 0.0 || MathUtilities<double>::equalEps(bend,0.0)))
+        {
+            TBOX_WARNING(d_object_name << ":\n  Beam with zero bending rigidity encountered in ASCII input file named " << beam_filename << "." << std::endl);
+            warned = true;
+        }
+
+        // Correct the node numbers to be in the global Lagrangian indexing
+        // scheme.
+        if (!input_uses_global_idxs)
+        {
+            prev_idx += d_vertex_offset[ln][j];
+            curr_idx += d_vertex_offset[ln][j];
+            next_idx += d_vertex_offset[ln][j];
+        }
+
+        // Initialize the map data corresponding to the present beam.
+        //
+        // Note that in the beam property map, each edge is associated with
+        // only the "current" vertex.
+        BeamSpec spec_data;
+        spec_data.neighbor_idxs = std::make_pair(next_idx,prev_idx);
+        spec_data.bend_rigidity = bend;
+        spec_data.curvature     = curv;
+        d_beam_spec_data[ln][j].insert(std::make_pair(curr_idx,spec_data));
+    }
+    if (num_parsed < num_beams)
+    {
+        TBOX_ERROR(d_object_name << ":\n  Premature end to input file encountered before line " << num_parsed+2 << " of file " << beam_filename << std::endl);
+    }
+
+    plog << d_object_name << ":  "
+         << "read " << num_beams << " beams from ASCII input file named " << beam_filename << std::endl
+         << "  on MPI process " << SAMRAI_MPI::getRank() << std::endl;
+    return;
+}// parseBeamFile
+
+bool
+IBStandardInitializer::readStructureCacheFile(
+    const int ln,
+    const unsigned int j)
+{
+    const std::string cache_filename = d_base_filename[ln][j] + ".ibcache";
+
+    // Only the root MPI process checks whether the cache file is consistent
+    // with the input files, since doing so may require hashing their contents.
+    int cache_is_valid = 0;
+    if (SAMRAI_MPI::getRank() == 0)
+    {
+        BinaryCacheFile cache_file;
+        cache_is_valid = (cache_file.openForReading(cache_filename) && readStructureCacheHeader(cache_file, ln, j, /*check_file_stamps*/ true)) ? 1 : 0;
+    }
+    if (SAMRAI_MPI::sumReduction(cache_is_valid) == 0) return false;
+
+    // All processes read the cached structure data.  Connectivity data are
+    // stored relative to the first vertex of the structure.
+    const int offset = d_vertex_offset[ln][j];
+    BinaryCacheFile cache_file;
+    bool read_ok = cache_file.openForReading(cache_filename) && readStructureCacheHeader(cache_file, ln, j, /*check_file_stamps*/ false);
+    if (read_ok)
+    {
+        // Vertex data.
+        d_num_vertex[ln][j] = std::max(cache_file.read<int>(), 0);
+        d_vertex_posn[ln][j].resize(d_num_vertex[ln][j]);
+        for (int k = 0; k < d_num_vertex[ln][j]; ++k)
+        {
+            cache_file.read(d_vertex_posn[ln][j][k].data(), NDIM);
+        }
+        read_ok = read_ok && d_num_vertex[ln][j] > 0;
+
+        // Spring data.
+        const int num_spring_edges = std::max(cache_file.read<int>(), 0);
+        for (int k = 0; k < num_spring_edges; ++k)
+        {
+            Edge e;
+            e.first  = cache_file.read<int>()+offset;
+            e.second = cache_file.read<int>()+offset;
+            d_spring_edge_map[ln][j].insert(std::make_pair(e.first,e));
+        }
+        const int num_spring_specs = std::max(cache_file.read<int>(), 0);
+        for (int k = 0; k < num_spring_specs; ++k)
+        {
+            Edge e;
+            e.first  = cache_file.read<int>()+offset;
+            e.second = cache_file.read<int>()+offset;
+            SpringSpec spec_data;
+            spec_data.force_fcn_idx = cache_file.read<int>();
+            spec_data.parameters.resize(std::max(cache_file.read<int>(), 0));
+            if (!spec_data.parameters.empty()) cache_file.read(&spec_data.parameters[0], spec_data.parameters.size());
+            d_spring_spec_data[ln][j].insert(std::make_pair(e,spec_data));
+        }
+
+        // Beam data.
+        const int num_beams = std::max(cache_file.read<int>(), 0);
+        for (int k = 0; k < num_beams; ++k)
+        {
+            const int curr_idx = cache_file.read<int>()+offset;
+            BeamSpec spec_data;
+            spec_data.neighbor_idxs.first  = cache_file.read<int>()+offset;
+            spec_data.neighbor_idxs.second = cache_file.read<int>()+offset;
+            spec_data.bend_rigidity = cache_file.read<double>();
+            cache_file.read(spec_data.curvature.data(), NDIM);
+            d_beam_spec_data[ln][j].insert(std::make_pair(curr_idx,spec_data));
+        }
+
+        // Rod data.
+        const int num_rod_edges = std::max(cache_file.read<int>(), 0);
+        for (int k = 0; k < num_rod_edges; ++k)
+        {
+            Edge e;
+            e.first  = cache_file.read<int>()+offset;
+            e.second = cache_file.read<int>()+offset;
+            d_rod_edge_map[ln][j].insert(std::make_pair(e.first,e));
+        }
+        const int num_rod_specs = std::max(cache_file.read<int>(), 0);
+        for (int k = 0; k < num_rod_specs; ++k)
+        {
+            Edge e;
+            e.first  = cache_file.read<int>()+offset;
+            e.second = cache_file.read<int>()+offset;
+            RodSpec rod_spec;
+            cache_file.read(rod_spec.properties.data(), IBRodForceSpec::NUM_MATERIAL_PARAMS);
+            d_rod_spec_data[ln][j].insert(std::make_pair(e,rod_spec));
+        }
+
+        // Target point data.
+        d_target_spec_data[ln][j].resize(std::max(cache_file.read<int>(), 0));
+        for (unsigned int k = 0; k < d_target_spec_data[ln][j].size(); ++k)
+        {
+            d_target_spec_data[ln][j][k].stiffness = cache_file.read<double>();
+            d_target_spec_data[ln][j][k].damping   = cache_file.read<double>();
+        }
+
+        // Anchor point data.
+        d_anchor_spec_data[ln][j].resize(std::max(cache_file.read<int>(), 0));
+        for (unsigned int k = 0; k < d_anchor_spec_data[ln][j].size(); ++k)
+        {
+            d_anchor_spec_data[ln][j][k].is_anchor_point = cache_file.read<int>() != 0;
+        }
+
+        // Boundary mass data.
+        d_bdry_mass_spec_data[ln][j].resize(std::max(cache_file.read<int>(), 0));
+        for (unsigned int k = 0; k < d_bdry_mass_spec_data[ln][j].size(); ++k)
+        {
+            d_bdry_mass_spec_data[ln][j][k].bdry_mass = cache_file.read<double>();
+            d_bdry_mass_spec_data[ln][j][k].stiffness = cache_file.read<double>();
+        }
+
+        // Director data.
+        d_directors[ln][j].resize(std::max(cache_file.read<int>(), 0));
+        for (unsigned int k = 0; k < d_directors[ln][j].size(); ++k)
+        {
+            d_directors[ln][j][k].resize(std::max(cache_file.read<int>(), 0));
+            if (!d_directors[ln][j][k].empty()) cache_file.read(&d_directors[ln][j][k][0], d_directors[ln][j][k].size());
+        }
+        read_ok = read_ok && cache_file.good();
+    }
+    cache_file.close();
+
+    // Fall back to reading the input files if any process was unable to read
+    // the cache file.
+    int read_failed = read_ok ? 0 : 1;
+    if (SAMRAI_MPI::sumReduction(read_failed) > 0)
+    {
+        TBOX_WARNING(d_object_name << ":\n  Unable to read structure cache file named " << cache_filename << "; reading input files instead." << std::endl);
+        d_num_vertex[ln][j] = 0;
+        d_vertex_posn[ln][j].clear();
+        d_spring_edge_map[ln][j].clear();
+        d_spring_spec_data[ln][j].clear();
+        d_beam_spec_data[ln][j].clear();
+        d_rod_edge_map[ln][j].clear();
+        d_rod_spec_data[ln][j].clear();
+        d_target_spec_data[ln][j].clear();
+        d_anchor_spec_data[ln][j].clear();
+        d_bdry_mass_spec_data[ln][j].clear();
+        d_directors[ln][j].clear();
+        return false;
+    }
+
+    plog << d_object_name << ":  "
+         << "read " << d_num_vertex[ln][j] << " vertices from structure cache file named " << cache_filename << std::endl
+         << "  on MPI process " << SAMRAI_MPI::getRank() << std::endl;
+    return true;
+}// readStructureCacheFile
+
+bool
+IBStandardInitializer::readStructureCacheHeader(
+    BinaryCacheFile& cache_file,
+    const int ln,
+    const unsigned int j,
+    const bool check_file_stamps) const
+{
+    std::string magic(STRUCTURE_CACHE_MAGIC_LENGTH, ' ');
+    cache_file.read(&magic[0], STRUCTURE_CACHE_MAGIC_LENGTH);
+    const int version = cache_file.read<int>();
+    const int ndim = cache_file.read<int>();
+    const unsigned long long key = cache_file.read<unsigned long long>();
+    if (!cache_file.good() || magic != STRUCTURE_CACHE_MAGIC || version != STRUCTURE_CACHE_VERSION || ndim != NDIM || key != computeStructureCacheKey(ln, j))
+    {
+        return false;
+    }
+
+    // Each input file must either be unmodified since the cache file was
+    // generated or have the same contents as at that time.  The contents of
+    // the input files are hashed only if their modification times differ.
+    for (int k = 0; k < NUM_CACHED_FILE_EXTENSIONS; ++k)
+    {
+        const BinaryCacheFile::FileStamp cached_stamp = read_file_stamp(cache_file);
+        if (!check_file_stamps) continue;
+        const std::string filename = d_base_filename[ln][j] + CACHED_FILE_EXTENSIONS[k];
+        const BinaryCacheFile::FileStamp stamp = BinaryCacheFile::getFileStamp(filename, /*compute_hash*/ false);
+        if (stamp.exists != cached_stamp.exists || stamp.size != cached_stamp.size) return false;
+        if (stamp.exists && stamp.mtime != cached_stamp.mtime && BinaryCacheFile::computeFileHash(filename) != cached_stamp.hash) return false;
+    }
+    return cache_file.good();
+}// readStructureCacheHeader
+
+void
+IBStandardInitializer::writeStructureCacheFiles()
+{
+    if (SAMRAI_MPI::getRank() != 0) return;
+    for (int ln = 0; ln < d_max_levels; ++ln)
+    {
+        const unsigned int num_base_filename = d_base_filename[ln].size();
+        for (unsigned int j = 0; j < num_base_filename; ++j)
+        {
+            // Only structures that were read from ASCII input files are cached.
+            if (d_using_hdf5_input[ln][j] || d_using_structure_cache[ln][j] || d_num_vertex[ln][j] <= 0) continue;
+            const std::string cache_filename = d_base_filename[ln][j] + ".ibcache";
+            const int offset = d_vertex_offset[ln][j];
+            BinaryCacheFile cache_file;
+
+            // Header.
+            cache_file.write(STRUCTURE_CACHE_MAGIC, STRUCTURE_CACHE_MAGIC_LENGTH);
+            cache_file.write(STRUCTURE_CACHE_VERSION);
+            cache_file.write<int>(NDIM);
+            cache_file.write(computeStructureCacheKey(ln, j));
+            for (int k = 0; k < NUM_CACHED_FILE_EXTENSIONS; ++k)
+            {
+                write_file_stamp(cache_file, BinaryCacheFile::getFileStamp(d_base_filename[ln][j] + CACHED_FILE_EXTENSIONS[k], /*compute_hash*/ true));
+            }
+
+            // Vertex data.
+            cache_file.write(d_num_vertex[ln][j]);
+            for (int k = 0; k < d_num_vertex[ln][j]; ++k)
+            {
+                cache_file.write(d_vertex_posn[ln][j][k].data(), NDIM);
+            }
+
+            // Spring data.
+            cache_file.write<int>(d_spring_edge_map[ln][j].size());
+            for (std::multimap<int,Edge>::const_iterator it = d_spring_edge_map[ln][j].begin(); it != d_spring_edge_map[ln][j].end(); ++it)
+            {
+                cache_file.write<int>(it->second.first -offset);
+                cache_file.write<int>(it->second.second-offset);
+            }
+            cache_file.write<int>(d_spring_spec_data[ln][j].size());
+            for (std::map<Edge,SpringSpec,EdgeComp>::const_iterator it = d_spring_spec_data[ln][j].begin(); it != d_spring_spec_data[ln][j].end(); ++it)
+            {
+                const SpringSpec& spec_data = it->second;
+                cache_file.write<int>(it->first.first -offset);
+                cache_file.write<int>(it->first.second-offset);
+                cache_file.write(spec_data.force_fcn_idx);
+                cache_file.write<int>(spec_data.parameters.size());
+                if (!spec_data.parameters.empty()) cache_file.write(&spec_data.parameters[0], spec_data.parameters.size());
+            }
+
+            // Beam data.
+            cache_file.write<int>(d_beam_spec_data[ln][j].size());
+            for (std::multimap<int,BeamSpec>::const_iterator it = d_beam_spec_data[ln][j].begin(); it != d_beam_spec_data[ln][j].end(); ++it)
+            {
+                const BeamSpec& spec_data = it->second;
+                cache_file.write<int>(it->first-offset);
+                cache_file.write<int>(spec_data.neighbor_idxs.first -offset);
+                cache_file.write<int>(spec_data.neighbor_idxs.second-offset);
+                cache_file.write(spec_data.bend_rigidity);
+                cache_file.write(spec_data.curvature.data(), NDIM);
+            }
+
+            // Rod data.
+            cache_file.write<int>(d_rod_edge_map[ln][j].size());
+            for (std::multimap<int,Edge>::const_iterator it = d_rod_edge_map[ln][j].begin(); it != d_rod_edge_map[ln][j].end(); ++it)
+            {
+                cache_file.write<int>(it->second.first -offset);
+                cache_file.write<int>(it->second.second-offset);
+            }
+            cache_file.write<int>(d_rod_spec_data[ln][j].size());
+            for (std::map<Edge,RodSpec,EdgeComp>::const_iterator it = d_rod_spec_data[ln][j].begin(); it != d_rod_spec_data[ln][j].end(); ++it)
+            {
+                cache_file.write<int>(it->first.first -offset);
+                cache_file.write<int>(it->first.second-offset);
+                cache_file.write(it->second.properties.data(), IBRodForceSpec::NUM_MATERIAL_PARAMS);
+            }
+
+            // Target point data.
+            cache_file.write<int>(d_target_spec_data[ln][j].size());
+            for (unsigned int k = 0; k < d_target_spec_data[ln][j].size(); ++k)
+            {
+                cache_file.write(d_target_spec_data[ln][j][k].stiffness);
+                cache_file.write(d_target_spec_data[ln][j][k].damping);
+            }
+
+            // Anchor point data.
+            cache_file.write<int>(d_anchor_spec_data[ln][j].size());
+            for (unsigned int k = 0; k < d_anchor_spec_data[ln][j].size(); ++k)
+            {
+                cache_file.write<int>(d_anchor_spec_data[ln][j][k].is_anchor_point ? 1 : 0);
+            }
+
+            // Boundary mass data.
+            cache_file.write<int>(d_bdry_mass_spec_data[ln][j].size());
+            for (unsigned int k = 0; k < d_bdry_mass_spec_data[ln][j].size(); ++k)
+            {
+                cache_file.write(d_bdry_mass_spec_data[ln][j][k].bdry_mass);
+                cache_file.write(d_bdry_mass_spec_data[ln][j][k].stiffness);
+            }
+
+            // Director data.
+            cache_file.write<int>(d_directors[ln][j].size());
+            for (unsigned int k = 0; k < d_directors[ln][j].size(); ++k)
+            {
+                cache_file.write<int>(d_directors[ln][j][k].size());
+                if (!d_directors[ln][j][k].empty()) cache_file.write(&d_directors[ln][j][k][0], d_directors[ln][j][k].size());
+            }
+
+            // Failing to write the cache file only affects subsequent runs.
+            if (cache_file.commit(cache_filename))
+            {
+                plog << d_object_name << ":  "
+                     << "wrote structure cache file named " << cache_filename << std::endl;
+            }
+            else
+            {
+                TBOX_WARNING(d_object_name << ":\n  Unable to write structure cache file named " << cache_filename << "." << std::endl);
+            }
+        }
+    }
+    return;
+}// writeStructureCacheFiles
+
+unsigned long long
+IBStandardInitializer::computeStructureCacheKey(
+    const int ln,
+    const unsigned int j) const
+{
+    // The key depends on all input database parameters that modify the data
+    // stored in the cache files, including the flags that enable or disable
+    // the various structure components (the readers zero or skip the data
+    // associated with disabled components).
+    unsigned long long key = BinaryCacheFile::hashBytes(&d_length_scale_factor, sizeof(double));
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        hash_value(d_posn_shift[d], key);
+    }
+    hash_value(static_cast<int>(d_enable_springs[ln][j]), key);
+    hash_value(static_cast<int>(d_enable_xsprings[ln][j]), key);
+    hash_value(static_cast<int>(d_enable_beams[ln][j]), key);
+    hash_value(static_cast<int>(d_enable_rods[ln][j]), key);
+    hash_value(static_cast<int>(d_enable_target_points[ln][j]), key);
+    hash_value(static_cast<int>(d_enable_anchor_points[ln][j]), key);
+    hash_value(static_cast<int>(d_enable_bdry_mass[ln][j]), key);
+    hash_value(static_cast<int>(d_enable_instrumentation[ln][j]), key);
+    hash_value(static_cast<int>(d_enable_sources[ln][j]), key);
+    hash_value(static_cast<int>(d_using_uniform_spring_stiffness[ln][j]), key);
+    if (d_using_uniform_spring_stiffness[ln][j]) hash_value(d_uniform_spring_stiffness[ln][j], key);
+    hash_value(static_cast<int>(d_using_uniform_spring_rest_length[ln][j]), key);
+    if (d_using_uniform_spring_rest_length[ln][j]) hash_value(d_uniform_spring_rest_length[ln][j], key);
+    hash_value(static_cast<int>(d_using_uniform_spring_force_fcn_idx[ln][j]), key);
+    if (d_using_uniform_spring_force_fcn_idx[ln][j]) hash_value(d_uniform_spring_force_fcn_idx[ln][j], key);
+    hash_value(static_cast<int>(d_using_uniform_beam_bend_rigidity[ln][j]), key);
+    if (d_using_uniform_beam_bend_rigidity[ln][j]) hash_value(d_uniform_beam_bend_rigidity[ln][j], key);
+    hash_value(static_cast<int>(d_using_uniform_beam_curvature[ln][j]), key);
+    if (d_using_uniform_beam_curvature[ln][j])
+    {
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            hash_value(d_uniform_beam_curvature[ln][j][d], key);
+        }
+    }
+    hash_value(static_cast<int>(d_using_uniform_rod_properties[ln][j]), key);
+    if (d_using_uniform_rod_properties[ln][j])
+    {
+        for (int k = 0; k < IBRodForceSpec::NUM_MATERIAL_PARAMS; ++k)
+        {
+            hash_value(d_uniform_rod_properties[ln][j][k], key);
+        }
+    }
+    hash_value(static_cast<int>(d_using_uniform_target_stiffness[ln][j]), key);
+    if (d_using_uniform_target_stiffness[ln][j]) hash_value(d_uniform_target_stiffness[ln][j], key);
+    hash_value(static_cast<int>(d_using_uniform_target_damping[ln][j]), key);
+    if (d_using_uniform_target_damping[ln][j]) hash_value(d_uniform_target_damping[ln][j], key);
+    hash_value(static_cast<int>(d_using_uniform_bdry_mass[ln][j]), key);
+    if (d_using_uniform_bdry_mass[ln][j]) hash_value(d_uniform_bdry_mass[ln][j], key);
+    hash_value(static_cast<int>(d_using_uniform_bdry_mass_stiffness[ln][j]), key);
+    if (d_using_uniform_bdry_mass_stiffness[ln][j]) hash_value(d_uniform_bdry_mass_stiffness[ln][j], key);
+    return key;
+}// computeStructureCacheKey
+
+void
+IBStandardInitializer::getPatchVertices(
+    std::vector<std::pair<int,int> >& patch_vertices,
+    const Pointer<Patch<NDIM> > patch,
+    const int level_number,
+    const bool /*can_be_refined*/) const
+{
+    // Loop over all of the vertices to determine the indices of those vertices
+    // within the present patch.
+    //
+    // NOTE: This is clearly not the best way to do this, but it will work for
+    // now.
+    const Pointer<CartesianPatchGeometry<NDIM> > patch_geom = patch->getPatchGeometry();
+    const double* const xLower = patch_geom->getXLower();
+    const double* const xUpper = patch_geom->getXUpper();
+
+    for (unsigned int j = 0; j < d_num_vertex[level_number].size(); ++j)
+    {
+        // Only the vertices in the buckets overlapping the patch need to be
+        // considered for spatially filtered structures.
+        if (d_using_spatial_filtering[level_number][j])
+        {
+            const BucketIndex& bucket_index = d_bucket_index[level_number][j];
+            std::vector<int> patch_buckets;
+            getPatchBuckets(patch_buckets, patch, level_number, j);
+            for (std::vector<int>::const_iterator b = patch_buckets.begin(); b != patch_buckets.end(); ++b)
+            {
+                std::map<int,std::vector<int> >::const_iterator it = bucket_index.bucket_vertices.find(*b);
+                if (it == bucket_index.bucket_vertices.end())
+                {
+                    TBOX_ERROR(d_object_name << "::getPatchVertices():\n"
+                               << "  structure data required by patch have not been loaded." << std::endl);
+                }
+                const std::vector<int>& bucket_vertices = it->second;
+                for (std::vector<int>::const_iterator k = bucket_vertices.begin(); k != bucket_vertices.end(); ++k)
+                {
+                    const blitz::TinyVector<double,NDIM>& X = d_local_vertex_posn[level_number][j].find(*k)->second;
+                    const bool patch_owns_node =
+                        ((  xLower[0] <= X[0])&&(X[0] < xUpper[0]))
+#if (NDIM > 1)
+                        &&((xLower[1] <= X[1])&&(X[1] < xUpper[1]))
+#if (NDIM > 2)
+                        &&((xLower[2] <= X[2])&&(X[2] < xUpper[2]))
+#endif
+#endif
+                        ;
+                    if (patch_owns_node) patch_vertices.push_back(std::make_pair(j,*k));
+                }
+            }
+            continue;
+        }
+
+        for (int k = 0; k < d_num_vertex[level_number][j]; ++k)
+        {
+            const blitz::TinyVector<double,NDIM>& X = d_vertex_posn[level_number][j][k];
+            const bool patch_owns_node =
+                ((  xLower[0] <= X[0])&&(X[0] < xUpper[0]))
+#if (NDIM > 1)
+                &&((xLower[1] <= X[1])&&(X[1] < xUpper[1]))
+#if (NDIM > 2)
+                &&((xLower[2] <= X[2])&&(X[2] < xUpper[2]))
+#endif
+#endif
+                ;
+            if (patch_owns_node) patch_vertices.push_back(std::make_pair(j,k));
+        }
+    }
+    return;
+}// getPatchVertices
+
+int
+IBStandardInitializer::getCanonicalLagrangianIndex(
+    const std::pair<int,int>& point_index,
+    const int level_number) const
+{
+    return d_vertex_offset[level_number][point_index.first]+point_index.second;
+}// getCanonicalLagrangianIndex
+
+blitz::TinyVector<double,NDIM>
+IBStandardInitializer::getVertexPosn(
+    const std::pair<int,int>& point_index,
+    const int level_number) const
+{
+    if (d_using_spatial_filtering[level_number][point_index.first])
+    {
+        return d_local_vertex_posn[level_number][point_index.first].find(point_index.second)->second;
+    }
+    return d_vertex_posn[level_number][point_index.first][point_index.second];
+}// getVertexPosn
+
+const IBStandardInitializer::TargetSpec&
+IBStandardInitializer::getVertexTargetSpec(
+    const std::pair<int,int>& point_index,
+    const int level_number) const
+{
+    if (d_using_spatial_filtering[level_number][point_index.first])
+    {
+        return d_local_target_spec_data[level_number][point_index.first].find(point_index.second)->second;
+    }
+    return d_target_spec_data[level_number][point_index.first][point_index.second];
+}// getVertexTargetSpec
+
+const IBStandardInitializer::AnchorSpec&
+IBStandardInitializer::getVertexAnchorSpec(
+    const std::pair<int,int>& point_index,
+    const int level_number) const
+{
+    return d_anchor_spec_data[level_number][point_index.first][point_index.second];
+}// getVertexAnchorSpec
+
+const IBStandardInitializer::BdryMassSpec&
+IBStandardInitializer::getVertexBdryMassSpec(
+    const std::pair<int,int>& point_index,
+    const int level_number) const
+{
+    if (d_using_spatial_filtering[level_number][point_index.first])
+    {
+        return d_local_bdry_mass_spec_data[level_number][point_index.first].find(point_index.second)->second;
+    }
+    return d_bdry_mass_spec_data[level_number][point_index.first][point_index.second];
+}// getVertexBdryMassSpec
+
+const std::vector<double>&
+IBStandardInitializer::getVertexDirectors(
+    const std::pair<int,int>& point_index,
+    const int level_number) const
+{
+    return d_directors[level_number][point_index.first][point_index.second];
+}// getVertexDirectors
+
+std::pair<int,int>
+IBStandardInitializer::getVertexInstrumentationIndices(
+    const std::pair<int,int>& point_index,
+    const int level_number) const
+{
+    std::map<int,std::pair<int,int> >::const_iterator it = d_instrument_idx[level_number][point_index.first].find(point_index.second);
+    if (it != d_instrument_idx[level_number][point_index.first].end())
+    {
+        return it->second;
+    }
+    else
+    {
+        return std::make_pair(-1,-1);
+    }
+}// getVertexInstrumentationIndices
+
+int
+IBStandardInitializer::getVertexSourceIndices(
+    const std::pair<int,int>& point_index,
+    const int level_number) const
+{
+    std::map<int,int>::const_iterator it = d_source_idx[level_number][point_index.first].find(point_index.second);
+    if (it != d_source_idx[level_number][point_index.first].end())
+    {
+        return it->second;
+    }
+    else
+    {
+        return -1;
+    }
+}// getVertexSourceIndices
+
+std::vector<Pointer<Streamable> >
+IBStandardInitializer::initializeSpecs(
+    const std::pair<int,int>& point_index,
+    const unsigned int global_index_offset,
+    const int level_number) const
+{
+    std::vector<Pointer<Streamable> > vertex_specs;
+
+    const int j = point_index.first;
+    const int mastr_idx = getCanonicalLagrangianIndex(point_index, level_number);
+
+    // Initialize any spring specifications associated with the present vertex.
     {
         std::vector<int> slave_idxs, force_fcn_idxs;
         std::vector<std::vector<double> > parameters;
@@ -2830,6 +4754,31 @@ IBStandardInitializer::getFromInput(
     // reading the same file at once.
     if (db->keyExists("use_file_batons")) d_use_file_batons = db->getBool("use_file_batons");
 
+    // Determine whether to read structure data from HDF5 files generated by
+    // ascii2hdf when such files are available.
+    if (db->keyExists("use_hdf5_input")) d_use_hdf5_input = db->getBool("use_hdf5_input");
+
+    // Determine whether to load only those parts of the structures that are
+    // near the local patches, and the width (in grid cells) of the margin that
+    // is added to each patch when determining which parts of the structures
+    // to load.
+    if (db->keyExists("use_spatial_filtering")) d_use_spatial_filtering = db->getBool("use_spatial_filtering");
+    if (db->keyExists("spatial_filter_ghost_width")) d_spatial_filter_ghost_width = db->getDouble("spatial_filter_ghost_width");
+    if (d_use_spatial_filtering && !d_use_hdf5_input)
+    {
+        TBOX_ERROR(d_object_name << ":  "
+                   << "Key data `use_spatial_filtering' requires `use_hdf5_input' to be TRUE.");
+    }
+
+    // Determine whether to store parsed structure data in binary cache files
+    // that are read instead of the ASCII input files on subsequent runs.
+    if (db->keyExists("use_structure_cache")) d_use_structure_cache = db->getBool("use_structure_cache");
+
+    // Determine whether to read the vertex, spring, and beam input files using
+    // the parallel ASCII parser, and the number of threads used by the parser.
+    if (db->keyExists("use_parallel_ascii_parser")) d_use_parallel_ascii_parser = db->getBool("use_parallel_ascii_parser");
+    if (db->keyExists("ascii_parser_num_threads")) d_ascii_parser_num_threads = db->getInteger("ascii_parser_num_threads");
+
     // Determine the (maximum) number of levels in the locally refined grid.
     // Note that each piece of the Lagrangian structure must be assigned to a
     // particular level of the grid.
@@ -2853,10 +4802,15 @@ IBStandardInitializer::getFromInput(
     d_level_is_initialized.resize(d_max_levels,false);
 
     d_base_filename.resize(d_max_levels);
+    d_using_hdf5_input.resize(d_max_levels);
+    d_using_structure_cache.resize(d_max_levels);
+    d_using_spatial_filtering.resize(d_max_levels);
+    d_bucket_index.resize(d_max_levels);
 
     d_num_vertex.resize(d_max_levels);
     d_vertex_offset.resize(d_max_levels);
     d_vertex_posn.resize(d_max_levels);
+    d_local_vertex_posn.resize(d_max_levels);
 
     d_enable_springs.resize(d_max_levels);
     d_spring_edge_map.resize(d_max_levels);
@@ -2893,6 +4847,7 @@ IBStandardInitializer::getFromInput(
 
     d_enable_target_points.resize(d_max_levels);
     d_target_spec_data.resize(d_max_levels);
+    d_local_target_spec_data.resize(d_max_levels);
     d_using_uniform_target_stiffness.resize(d_max_levels);
     d_uniform_target_stiffness.resize(d_max_levels);
     d_using_uniform_target_damping.resize(d_max_levels);
@@ -2903,6 +4858,7 @@ IBStandardInitializer::getFromInput(
 
     d_enable_bdry_mass.resize(d_max_levels);
     d_bdry_mass_spec_data.resize(d_max_levels);
+    d_local_bdry_mass_spec_data.resize(d_max_levels);
     d_using_uniform_bdry_mass.resize(d_max_levels);
     d_uniform_bdry_mass.resize(d_max_levels);
     d_using_uniform_bdry_mass_stiffness.resize(d_max_levels);
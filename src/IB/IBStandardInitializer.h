@@ -48,6 +48,7 @@
 #include "tbox/Pointer.h"
 
 namespace IBTK {
+class BinaryCacheFile;
 class LData;
 class LDataManager;
 class Streamable;
@@ -405,6 +406,58 @@ namespace IBAMR
  D2_x_2   D2_y_2   D2_z_2  # coordinates of director D2 associated with vertex 2
  ...
  \endverbatim
+ *
+ * <HR>
+ *
+ * <B>HDF5 input</B>
+ *
+ * When the input database key <TT>use_hdf5_input</TT> is set to <TT>TRUE</TT>,
+ * the vertex, spring, beam, target point, and boundary mass data for each
+ * structure are read from the file <TT>"base_filename.h5"</TT> generated by the
+ * <TT>ascii2hdf</TT> utility, if that file exists.  Each MPI process reads a
+ * contiguous block of each dataset (collectively when HDF5 has been configured
+ * with parallel I/O support), and the blocks are subsequently exchanged so that
+ * every process holds the complete structure.  File batons are not used for
+ * HDF5 input files.  All other data (e.g., x-springs, rods, anchor points,
+ * directors, instrumentation, and sources) are always read from ASCII input
+ * files.
+ *
+ * HDF5 input files generated by <TT>ascii2hdf base_filename N</TT> also contain
+ * a spatial bucket index that sorts the vertices, springs, beams, target
+ * points, and boundary mass points into an N x N (x N) grid of buckets covering
+ * the structure.  When the input database key <TT>use_spatial_filtering</TT> is
+ * set to <TT>TRUE</TT>, only this index is read during construction.  The
+ * remaining data are loaded on demand, one bucket at a time, for the buckets
+ * that overlap the local patches grown by <TT>spatial_filter_ghost_width</TT>
+ * grid cells (default 1.0).  Memory usage and read time on each MPI process
+ * therefore scale with the local part of the structure.  Spring connectivity
+ * is not registered with the Silo data writer for such structures.
+ *
+ * <B>Structure cache</B>
+ *
+ * When the input database key <TT>use_structure_cache</TT> is set to
+ * <TT>TRUE</TT>, the parsed vertex, spring, beam, rod, target point, anchor
+ * point, boundary mass, and director data of each structure that is read from
+ * ASCII input files are written to the binary file
+ * <TT>"base_filename.ibcache"</TT>.  On subsequent runs, the structure is read
+ * from this file instead of from the ASCII input files, provided that the cache
+ * file was generated with the same scale and shift factors and uniform
+ * parameter values, and that each input file has the same size and either the
+ * same modification time or the same contents as when the cache file was
+ * generated.  Otherwise, the ASCII input files are read and the cache file is
+ * regenerated.  The cache file is written by MPI process 0, and errors writing
+ * it are not fatal.  All other data (e.g., x-springs, instrumentation, and
+ * sources) are always read from ASCII input files.
+ *
+ * <B>Parallel ASCII parser</B>
+ *
+ * When the input database key <TT>use_parallel_ascii_parser</TT> is set to
+ * <TT>TRUE</TT>, ASCII vertex, spring, and beam input files are memory mapped
+ * and parsed by <TT>ascii_parser_num_threads</TT> threads (default 1; a
+ * nonpositive value indicates the default number of OpenMP threads).  All MPI
+ * processes read these files at the same time, so file batons are not used for
+ * them.  The file format, including the treatment of comments, and the error
+ * checking are the same as for the default reader.
 */
 class IBStandardInitializer
     : public IBTK::LInitStrategy
@@ -589,6 +642,210 @@ private:
     readVertexFiles(
         const std::string& extension);
 
+    /*!
+     * \brief Read the vertex data for a single structure from an HDF5 input
+     * file.
+     */
+    void
+    readVertexHDF5File(
+        int ln,
+        unsigned int j);
+
+    /*!
+     * \brief Read the spring data for a single structure from an HDF5 input
+     * file.
+     */
+    void
+    readSpringHDF5File(
+        int ln,
+        unsigned int j,
+        bool input_uses_global_idxs);
+
+    /*!
+     * \brief Read the beam data for a single structure from an HDF5 input
+     * file.
+     */
+    void
+    readBeamHDF5File(
+        int ln,
+        unsigned int j,
+        bool input_uses_global_idxs);
+
+    /*!
+     * \brief Read the target point data for a single structure from an HDF5
+     * input file.
+     */
+    void
+    readTargetPointHDF5File(
+        int ln,
+        unsigned int j);
+
+    /*!
+     * \brief Read the boundary mass data for a single structure from an HDF5
+     * input file.
+     */
+    void
+    readBoundaryMassHDF5File(
+        int ln,
+        unsigned int j);
+
+    /*!
+     * \brief Add spring data read from an HDF5 input file.
+     */
+    void
+    addHDF5SpringData(
+        int ln,
+        unsigned int j,
+        bool input_uses_global_idxs,
+        const std::vector<int>& node1_idx,
+        const std::vector<int>& node2_idx,
+        const std::vector<int>& force_fcn_idx,
+        const std::vector<double>& stiffness,
+        const std::vector<double>& rest_length,
+        const std::string& hdf5_filename);
+
+    /*!
+     * \brief Add beam data read from an HDF5 input file.
+     */
+    void
+    addHDF5BeamData(
+        int ln,
+        unsigned int j,
+        bool input_uses_global_idxs,
+        const std::vector<int>& node1_idx,
+        const std::vector<int>& node2_idx,
+        const std::vector<int>& node3_idx,
+        const std::vector<double>& bend_rigidity,
+        const std::vector<std::vector<double> >& rest_curvature,
+        const std::string& hdf5_filename);
+
+    /*!
+     * \brief Add target point data read from an HDF5 input file.
+     */
+    void
+    addHDF5TargetPointData(
+        int ln,
+        unsigned int j,
+        const std::vector<int>& node_idx,
+        const std::vector<double>& stiffness,
+        const std::vector<double>& damping,
+        const std::string& hdf5_filename);
+
+    /*!
+     * \brief Add boundary mass data read from an HDF5 input file.
+     */
+    void
+    addHDF5BoundaryMassData(
+        int ln,
+        unsigned int j,
+        const std::vector<int>& node_idx,
+        const std::vector<double>& bdry_mass,
+        const std::vector<double>& stiffness,
+        const std::string& hdf5_filename);
+
+    /*!
+     * \brief Determine the spatial buckets of a spatially filtered structure
+     * that overlap the specified patch (including a ghost margin).
+     */
+    void
+    getPatchBuckets(
+        std::vector<int>& patch_buckets,
+        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
+        int level_number,
+        unsigned int j) const;
+
+    /*!
+     * \brief Load the data of all spatially filtered structures on the
+     * specified level that are located near the specified patch.
+     */
+    void
+    loadPatchBuckets(
+        SAMRAI::tbox::Pointer<SAMRAI::hier::Patch<NDIM> > patch,
+        int level_number);
+
+    /*!
+     * \brief Load the data associated with the specified spatial buckets of a
+     * spatially filtered structure.
+     */
+    void
+    loadBuckets(
+        int ln,
+        unsigned int j,
+        const std::vector<int>& buckets);
+
+    /*!
+     * \brief Read the vertex data for a single structure using the parallel
+     * ASCII parser.
+     */
+    void
+    parseVertexFile(
+        int ln,
+        unsigned int j,
+        const std::string& vertex_filename);
+
+    /*!
+     * \brief Read the spring data for a single structure using the parallel
+     * ASCII parser.
+     */
+    void
+    parseSpringFile(
+        int ln,
+        unsigned int j,
+        const std::string& spring_filename,
+        bool input_uses_global_idxs);
+
+    /*!
+     * \brief Read the beam data for a single structure using the parallel
+     * ASCII parser.
+     */
+    void
+    parseBeamFile(
+        int ln,
+        unsigned int j,
+        const std::string& beam_filename,
+        bool input_uses_global_idxs);
+
+    /*!
+     * \brief Read the data for a single structure from its binary structure
+     * cache file, if that file is consistent with the structure's input files
+     * and the input database.
+     *
+     * \return Whether the structure data were read from the cache file.
+     */
+    bool
+    readStructureCacheFile(
+        int ln,
+        unsigned int j);
+
+    /*!
+     * \brief Read and check the header of a binary structure cache file.
+     *
+     * The file stamps of the structure's input files are compared to those
+     * stored in the cache file only if \a check_file_stamps is true.
+     */
+    bool
+    readStructureCacheHeader(
+        IBTK::BinaryCacheFile& cache_file,
+        int ln,
+        unsigned int j,
+        bool check_file_stamps) const;
+
+    /*!
+     * \brief Write the binary structure cache files for all structures that
+     * were read from ASCII input files.
+     */
+    void
+    writeStructureCacheFiles();
+
+    /*!
+     * \brief Compute a hash of the input database parameters that modify the
+     * data read from the input files of a single structure.
+     */
+    unsigned long long
+    computeStructureCacheKey(
+        int ln,
+        unsigned int j) const;
+
     /*!
      * \brief Read the spring data from one or more input files.
      */
@@ -782,6 +1039,36 @@ private:
      */
     bool d_use_file_batons;
 
+    /*
+     * The boolean value determines whether structure data are read from HDF5
+     * input files when such files are available, and, for each structure,
+     * whether an HDF5 input file is actually being used.
+     */
+    bool d_use_hdf5_input;
+
+    /*
+     * The boolean value determines whether structures that provide a spatial
+     * bucket index are loaded on demand, so that each MPI process stores only
+     * the parts of the structures that are located near its patches, and the
+     * width (in grid cells) of the margin added to each patch.
+     */
+    bool d_use_spatial_filtering;
+    double d_spatial_filter_ghost_width;
+
+    /*
+     * The boolean value determines whether parsed structure data are stored in
+     * and read from binary structure cache files.
+     */
+    bool d_use_structure_cache;
+
+    /*
+     * The boolean value determines whether vertex, spring, and beam input files
+     * are read using the parallel ASCII parser, and the number of threads used
+     * by that parser.
+     */
+    bool d_use_parallel_ascii_parser;
+    int d_ascii_parser_num_threads;
+
     /*
      * The maximum number of levels in the Cartesian grid patch hierarchy and a
      * vector of boolean values indicating whether a particular level has been
@@ -800,6 +1087,26 @@ private:
      * when registering data with the Silo data writer.
      */
     std::vector<std::vector<std::string> > d_base_filename;
+    std::vector<std::vector<bool> > d_using_hdf5_input;
+    std::vector<std::vector<bool> > d_using_structure_cache;
+
+    /*
+     * Spatial bucket indices of spatially filtered structures.
+     *
+     * The buckets form a uniform grid over the bounding box of the structure
+     * (in the coordinates of the input file) and are numbered with the first
+     * index varying fastest.  The offset arrays give the ranges of the
+     * bucket-sorted item indices stored in the input file for each bucket.
+     */
+    struct BucketIndex
+    {
+        blitz::TinyVector<double,NDIM> lower, upper;
+        blitz::TinyVector<int,NDIM> num_buckets;
+        std::vector<int> vertex_offsets, spring_offsets, beam_offsets, target_point_offsets, mass_point_offsets;
+        std::map<int,std::vector<int> > bucket_vertices;
+    };
+    std::vector<std::vector<bool> > d_using_spatial_filtering;
+    std::vector<std::vector<BucketIndex> > d_bucket_index;
 
     /*
      * Optional shift and scale factors.
@@ -821,6 +1128,7 @@ private:
      */
     std::vector<std::vector<int> > d_num_vertex, d_vertex_offset;
     std::vector<std::vector<std::vector<blitz::TinyVector<double,NDIM> > > > d_vertex_posn;
+    std::vector<std::vector<std::map<int,blitz::TinyVector<double,NDIM> > > > d_local_vertex_posn;
 
     /*
      * Edge data structures.
@@ -929,6 +1237,7 @@ private:
         double stiffness, damping;
     };
     std::vector<std::vector<std::vector<TargetSpec> > > d_target_spec_data;
+    std::vector<std::vector<std::map<int,TargetSpec> > > d_local_target_spec_data;
 
     std::vector<std::vector<bool> > d_using_uniform_target_stiffness;
     std::vector<std::vector<double> > d_uniform_target_stiffness;
@@ -957,6 +1266,7 @@ private:
         double bdry_mass, stiffness;
     };
     std::vector<std::vector<std::vector<BdryMassSpec> > > d_bdry_mass_spec_data;
+    std::vector<std::vector<std::map<int,BdryMassSpec> > > d_local_bdry_mass_spec_data;
 
     std::vector<std::vector<bool> > d_using_uniform_bdry_mass;
     std::vector<std::vector<double> > d_uniform_bdry_mass;
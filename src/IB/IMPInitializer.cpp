@@ -55,6 +55,8 @@
 #include "ibamr/MaterialPointSpec.h"
 #include "ibamr/MaterialPointSpec-inl.h"
 #include "ibamr/namespaces.h" // IWYU pragma: keep
+#include "ibtk/BinaryCacheFile.h"
+#include "ibtk/BinaryCacheFile-inl.h"
 #include "ibtk/IndexUtilities.h"
 #include "ibtk/IndexUtilities-inl.h"
 #include "ibtk/LData.h"
@@ -100,6 +102,23 @@ namespace
 {
 static const double MIN_POINTS = 1.0;
 static const double POINT_FACTOR = 2.0;
+
+// Identifying string and version number of material point cache files.  The
+// version number must be incremented whenever the layout of the cache files or
+// the algorithm used to generate the material points is changed.
+static const char* const MESH_CACHE_MAGIC = "IMPCACHE";
+static const int MESH_CACHE_MAGIC_LENGTH = 8;
+static const int MESH_CACHE_VERSION = 1;
+
+template<typename T>
+inline void
+hash_value(
+    const T& value,
+    unsigned long long& hash)
+{
+    hash = BinaryCacheFile::hashBytes(&value, sizeof(T), hash);
+    return;
+}// hash_value
 }
 
 /////////////////////////////// PUBLIC ///////////////////////////////////////
@@ -119,7 +138,9 @@ IMPInitializer::IMPInitializer(
       d_vertex_posn(d_gridding_alg->getMaxLevels()),
       d_vertex_wgt(d_gridding_alg->getMaxLevels()),
       d_vertex_subdomain_id(d_gridding_alg->getMaxLevels()),
-      d_silo_writer(NULL)
+      d_silo_writer(NULL),
+      d_use_structure_cache(false),
+      d_structure_cache_prefix(object_name)
 {
 #ifdef DEBUG_CHECK_ASSERTIONS
     TBOX_ASSERT(!object_name.empty());
@@ -130,7 +151,7 @@ IMPInitializer::IMPInitializer(
     MaterialPointSpec::registerWithStreamableManager();
 
     // Initialize object with data read from the input database.
-    getFromInput(input_db);
+    if (input_db) getFromInput(input_db);
     return;
 }// IMPInitializer
 
@@ -163,6 +184,26 @@ IMPInitializer::registerMesh(
     }
     const double dx_min = *std::min_element(dx,dx+NDIM);
 
+    // Allocate storage for the material points of the mesh.
+    d_num_vertex         [level_number].resize(d_num_vertex         [level_number].size()+1, 0);
+    d_vertex_offset      [level_number].resize(d_vertex_offset      [level_number].size()+1, mesh_idx == 0 ? 0 : d_num_vertex[level_number][mesh_idx-1]);
+    d_vertex_posn        [level_number].resize(d_vertex_posn        [level_number].size()+1);
+    d_vertex_wgt         [level_number].resize(d_vertex_wgt         [level_number].size()+1);
+    d_vertex_subdomain_id[level_number].resize(d_vertex_subdomain_id[level_number].size()+1);
+
+    // Reuse the cached material points if they were generated from the same
+    // mesh and grid spacing.
+    unsigned long long cache_key = 0;
+    std::string cache_filename;
+    if (d_use_structure_cache)
+    {
+        cache_key = computeMeshCacheKey(mesh, dx_min);
+        std::ostringstream cache_filename_stream;
+        cache_filename_stream << d_structure_cache_prefix << "_level" << level_number << "_mesh" << mesh_idx << ".impcache";
+        cache_filename = cache_filename_stream.str();
+        if (readMeshCacheFile(cache_filename, cache_key, level_number, mesh_idx)) return;
+    }
+
     // Setup data structures for computing the positions of the material points
     // and weighting factors.
     const int dim = mesh->mesh_dimension();
@@ -176,8 +217,6 @@ IMPInitializer::registerMesh(
     const MeshBase::const_element_iterator el_end   = mesh->active_elements_end();
 
     // Count the number of material points.
-    d_num_vertex   [level_number].resize(d_num_vertex   [level_number].size()+1, 0);
-    d_vertex_offset[level_number].resize(d_vertex_offset[level_number].size()+1, mesh_idx == 0 ? 0 : d_num_vertex[level_number][mesh_idx-1]);
     for (MeshBase::const_element_iterator el_it = el_begin; el_it != el_end; ++el_it)
     {
         const Elem* const elem = *el_it;
@@ -194,9 +233,6 @@ IMPInitializer::registerMesh(
     }
 
     // Initialize the material points.
-    d_vertex_posn        [level_number].resize(d_vertex_posn         [level_number].size()+1);
-    d_vertex_wgt         [level_number].resize(d_vertex_wgt          [level_number].size()+1);
-    d_vertex_subdomain_id[level_number].resize(d_vertex_subdomain_id [level_number].size()+1);
     d_vertex_posn        [level_number][mesh_idx].resize(d_num_vertex[level_number][mesh_idx]);
     d_vertex_wgt         [level_number][mesh_idx].resize(d_num_vertex[level_number][mesh_idx]);
     d_vertex_subdomain_id[level_number][mesh_idx].resize(d_num_vertex[level_number][mesh_idx]);
@@ -220,6 +256,12 @@ IMPInitializer::registerMesh(
             d_vertex_subdomain_id[level_number][mesh_idx][k] = elem->subdomain_id();
         }
     }
+
+    // Cache the material points for subsequent runs.
+    if (d_use_structure_cache && SAMRAI_MPI::getRank() == 0)
+    {
+        writeMeshCacheFile(cache_filename, cache_key, level_number, mesh_idx);
+    }
     return;
 }// registerMesh
 
@@ -553,11 +595,141 @@ IMPInitializer::getVertexPosn(
 
 void
 IMPInitializer::getFromInput(
-    Pointer<Database> /*db*/)
+    Pointer<Database> db)
 {
+    // Determine whether to store the material points generated for each mesh in
+    // binary cache files that are read on subsequent runs.
+    if (db->keyExists("use_structure_cache")) d_use_structure_cache = db->getBool("use_structure_cache");
+    if (db->keyExists("structure_cache_prefix")) d_structure_cache_prefix = db->getString("structure_cache_prefix");
     return;
 }// getFromInput
 
+unsigned long long
+IMPInitializer::computeMeshCacheKey(
+    const MeshBase* const mesh,
+    const double dx_min) const
+{
+    // The material points are determined by the element types, node positions,
+    // and subdomain IDs of the active elements and by the grid spacing.
+    unsigned long long key = BinaryCacheFile::hashBytes(&dx_min, sizeof(double));
+    hash_value(MIN_POINTS, key);
+    hash_value(POINT_FACTOR, key);
+    hash_value(static_cast<int>(mesh->mesh_dimension()), key);
+    const MeshBase::const_element_iterator el_begin = mesh->active_elements_begin();
+    const MeshBase::const_element_iterator el_end   = mesh->active_elements_end();
+    for (MeshBase::const_element_iterator el_it = el_begin; el_it != el_end; ++el_it)
+    {
+        const Elem* const elem = *el_it;
+        hash_value(static_cast<int>(elem->type()), key);
+        hash_value(static_cast<int>(elem->subdomain_id()), key);
+        for (unsigned int n = 0; n < elem->n_nodes(); ++n)
+        {
+            const Point& X = elem->point(n);
+            for (unsigned int d = 0; d < LIBMESH_DIM; ++d)
+            {
+                hash_value(static_cast<double>(X(d)), key);
+            }
+        }
+    }
+    return key;
+}// computeMeshCacheKey
+
+bool
+IMPInitializer::readMeshCacheFile(
+    const std::string& cache_filename,
+    const unsigned long long cache_key,
+    const int level_number,
+    const unsigned int mesh_idx)
+{
+    BinaryCacheFile cache_file;
+    if (!cache_file.openForReading(cache_filename)) return false;
+    std::string magic(MESH_CACHE_MAGIC_LENGTH, ' ');
+    cache_file.read(&magic[0], MESH_CACHE_MAGIC_LENGTH);
+    const int version = cache_file.read<int>();
+    const int libmesh_dim = cache_file.read<int>();
+    const unsigned long long key = cache_file.read<unsigned long long>();
+    const int num_vertex = cache_file.read<int>();
+    if (!cache_file.good() || magic != MESH_CACHE_MAGIC || version != MESH_CACHE_VERSION || libmesh_dim != LIBMESH_DIM || key != cache_key || num_vertex < 0)
+    {
+        return false;
+    }
+
+    std::vector<Point>& X = d_vertex_posn[level_number][mesh_idx];
+    std::vector<double>& wgt = d_vertex_wgt[level_number][mesh_idx];
+    std::vector<subdomain_id_type>& subdomain_id = d_vertex_subdomain_id[level_number][mesh_idx];
+    X.resize(num_vertex);
+    wgt.resize(num_vertex);
+    subdomain_id.resize(num_vertex);
+    for (int k = 0; k < num_vertex; ++k)
+    {
+        for (unsigned int d = 0; d < LIBMESH_DIM; ++d)
+        {
+            X[k](d) = cache_file.read<double>();
+        }
+    }
+    if (num_vertex > 0) cache_file.read(&wgt[0], num_vertex);
+    for (int k = 0; k < num_vertex; ++k)
+    {
+        subdomain_id[k] = cache_file.read<int>();
+    }
+    if (!cache_file.good())
+    {
+        X.clear();
+        wgt.clear();
+        subdomain_id.clear();
+        return false;
+    }
+    d_num_vertex[level_number][mesh_idx] = num_vertex;
+
+    plog << d_object_name << ":  "
+         << "read " << num_vertex << " material points from cache file named " << cache_filename << std::endl
+         << "  on MPI process " << SAMRAI_MPI::getRank() << std::endl;
+    return true;
+}// readMeshCacheFile
+
+void
+IMPInitializer::writeMeshCacheFile(
+    const std::string& cache_filename,
+    const unsigned long long cache_key,
+    const int level_number,
+    const unsigned int mesh_idx) const
+{
+    const std::vector<Point>& X = d_vertex_posn[level_number][mesh_idx];
+    const std::vector<double>& wgt = d_vertex_wgt[level_number][mesh_idx];
+    const std::vector<subdomain_id_type>& subdomain_id = d_vertex_subdomain_id[level_number][mesh_idx];
+    const int num_vertex = d_num_vertex[level_number][mesh_idx];
+    BinaryCacheFile cache_file;
+    cache_file.write(MESH_CACHE_MAGIC, MESH_CACHE_MAGIC_LENGTH);
+    cache_file.write(MESH_CACHE_VERSION);
+    cache_file.write<int>(LIBMESH_DIM);
+    cache_file.write(cache_key);
+    cache_file.write(num_vertex);
+    for (int k = 0; k < num_vertex; ++k)
+    {
+        for (unsigned int d = 0; d < LIBMESH_DIM; ++d)
+        {
+            cache_file.write<double>(X[k](d));
+        }
+    }
+    if (num_vertex > 0) cache_file.write(&wgt[0], num_vertex);
+    for (int k = 0; k < num_vertex; ++k)
+    {
+        cache_file.write<int>(subdomain_id[k]);
+    }
+
+    // Failing to write the cache file only affects subsequent runs.
+    if (cache_file.commit(cache_filename))
+    {
+        plog << d_object_name << ":  "
+             << "wrote material point cache file named " << cache_filename << std::endl;
+    }
+    else
+    {
+        TBOX_WARNING(d_object_name << ":\n  Unable to write material point cache file named " << cache_filename << "." << std::endl);
+    }
+    return;
+}// writeMeshCacheFile
+
 /////////////////////////////// NAMESPACE ////////////////////////////////////
 
 }// namespace IBAMR
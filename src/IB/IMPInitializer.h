@@ -74,6 +74,17 @@ namespace IBAMR
  * \brief Class IMPInitializer is a concrete LInitStrategy that initializes the
  * configuration of one or more Lagrangian structures that are described using
  * the immersed material point method from FE meshes.
+ *
+ * When the input database key <TT>use_structure_cache</TT> is set to
+ * <TT>TRUE</TT>, the material point positions, weights, and subdomain IDs
+ * generated for each registered mesh are written to the binary file
+ * <TT>"prefix_levelL_meshM.impcache"</TT>, in which the prefix is given by the
+ * input database key <TT>structure_cache_prefix</TT> (default: the object
+ * name).  Subsequent runs reuse these data, provided that the mesh nodes,
+ * element connectivity and subdomain IDs, and the grid spacing on the assigned
+ * level are unchanged.  Because meshes are provided by the application rather
+ * than read from files by this class, consistency is determined from a hash of
+ * the mesh data rather than from file modification times.
 */
 class IMPInitializer
     : public IBTK::LInitStrategy
@@ -260,6 +271,40 @@ private:
     getFromInput(
         SAMRAI::tbox::Pointer<SAMRAI::tbox::Database> db);
 
+    /*!
+     * \brief Compute a hash of the mesh data and grid spacing that determine the
+     * material points generated for a mesh.
+     */
+    unsigned long long
+    computeMeshCacheKey(
+        const libMesh::MeshBase* mesh,
+        double dx_min) const;
+
+    /*!
+     * \brief Read the material point data for the specified mesh from a binary
+     * cache file.
+     *
+     * \return Whether the cache file exists and was generated with the
+     * specified key.
+     */
+    bool
+    readMeshCacheFile(
+        const std::string& cache_filename,
+        unsigned long long cache_key,
+        int level_number,
+        unsigned int mesh_idx);
+
+    /*!
+     * \brief Write the material point data for the specified mesh to a binary
+     * cache file.
+     */
+    void
+    writeMeshCacheFile(
+        const std::string& cache_filename,
+        unsigned long long cache_key,
+        int level_number,
+        unsigned int mesh_idx) const;
+
     /*
      * The object name is used as a handle to databases stored in restart files
      * and for error reporting purposes.
@@ -291,6 +336,14 @@ private:
      * An (optional) Lagrangian Silo data writer.
      */
     SAMRAI::tbox::Pointer<IBTK::LSiloDataWriter> d_silo_writer;
+
+    /*
+     * The boolean value determines whether material point data are stored in
+     * and read from binary cache files, and the prefix of the names of those
+     * files.
+     */
+    bool d_use_structure_cache;
+    std::string d_structure_cache_prefix;
 };
 }// namespace IBAMR
 
@@ -32,6 +32,8 @@
 
 /////////////////////////////// INCLUDES /////////////////////////////////////
 
+#include <algorithm>
+#include <cmath>
 #include <cstdlib>
 #include <fstream>
 #include <iomanip>
@@ -57,20 +59,27 @@ void initializeBeamData(           const string& base_filename, hid_t file_id);
 void initializeTargetPointData(    const string& base_filename, hid_t file_id);
 void initializeMassData(           const string& base_filename, hid_t file_id);
 void initializeInstrumentationData(const string& base_filename, hid_t file_id);
+void initializeBucketData(         const string& base_filename, int num_buckets_per_dim, hid_t file_id);
 
 int
 main(
     int argc,
     char* argv[])
 {
-    if (argc != 2)
+    if (argc != 2 && argc != 3)
     {
         cout << argv[0] << ": a tool to convert IBAMR input files from ASCII to HDF5 formats\n"
-             << "USAGE: " << argv[0] << " <base filename>\n";
+             << "USAGE: " << argv[0] << " <base filename> [<number of spatial buckets per dimension>]\n";
         return -1;
     }
 
     const string base_filename = argv[1];
+    const int num_buckets_per_dim = (argc == 3 ? atoi(argv[2]) : 0);
+    if (argc == 3 && num_buckets_per_dim <= 0)
+    {
+        cout << "error: number of spatial buckets per dimension must be positive\n";
+        return -1;
+    }
 
     cout << argv[0] << ": a tool to convert IBAMR input files from ASCII to HDF5 formats\n\n"
          << "base filename: " << base_filename << "\n\n"
@@ -99,6 +108,7 @@ main(
     initializeTargetPointData(base_filename, file_id);
     initializeMassData(base_filename, file_id);
     initializeInstrumentationData(base_filename, file_id);
+    if (num_buckets_per_dim > 0) initializeBucketData(base_filename, num_buckets_per_dim, file_id);
 
     // Cleanup HDF5 data structures.
     H5Gclose(base_group_id);
@@ -1439,6 +1449,186 @@ initializeInstrumentationData(
     return;
 }// initializeInstrumentationData
 
+void
+sortByBucket(
+    const vector<int>& item_bucket,
+    const int num_buckets,
+    vector<int>& bucket_offsets,
+    vector<int>& bucket_items)
+{
+    // Counting sort of the item indices by bucket.
+    bucket_offsets.assign(num_buckets+1,0);
+    for (unsigned int k = 0; k < item_bucket.size(); ++k)
+    {
+        ++bucket_offsets[item_bucket[k]+1];
+    }
+    for (int b = 0; b < num_buckets; ++b)
+    {
+        bucket_offsets[b+1] += bucket_offsets[b];
+    }
+    bucket_items.resize(item_bucket.size());
+    vector<int> next(bucket_offsets.begin(), bucket_offsets.end()-1);
+    for (unsigned int k = 0; k < item_bucket.size(); ++k)
+    {
+        bucket_items[next[item_bucket[k]]++] = k;
+    }
+    return;
+}// sortByBucket
+
+void
+writeBucketIndex(
+    const string& bucket_group_name,
+    const string& item_name,
+    const vector<int>& item_bucket,
+    const int num_buckets,
+    hid_t file_id)
+{
+    vector<int> bucket_offsets, bucket_items;
+    sortByBucket(item_bucket, num_buckets, bucket_offsets, bucket_items);
+    hsize_t offsets_dims[1] = { static_cast<hsize_t>(bucket_offsets.size()) };
+    const string offsets_dset_name = bucket_group_name + "/" + item_name + "_offsets";
+    H5LTmake_dataset_int(file_id, offsets_dset_name.c_str(), 1, offsets_dims, &bucket_offsets[0]);
+    if (!bucket_items.empty())
+    {
+        hsize_t items_dims[1] = { static_cast<hsize_t>(bucket_items.size()) };
+        const string items_dset_name = bucket_group_name + "/" + item_name + "_idx";
+        H5LTmake_dataset_int(file_id, items_dset_name.c_str(), 1, items_dims, &bucket_items[0]);
+    }
+    return;
+}// writeBucketIndex
+
+void
+readIntDataset(
+    const string& dset_name,
+    const int num_items,
+    hid_t file_id,
+    vector<int>& data)
+{
+    data.resize(num_items);
+    if (num_items > 0) H5LTread_dataset_int(file_id, dset_name.c_str(), &data[0]);
+    return;
+}// readIntDataset
+
+void
+initializeBucketData(
+    const string& base_filename,
+    const int num_buckets_per_dim,
+    hid_t file_id)
+{
+    cout << "generating spatial bucket index with " << num_buckets_per_dim << " buckets per dimension\n";
+
+    // Read back the vertex positions.
+    vector<double> posn(NDIM*num_vertex);
+    const string vertex_posn_dset_name = "/" + base_filename + "/vertex/posn";
+    H5LTread_dataset_double(file_id, vertex_posn_dset_name.c_str(), &posn[0]);
+
+    // Determine the bounding box of the structure.
+    vector<double> lower(NDIM), upper(NDIM);
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        lower[d] = upper[d] = posn[d];
+    }
+    for (int k = 0; k < num_vertex; ++k)
+    {
+        for (unsigned int d = 0; d < NDIM; ++d)
+        {
+            lower[d] = min(lower[d],posn[NDIM*k+d]);
+            upper[d] = max(upper[d],posn[NDIM*k+d]);
+        }
+    }
+
+    // Assign each vertex to a bucket of a uniform grid that covers the
+    // bounding box of the structure.
+    int num_buckets = 1;
+    vector<int> num_buckets_dim(NDIM,num_buckets_per_dim);
+    for (unsigned int d = 0; d < NDIM; ++d)
+    {
+        num_buckets *= num_buckets_dim[d];
+    }
+    vector<int> vertex_bucket(num_vertex);
+    for (int k = 0; k < num_vertex; ++k)
+    {
+        int b = 0;
+        for (int d = NDIM-1; d >= 0; --d)
+        {
+            const double h = (upper[d]-lower[d])/static_cast<double>(num_buckets_dim[d]);
+            int i = (h > 0.0 ? static_cast<int>(floor((posn[NDIM*k+d]-lower[d])/h)) : 0);
+            i = max(0,min(num_buckets_dim[d]-1,i));
+            b = b*num_buckets_dim[d]+i;
+        }
+        vertex_bucket[k] = b;
+    }
+
+    // Create the bucket group and write out the bucket grid and the vertex
+    // index.
+    const string bucket_group_name = "/" + base_filename + "/bucket";
+    hid_t bucket_group_id = H5Gcreate1(file_id, bucket_group_name.c_str(), 0);
+    hsize_t dims[1] = { NDIM };
+    H5LTmake_dataset_double(file_id, (bucket_group_name + "/lower").c_str(), 1, dims, &lower[0]);
+    H5LTmake_dataset_double(file_id, (bucket_group_name + "/upper").c_str(), 1, dims, &upper[0]);
+    H5LTmake_dataset_int(file_id, (bucket_group_name + "/num_buckets").c_str(), 1, dims, &num_buckets_dim[0]);
+    writeBucketIndex(bucket_group_name, "vertex", vertex_bucket, num_buckets, file_id);
+
+    // Springs are assigned to the bucket of their "master" vertex, i.e., the
+    // vertex with the smaller index.
+    if (num_spring > 0)
+    {
+        vector<int> node1_idx, node2_idx;
+        readIntDataset("/" + base_filename + "/spring/node1_idx", num_spring, file_id, node1_idx);
+        readIntDataset("/" + base_filename + "/spring/node2_idx", num_spring, file_id, node2_idx);
+        vector<int> spring_bucket(num_spring);
+        for (int k = 0; k < num_spring; ++k)
+        {
+            spring_bucket[k] = vertex_bucket[min(node1_idx[k],node2_idx[k])];
+        }
+        writeBucketIndex(bucket_group_name, "spring", spring_bucket, num_buckets, file_id);
+    }
+
+    // Beams are assigned to the bucket of their "current" (middle) vertex.
+    if (num_beam > 0)
+    {
+        vector<int> node2_idx;
+        readIntDataset("/" + base_filename + "/beam/node2_idx", num_beam, file_id, node2_idx);
+        vector<int> beam_bucket(num_beam);
+        for (int k = 0; k < num_beam; ++k)
+        {
+            beam_bucket[k] = vertex_bucket[node2_idx[k]];
+        }
+        writeBucketIndex(bucket_group_name, "beam", beam_bucket, num_buckets, file_id);
+    }
+
+    // Target and mass points are assigned to the bucket of their vertex.
+    if (num_target_point > 0)
+    {
+        vector<int> node_idx;
+        readIntDataset("/" + base_filename + "/target_point/node_idx", num_target_point, file_id, node_idx);
+        vector<int> target_point_bucket(num_target_point);
+        for (int k = 0; k < num_target_point; ++k)
+        {
+            target_point_bucket[k] = vertex_bucket[node_idx[k]];
+        }
+        writeBucketIndex(bucket_group_name, "target_point", target_point_bucket, num_buckets, file_id);
+    }
+
+    if (num_mass_point > 0)
+    {
+        vector<int> node_idx;
+        readIntDataset("/" + base_filename + "/mass_point/node_idx", num_mass_point, file_id, node_idx);
+        vector<int> mass_point_bucket(num_mass_point);
+        for (int k = 0; k < num_mass_point; ++k)
+        {
+            mass_point_bucket[k] = vertex_bucket[node_idx[k]];
+        }
+        writeBucketIndex(bucket_group_name, "mass_point", mass_point_bucket, num_buckets, file_id);
+    }
+
+    cout << "\n";
+
+    // Cleanup HDF5 data structures.
+    H5Gclose(bucket_group_id);
+    return;
+}// initializeBucketData
+
 /////////////////////////////// PUBLIC ///////////////////////////////////////
 
 /////////////////////////////// PROTECTED ////////////////////////////////////